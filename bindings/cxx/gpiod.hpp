@@ -39,8 +39,10 @@
 #include "gpiodcxx/line.hpp"
 #include "gpiodcxx/line-config.hpp"
 #include "gpiodcxx/line-info.hpp"
+#include "gpiodcxx/line-program.hpp"
 #include "gpiodcxx/line-request.hpp"
 #include "gpiodcxx/line-settings.hpp"
+#include "gpiodcxx/quadrature-decoder.hpp"
 #include "gpiodcxx/request-builder.hpp"
 #include "gpiodcxx/request-config.hpp"
 #undef __LIBGPIOD_GPIOD_CXX_INSIDE__
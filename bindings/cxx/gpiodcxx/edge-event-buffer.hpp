@@ -21,6 +21,7 @@ namespace gpiod {
 
 class edge_event;
 class line_request;
+class quadrature_decoder;
 
 /**
  * @ingroup gpiod_cxx
@@ -110,6 +111,7 @@ private:
 	::std::unique_ptr<impl> _m_priv;
 
 	friend line_request;
+	friend quadrature_decoder;
 };
 
 /**
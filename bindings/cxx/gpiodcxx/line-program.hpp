@@ -0,0 +1,155 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* SPDX-FileCopyrightText: 2026 The libgpiod authors */
+
+/**
+ * @file line-program.hpp
+ */
+
+#ifndef __LIBGPIOD_CXX_LINE_PROGRAM_HPP__
+#define __LIBGPIOD_CXX_LINE_PROGRAM_HPP__
+
+#if !defined(__LIBGPIOD_GPIOD_CXX_INSIDE__)
+#error "Only gpiod.hpp can be included directly."
+#endif
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "line.hpp"
+
+namespace gpiod {
+
+class line_request;
+
+/**
+ * @ingroup gpiod_cxx
+ * @{
+ */
+
+/**
+ * @brief Precompiled sequence of line operations executed in a single call.
+ *
+ * Running a whole transaction in the core library avoids the overhead of
+ * going through the bindings for every step. Lines are addressed with bit
+ * masks where bit N corresponds to the N-th line of the request. The line
+ * requests referenced by the program must outlive it.
+ */
+class line_program final
+{
+public:
+
+	/**
+	 * @brief Constructor. Creates a new, empty program.
+	 */
+	line_program();
+
+	line_program(const line_program& other) = delete;
+
+	/**
+	 * @brief Move constructor.
+	 * @param other Object to move.
+	 */
+	line_program(line_program&& other) noexcept;
+
+	~line_program();
+
+	line_program& operator=(const line_program& other) = delete;
+
+	/**
+	 * @brief Move assignment operator.
+	 * @param other Object to move.
+	 * @return Reference to self.
+	 */
+	line_program& operator=(line_program&& other) noexcept;
+
+	/**
+	 * @brief Append an operation setting the values of a subset of lines.
+	 * @param request Line request to operate on.
+	 * @param mask Lines to set.
+	 * @param bits Values to set. Bits not in the mask are ignored.
+	 * @return Reference to self.
+	 */
+	line_program& add_set(const line_request& request, ::std::uint64_t mask,
+			      ::std::uint64_t bits);
+
+	/**
+	 * @brief Append an operation reading the values of a subset of lines.
+	 * @param request Line request to operate on.
+	 * @param mask Lines to read.
+	 * @return Reference to self.
+	 *
+	 * Stores the masked bits in the next result slot.
+	 */
+	line_program& add_get(const line_request& request, ::std::uint64_t mask);
+
+	/**
+	 * @brief Append an operation sleeping until a point in time.
+	 * @param offset Offset from the start of the innermost loop iteration
+	 *               or from the start of the run outside of any loops.
+	 * @return Reference to self.
+	 */
+	line_program& add_sleep_until(const ::std::chrono::nanoseconds& offset);
+
+	/**
+	 * @brief Append an operation waiting for an edge on a subset of lines.
+	 * @param request Line request to operate on.
+	 * @param mask Lines to watch.
+	 * @param edge Edge to wait for.
+	 * @param timeout Wait time limit. Negative value means no limit.
+	 * @return Reference to self.
+	 *
+	 * Stores the timestamp of the event in the next result slot.
+	 */
+	line_program& add_wait_edge(const line_request& request, ::std::uint64_t mask,
+				    line::edge edge, const ::std::chrono::nanoseconds& timeout);
+
+	/**
+	 * @brief Open a loop repeating the subsequent operations.
+	 * @param count Number of iterations.
+	 * @return Reference to self.
+	 */
+	line_program& begin_loop(unsigned int count);
+
+	/**
+	 * @brief Close the innermost open loop.
+	 * @return Reference to self.
+	 */
+	line_program& end_loop();
+
+	/**
+	 * @brief Get the number of results a single run produces.
+	 * @return Number of result slots.
+	 */
+	::std::size_t num_results() const;
+
+	/**
+	 * @brief Run the program.
+	 * @return Results in the order in which they were produced.
+	 */
+	::std::vector<::std::uint64_t> run();
+
+	/**
+	 * @brief Run the program storing the results in an existing buffer.
+	 * @param results Buffer for the results. Must be at least as large as
+	 *                the number of results a run produces.
+	 * @return Number of results stored.
+	 */
+	::std::size_t run(::std::vector<::std::uint64_t>& results);
+
+private:
+
+	struct impl;
+
+	::std::unique_ptr<impl> _m_priv;
+};
+
+/**
+ * @}
+ */
+
+} /* namespace gpiod */
+
+#endif /* __LIBGPIOD_CXX_LINE_PROGRAM_HPP__ */
@@ -25,6 +25,8 @@ class chip;
 class edge_event;
 class edge_event_buffer;
 class line_config;
+class line_program;
+class quadrature_decoder;
 
 /**
  * @ingroup gpiod_cxx
@@ -216,6 +218,8 @@ private:
 
 	::std::unique_ptr<impl> _m_priv;
 
+	friend line_program;
+	friend quadrature_decoder;
 	friend request_builder;
 };
 
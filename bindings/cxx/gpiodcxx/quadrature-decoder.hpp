@@ -0,0 +1,148 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* SPDX-FileCopyrightText: 2026 The libgpiod authors */
+
+/**
+ * @file quadrature-decoder.hpp
+ */
+
+#ifndef __LIBGPIOD_CXX_QUADRATURE_DECODER_HPP__
+#define __LIBGPIOD_CXX_QUADRATURE_DECODER_HPP__
+
+#if !defined(__LIBGPIOD_GPIOD_CXX_INSIDE__)
+#error "Only gpiod.hpp can be included directly."
+#endif
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "line.hpp"
+
+namespace gpiod {
+
+class edge_event_buffer;
+class line_request;
+
+/**
+ * @ingroup gpiod_cxx
+ * @{
+ */
+
+/**
+ * @brief Decoder for the signals of incremental rotary encoders.
+ *
+ * Each encoder is connected to two input lines with edge detection enabled
+ * on both edges. Edge events are decoded in whole batches straight from an
+ * edge_event_buffer, counting four steps per encoder cycle. The position
+ * increases when channel A leads channel B. Edges that can't be explained
+ * by a single step are counted as errors.
+ */
+class quadrature_decoder final
+{
+public:
+
+	/**
+	 * @brief Constructor. Creates a decoder without any encoders.
+	 */
+	quadrature_decoder();
+
+	quadrature_decoder(const quadrature_decoder& other) = delete;
+
+	/**
+	 * @brief Move constructor.
+	 * @param other Object to move.
+	 */
+	quadrature_decoder(quadrature_decoder&& other) noexcept;
+
+	~quadrature_decoder();
+
+	quadrature_decoder& operator=(const quadrature_decoder& other) = delete;
+
+	/**
+	 * @brief Move assignment operator.
+	 * @param other Object to move.
+	 * @return Reference to self.
+	 */
+	quadrature_decoder& operator=(quadrature_decoder&& other) noexcept;
+
+	/**
+	 * @brief Add an encoder.
+	 * @param offset_a Offset of the line connected to channel A.
+	 * @param offset_b Offset of the line connected to channel B.
+	 * @return Index of the new encoder.
+	 */
+	::std::size_t add_encoder(line::offset offset_a, line::offset offset_b);
+
+	/**
+	 * @brief Get the number of encoders.
+	 * @return Number of encoders added to the decoder.
+	 */
+	::std::size_t num_encoders() const;
+
+	/**
+	 * @brief Set the length of the velocity measurement window.
+	 * @param window Minimum time span of the steps over which the velocity
+	 *               is measured. Zero restores the default of 10ms.
+	 * @return Reference to self.
+	 */
+	quadrature_decoder& set_velocity_window(const ::std::chrono::nanoseconds& window);
+
+	/**
+	 * @brief Synchronize the decoder with the current levels of the lines.
+	 * @param request Line request the encoder lines belong to.
+	 * @return Number of encoders whose both lines belong to the request.
+	 */
+	::std::size_t sync(const line_request& request);
+
+	/**
+	 * @brief Decode all edge events stored in a buffer.
+	 * @param buffer Edge event buffer filled by
+	 *               line_request::read_edge_events.
+	 * @return Number of events that belonged to one of the encoders.
+	 */
+	::std::size_t process(const edge_event_buffer& buffer);
+
+	/**
+	 * @brief Get the position of an encoder.
+	 * @param encoder Index of the encoder.
+	 * @return Position in steps.
+	 */
+	::std::int64_t position(::std::size_t encoder) const;
+
+	/**
+	 * @brief Get the velocity of an encoder.
+	 * @param encoder Index of the encoder.
+	 * @return Velocity in steps per second measured over the last window.
+	 */
+	double velocity(::std::size_t encoder) const;
+
+	/**
+	 * @brief Get the number of invalid transitions seen on an encoder.
+	 * @param encoder Index of the encoder.
+	 * @return Number of errors.
+	 */
+	::std::uint64_t num_errors(::std::size_t encoder) const;
+
+	/**
+	 * @brief Reset the state of an encoder.
+	 * @param encoder Index of the encoder.
+	 * @param position New position of the encoder.
+	 * @return Reference to self.
+	 */
+	quadrature_decoder& reset(::std::size_t encoder, ::std::int64_t position = 0);
+
+private:
+
+	struct impl;
+
+	::std::unique_ptr<impl> _m_priv;
+};
+
+/**
+ * @}
+ */
+
+} /* namespace gpiod */
+
+#endif /* __LIBGPIOD_CXX_QUADRATURE_DECODER_HPP__ */
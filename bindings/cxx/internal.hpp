@@ -50,6 +50,8 @@ using line_request_deleter = deleter<::gpiod_line_request, ::gpiod_line_request_
 using edge_event_deleter = deleter<::gpiod_edge_event, ::gpiod_edge_event_free>;
 using edge_event_buffer_deleter = deleter<::gpiod_edge_event_buffer,
 					  ::gpiod_edge_event_buffer_free>;
+using line_program_deleter = deleter<::gpiod_line_program, ::gpiod_line_program_free>;
+using quadrature_deleter = deleter<::gpiod_quadrature, ::gpiod_quadrature_free>;
 
 using chip_ptr = ::std::unique_ptr<::gpiod_chip, chip_deleter>;
 using chip_info_ptr = ::std::unique_ptr<::gpiod_chip_info, chip_info_deleter>;
@@ -62,6 +64,8 @@ using line_request_ptr = ::std::unique_ptr<::gpiod_line_request, line_request_de
 using edge_event_ptr = ::std::unique_ptr<::gpiod_edge_event, edge_event_deleter>;
 using edge_event_buffer_ptr = ::std::unique_ptr<::gpiod_edge_event_buffer,
 						edge_event_buffer_deleter>;
+using line_program_ptr = ::std::unique_ptr<::gpiod_line_program, line_program_deleter>;
+using quadrature_ptr = ::std::unique_ptr<::gpiod_quadrature, quadrature_deleter>;
 
 struct chip::impl
 {
@@ -163,6 +167,12 @@ struct line_request::impl
 
 	line_request_ptr request;
 
+	/*
+	 * Expires together with the request. Allows objects storing raw
+	 * pointers to the request to check if it has been released.
+	 */
+	::std::shared_ptr<bool> alive;
+
 	/*
 	 * Used when reading/setting the line values in order to avoid
 	 * allocating a new buffer on every call. We're not doing it for
@@ -229,6 +239,39 @@ struct edge_event_buffer::impl
 	::std::vector<edge_event> events;
 };
 
+struct line_program::impl
+{
+	impl();
+	impl(const impl& other) = delete;
+	impl(impl&& other) = delete;
+	impl& operator=(const impl& other) = delete;
+	impl& operator=(impl&& other) = delete;
+
+	void add_request(const line_request::impl& request);
+
+	line_program_ptr program;
+
+	/*
+	 * Liveness of the requests used by the program. Checked before every
+	 * run as the C program only stores raw pointers to them.
+	 */
+	::std::vector<::std::weak_ptr<bool>> requests;
+};
+
+struct quadrature_decoder::impl
+{
+	impl();
+	impl(const impl& other) = delete;
+	impl(impl&& other) = delete;
+	impl& operator=(const impl& other) = delete;
+	impl& operator=(impl&& other) = delete;
+
+	void get_state(::std::size_t encoder, ::std::int64_t* position,
+		       double* velocity, ::std::uint64_t* num_errors) const;
+
+	quadrature_ptr quad;
+};
+
 } /* namespace gpiod */
 
 #endif /* __LIBGPIOD_CXX_INTERNAL_HPP__ */
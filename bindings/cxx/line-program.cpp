@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+#include "internal.hpp"
+
+namespace gpiod {
+
+namespace {
+
+const ::std::map<line::edge, ::gpiod_line_edge> edge_mapping = {
+	{ line::edge::NONE,		GPIOD_LINE_EDGE_NONE },
+	{ line::edge::FALLING,		GPIOD_LINE_EDGE_FALLING },
+	{ line::edge::RISING,		GPIOD_LINE_EDGE_RISING },
+	{ line::edge::BOTH,		GPIOD_LINE_EDGE_BOTH },
+};
+
+line_program_ptr make_line_program()
+{
+	line_program_ptr program(::gpiod_line_program_new());
+	if (!program)
+		throw_from_errno("unable to allocate the line program");
+
+	return program;
+}
+
+} /* namespace */
+
+line_program::impl::impl()
+	: program(make_line_program())
+{
+
+}
+
+void line_program::impl::add_request(const line_request::impl& request)
+{
+	auto same = [&request](const ::std::weak_ptr<bool>& alive) {
+		return !alive.owner_before(request.alive) &&
+		       !request.alive.owner_before(alive);
+	};
+
+	if (::std::find_if(this->requests.begin(), this->requests.end(),
+			   same) == this->requests.end())
+		this->requests.push_back(request.alive);
+}
+
+GPIOD_CXX_API line_program::line_program()
+	: _m_priv(new impl)
+{
+
+}
+
+GPIOD_CXX_API line_program::line_program(line_program&& other) noexcept
+	: _m_priv(::std::move(other._m_priv))
+{
+
+}
+
+GPIOD_CXX_API line_program::~line_program()
+{
+
+}
+
+GPIOD_CXX_API line_program& line_program::operator=(line_program&& other) noexcept
+{
+	this->_m_priv = ::std::move(other._m_priv);
+
+	return *this;
+}
+
+GPIOD_CXX_API line_program& line_program::add_set(const line_request& request,
+						  ::std::uint64_t mask, ::std::uint64_t bits)
+{
+	request._m_priv->throw_if_released();
+
+	int ret = ::gpiod_line_program_add_set(this->_m_priv->program.get(),
+					       request._m_priv->request.get(), mask, bits);
+	if (ret)
+		throw_from_errno("unable to add the set operation");
+
+	this->_m_priv->add_request(*request._m_priv);
+
+	return *this;
+}
+
+GPIOD_CXX_API line_program& line_program::add_get(const line_request& request,
+						  ::std::uint64_t mask)
+{
+	request._m_priv->throw_if_released();
+
+	int ret = ::gpiod_line_program_add_get(this->_m_priv->program.get(),
+					       request._m_priv->request.get(), mask);
+	if (ret)
+		throw_from_errno("unable to add the get operation");
+
+	this->_m_priv->add_request(*request._m_priv);
+
+	return *this;
+}
+
+GPIOD_CXX_API line_program&
+line_program::add_sleep_until(const ::std::chrono::nanoseconds& offset)
+{
+	if (offset.count() < 0)
+		throw ::std::invalid_argument("sleep offset must not be negative");
+
+	int ret = ::gpiod_line_program_add_sleep_until(this->_m_priv->program.get(),
+						       offset.count());
+	if (ret)
+		throw_from_errno("unable to add the sleep operation");
+
+	return *this;
+}
+
+GPIOD_CXX_API line_program&
+line_program::add_wait_edge(const line_request& request, ::std::uint64_t mask,
+			    line::edge edge, const ::std::chrono::nanoseconds& timeout)
+{
+	request._m_priv->throw_if_released();
+
+	auto mapped = edge_mapping.find(edge);
+	if (mapped == edge_mapping.end())
+		throw ::std::invalid_argument("invalid edge value");
+
+	int ret = ::gpiod_line_program_add_wait_edge(this->_m_priv->program.get(),
+						     request._m_priv->request.get(),
+						     mask, mapped->second, timeout.count());
+	if (ret)
+		throw_from_errno("unable to add the wait operation");
+
+	this->_m_priv->add_request(*request._m_priv);
+
+	return *this;
+}
+
+GPIOD_CXX_API line_program& line_program::begin_loop(unsigned int count)
+{
+	int ret = ::gpiod_line_program_begin_loop(this->_m_priv->program.get(), count);
+	if (ret)
+		throw_from_errno("unable to open the loop");
+
+	return *this;
+}
+
+GPIOD_CXX_API line_program& line_program::end_loop()
+{
+	int ret = ::gpiod_line_program_end_loop(this->_m_priv->program.get());
+	if (ret)
+		throw_from_errno("unable to close the loop");
+
+	return *this;
+}
+
+GPIOD_CXX_API ::std::size_t line_program::num_results() const
+{
+	return ::gpiod_line_program_get_num_results(this->_m_priv->program.get());
+}
+
+GPIOD_CXX_API ::std::vector<::std::uint64_t> line_program::run()
+{
+	::std::vector<::std::uint64_t> results(this->num_results());
+
+	this->run(results);
+
+	return results;
+}
+
+GPIOD_CXX_API ::std::size_t line_program::run(::std::vector<::std::uint64_t>& results)
+{
+	for (const auto& alive: this->_m_priv->requests) {
+		if (alive.expired())
+			throw request_released("GPIO lines have been released");
+	}
+
+	int ret = ::gpiod_line_program_run(this->_m_priv->program.get(),
+					   results.data(), results.size());
+	if (ret < 0)
+		throw_from_errno("error running the line program");
+
+	return ret;
+}
+
+} /* namespace gpiod */
@@ -18,6 +18,7 @@ void line_request::impl::throw_if_released() const
 void line_request::impl::set_request_ptr(line_request_ptr& ptr)
 {
 	this->request = ::std::move(ptr);
+	this->alive = ::std::make_shared<bool>(true);
 	this->offset_buf.resize(::gpiod_line_request_get_num_requested_lines(this->request.get()));
 }
 
@@ -61,6 +62,7 @@ GPIOD_CXX_API void line_request::release()
 	this->_m_priv->throw_if_released();
 
 	this->_m_priv->request.reset();
+	this->_m_priv->alive.reset();
 }
 
 GPIOD_CXX_API ::std::string line_request::chip_name() const
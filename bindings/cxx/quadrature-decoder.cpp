@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <stdexcept>
+#include <utility>
+
+#include "internal.hpp"
+
+namespace gpiod {
+
+namespace {
+
+quadrature_ptr make_quadrature()
+{
+	quadrature_ptr quad(::gpiod_quadrature_new());
+	if (!quad)
+		throw_from_errno("unable to allocate the quadrature decoder");
+
+	return quad;
+}
+
+} /* namespace */
+
+quadrature_decoder::impl::impl()
+	: quad(make_quadrature())
+{
+
+}
+
+void quadrature_decoder::impl::get_state(::std::size_t encoder, ::std::int64_t* position,
+					 double* velocity, ::std::uint64_t* num_errors) const
+{
+	int ret = ::gpiod_quadrature_get_state(this->quad.get(), encoder,
+					       position, velocity, num_errors);
+	if (ret)
+		throw ::std::out_of_range("encoder index out of range");
+}
+
+GPIOD_CXX_API quadrature_decoder::quadrature_decoder()
+	: _m_priv(new impl)
+{
+
+}
+
+GPIOD_CXX_API quadrature_decoder::quadrature_decoder(quadrature_decoder&& other) noexcept
+	: _m_priv(::std::move(other._m_priv))
+{
+
+}
+
+GPIOD_CXX_API quadrature_decoder::~quadrature_decoder()
+{
+
+}
+
+GPIOD_CXX_API quadrature_decoder&
+quadrature_decoder::operator=(quadrature_decoder&& other) noexcept
+{
+	this->_m_priv = ::std::move(other._m_priv);
+
+	return *this;
+}
+
+GPIOD_CXX_API ::std::size_t quadrature_decoder::add_encoder(line::offset offset_a,
+							    line::offset offset_b)
+{
+	int ret = ::gpiod_quadrature_add_encoder(this->_m_priv->quad.get(),
+						 offset_a, offset_b);
+	if (ret < 0)
+		throw_from_errno("unable to add the encoder");
+
+	return ret;
+}
+
+GPIOD_CXX_API ::std::size_t quadrature_decoder::num_encoders() const
+{
+	return ::gpiod_quadrature_get_num_encoders(this->_m_priv->quad.get());
+}
+
+GPIOD_CXX_API quadrature_decoder&
+quadrature_decoder::set_velocity_window(const ::std::chrono::nanoseconds& window)
+{
+	if (window.count() < 0)
+		throw ::std::invalid_argument("velocity window must not be negative");
+
+	::gpiod_quadrature_set_velocity_window(this->_m_priv->quad.get(), window.count());
+
+	return *this;
+}
+
+GPIOD_CXX_API ::std::size_t quadrature_decoder::sync(const line_request& request)
+{
+	request._m_priv->throw_if_released();
+
+	int ret = ::gpiod_quadrature_sync(this->_m_priv->quad.get(),
+					  request._m_priv->request.get());
+	if (ret < 0)
+		throw_from_errno("unable to read the encoder line values");
+
+	return ret;
+}
+
+GPIOD_CXX_API ::std::size_t quadrature_decoder::process(const edge_event_buffer& buffer)
+{
+	return ::gpiod_quadrature_process(this->_m_priv->quad.get(),
+					  buffer._m_priv->buffer.get());
+}
+
+GPIOD_CXX_API ::std::int64_t quadrature_decoder::position(::std::size_t encoder) const
+{
+	::std::int64_t position;
+
+	this->_m_priv->get_state(encoder, &position, nullptr, nullptr);
+
+	return position;
+}
+
+GPIOD_CXX_API double quadrature_decoder::velocity(::std::size_t encoder) const
+{
+	double velocity;
+
+	this->_m_priv->get_state(encoder, nullptr, &velocity, nullptr);
+
+	return velocity;
+}
+
+GPIOD_CXX_API ::std::uint64_t quadrature_decoder::num_errors(::std::size_t encoder) const
+{
+	::std::uint64_t num_errors;
+
+	this->_m_priv->get_state(encoder, nullptr, nullptr, &num_errors);
+
+	return num_errors;
+}
+
+GPIOD_CXX_API quadrature_decoder&
+quadrature_decoder::reset(::std::size_t encoder, ::std::int64_t position)
+{
+	int ret = ::gpiod_quadrature_reset(this->_m_priv->quad.get(), encoder, position);
+	if (ret)
+		throw ::std::out_of_range("encoder index out of range");
+
+	return *this;
+}
+
+} /* namespace gpiod */
@@ -0,0 +1,205 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <gpiod.hpp>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "gpiosim.hpp"
+#include "helpers.hpp"
+
+using ::gpiosim::make_sim;
+using direction = ::gpiod::line::direction;
+using edge = ::gpiod::line::edge;
+using simval = ::gpiosim::chip::value;
+using pull = ::gpiosim::chip::pull;
+
+namespace {
+
+TEST_CASE("line program sets and reads line values", "[line-program]")
+{
+	auto sim = make_sim()
+		.set_num_lines(8)
+		.build();
+
+	::gpiod::chip chip(sim.dev_path());
+
+	auto outputs = chip
+		.prepare_request()
+		.add_line_settings(
+			{ 0, 1, 2 },
+			::gpiod::line_settings()
+				.set_direction(direction::OUTPUT)
+		)
+		.do_request();
+
+	auto inputs = chip
+		.prepare_request()
+		.add_line_settings(
+			{ 4, 5 },
+			::gpiod::line_settings()
+				.set_direction(direction::INPUT)
+		)
+		.do_request();
+
+	sim.set_pull(5, pull::PULL_UP);
+
+	::gpiod::line_program program;
+
+	program
+		.add_set(outputs, 0x7, 0x5)
+		.add_get(inputs, 0x3);
+
+	REQUIRE(program.num_results() == 1);
+
+	auto results = program.run();
+	REQUIRE(results.size() == 1);
+	REQUIRE(results[0] == 0x2);
+
+	REQUIRE(sim.get_value(0) == simval::ACTIVE);
+	REQUIRE(sim.get_value(1) == simval::INACTIVE);
+	REQUIRE(sim.get_value(2) == simval::ACTIVE);
+}
+
+TEST_CASE("line program loops produce results in order", "[line-program]")
+{
+	auto sim = make_sim()
+		.set_num_lines(4)
+		.build();
+
+	::gpiod::chip chip(sim.dev_path());
+
+	auto request = chip
+		.prepare_request()
+		.add_line_settings(
+			{ 0, 1 },
+			::gpiod::line_settings()
+				.set_direction(direction::OUTPUT)
+		)
+		.do_request();
+
+	::gpiod::line_program program;
+
+	program
+		.begin_loop(3)
+			.add_set(request, 0x3, 0x1)
+			.add_get(request, 0x3)
+			.add_set(request, 0x3, 0x2)
+			.add_get(request, 0x3)
+		.end_loop();
+
+	REQUIRE(program.num_results() == 6);
+
+	::std::vector<::std::uint64_t> results(program.num_results());
+	REQUIRE(program.run(results) == 6);
+	REQUIRE(results == ::std::vector<::std::uint64_t>({ 1, 2, 1, 2, 1, 2 }));
+}
+
+TEST_CASE("line program waits for edges", "[line-program]")
+{
+	auto sim = make_sim()
+		.set_num_lines(4)
+		.build();
+
+	::gpiod::chip chip(sim.dev_path());
+
+	auto request = chip
+		.prepare_request()
+		.add_line_settings(
+			2,
+			::gpiod::line_settings()
+				.set_edge_detection(edge::RISING)
+		)
+		.do_request();
+
+	::gpiod::line_program program;
+
+	program.add_wait_edge(request, 0x1, edge::RISING, ::std::chrono::seconds(1));
+
+	::std::thread thread([&sim]() {
+		::std::this_thread::sleep_for(::std::chrono::milliseconds(30));
+		sim.set_pull(2, pull::PULL_UP);
+	});
+
+	auto results = program.run();
+	thread.join();
+
+	REQUIRE(results.size() == 1);
+	REQUIRE(results[0] > 0);
+
+	::gpiod::line_program timeout;
+
+	timeout.add_wait_edge(request, 0x1, edge::RISING, ::std::chrono::milliseconds(10));
+
+	REQUIRE_THROWS_AS(timeout.run(), ::std::system_error);
+}
+
+TEST_CASE("line program rejects invalid arguments", "[line-program]")
+{
+	auto sim = make_sim()
+		.set_num_lines(4)
+		.build();
+
+	::gpiod::chip chip(sim.dev_path());
+
+	auto request = chip
+		.prepare_request()
+		.add_line_settings(
+			{ 0, 1 },
+			::gpiod::line_settings()
+				.set_direction(direction::OUTPUT)
+		)
+		.do_request();
+
+	::gpiod::line_program program;
+
+	SECTION("mask out of range")
+	{
+		REQUIRE_THROWS_AS(program.add_set(request, 0x4, 0x4), ::std::invalid_argument);
+		REQUIRE_THROWS_AS(program.add_get(request, 0), ::std::invalid_argument);
+	}
+
+	SECTION("no edge to wait for")
+	{
+		REQUIRE_THROWS_AS(program.add_wait_edge(request, 0x1, edge::NONE,
+							::std::chrono::seconds(1)),
+				  ::std::invalid_argument);
+	}
+
+	SECTION("unbalanced loops")
+	{
+		REQUIRE_THROWS_AS(program.end_loop(), ::std::invalid_argument);
+
+		program.begin_loop(2);
+		REQUIRE_THROWS_AS(program.run(), ::std::invalid_argument);
+	}
+
+	SECTION("results buffer too small")
+	{
+		program.add_get(request, 0x3);
+
+		::std::vector<::std::uint64_t> results;
+		REQUIRE_THROWS_AS(program.run(results), ::std::invalid_argument);
+	}
+
+	SECTION("released request")
+	{
+		request.release();
+
+		REQUIRE_THROWS_AS(program.add_get(request, 0x3), ::gpiod::request_released);
+	}
+
+	SECTION("request released after adding operations")
+	{
+		program.add_get(request, 0x3);
+		request.release();
+
+		REQUIRE_THROWS_AS(program.run(), ::gpiod::request_released);
+	}
+}
+
+} /* namespace */
@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <gpiod.hpp>
+#include <stdexcept>
+#include <system_error>
+
+#include "gpiosim.hpp"
+#include "helpers.hpp"
+
+using ::gpiosim::make_sim;
+using direction = ::gpiod::line::direction;
+using edge = ::gpiod::line::edge;
+using pull = ::gpiosim::chip::pull;
+
+namespace {
+
+::gpiod::line_request request_encoder(::gpiod::chip& chip)
+{
+	return chip
+		.prepare_request()
+		.add_line_settings(
+			{ 0, 1 },
+			::gpiod::line_settings()
+				.set_direction(direction::INPUT)
+				.set_edge_detection(edge::BOTH)
+		)
+		.do_request();
+}
+
+/* One full cycle with channel A leading channel B. */
+void turn_forward(::gpiosim::chip& sim)
+{
+	sim.set_pull(0, pull::PULL_UP);
+	sim.set_pull(1, pull::PULL_UP);
+	sim.set_pull(0, pull::PULL_DOWN);
+	sim.set_pull(1, pull::PULL_DOWN);
+}
+
+void turn_backward(::gpiosim::chip& sim)
+{
+	sim.set_pull(1, pull::PULL_UP);
+	sim.set_pull(0, pull::PULL_UP);
+	sim.set_pull(1, pull::PULL_DOWN);
+	sim.set_pull(0, pull::PULL_DOWN);
+}
+
+TEST_CASE("quadrature decoder counts steps in both directions", "[quadrature-decoder]")
+{
+	auto sim = make_sim()
+		.set_num_lines(4)
+		.build();
+
+	::gpiod::chip chip(sim.dev_path());
+	auto request = request_encoder(chip);
+	::gpiod::edge_event_buffer buffer(64);
+	::gpiod::quadrature_decoder decoder;
+
+	REQUIRE(decoder.add_encoder(0, 1) == 0);
+	REQUIRE(decoder.num_encoders() == 1);
+	REQUIRE(decoder.sync(request) == 1);
+
+	turn_forward(sim);
+	turn_forward(sim);
+
+	REQUIRE(request.wait_edge_events(::std::chrono::seconds(1)));
+	REQUIRE(request.read_edge_events(buffer) == 8);
+	REQUIRE(decoder.process(buffer) == 8);
+	REQUIRE(decoder.position(0) == 8);
+	REQUIRE(decoder.num_errors(0) == 0);
+
+	turn_backward(sim);
+
+	REQUIRE(request.wait_edge_events(::std::chrono::seconds(1)));
+	REQUIRE(request.read_edge_events(buffer) == 4);
+	REQUIRE(decoder.process(buffer) == 4);
+	REQUIRE(decoder.position(0) == 4);
+
+	decoder.reset(0, 100);
+	REQUIRE(decoder.position(0) == 100);
+	REQUIRE(decoder.velocity(0) == 0.0);
+}
+
+TEST_CASE("quadrature decoder ignores unrelated lines", "[quadrature-decoder]")
+{
+	auto sim = make_sim()
+		.set_num_lines(4)
+		.build();
+
+	::gpiod::chip chip(sim.dev_path());
+	auto request = chip
+		.prepare_request()
+		.add_line_settings(
+			{ 0, 1, 2 },
+			::gpiod::line_settings()
+				.set_direction(direction::INPUT)
+				.set_edge_detection(edge::BOTH)
+		)
+		.do_request();
+	::gpiod::edge_event_buffer buffer(64);
+	::gpiod::quadrature_decoder decoder;
+
+	decoder.add_encoder(0, 1);
+	decoder.sync(request);
+
+	sim.set_pull(2, pull::PULL_UP);
+	sim.set_pull(0, pull::PULL_UP);
+
+	REQUIRE(request.wait_edge_events(::std::chrono::seconds(1)));
+	REQUIRE(request.read_edge_events(buffer) == 2);
+	REQUIRE(decoder.process(buffer) == 1);
+	REQUIRE(decoder.position(0) == 1);
+}
+
+TEST_CASE("quadrature decoder rejects invalid arguments", "[quadrature-decoder]")
+{
+	::gpiod::quadrature_decoder decoder;
+
+	decoder.add_encoder(0, 1);
+
+	REQUIRE_THROWS_AS(decoder.add_encoder(2, 2), ::std::invalid_argument);
+	REQUIRE_THROWS_AS(decoder.add_encoder(1, 2), ::std::invalid_argument);
+	REQUIRE_THROWS_AS(decoder.position(1), ::std::out_of_range);
+	REQUIRE_THROWS_AS(decoder.reset(3), ::std::out_of_range);
+	REQUIRE_THROWS_AS(decoder.set_velocity_window(::std::chrono::nanoseconds(-1)),
+			  ::std::invalid_argument);
+}
+
+} /* namespace */
@@ -14,8 +14,10 @@ from .chip_info import ChipInfo
 from .edge_event import EdgeEvent
 from .exception import ChipClosedError, RequestReleasedError
 from .info_event import InfoEvent
+from .line_program import LineProgram
 from .line_request import LineRequest
 from .line_settings import LineSettings
+from .quadrature_decoder import QuadratureDecoder
 from .version import __version__
 
 api_version = _ext.api_version
@@ -93,28 +93,31 @@ static PyObject *chip_get_info(chip_object *self, PyObject *Py_UNUSED(ignored))
 
 static PyObject *make_line_info(struct gpiod_line_info *info)
 {
+	struct gpiod_line_info_data data;
 	PyObject *type;
+	int ret;
 
 	type = Py_gpiod_GetGlobalType("LineInfo");
 	if (!type)
 		return NULL;
 
+	ret = gpiod_line_info_export(info, &data, sizeof(data));
+	if (ret)
+		return Py_gpiod_SetErrFromErrno();
+
 	return PyObject_CallFunction(type, "IsOsiOiiiiOk",
-				gpiod_line_info_get_offset(info),
-				gpiod_line_info_get_name(info),
-				gpiod_line_info_is_used(info) ?
-							Py_True : Py_False,
-				gpiod_line_info_get_consumer(info),
-				gpiod_line_info_get_direction(info),
-				gpiod_line_info_is_active_low(info) ?
-							Py_True : Py_False,
-				gpiod_line_info_get_bias(info),
-				gpiod_line_info_get_drive(info),
-				gpiod_line_info_get_edge_detection(info),
-				gpiod_line_info_get_event_clock(info),
-				gpiod_line_info_is_debounced(info) ?
-							Py_True : Py_False,
-				gpiod_line_info_get_debounce_period_us(info));
+				data.offset,
+				data.name[0] ? data.name : NULL,
+				data.used ? Py_True : Py_False,
+				data.consumer[0] ? data.consumer : NULL,
+				data.direction,
+				data.active_low ? Py_True : Py_False,
+				data.bias,
+				data.drive,
+				data.edge_detection,
+				data.event_clock,
+				data.debounced ? Py_True : Py_False,
+				data.debounce_period_us);
 }
 
 static PyObject *chip_get_line_info(chip_object *self, PyObject *args)
@@ -0,0 +1,304 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include "internal.h"
+
+typedef struct {
+	PyObject_HEAD;
+	struct gpiod_line_program *program;
+	/* Keeps the requests referenced by the program alive. */
+	PyObject *requests;
+	uint64_t *results;
+	size_t max_results;
+} line_program_object;
+
+static int line_program_init(line_program_object *self,
+			     PyObject *Py_UNUSED(args),
+			     PyObject *Py_UNUSED(ignored))
+{
+	self->requests = PySet_New(NULL);
+	if (!self->requests)
+		return -1;
+
+	self->program = gpiod_line_program_new();
+	if (!self->program) {
+		Py_gpiod_SetErrFromErrno();
+		return -1;
+	}
+
+	return 0;
+}
+
+static void line_program_finalize(line_program_object *self)
+{
+	if (self->program)
+		gpiod_line_program_free(self->program);
+
+	if (self->results)
+		PyMem_Free(self->results);
+
+	Py_XDECREF(self->requests);
+}
+
+static struct gpiod_line_request *
+line_program_get_request(line_program_object *self, PyObject *req_obj)
+{
+	struct gpiod_line_request *request;
+	int ret;
+
+	request = Py_gpiod_RequestGetData(req_obj);
+	if (!request)
+		return NULL;
+
+	ret = PySet_Add(self->requests, req_obj);
+	if (ret)
+		return NULL;
+
+	return request;
+}
+
+static PyObject *line_program_add_set(line_program_object *self, PyObject *args)
+{
+	struct gpiod_line_request *request;
+	unsigned long long mask, bits;
+	PyObject *req_obj;
+	int ret;
+
+	ret = PyArg_ParseTuple(args, "OKK", &req_obj, &mask, &bits);
+	if (!ret)
+		return NULL;
+
+	request = line_program_get_request(self, req_obj);
+	if (!request)
+		return NULL;
+
+	ret = gpiod_line_program_add_set(self->program, request, mask, bits);
+	if (ret)
+		return Py_gpiod_SetErrFromErrno();
+
+	Py_RETURN_NONE;
+}
+
+static PyObject *line_program_add_get(line_program_object *self, PyObject *args)
+{
+	struct gpiod_line_request *request;
+	unsigned long long mask;
+	PyObject *req_obj;
+	int ret;
+
+	ret = PyArg_ParseTuple(args, "OK", &req_obj, &mask);
+	if (!ret)
+		return NULL;
+
+	request = line_program_get_request(self, req_obj);
+	if (!request)
+		return NULL;
+
+	ret = gpiod_line_program_add_get(self->program, request, mask);
+	if (ret)
+		return Py_gpiod_SetErrFromErrno();
+
+	Py_RETURN_NONE;
+}
+
+static PyObject *
+line_program_add_sleep_until(line_program_object *self, PyObject *args)
+{
+	unsigned long long offset;
+	int ret;
+
+	ret = PyArg_ParseTuple(args, "K", &offset);
+	if (!ret)
+		return NULL;
+
+	ret = gpiod_line_program_add_sleep_until(self->program, offset);
+	if (ret)
+		return Py_gpiod_SetErrFromErrno();
+
+	Py_RETURN_NONE;
+}
+
+static PyObject *
+line_program_add_wait_edge(line_program_object *self, PyObject *args)
+{
+	struct gpiod_line_request *request;
+	unsigned long long mask;
+	long long timeout;
+	PyObject *req_obj;
+	int ret, edge;
+
+	ret = PyArg_ParseTuple(args, "OKiL", &req_obj, &mask, &edge, &timeout);
+	if (!ret)
+		return NULL;
+
+	request = line_program_get_request(self, req_obj);
+	if (!request)
+		return NULL;
+
+	ret = gpiod_line_program_add_wait_edge(self->program, request, mask,
+					       edge, timeout);
+	if (ret)
+		return Py_gpiod_SetErrFromErrno();
+
+	Py_RETURN_NONE;
+}
+
+static PyObject *
+line_program_begin_loop(line_program_object *self, PyObject *args)
+{
+	unsigned int count;
+	int ret;
+
+	ret = PyArg_ParseTuple(args, "I", &count);
+	if (!ret)
+		return NULL;
+
+	ret = gpiod_line_program_begin_loop(self->program, count);
+	if (ret)
+		return Py_gpiod_SetErrFromErrno();
+
+	Py_RETURN_NONE;
+}
+
+static PyObject *
+line_program_end_loop(line_program_object *self, PyObject *Py_UNUSED(ignored))
+{
+	int ret;
+
+	ret = gpiod_line_program_end_loop(self->program);
+	if (ret)
+		return Py_gpiod_SetErrFromErrno();
+
+	Py_RETURN_NONE;
+}
+
+static PyObject *line_program_run(line_program_object *self,
+				  PyObject *Py_UNUSED(ignored))
+{
+	PyObject *results, *val, *iter, *next;
+	struct gpiod_line_request *request;
+	size_t num_results, i;
+	uint64_t *buf;
+	int ret;
+
+	/* Don't let the program touch requests released since it was built. */
+	iter = PyObject_GetIter(self->requests);
+	if (!iter)
+		return NULL;
+
+	while ((next = PyIter_Next(iter))) {
+		request = Py_gpiod_RequestGetData(next);
+		Py_DECREF(next);
+		if (!request) {
+			Py_DECREF(iter);
+			return NULL;
+		}
+	}
+
+	Py_DECREF(iter);
+	if (PyErr_Occurred())
+		return NULL;
+
+	num_results = gpiod_line_program_get_num_results(self->program);
+
+	/* Reuse the buffer across runs, it only needs to grow. */
+	if (num_results > self->max_results) {
+		buf = PyMem_Realloc(self->results,
+				    num_results * sizeof(*self->results));
+		if (!buf)
+			return PyErr_NoMemory();
+
+		self->results = buf;
+		self->max_results = num_results;
+	}
+
+	Py_BEGIN_ALLOW_THREADS;
+	ret = gpiod_line_program_run(self->program, self->results,
+				     self->max_results);
+	Py_END_ALLOW_THREADS;
+	if (ret < 0)
+		return Py_gpiod_SetErrFromErrno();
+
+	results = PyList_New(ret);
+	if (!results)
+		return NULL;
+
+	for (i = 0; i < (size_t)ret; i++) {
+		val = PyLong_FromUnsignedLongLong(self->results[i]);
+		if (!val) {
+			Py_DECREF(results);
+			return NULL;
+		}
+
+		PyList_SET_ITEM(results, i, val);
+	}
+
+	return results;
+}
+
+static PyObject *
+line_program_num_results(line_program_object *self, void *Py_UNUSED(ignored))
+{
+	return PyLong_FromSize_t(
+			gpiod_line_program_get_num_results(self->program));
+}
+
+static PyGetSetDef line_program_getset[] = {
+	{
+		.name = "num_results",
+		.get = (getter)line_program_num_results,
+	},
+	{ }
+};
+
+static PyMethodDef line_program_methods[] = {
+	{
+		.ml_name = "add_set",
+		.ml_meth = (PyCFunction)line_program_add_set,
+		.ml_flags = METH_VARARGS,
+	},
+	{
+		.ml_name = "add_get",
+		.ml_meth = (PyCFunction)line_program_add_get,
+		.ml_flags = METH_VARARGS,
+	},
+	{
+		.ml_name = "add_sleep_until",
+		.ml_meth = (PyCFunction)line_program_add_sleep_until,
+		.ml_flags = METH_VARARGS,
+	},
+	{
+		.ml_name = "add_wait_edge",
+		.ml_meth = (PyCFunction)line_program_add_wait_edge,
+		.ml_flags = METH_VARARGS,
+	},
+	{
+		.ml_name = "begin_loop",
+		.ml_meth = (PyCFunction)line_program_begin_loop,
+		.ml_flags = METH_VARARGS,
+	},
+	{
+		.ml_name = "end_loop",
+		.ml_meth = (PyCFunction)line_program_end_loop,
+		.ml_flags = METH_NOARGS,
+	},
+	{
+		.ml_name = "run",
+		.ml_meth = (PyCFunction)line_program_run,
+		.ml_flags = METH_NOARGS,
+	},
+	{ }
+};
+
+PyTypeObject line_program_type = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	.tp_name = "gpiod._ext.LineProgram",
+	.tp_basicsize = sizeof(line_program_object),
+	.tp_flags = Py_TPFLAGS_DEFAULT,
+	.tp_new = PyType_GenericNew,
+	.tp_init = (initproc)line_program_init,
+	.tp_finalize = (destructor)line_program_finalize,
+	.tp_dealloc = (destructor)Py_gpiod_dealloc,
+	.tp_getset = line_program_getset,
+	.tp_methods = line_program_methods,
+};
@@ -143,13 +143,17 @@ static PyModuleDef module_def = {
 
 extern PyTypeObject chip_type;
 extern PyTypeObject line_config_type;
+extern PyTypeObject line_program_type;
 extern PyTypeObject line_settings_type;
+extern PyTypeObject quadrature_type;
 extern PyTypeObject request_type;
 
 static PyTypeObject *types[] = {
 	&chip_type,
 	&line_config_type,
+	&line_program_type,
 	&line_settings_type,
+	&quadrature_type,
 	&request_type,
 	NULL,
 };
@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include "internal.h"
+
+typedef struct {
+	PyObject_HEAD;
+	struct gpiod_quadrature *quad;
+	struct gpiod_edge_event_buffer *buffer;
+} quadrature_object;
+
+static int quadrature_init(quadrature_object *self, PyObject *args,
+			   PyObject *Py_UNUSED(ignored))
+{
+	unsigned int event_buffer_size;
+	int ret;
+
+	ret = PyArg_ParseTuple(args, "I", &event_buffer_size);
+	if (!ret)
+		return -1;
+
+	self->quad = gpiod_quadrature_new();
+	if (!self->quad) {
+		Py_gpiod_SetErrFromErrno();
+		return -1;
+	}
+
+	self->buffer = gpiod_edge_event_buffer_new(event_buffer_size);
+	if (!self->buffer) {
+		Py_gpiod_SetErrFromErrno();
+		return -1;
+	}
+
+	return 0;
+}
+
+static void quadrature_finalize(quadrature_object *self)
+{
+	if (self->buffer)
+		gpiod_edge_event_buffer_free(self->buffer);
+
+	if (self->quad)
+		gpiod_quadrature_free(self->quad);
+}
+
+static PyObject *quadrature_add_encoder(quadrature_object *self, PyObject *args)
+{
+	unsigned int offset_a, offset_b;
+	int ret;
+
+	ret = PyArg_ParseTuple(args, "II", &offset_a, &offset_b);
+	if (!ret)
+		return NULL;
+
+	ret = gpiod_quadrature_add_encoder(self->quad, offset_a, offset_b);
+	if (ret < 0)
+		return Py_gpiod_SetErrFromErrno();
+
+	return PyLong_FromLong(ret);
+}
+
+static PyObject *
+quadrature_set_velocity_window(quadrature_object *self, PyObject *args)
+{
+	unsigned long long window;
+	int ret;
+
+	ret = PyArg_ParseTuple(args, "K", &window);
+	if (!ret)
+		return NULL;
+
+	gpiod_quadrature_set_velocity_window(self->quad, window);
+
+	Py_RETURN_NONE;
+}
+
+static PyObject *quadrature_sync(quadrature_object *self, PyObject *args)
+{
+	struct gpiod_line_request *request;
+	PyObject *req_obj;
+	int ret;
+
+	ret = PyArg_ParseTuple(args, "O", &req_obj);
+	if (!ret)
+		return NULL;
+
+	request = Py_gpiod_RequestGetData(req_obj);
+	if (!request)
+		return NULL;
+
+	ret = gpiod_quadrature_sync(self->quad, request);
+	if (ret < 0)
+		return Py_gpiod_SetErrFromErrno();
+
+	return PyLong_FromLong(ret);
+}
+
+static PyObject *
+quadrature_read_edge_events(quadrature_object *self, PyObject *args)
+{
+	struct gpiod_line_request *request;
+	PyObject *req_obj, *max_events_obj;
+	size_t max_events, num_decoded = 0;
+	int ret;
+
+	ret = PyArg_ParseTuple(args, "OO", &req_obj, &max_events_obj);
+	if (!ret)
+		return NULL;
+
+	request = Py_gpiod_RequestGetData(req_obj);
+	if (!request)
+		return NULL;
+
+	if (max_events_obj != Py_None) {
+		max_events = PyLong_AsSize_t(max_events_obj);
+		if (PyErr_Occurred())
+			return NULL;
+	} else {
+		max_events = gpiod_edge_event_buffer_get_capacity(self->buffer);
+	}
+
+	/* Read and decode the whole batch without going back to Python. */
+	Py_BEGIN_ALLOW_THREADS;
+	ret = gpiod_line_request_read_edge_events(request, self->buffer,
+						  max_events);
+	if (ret >= 0)
+		num_decoded = gpiod_quadrature_process(self->quad,
+						       self->buffer);
+	Py_END_ALLOW_THREADS;
+	if (ret < 0)
+		return Py_gpiod_SetErrFromErrno();
+
+	return PyLong_FromSize_t(num_decoded);
+}
+
+static PyObject *quadrature_get_state(quadrature_object *self, PyObject *args)
+{
+	unsigned long long num_errors;
+	unsigned int encoder;
+	long long position;
+	int64_t pos;
+	uint64_t errs;
+	double velocity;
+	int ret;
+
+	ret = PyArg_ParseTuple(args, "I", &encoder);
+	if (!ret)
+		return NULL;
+
+	ret = gpiod_quadrature_get_state(self->quad, encoder, &pos, &velocity,
+					 &errs);
+	if (ret) {
+		PyErr_SetString(PyExc_IndexError, "encoder index out of range");
+		return NULL;
+	}
+
+	position = pos;
+	num_errors = errs;
+
+	return Py_BuildValue("(LdK)", position, velocity, num_errors);
+}
+
+static PyObject *quadrature_reset(quadrature_object *self, PyObject *args)
+{
+	unsigned int encoder;
+	long long position;
+	int ret;
+
+	ret = PyArg_ParseTuple(args, "IL", &encoder, &position);
+	if (!ret)
+		return NULL;
+
+	ret = gpiod_quadrature_reset(self->quad, encoder, position);
+	if (ret) {
+		PyErr_SetString(PyExc_IndexError, "encoder index out of range");
+		return NULL;
+	}
+
+	Py_RETURN_NONE;
+}
+
+static PyObject *
+quadrature_num_encoders(quadrature_object *self, void *Py_UNUSED(ignored))
+{
+	return PyLong_FromSize_t(gpiod_quadrature_get_num_encoders(self->quad));
+}
+
+static PyGetSetDef quadrature_getset[] = {
+	{
+		.name = "num_encoders",
+		.get = (getter)quadrature_num_encoders,
+	},
+	{ }
+};
+
+static PyMethodDef quadrature_methods[] = {
+	{
+		.ml_name = "add_encoder",
+		.ml_meth = (PyCFunction)quadrature_add_encoder,
+		.ml_flags = METH_VARARGS,
+	},
+	{
+		.ml_name = "set_velocity_window",
+		.ml_meth = (PyCFunction)quadrature_set_velocity_window,
+		.ml_flags = METH_VARARGS,
+	},
+	{
+		.ml_name = "sync",
+		.ml_meth = (PyCFunction)quadrature_sync,
+		.ml_flags = METH_VARARGS,
+	},
+	{
+		.ml_name = "read_edge_events",
+		.ml_meth = (PyCFunction)quadrature_read_edge_events,
+		.ml_flags = METH_VARARGS,
+	},
+	{
+		.ml_name = "get_state",
+		.ml_meth = (PyCFunction)quadrature_get_state,
+		.ml_flags = METH_VARARGS,
+	},
+	{
+		.ml_name = "reset",
+		.ml_meth = (PyCFunction)quadrature_reset,
+		.ml_flags = METH_VARARGS,
+	},
+	{ }
+};
+
+PyTypeObject quadrature_type = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	.tp_name = "gpiod._ext.Quadrature",
+	.tp_basicsize = sizeof(quadrature_object),
+	.tp_flags = Py_TPFLAGS_DEFAULT,
+	.tp_new = PyType_GenericNew,
+	.tp_init = (initproc)quadrature_init,
+	.tp_finalize = (destructor)quadrature_finalize,
+	.tp_dealloc = (destructor)Py_gpiod_dealloc,
+	.tp_getset = quadrature_getset,
+	.tp_methods = quadrature_methods,
+};
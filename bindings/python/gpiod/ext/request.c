@@ -263,8 +263,8 @@ static PyObject *request_reconfigure_lines(request_object *self, PyObject *args)
 static PyObject *request_read_edge_events(request_object *self, PyObject *args)
 {
 	PyObject *max_events_obj, *event_obj, *events, *type;
+	struct gpiod_edge_event_data *data;
 	size_t max_events, num_events, i;
-	struct gpiod_edge_event *event;
 	int ret;
 
 	ret = PyArg_ParseTuple(args, "O", &max_events_obj);
@@ -292,36 +292,46 @@ static PyObject *request_read_edge_events(request_object *self, PyObject *args)
 
 	num_events = ret;
 
+	data = PyMem_Calloc(num_events ?: 1, sizeof(*data));
+	if (!data)
+		return PyErr_NoMemory();
+
+	ret = gpiod_edge_event_buffer_export(self->buffer, data, sizeof(*data),
+					     num_events);
+	if (ret < 0) {
+		PyMem_Free(data);
+		return Py_gpiod_SetErrFromErrno();
+	}
+
 	events = PyList_New(num_events);
 	if (!events)
-		return NULL;
+		goto out_free_data;
 
 	for (i = 0; i < num_events; i++) {
-		event = gpiod_edge_event_buffer_get_event(self->buffer, i);
-		if (!event) {
-			Py_DECREF(events);
-			return NULL;
-		}
-
-		event_obj = PyObject_CallFunction(type, "iKiii",
-				gpiod_edge_event_get_event_type(event),
-				gpiod_edge_event_get_timestamp_ns(event),
-				gpiod_edge_event_get_line_offset(event),
-				gpiod_edge_event_get_global_seqno(event),
-				gpiod_edge_event_get_line_seqno(event));
-		if (!event_obj) {
-			Py_DECREF(events);
-			return NULL;
-		}
+		event_obj = PyObject_CallFunction(type, "iKikk",
+						  data[i].event_type,
+						  data[i].timestamp_ns,
+						  data[i].line_offset,
+						  data[i].global_seqno,
+						  data[i].line_seqno);
+		if (!event_obj)
+			goto out_free_events;
 
 		ret = PyList_SetItem(events, i, event_obj);
 		if (ret) {
 			Py_DECREF(event_obj);
-			Py_DECREF(events);
-			return NULL;
+			goto out_free_events;
 		}
 	}
 
+	PyMem_Free(data);
+	return events;
+
+out_free_events:
+	Py_DECREF(events);
+	events = NULL;
+out_free_data:
+	PyMem_Free(data);
 	return events;
 }
 
@@ -411,3 +421,29 @@ PyObject *Py_gpiod_MakeRequestObject(struct gpiod_line_request *request,
 
 	return (PyObject *)req_obj;
 }
+
+struct gpiod_line_request *Py_gpiod_RequestGetData(PyObject *obj)
+{
+	request_object *req_obj;
+	PyObject *type;
+
+	type = PyObject_Type(obj);
+	if (!type)
+		return NULL;
+
+	if ((PyTypeObject *)type != &request_type) {
+		PyErr_SetString(PyExc_TypeError,
+				"not a gpiod._ext.Request object");
+		Py_DECREF(type);
+		return NULL;
+	}
+	Py_DECREF(type);
+
+	req_obj = (request_object *)obj;
+	if (!req_obj->request) {
+		PyErr_SetString(PyExc_ValueError, "request has been released");
+		return NULL;
+	}
+
+	return req_obj->request;
+}
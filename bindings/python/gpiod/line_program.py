@@ -0,0 +1,171 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+# SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+from . import _ext
+from .line import Edge
+from .line_request import LineRequest
+from datetime import timedelta
+from typing import Optional, Union
+
+__all__ = "LineProgram"
+
+
+def _to_ns(time: Union[timedelta, float]) -> int:
+    if isinstance(time, timedelta):
+        return (
+            time.days * 86400 + time.seconds
+        ) * 1000000000 + time.microseconds * 1000
+
+    return int(time * 1000000000)
+
+
+class LineProgram:
+    """
+    Precompiled sequence of line operations executed in a single call.
+
+    Running a whole transaction in the core library avoids the overhead of
+    going through the bindings for every step. Lines are addressed with bit
+    masks where bit N corresponds to the N-th line of the request.
+    """
+
+    def __init__(self):
+        """
+        Create a new, empty program.
+        """
+        self._program = _ext.LineProgram()
+        self._requests = []
+
+    def _add_request(self, request: LineRequest) -> _ext.Request:
+        request._check_released()
+        if request not in self._requests:
+            self._requests.append(request)
+
+        return request._req
+
+    def add_set(self, request: LineRequest, mask: int, bits: int) -> "LineProgram":
+        """
+        Append an operation setting the values of a subset of lines.
+
+        Args:
+          request:
+            Line request to operate on.
+          mask:
+            Lines to set.
+          bits:
+            Values to set. Bits not in the mask are ignored.
+
+        Returns:
+          Self so that calls can be chained.
+        """
+        self._program.add_set(self._add_request(request), mask, bits)
+        return self
+
+    def add_get(self, request: LineRequest, mask: int) -> "LineProgram":
+        """
+        Append an operation reading the values of a subset of lines. The
+        masked bits are stored in the next result slot.
+
+        Args:
+          request:
+            Line request to operate on.
+          mask:
+            Lines to read.
+
+        Returns:
+          Self so that calls can be chained.
+        """
+        self._program.add_get(self._add_request(request), mask)
+        return self
+
+    def add_sleep_until(self, offset: Union[timedelta, float]) -> "LineProgram":
+        """
+        Append an operation sleeping until a point in time.
+
+        Args:
+          offset:
+            Offset from the start of the innermost loop iteration or from the
+            start of the run outside of any loops, expressed as either a
+            datetime.timedelta object or the number of seconds stored in a
+            float.
+
+        Returns:
+          Self so that calls can be chained.
+        """
+        self._program.add_sleep_until(_to_ns(offset))
+        return self
+
+    def add_wait_edge(
+        self,
+        request: LineRequest,
+        mask: int,
+        edge: Edge,
+        timeout: Optional[Union[timedelta, float]] = None,
+    ) -> "LineProgram":
+        """
+        Append an operation waiting for an edge on a subset of lines. The
+        timestamp of the event is stored in the next result slot.
+
+        Args:
+          request:
+            Line request to operate on.
+          mask:
+            Lines to watch.
+          edge:
+            Edge to wait for.
+          timeout:
+            Wait time limit expressed as either a datetime.timedelta object
+            or the number of seconds stored in a float. If set to None, the
+            operation blocks indefinitely.
+
+        Returns:
+          Self so that calls can be chained.
+        """
+        timeout_ns = -1 if timeout is None else _to_ns(timeout)
+        self._program.add_wait_edge(
+            self._add_request(request), mask, edge.value, timeout_ns
+        )
+        return self
+
+    def begin_loop(self, count: int) -> "LineProgram":
+        """
+        Open a loop repeating the subsequent operations.
+
+        Args:
+          count:
+            Number of iterations.
+
+        Returns:
+          Self so that calls can be chained.
+        """
+        self._program.begin_loop(count)
+        return self
+
+    def end_loop(self) -> "LineProgram":
+        """
+        Close the innermost open loop.
+
+        Returns:
+          Self so that calls can be chained.
+        """
+        self._program.end_loop()
+        return self
+
+    @property
+    def num_results(self) -> int:
+        """
+        Number of results a single run produces.
+        """
+        return self._program.num_results
+
+    def run(self) -> list[int]:
+        """
+        Run the program.
+
+        Returns:
+          Results of the get and wait operations in the order in which they
+          were produced.
+        """
+        for request in self._requests:
+            request._check_released()
+
+        return self._program.run()
@@ -0,0 +1,133 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+# SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+from . import _ext
+from .line_program import _to_ns
+from .line_request import LineRequest
+from datetime import timedelta
+from typing import Optional, Union
+
+__all__ = "QuadratureDecoder"
+
+
+class QuadratureDecoder:
+    """
+    Decoder for the signals of incremental rotary encoders.
+
+    Edge events are read and decoded in whole batches by the core library
+    without creating any Python objects, which keeps up with encoders turning
+    much faster than decoding the events returned by
+    LineRequest.read_edge_events() in Python would. Each encoder uses two
+    lines of the request with edge detection enabled on both edges. Four
+    steps are counted per encoder cycle and the position increases when
+    channel A leads channel B.
+    """
+
+    def __init__(self, request: LineRequest, event_buffer_size: Optional[int] = None):
+        """
+        Create a new decoder without any encoders.
+
+        Args:
+          request:
+            Line request the encoder lines belong to.
+          event_buffer_size:
+            Maximum number of events read and decoded in one go. Defaults to
+            64.
+        """
+        request._check_released()
+
+        self._request = request
+        self._decoder = _ext.Quadrature(event_buffer_size or 64)
+
+    def _line_offset(self, line: Union[int, str]) -> int:
+        if self._request._check_line_name(line):
+            return self._request._name_map[line]
+
+        return line
+
+    def add_encoder(self, line_a: Union[int, str], line_b: Union[int, str]) -> int:
+        """
+        Add an encoder.
+
+        Args:
+          line_a:
+            Offset or name of the line connected to channel A.
+          line_b:
+            Offset or name of the line connected to channel B.
+
+        Returns:
+          Index of the new encoder.
+        """
+        return self._decoder.add_encoder(
+            self._line_offset(line_a), self._line_offset(line_b)
+        )
+
+    @property
+    def num_encoders(self) -> int:
+        """
+        Number of encoders added to the decoder.
+        """
+        return self._decoder.num_encoders
+
+    def set_velocity_window(self, window: Union[timedelta, float]) -> None:
+        """
+        Set the length of the velocity measurement window.
+
+        Args:
+          window:
+            Minimum time span of the steps over which the velocity is
+            measured, expressed as either a datetime.timedelta object or the
+            number of seconds stored in a float. Zero restores the default of
+            10 milliseconds.
+        """
+        self._decoder.set_velocity_window(_to_ns(window))
+
+    def sync(self) -> None:
+        """
+        Synchronize the decoder with the current levels of the lines. Should
+        be called after adding the encoders and before reading any events.
+        """
+        self._request._check_released()
+        self._decoder.sync(self._request._req)
+
+    def read_edge_events(self, max_events: Optional[int] = None) -> int:
+        """
+        Read a batch of edge events from the request and decode it. Blocks if
+        no events are pending.
+
+        Args:
+          max_events:
+            Maximum number of events to read.
+
+        Returns:
+          Number of events that belonged to one of the encoders.
+        """
+        self._request._check_released()
+        return self._decoder.read_edge_events(self._request._req, max_events)
+
+    def position(self, encoder: int) -> int:
+        """
+        Get the position of an encoder in steps.
+        """
+        return self._decoder.get_state(encoder)[0]
+
+    def velocity(self, encoder: int) -> float:
+        """
+        Get the velocity of an encoder in steps per second measured over the
+        last window.
+        """
+        return self._decoder.get_state(encoder)[1]
+
+    def num_errors(self, encoder: int) -> int:
+        """
+        Get the number of transitions of an encoder that couldn't be decoded,
+        for instance because events were lost.
+        """
+        return self._decoder.get_state(encoder)[2]
+
+    def reset(self, encoder: int, position: int = 0) -> None:
+        """
+        Set the position of an encoder, clear its error count and restart the
+        velocity measurement.
+        """
+        self._decoder.reset(encoder, position)
@@ -168,17 +168,36 @@ class build_ext(orig_build_ext):
             # amend gpiod._ext sources and settings accordingly.
             gpiod_ext = self.ext_map["gpiod._ext"]
             gpiod_ext.sources += [
+                "lib/bitbang.c",
                 "lib/chip.c",
                 "lib/chip-info.c",
+                "lib/chip-mirror.c",
+                "lib/chip-monitor.c",
+                "lib/edge-decoder.c",
+                "lib/edge-decoder-uart.c",
+                "lib/edge-decoder-wiegand.c",
+                "lib/edge-limiter.c",
                 "lib/edge-event.c",
                 "lib/info-event.c",
                 "lib/internal.c",
+                "lib/keypad.c",
+                "lib/line-bus.c",
                 "lib/line-config.c",
+                "lib/line-config-table.c",
                 "lib/line-info.c",
+                "lib/line-program.c",
+                "lib/line-pulse.c",
+                "lib/line-pwm.c",
                 "lib/line-request.c",
                 "lib/line-settings.c",
                 "lib/misc.c",
+                "lib/output-journal.c",
+                "lib/quadrature.c",
+                "lib/reflex.c",
                 "lib/request-config.c",
+                "lib/request-group.c",
+                "lib/scheduler.c",
+                "lib/slab.c",
             ]
             gpiod_ext.libraries = []
             gpiod_ext.include_dirs = ["include", "lib", "gpiod/ext"]
@@ -211,8 +230,10 @@ gpiod_ext = Extension(
         "gpiod/ext/chip.c",
         "gpiod/ext/common.c",
         "gpiod/ext/line-config.c",
+        "gpiod/ext/line-program.c",
         "gpiod/ext/line-settings.c",
         "gpiod/ext/module.c",
+        "gpiod/ext/quadrature.c",
         "gpiod/ext/request.c",
     ],
     define_macros=[("_GNU_SOURCE", "1")],
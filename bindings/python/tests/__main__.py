@@ -10,8 +10,10 @@ from .tests_edge_event import *
 from .tests_info_event import *
 from .tests_line import *
 from .tests_line_info import *
+from .tests_line_program import *
 from .tests_line_settings import *
 from .tests_module import *
+from .tests_quadrature_decoder import *
 from .tests_line_request import *
 
 from . import procname
@@ -0,0 +1,144 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+# SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+import gpiod
+import time
+
+from . import gpiosim
+from gpiod import LineProgram, RequestReleasedError
+from gpiod.line import Direction, Edge
+from threading import Thread
+from unittest import TestCase
+
+Pull = gpiosim.Chip.Pull
+SimVal = gpiosim.Chip.Value
+
+
+class LineProgramSetAndGet(TestCase):
+    def setUp(self):
+        self.sim = gpiosim.Chip(num_lines=8)
+        self.chip = gpiod.Chip(self.sim.dev_path)
+        self.outputs = self.chip.request_lines(
+            config={(0, 1, 2): gpiod.LineSettings(direction=Direction.OUTPUT)}
+        )
+        self.inputs = self.chip.request_lines(
+            config={(4, 5): gpiod.LineSettings(direction=Direction.INPUT)}
+        )
+
+    def tearDown(self):
+        if self.inputs:
+            self.inputs.release()
+        self.outputs.release()
+        self.chip.close()
+        del self.chip
+        del self.sim
+
+    def test_set_and_get_on_two_requests(self):
+        self.sim.set_pull(5, Pull.UP)
+
+        program = (
+            LineProgram()
+            .add_set(self.outputs, 0b111, 0b101)
+            .add_get(self.inputs, 0b11)
+        )
+
+        self.assertEqual(program.num_results, 1)
+        self.assertEqual(program.run(), [0b10])
+        self.assertEqual(self.sim.get_value(0), SimVal.ACTIVE)
+        self.assertEqual(self.sim.get_value(1), SimVal.INACTIVE)
+        self.assertEqual(self.sim.get_value(2), SimVal.ACTIVE)
+
+    def test_loop_results_in_order(self):
+        program = (
+            LineProgram()
+            .begin_loop(3)
+            .add_set(self.outputs, 0b11, 0b01)
+            .add_get(self.outputs, 0b11)
+            .add_set(self.outputs, 0b11, 0b10)
+            .add_get(self.outputs, 0b11)
+            .end_loop()
+        )
+
+        self.assertEqual(program.num_results, 6)
+        self.assertEqual(program.run(), [1, 2, 1, 2, 1, 2])
+        # Running again reuses the program.
+        self.assertEqual(program.run(), [1, 2, 1, 2, 1, 2])
+
+    def test_periodic_loop(self):
+        program = (
+            LineProgram()
+            .begin_loop(5)
+            .add_set(self.outputs, 0b1, 0b1)
+            .add_sleep_until(0.005)
+            .add_set(self.outputs, 0b1, 0b0)
+            .add_sleep_until(0.01)
+            .end_loop()
+        )
+
+        start = time.monotonic()
+        program.run()
+        self.assertGreaterEqual(time.monotonic() - start, 0.045)
+
+    def test_invalid_arguments(self):
+        program = LineProgram()
+
+        with self.assertRaises(ValueError):
+            program.add_set(self.outputs, 0b1000, 0)
+
+        with self.assertRaises(ValueError):
+            program.add_get(self.inputs, 0)
+
+        with self.assertRaises(ValueError):
+            program.end_loop()
+
+        program.begin_loop(2)
+        with self.assertRaises(ValueError):
+            program.run()
+
+    def test_released_request(self):
+        program = LineProgram().add_get(self.inputs, 0b11)
+        self.inputs.release()
+
+        with self.assertRaises(RequestReleasedError):
+            program.run()
+
+        with self.assertRaises(RequestReleasedError):
+            program.add_get(self.inputs, 0b1)
+
+
+class LineProgramWaitEdge(TestCase):
+    def setUp(self):
+        self.sim = gpiosim.Chip(num_lines=4)
+        self.thread = None
+
+    def tearDown(self):
+        if self.thread:
+            self.thread.join()
+            del self.thread
+        self.sim = None
+
+    def trigger_rising_edge(self, offset):
+        time.sleep(0.05)
+        self.sim.set_pull(offset, Pull.UP)
+
+    def test_wait_edge(self):
+        with gpiod.request_lines(
+            self.sim.dev_path, {2: gpiod.LineSettings(edge_detection=Edge.RISING)}
+        ) as req:
+            program = LineProgram().add_wait_edge(req, 0b1, Edge.RISING, 1.0)
+
+            self.thread = Thread(target=self.trigger_rising_edge, args=(2,))
+            self.thread.start()
+
+            results = program.run()
+            self.assertEqual(len(results), 1)
+            self.assertGreater(results[0], 0)
+
+    def test_wait_edge_timeout(self):
+        with gpiod.request_lines(
+            self.sim.dev_path, {2: gpiod.LineSettings(edge_detection=Edge.RISING)}
+        ) as req:
+            program = LineProgram().add_wait_edge(req, 0b1, Edge.RISING, 0.01)
+
+            with self.assertRaises(TimeoutError):
+                program.run()
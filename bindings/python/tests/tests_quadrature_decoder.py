@@ -0,0 +1,89 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+# SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+import gpiod
+
+from . import gpiosim
+from gpiod import QuadratureDecoder, RequestReleasedError
+from gpiod.line import Direction, Edge
+from unittest import TestCase
+
+Pull = gpiosim.Chip.Pull
+
+
+class QuadratureDecoderCounting(TestCase):
+    def setUp(self):
+        self.sim = gpiosim.Chip(num_lines=4, line_names={0: "enc-a", 1: "enc-b"})
+        self.chip = gpiod.Chip(self.sim.dev_path)
+        self.request = self.chip.request_lines(
+            config={
+                (0, 1, 2): gpiod.LineSettings(
+                    direction=Direction.INPUT, edge_detection=Edge.BOTH
+                )
+            }
+        )
+        self.decoder = QuadratureDecoder(self.request)
+        self.assertEqual(self.decoder.add_encoder("enc-a", "enc-b"), 0)
+        self.decoder.sync()
+
+    def tearDown(self):
+        if self.request:
+            self.request.release()
+        self.chip.close()
+        del self.decoder
+        del self.chip
+        del self.sim
+
+    def turn(self, first, second):
+        self.sim.set_pull(first, Pull.UP)
+        self.sim.set_pull(second, Pull.UP)
+        self.sim.set_pull(first, Pull.DOWN)
+        self.sim.set_pull(second, Pull.DOWN)
+
+    def test_forward_and_backward(self):
+        self.turn(0, 1)
+        self.turn(0, 1)
+
+        self.assertTrue(self.request.wait_edge_events(1.0))
+        self.assertEqual(self.decoder.read_edge_events(), 8)
+        self.assertEqual(self.decoder.position(0), 8)
+        self.assertEqual(self.decoder.num_errors(0), 0)
+
+        self.turn(1, 0)
+
+        self.assertTrue(self.request.wait_edge_events(1.0))
+        self.assertEqual(self.decoder.read_edge_events(), 4)
+        self.assertEqual(self.decoder.position(0), 4)
+
+    def test_unrelated_lines_are_ignored(self):
+        self.sim.set_pull(2, Pull.UP)
+        self.sim.set_pull(0, Pull.UP)
+
+        self.assertTrue(self.request.wait_edge_events(1.0))
+        self.assertEqual(self.decoder.read_edge_events(), 1)
+        self.assertEqual(self.decoder.position(0), 1)
+
+    def test_reset(self):
+        self.turn(0, 1)
+
+        self.assertTrue(self.request.wait_edge_events(1.0))
+        self.decoder.read_edge_events()
+        self.decoder.reset(0, 100)
+        self.assertEqual(self.decoder.position(0), 100)
+        self.assertEqual(self.decoder.velocity(0), 0.0)
+
+    def test_invalid_arguments(self):
+        with self.assertRaises(ValueError):
+            self.decoder.add_encoder(1, 2)
+
+        with self.assertRaises(ValueError):
+            self.decoder.add_encoder("foo", 3)
+
+        with self.assertRaises(IndexError):
+            self.decoder.position(1)
+
+    def test_released_request(self):
+        self.request.release()
+
+        with self.assertRaises(RequestReleasedError):
+            self.decoder.read_edge_events()
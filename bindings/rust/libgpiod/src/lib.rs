@@ -75,6 +75,9 @@ pub enum OperationType {
     LineConfigGetOffsets,
     LineConfigGetSettings,
     LineInfoCopy,
+    LineProgramNew,
+    LineProgramAddOp,
+    LineProgramRun,
     LineRequestReconfigLines,
     LineRequestGetVal,
     LineRequestGetValSubset,
@@ -93,6 +96,9 @@ pub enum OperationType {
     LineSettingsSetDebouncePeriod,
     LineSettingsSetEventClock,
     LineSettingsSetOutputValue,
+    QuadratureNew,
+    QuadratureAddEncoder,
+    QuadratureSync,
     RequestConfigNew,
     RequestConfigGetConsumer,
     SimBankGetVal,
@@ -145,14 +151,18 @@ pub mod chip;
 
 mod edge_event;
 mod event_buffer;
+mod line_program;
 mod line_request;
+mod quadrature;
 mod request_config;
 
 /// GPIO chip request related definitions.
 pub mod request {
     pub use crate::edge_event::*;
     pub use crate::event_buffer::*;
+    pub use crate::line_program::*;
     pub use crate::line_request::*;
+    pub use crate::quadrature::*;
     pub use crate::request_config::*;
 }
 
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: Apache-2.0 OR BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+use std::marker::PhantomData;
+use std::time::Duration;
+
+use super::{gpiod, line::Edge, request::Request, Error, OperationType, Result};
+
+/// Line operation program
+///
+/// A precompiled sequence of line operations executed in a single call,
+/// which avoids the overhead of going through the bindings for every step.
+/// Lines are addressed with bit masks where bit N corresponds to the N-th
+/// line of the request. The program borrows the requests it operates on.
+#[derive(Debug, Eq, PartialEq)]
+pub struct Program<'a> {
+    program: *mut gpiod::gpiod_line_program,
+    results: Vec<u64>,
+    requests: PhantomData<&'a Request>,
+}
+
+impl<'a> Program<'a> {
+    /// Create a new, empty program.
+    pub fn new() -> Result<Self> {
+        // SAFETY: The `gpiod_line_program` returned by libgpiod is
+        // guaranteed to live as long as the `struct Program`.
+        let program = unsafe { gpiod::gpiod_line_program_new() };
+        if program.is_null() {
+            return Err(Error::OperationFailed(
+                OperationType::LineProgramNew,
+                errno::errno(),
+            ));
+        }
+
+        Ok(Self {
+            program,
+            results: Vec::new(),
+            requests: PhantomData,
+        })
+    }
+
+    fn check(ret: i32) -> Result<()> {
+        if ret == -1 {
+            Err(Error::OperationFailed(
+                OperationType::LineProgramAddOp,
+                errno::errno(),
+            ))
+        } else {
+            Ok(())
+        }
+    }
+
+    /// Append an operation setting the values of the lines in `mask` to
+    /// `bits`.
+    pub fn add_set(&mut self, request: &'a Request, mask: u64, bits: u64) -> Result<&mut Self> {
+        // SAFETY: `gpiod_line_program` and `gpiod_line_request` are
+        // guaranteed to be valid here.
+        Self::check(unsafe {
+            gpiod::gpiod_line_program_add_set(self.program, request.request, mask, bits)
+        })?;
+
+        Ok(self)
+    }
+
+    /// Append an operation reading the values of the lines in `mask` into
+    /// the next result slot.
+    pub fn add_get(&mut self, request: &'a Request, mask: u64) -> Result<&mut Self> {
+        // SAFETY: `gpiod_line_program` and `gpiod_line_request` are
+        // guaranteed to be valid here.
+        Self::check(unsafe {
+            gpiod::gpiod_line_program_add_get(self.program, request.request, mask)
+        })?;
+
+        Ok(self)
+    }
+
+    /// Append an operation sleeping until `offset` past the start of the
+    /// innermost loop iteration, or of the run outside of any loops.
+    pub fn add_sleep_until(&mut self, offset: Duration) -> Result<&mut Self> {
+        // SAFETY: `gpiod_line_program` is guaranteed to be valid here.
+        Self::check(unsafe {
+            gpiod::gpiod_line_program_add_sleep_until(self.program, offset.as_nanos() as u64)
+        })?;
+
+        Ok(self)
+    }
+
+    /// Append an operation waiting for an edge on any of the lines in
+    /// `mask` and storing its timestamp in the next result slot.
+    pub fn add_wait_edge(
+        &mut self,
+        request: &'a Request,
+        mask: u64,
+        edge: Edge,
+        timeout: Option<Duration>,
+    ) -> Result<&mut Self> {
+        let timeout = match timeout {
+            Some(x) => x.as_nanos() as i64,
+            // Block indefinitely
+            None => -1,
+        };
+
+        // SAFETY: `gpiod_line_program` and `gpiod_line_request` are
+        // guaranteed to be valid here.
+        Self::check(unsafe {
+            gpiod::gpiod_line_program_add_wait_edge(
+                self.program,
+                request.request,
+                mask,
+                Edge::gpiod_edge(Some(edge)),
+                timeout,
+            )
+        })?;
+
+        Ok(self)
+    }
+
+    /// Open a loop repeating the subsequent operations `count` times.
+    pub fn begin_loop(&mut self, count: u32) -> Result<&mut Self> {
+        // SAFETY: `gpiod_line_program` is guaranteed to be valid here.
+        Self::check(unsafe { gpiod::gpiod_line_program_begin_loop(self.program, count) })?;
+
+        Ok(self)
+    }
+
+    /// Close the innermost open loop.
+    pub fn end_loop(&mut self) -> Result<&mut Self> {
+        // SAFETY: `gpiod_line_program` is guaranteed to be valid here.
+        Self::check(unsafe { gpiod::gpiod_line_program_end_loop(self.program) })?;
+
+        Ok(self)
+    }
+
+    /// Get the number of results a single run produces.
+    pub fn num_results(&self) -> usize {
+        // SAFETY: `gpiod_line_program` is guaranteed to be valid here.
+        unsafe { gpiod::gpiod_line_program_get_num_results(self.program) }
+    }
+
+    /// Run the program and return the results in the order in which they
+    /// were produced.
+    pub fn run(&mut self) -> Result<&[u64]> {
+        self.results.resize(self.num_results(), 0);
+
+        // SAFETY: `gpiod_line_program` is guaranteed to be valid here and
+        // the results buffer is large enough for a single run.
+        let ret = unsafe {
+            gpiod::gpiod_line_program_run(
+                self.program,
+                self.results.as_mut_ptr(),
+                self.results.len(),
+            )
+        };
+
+        if ret == -1 {
+            Err(Error::OperationFailed(
+                OperationType::LineProgramRun,
+                errno::errno(),
+            ))
+        } else {
+            Ok(&self.results[..ret as usize])
+        }
+    }
+}
+
+impl<'a> Drop for Program<'a> {
+    /// Free the program and release all associated resources.
+    fn drop(&mut self) {
+        // SAFETY: `gpiod_line_program` is guaranteed to be valid here.
+        unsafe { gpiod::gpiod_line_program_free(self.program) }
+    }
+}
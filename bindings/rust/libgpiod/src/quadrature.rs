@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: Apache-2.0 OR BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+use std::time::Duration;
+
+use super::{
+    gpiod,
+    line::Offset,
+    request::{Buffer, Request},
+    Error, OperationType, Result,
+};
+
+/// State of a single encoder.
+#[derive(Copy, Clone, Debug, PartialEq)]
+pub struct EncoderState {
+    /// Position in steps.
+    pub position: i64,
+    /// Velocity in steps per second measured over the last window.
+    pub velocity: f64,
+    /// Number of transitions that couldn't be decoded.
+    pub num_errors: u64,
+}
+
+/// Quadrature decoder
+///
+/// Decodes the signals of incremental rotary encoders straight from edge
+/// event buffers. Each encoder uses two lines with edge detection enabled on
+/// both edges. Four steps are counted per encoder cycle and the position
+/// increases when channel A leads channel B.
+#[derive(Debug, Eq, PartialEq)]
+pub struct QuadratureDecoder {
+    quad: *mut gpiod::gpiod_quadrature,
+}
+
+// SAFETY: QuadratureDecoder models an owned gpiod_quadrature which isn't tied
+// to any thread.
+unsafe impl Send for QuadratureDecoder {}
+
+impl QuadratureDecoder {
+    /// Create a new decoder without any encoders.
+    pub fn new() -> Result<Self> {
+        // SAFETY: The `gpiod_quadrature` returned by libgpiod is guaranteed
+        // to live as long as the `struct QuadratureDecoder`.
+        let quad = unsafe { gpiod::gpiod_quadrature_new() };
+        if quad.is_null() {
+            return Err(Error::OperationFailed(
+                OperationType::QuadratureNew,
+                errno::errno(),
+            ));
+        }
+
+        Ok(Self { quad })
+    }
+
+    /// Add an encoder connected to lines `offset_a` and `offset_b` and
+    /// return its index.
+    pub fn add_encoder(&mut self, offset_a: Offset, offset_b: Offset) -> Result<usize> {
+        // SAFETY: `gpiod_quadrature` is guaranteed to be valid here.
+        let ret = unsafe { gpiod::gpiod_quadrature_add_encoder(self.quad, offset_a, offset_b) };
+        if ret == -1 {
+            Err(Error::OperationFailed(
+                OperationType::QuadratureAddEncoder,
+                errno::errno(),
+            ))
+        } else {
+            Ok(ret as usize)
+        }
+    }
+
+    /// Get the number of encoders.
+    pub fn num_encoders(&self) -> usize {
+        // SAFETY: `gpiod_quadrature` is guaranteed to be valid here.
+        unsafe { gpiod::gpiod_quadrature_get_num_encoders(self.quad) }
+    }
+
+    /// Set the minimum time span of the steps over which the velocity is
+    /// measured. Zero restores the default of 10 milliseconds.
+    pub fn set_velocity_window(&mut self, window: Duration) -> &mut Self {
+        // SAFETY: `gpiod_quadrature` is guaranteed to be valid here.
+        unsafe { gpiod::gpiod_quadrature_set_velocity_window(self.quad, window.as_nanos() as u64) }
+
+        self
+    }
+
+    /// Synchronize the decoder with the current levels of the lines of the
+    /// request and return the number of encoders whose both lines belong to
+    /// it.
+    pub fn sync(&mut self, request: &Request) -> Result<usize> {
+        // SAFETY: `gpiod_quadrature` and `gpiod_line_request` are guaranteed
+        // to be valid here.
+        let ret = unsafe { gpiod::gpiod_quadrature_sync(self.quad, request.request) };
+        if ret == -1 {
+            Err(Error::OperationFailed(
+                OperationType::QuadratureSync,
+                errno::errno(),
+            ))
+        } else {
+            Ok(ret as usize)
+        }
+    }
+
+    /// Decode all events stored in the buffer and return the number of
+    /// events that belonged to one of the encoders.
+    pub fn process(&mut self, buffer: &Buffer) -> usize {
+        // SAFETY: `gpiod_quadrature` and `gpiod_edge_event_buffer` are
+        // guaranteed to be valid here.
+        unsafe { gpiod::gpiod_quadrature_process(self.quad, buffer.buffer) }
+    }
+
+    /// Get the state of an encoder.
+    pub fn state(&self, encoder: usize) -> Result<EncoderState> {
+        let mut state = EncoderState {
+            position: 0,
+            velocity: 0.0,
+            num_errors: 0,
+        };
+
+        let encoder = u32::try_from(encoder).map_err(|_| Error::InvalidArguments)?;
+
+        // SAFETY: `gpiod_quadrature` is guaranteed to be valid here and the
+        // pointers point to live locals.
+        let ret = unsafe {
+            gpiod::gpiod_quadrature_get_state(
+                self.quad,
+                encoder,
+                &mut state.position,
+                &mut state.velocity,
+                &mut state.num_errors,
+            )
+        };
+
+        if ret == -1 {
+            Err(Error::InvalidArguments)
+        } else {
+            Ok(state)
+        }
+    }
+
+    /// Set the position of an encoder, clear its error count and restart the
+    /// velocity measurement.
+    pub fn reset(&mut self, encoder: usize, position: i64) -> Result<()> {
+        let encoder = u32::try_from(encoder).map_err(|_| Error::InvalidArguments)?;
+
+        // SAFETY: `gpiod_quadrature` is guaranteed to be valid here.
+        let ret = unsafe { gpiod::gpiod_quadrature_reset(self.quad, encoder, position) };
+        if ret == -1 {
+            Err(Error::InvalidArguments)
+        } else {
+            Ok(())
+        }
+    }
+}
+
+impl Drop for QuadratureDecoder {
+    /// Free the decoder and release all associated resources.
+    fn drop(&mut self) {
+        // SAFETY: `gpiod_quadrature` is guaranteed to be valid here.
+        unsafe { gpiod::gpiod_quadrature_free(self.quad) }
+    }
+}
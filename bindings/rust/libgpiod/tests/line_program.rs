@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: Apache-2.0 OR BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+mod common;
+
+mod line_program {
+    use libc::{EINVAL, ETIMEDOUT};
+    use std::time::{Duration, Instant};
+
+    use crate::common::*;
+    use gpiosim_sys::{Pull, Value as SimValue};
+    use libgpiod::{
+        line::{Direction, Edge},
+        request::Program,
+        Error as ChipError, OperationType,
+    };
+
+    const NGPIO: usize = 8;
+
+    #[test]
+    fn set_and_get() {
+        let mut config = TestConfig::new(NGPIO).unwrap();
+        config.lconfig_val(Some(Direction::Output), None);
+        config.lconfig_add_settings(&[0, 1, 2]);
+        config.request_lines().unwrap();
+
+        {
+            let request = config.request();
+            let mut program = Program::new().unwrap();
+
+            program
+                .add_set(request, 0b111, 0b101)
+                .unwrap()
+                .add_get(request, 0b111)
+                .unwrap();
+
+            assert_eq!(program.num_results(), 1);
+            assert_eq!(program.run().unwrap(), &[0b101]);
+        }
+
+        assert_eq!(config.sim_val(0).unwrap(), SimValue::Active);
+        assert_eq!(config.sim_val(1).unwrap(), SimValue::InActive);
+        assert_eq!(config.sim_val(2).unwrap(), SimValue::Active);
+    }
+
+    #[test]
+    fn loop_results_in_order() {
+        let mut config = TestConfig::new(NGPIO).unwrap();
+        config.lconfig_val(Some(Direction::Output), None);
+        config.lconfig_add_settings(&[3, 4]);
+        config.request_lines().unwrap();
+
+        let request = config.request();
+        let mut program = Program::new().unwrap();
+
+        program
+            .begin_loop(3)
+            .unwrap()
+            .add_set(request, 0b11, 0b01)
+            .unwrap()
+            .add_get(request, 0b11)
+            .unwrap()
+            .add_set(request, 0b11, 0b10)
+            .unwrap()
+            .add_get(request, 0b11)
+            .unwrap()
+            .end_loop()
+            .unwrap();
+
+        assert_eq!(program.num_results(), 6);
+        assert_eq!(program.run().unwrap(), &[1, 2, 1, 2, 1, 2]);
+    }
+
+    #[test]
+    fn periodic_loop() {
+        let mut config = TestConfig::new(NGPIO).unwrap();
+        config.lconfig_val(Some(Direction::Output), None);
+        config.lconfig_add_settings(&[0]);
+        config.request_lines().unwrap();
+
+        let request = config.request();
+        let mut program = Program::new().unwrap();
+
+        program
+            .begin_loop(5)
+            .unwrap()
+            .add_set(request, 0b1, 0b1)
+            .unwrap()
+            .add_sleep_until(Duration::from_millis(5))
+            .unwrap()
+            .add_set(request, 0b1, 0b0)
+            .unwrap()
+            .add_sleep_until(Duration::from_millis(10))
+            .unwrap()
+            .end_loop()
+            .unwrap();
+
+        let start = Instant::now();
+        program.run().unwrap();
+        assert!(start.elapsed() >= Duration::from_millis(45));
+    }
+
+    #[test]
+    fn wait_edge() {
+        const GPIO: u32 = 2;
+        let mut config = TestConfig::new(NGPIO).unwrap();
+        config.lconfig_edge(None, Some(Edge::Rising));
+        config.lconfig_add_settings(&[GPIO]);
+        config.request_lines().unwrap();
+
+        let sim = config.sim();
+        let thread = std::thread::spawn(move || {
+            std::thread::sleep(Duration::from_millis(30));
+            sim.lock().unwrap().set_pull(GPIO, Pull::Up).unwrap();
+        });
+
+        let request = config.request();
+        let mut program = Program::new().unwrap();
+
+        program
+            .add_wait_edge(request, 0b1, Edge::Rising, Some(Duration::from_secs(1)))
+            .unwrap();
+
+        let results = program.run().unwrap();
+        assert_eq!(results.len(), 1);
+        assert!(results[0] > 0);
+
+        thread.join().unwrap();
+
+        let mut program = Program::new().unwrap();
+
+        program
+            .add_wait_edge(request, 0b1, Edge::Rising, Some(Duration::from_millis(10)))
+            .unwrap();
+
+        assert_eq!(
+            program.run().unwrap_err(),
+            ChipError::OperationFailed(OperationType::LineProgramRun, errno::Errno(ETIMEDOUT))
+        );
+    }
+
+    #[test]
+    fn invalid_arguments() {
+        let mut config = TestConfig::new(NGPIO).unwrap();
+        config.lconfig_val(Some(Direction::Output), None);
+        config.lconfig_add_settings(&[0, 1]);
+        config.request_lines().unwrap();
+
+        let request = config.request();
+        let mut program = Program::new().unwrap();
+
+        assert_eq!(
+            program.add_set(request, 0b100, 0).unwrap_err(),
+            ChipError::OperationFailed(OperationType::LineProgramAddOp, errno::Errno(EINVAL))
+        );
+        assert_eq!(
+            program.end_loop().unwrap_err(),
+            ChipError::OperationFailed(OperationType::LineProgramAddOp, errno::Errno(EINVAL))
+        );
+
+        program.begin_loop(2).unwrap();
+        assert_eq!(
+            program.run().unwrap_err(),
+            ChipError::OperationFailed(OperationType::LineProgramRun, errno::Errno(EINVAL))
+        );
+    }
+}
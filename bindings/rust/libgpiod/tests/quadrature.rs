@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: Apache-2.0 OR BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+mod common;
+
+mod quadrature {
+    use libc::EINVAL;
+    use std::time::Duration;
+
+    use crate::common::*;
+    use gpiosim_sys::Pull;
+    use libgpiod::{
+        line::Edge,
+        request::{Buffer, QuadratureDecoder},
+        Error as ChipError, OperationType,
+    };
+
+    const NGPIO: usize = 4;
+
+    fn turn(config: &TestConfig, first: u32, second: u32) {
+        config.set_pull(
+            &[first, second, first, second],
+            &[Pull::Up, Pull::Up, Pull::Down, Pull::Down],
+        );
+    }
+
+    #[test]
+    fn counts_both_directions() {
+        let mut config = TestConfig::new(NGPIO).unwrap();
+        config.lconfig_edge(None, Some(Edge::Both));
+        config.lconfig_add_settings(&[0, 1]);
+        config.request_lines().unwrap();
+
+        let mut buf = Buffer::new(64).unwrap();
+        let mut decoder = QuadratureDecoder::new().unwrap();
+
+        assert_eq!(decoder.add_encoder(0, 1).unwrap(), 0);
+        assert_eq!(decoder.num_encoders(), 1);
+        assert_eq!(decoder.sync(config.request()).unwrap(), 1);
+
+        turn(&config, 0, 1);
+        turn(&config, 0, 1);
+
+        assert!(config
+            .request()
+            .wait_edge_events(Some(Duration::from_secs(1)))
+            .unwrap());
+        assert_eq!(
+            config.request().read_edge_events(&mut buf).unwrap().len(),
+            8
+        );
+        assert_eq!(decoder.process(&buf), 8);
+
+        let state = decoder.state(0).unwrap();
+        assert_eq!(state.position, 8);
+        assert_eq!(state.num_errors, 0);
+
+        turn(&config, 1, 0);
+
+        assert!(config
+            .request()
+            .wait_edge_events(Some(Duration::from_secs(1)))
+            .unwrap());
+        assert_eq!(
+            config.request().read_edge_events(&mut buf).unwrap().len(),
+            4
+        );
+        assert_eq!(decoder.process(&buf), 4);
+        assert_eq!(decoder.state(0).unwrap().position, 4);
+
+        decoder.reset(0, 100).unwrap();
+        assert_eq!(decoder.state(0).unwrap().position, 100);
+    }
+
+    #[test]
+    fn invalid_arguments() {
+        let mut decoder = QuadratureDecoder::new().unwrap();
+
+        decoder.add_encoder(0, 1).unwrap();
+
+        assert_eq!(
+            decoder.add_encoder(1, 2).unwrap_err(),
+            ChipError::OperationFailed(OperationType::QuadratureAddEncoder, errno::Errno(EINVAL),)
+        );
+        assert_eq!(decoder.state(1).unwrap_err(), ChipError::InvalidArguments);
+        assert_eq!(
+            decoder.reset(1, 0).unwrap_err(),
+            ChipError::InvalidArguments
+        );
+    }
+}
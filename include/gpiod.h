@@ -156,6 +156,173 @@ struct gpiod_edge_event;
 */
 struct gpiod_edge_event_buffer;
 
+/**
+ * @struct gpiod_chip_mirror
+ * @{
+ *
+ * Refer to @ref chip_mirror for functions that operate on gpiod_chip_mirror.
+ *
+ * @}
+*/
+struct gpiod_chip_mirror;
+
+/**
+ * @struct gpiod_chip_monitor
+ * @{
+ *
+ * Refer to @ref chip_monitor for functions that operate on gpiod_chip_monitor.
+ *
+ * @}
+*/
+struct gpiod_chip_monitor;
+
+/**
+ * @struct gpiod_chip_monitor_event
+ * @{
+ *
+ * Refer to @ref chip_monitor for functions that operate on
+ * gpiod_chip_monitor_event.
+ *
+ * @}
+*/
+struct gpiod_chip_monitor_event;
+
+/**
+ * @struct gpiod_pwm
+ * @{
+ *
+ * Refer to @ref line_pwm for functions that operate on gpiod_pwm.
+ *
+ * @}
+*/
+struct gpiod_pwm;
+
+/**
+ * @struct gpiod_bitbang
+ * @{
+ *
+ * Refer to @ref bitbang for functions that operate on gpiod_bitbang.
+ *
+ * @}
+*/
+struct gpiod_bitbang;
+
+/**
+ * @struct gpiod_line_bus
+ * @{
+ *
+ * Refer to @ref line_bus for functions that operate on gpiod_line_bus.
+ *
+ * @}
+*/
+struct gpiod_line_bus;
+
+/**
+ * @struct gpiod_line_program
+ * @{
+ *
+ * Refer to @ref line_program for functions that operate on
+ * gpiod_line_program.
+ *
+ * @}
+*/
+struct gpiod_line_program;
+
+/**
+ * @struct gpiod_reflex
+ * @{
+ *
+ * Refer to @ref reflex for functions that operate on gpiod_reflex.
+ *
+ * @}
+*/
+struct gpiod_reflex;
+
+/**
+ * @struct gpiod_quadrature
+ * @{
+ *
+ * Refer to @ref quadrature for functions that operate on gpiod_quadrature.
+ *
+ * @}
+*/
+struct gpiod_quadrature;
+
+/**
+ * @struct gpiod_edge_decoder
+ * @{
+ *
+ * Refer to @ref edge_decoder for functions that operate on
+ * gpiod_edge_decoder.
+ *
+ * @}
+*/
+struct gpiod_edge_decoder;
+
+/**
+ * @struct gpiod_keypad
+ * @{
+ *
+ * Refer to @ref keypad for functions that operate on gpiod_keypad.
+ *
+ * @}
+*/
+struct gpiod_keypad;
+
+/**
+ * @struct gpiod_edge_limiter
+ * @{
+ *
+ * Refer to @ref edge_limiter for functions that operate on
+ * gpiod_edge_limiter.
+ *
+ * @}
+*/
+struct gpiod_edge_limiter;
+
+/**
+ * @struct gpiod_line_config_table
+ * @{
+ *
+ * Refer to @ref line_config_table for functions that operate on
+ * gpiod_line_config_table.
+ *
+ * @}
+*/
+struct gpiod_line_config_table;
+
+/**
+ * @struct gpiod_output_journal
+ * @{
+ *
+ * Refer to @ref output_journal for functions that operate on
+ * gpiod_output_journal.
+ *
+ * @}
+*/
+struct gpiod_output_journal;
+
+/**
+ * @struct gpiod_request_group
+ * @{
+ *
+ * Refer to @ref request_group for functions that operate on
+ * gpiod_request_group.
+ *
+ * @}
+*/
+struct gpiod_request_group;
+
+/**
+ * @struct gpiod_scheduler
+ * @{
+ *
+ * Refer to @ref scheduler for functions that operate on gpiod_scheduler.
+ *
+ * @}
+*/
+struct gpiod_scheduler;
+
 /**
  * @defgroup chips GPIO chips
  * @{
@@ -338,6 +505,159 @@ const char *gpiod_chip_info_get_label(struct gpiod_chip_info *info);
  */
 size_t gpiod_chip_info_get_num_lines(struct gpiod_chip_info *info);
 
+/**
+ * @brief Maximum length of the name and label strings in exported chip and
+ *        line info data, including the terminating null byte.
+ */
+#define GPIOD_INFO_NAME_SIZE 32
+
+/**
+ * @brief Plain copy of the contents of a chip info object.
+ *
+ * New fields are only ever appended at the end of the structure. Users pass
+ * the size of the structure as they know it to the export function which
+ * fills in all the fields both sides know about and zeroes the rest.
+ */
+struct gpiod_chip_info_data {
+	size_t num_lines;
+	/**< Number of GPIO lines. */
+	char name[GPIOD_INFO_NAME_SIZE];
+	/**< Name of the chip as represented in the kernel. */
+	char label[GPIOD_INFO_NAME_SIZE];
+	/**< Label of the chip as represented in the kernel. */
+};
+
+/**
+ * @brief Copy the contents of a chip info object into a plain structure.
+ * @param info GPIO chip info object.
+ * @param data Structure to fill.
+ * @param size Size of the structure as known to the caller. Should be
+ *             sizeof(struct gpiod_chip_info_data).
+ * @return 0 on success, -1 on failure. Fails with EINVAL if size is smaller
+ *         than the first version of the structure.
+ */
+int gpiod_chip_info_export(struct gpiod_chip_info *info,
+			   struct gpiod_chip_info_data *data, size_t size);
+
+/**
+ * @}
+ *
+ * @defgroup chip_monitor Chip hot-plug monitor
+ * @{
+ *
+ * Functions for getting notified about GPIO chips appearing in and
+ * disappearing from the system.
+ *
+ * The monitor watches the /dev directory for GPIO character devices being
+ * created or removed and exposes those changes as events that can be read
+ * from a pollable file descriptor. This allows reacting to hot-plugged
+ * GPIO expanders without periodically rescanning all chips.
+ */
+
+/**
+ * @brief Chip monitor event types.
+ */
+enum gpiod_chip_monitor_event_type {
+	GPIOD_CHIP_MONITOR_EVENT_CHIP_ADDED = 1,
+	/**< A GPIO chip device has appeared. */
+	GPIOD_CHIP_MONITOR_EVENT_CHIP_REMOVED,
+	/**< A GPIO chip device has been removed. */
+	GPIOD_CHIP_MONITOR_EVENT_OVERFLOW,
+	/**< The kernel event queue overflowed and some chip events have been
+	 *   lost. The user should rescan the chips present in the system. */
+};
+
+/**
+ * @brief Create a new chip monitor.
+ * @return New chip monitor object or NULL if an error occurred. The returned
+ *         object must be freed by the caller using ::gpiod_chip_monitor_free.
+ * @note Only chips added or removed after the monitor has been created are
+ *       reported. Chips present at creation time can be enumerated by
+ *       scanning /dev with ::gpiod_is_gpiochip_device.
+ */
+struct gpiod_chip_monitor *gpiod_chip_monitor_new(void);
+
+/**
+ * @brief Free the chip monitor and release all associated resources.
+ * @param monitor Chip monitor to free.
+ */
+void gpiod_chip_monitor_free(struct gpiod_chip_monitor *monitor);
+
+/**
+ * @brief Get the file descriptor associated with the chip monitor.
+ * @param monitor Chip monitor object.
+ * @return File descriptor number. The file descriptor must not be closed or
+ *         read from by the caller but can be polled for readability.
+ * @note The file descriptor becomes readable on any change in /dev, not only
+ *       on those concerning GPIO chips. Several changes may also be read
+ *       from the kernel at once and buffered by the monitor, after which the
+ *       file descriptor no longer polls readable. After it polls readable,
+ *       keep calling ::gpiod_chip_monitor_wait_event with a timeout of 0 and
+ *       reading the pending events until it returns 0 before polling it
+ *       again.
+ */
+int gpiod_chip_monitor_get_fd(struct gpiod_chip_monitor *monitor);
+
+/**
+ * @brief Wait for chips being added or removed.
+ * @param monitor Chip monitor object.
+ * @param timeout_ns Wait time limit in nanoseconds. If set to 0, the function
+ *                   returns immediately. If set to a negative number, the
+ *                   function blocks indefinitely until an event becomes
+ *                   available.
+ * @return 0 if wait timed out, -1 if an error occurred, 1 if an event is
+ *         pending.
+ */
+int gpiod_chip_monitor_wait_event(struct gpiod_chip_monitor *monitor,
+				  int64_t timeout_ns);
+
+/**
+ * @brief Read a single chip monitor event.
+ * @param monitor Chip monitor object.
+ * @return Newly read chip monitor event or NULL on error. The event must be
+ *         freed by the caller using ::gpiod_chip_monitor_event_free.
+ * @note If no events are pending, this function will block.
+ */
+struct gpiod_chip_monitor_event *
+gpiod_chip_monitor_read_event(struct gpiod_chip_monitor *monitor);
+
+/**
+ * @brief Free the chip monitor event object.
+ * @param event Chip monitor event to free.
+ */
+void gpiod_chip_monitor_event_free(struct gpiod_chip_monitor_event *event);
+
+/**
+ * @brief Get the event type.
+ * @param event Chip monitor event.
+ * @return ::GPIOD_CHIP_MONITOR_EVENT_CHIP_ADDED,
+ *         ::GPIOD_CHIP_MONITOR_EVENT_CHIP_REMOVED or
+ *         ::GPIOD_CHIP_MONITOR_EVENT_OVERFLOW.
+ */
+enum gpiod_chip_monitor_event_type
+gpiod_chip_monitor_event_get_event_type(struct gpiod_chip_monitor_event *event);
+
+/**
+ * @brief Get the path to the chip the event concerns.
+ * @param event Chip monitor event.
+ * @return Path to the character device or an empty string for overflow
+ *         events. The string lifetime is tied to the event object so the
+ *         pointer must not be freed by the caller.
+ */
+const char *
+gpiod_chip_monitor_event_get_chip_path(struct gpiod_chip_monitor_event *event);
+
+/**
+ * @brief Get the label of the chip the event concerns.
+ * @param event Chip monitor event.
+ * @return Label of the chip or NULL if it is not known. The label is only
+ *         available for added chips and only if the device could be opened
+ *         at the time the event was read. The string lifetime is tied to the
+ *         event object so the pointer must not be freed by the caller.
+ */
+const char *
+gpiod_chip_monitor_event_get_chip_label(struct gpiod_chip_monitor_event *event);
+
 /**
  * @}
  *
@@ -576,6 +896,77 @@ gpiod_line_info_get_debounce_period_us(struct gpiod_line_info *info);
 enum gpiod_line_clock
 gpiod_line_info_get_event_clock(struct gpiod_line_info *info);
 
+/**
+ * @brief Plain copy of the contents of a line info object.
+ *
+ * New fields are only ever appended at the end of the structure. Users pass
+ * the size of the structure as they know it to the export function which
+ * fills in all the fields both sides know about and zeroes the rest.
+ */
+struct gpiod_line_info_data {
+	unsigned int offset;
+	/**< Offset of the line within the parent chip. */
+	char name[GPIOD_INFO_NAME_SIZE];
+	/**< Name of the line, empty if the line is unnamed. */
+	char consumer[GPIOD_INFO_NAME_SIZE];
+	/**< Name of the consumer, empty if not set. */
+	bool used;
+	/**< True if the line is in use. */
+	bool active_low;
+	/**< True if the line is active-low. */
+	bool debounced;
+	/**< True if the line is debounced. */
+	enum gpiod_line_direction direction;
+	/**< Direction setting of the line. */
+	enum gpiod_line_bias bias;
+	/**< Bias setting of the line. */
+	enum gpiod_line_drive drive;
+	/**< Drive setting of the line. */
+	enum gpiod_line_edge edge_detection;
+	/**< Edge detection setting of the line. */
+	enum gpiod_line_clock event_clock;
+	/**< Event clock setting of the line. */
+	unsigned long debounce_period_us;
+	/**< Debounce period in microseconds, 0 if not debounced. */
+};
+
+/**
+ * @brief Copy the contents of a line info object into a plain structure.
+ * @param info GPIO line info object.
+ * @param data Structure to fill.
+ * @param size Size of the structure as known to the caller. Should be
+ *             sizeof(struct gpiod_line_info_data).
+ * @return 0 on success, -1 on failure. Fails with EINVAL if size is smaller
+ *         than the first version of the structure.
+ *
+ * Retrieves all the information in a single call instead of one call per
+ * accessor.
+ */
+int gpiod_line_info_export(struct gpiod_line_info *info,
+			   struct gpiod_line_info_data *data, size_t size);
+
+/**
+ * @brief Read the information about a range of lines straight into an array
+ *        of plain structures.
+ * @param chip GPIO chip object.
+ * @param offset Offset of the first line to read.
+ * @param num_lines Number of consecutive lines to read.
+ * @param data Array of at least num_lines structures to fill.
+ * @param size Size of each structure in the array as known to the caller.
+ *             Should be sizeof(struct gpiod_line_info_data).
+ * @return 0 on success, -1 on failure. Fails with EINVAL if size is smaller
+ *         than the first version of the structure or if the range of lines
+ *         doesn't fit within the chip. The contents of \p data are undefined
+ *         on failure.
+ *
+ * Unlike reading the lines one by one with ::gpiod_chip_get_line_info and
+ * exporting them, no line info objects are allocated.
+ */
+int gpiod_chip_read_line_info_data(struct gpiod_chip *chip,
+				   unsigned int offset, size_t num_lines,
+				   struct gpiod_line_info_data *data,
+				   size_t size);
+
 /**
  * @}
  *
@@ -642,6 +1033,122 @@ uint64_t gpiod_info_event_get_timestamp_ns(struct gpiod_info_event *event);
 struct gpiod_line_info *
 gpiod_info_event_get_line_info(struct gpiod_info_event *event);
 
+/**
+ * @}
+ *
+ * @defgroup chip_mirror Line info mirror
+ * @{
+ *
+ * Functions for keeping an up-to-date copy of the status of all lines of
+ * a chip.
+ *
+ * A chip mirror takes a snapshot of the info of every line exposed by a chip
+ * and starts watching all of them for status changes. The mirror is then kept
+ * current by applying the info events as they arrive, so the status of any
+ * line can be looked up from memory without issuing an ioctl.
+ *
+ * The mirror opens its own file descriptor to the chip and reads the info
+ * events itself. Callers must use ::gpiod_chip_mirror_process_info_events
+ * whenever the file descriptor becomes readable in order to keep the mirror
+ * up to date.
+ */
+
+/**
+ * @brief Signature of the function called for every info event applied to
+ *        the mirror.
+ * @param event Info event that has been applied. The event object is only
+ *              valid for the duration of the callback and must not be freed
+ *              by the callee.
+ * @param user_data Pointer passed to ::gpiod_chip_mirror_set_callback.
+ */
+typedef void (*gpiod_chip_mirror_callback)(struct gpiod_info_event *event,
+					   void *user_data);
+
+/**
+ * @brief Create a line info mirror for a chip.
+ * @param path Path to the gpiochip device file.
+ * @return New chip mirror object or NULL if an error occurred. The returned
+ *         object must be freed by the caller using ::gpiod_chip_mirror_free.
+ */
+struct gpiod_chip_mirror *gpiod_chip_mirror_new(const char *path);
+
+/**
+ * @brief Free the chip mirror and release all associated resources.
+ * @param mirror Chip mirror to free.
+ */
+void gpiod_chip_mirror_free(struct gpiod_chip_mirror *mirror);
+
+/**
+ * @brief Get the path of the chip being mirrored.
+ * @param mirror Chip mirror object.
+ * @return Path to the file passed as argument to ::gpiod_chip_mirror_new.
+ *         The returned pointer is valid for the lifetime of the mirror object
+ *         and must not be freed by the caller.
+ */
+const char *gpiod_chip_mirror_get_chip_path(struct gpiod_chip_mirror *mirror);
+
+/**
+ * @brief Get the number of lines in the mirror.
+ * @param mirror Chip mirror object.
+ * @return Number of lines exposed by the mirrored chip.
+ */
+size_t gpiod_chip_mirror_get_num_lines(struct gpiod_chip_mirror *mirror);
+
+/**
+ * @brief Get the current status of a line from the mirror.
+ * @param mirror Chip mirror object.
+ * @param offset The offset of the GPIO line.
+ * @return Pointer to the line info object held by the mirror or NULL if the
+ *         offset is out of range. The object lifetime is tied to the mirror
+ *         so the pointer must not be freed by the caller. The contents of the
+ *         object are updated in place by
+ *         ::gpiod_chip_mirror_process_info_events.
+ */
+struct gpiod_line_info *
+gpiod_chip_mirror_get_line_info(struct gpiod_chip_mirror *mirror,
+				unsigned int offset);
+
+/**
+ * @brief Set the function to call for every info event applied to the mirror.
+ * @param mirror Chip mirror object.
+ * @param callback Function to call or NULL to disable notifications.
+ * @param user_data Pointer passed verbatim to the callback.
+ * @note The callback is invoked after the mirror has been updated so looking
+ *       up the line from within the callback returns the new status.
+ */
+void gpiod_chip_mirror_set_callback(struct gpiod_chip_mirror *mirror,
+				    gpiod_chip_mirror_callback callback,
+				    void *user_data);
+
+/**
+ * @brief Get the file descriptor the mirror reads info events from.
+ * @param mirror Chip mirror object.
+ * @return File descriptor number. The file descriptor must not be closed or
+ *         read from by the caller but can be polled for readability.
+ */
+int gpiod_chip_mirror_get_fd(struct gpiod_chip_mirror *mirror);
+
+/**
+ * @brief Wait for info events on the mirrored chip.
+ * @param mirror Chip mirror object.
+ * @param timeout_ns Wait time limit in nanoseconds. If set to 0, the function
+ *                   returns immediately. If set to a negative number, the
+ *                   function blocks indefinitely until an event becomes
+ *                   available.
+ * @return 0 if wait timed out, -1 if an error occurred, 1 if an event is
+ *         pending.
+ */
+int gpiod_chip_mirror_wait_info_events(struct gpiod_chip_mirror *mirror,
+				       int64_t timeout_ns);
+
+/**
+ * @brief Apply all pending info events to the mirror.
+ * @param mirror Chip mirror object.
+ * @return Number of events applied or -1 on error.
+ * @note This function never blocks. If no events are pending it returns 0.
+ */
+int gpiod_chip_mirror_process_info_events(struct gpiod_chip_mirror *mirror);
+
 /**
  * @}
  *
@@ -1176,6 +1683,48 @@ int gpiod_line_request_get_fd(struct gpiod_line_request *request);
 int gpiod_line_request_wait_edge_events(struct gpiod_line_request *request,
 					int64_t timeout_ns);
 
+/**
+ * @brief Set the busy-poll budget used when waiting for edge events.
+ * @param request GPIO line request.
+ * @param spin_ns Time in nanoseconds for which
+ *                ::gpiod_line_request_wait_edge_events checks the request
+ *                for pending events without sleeping before it falls back to
+ *                sleeping in the kernel. 0, the default, disables
+ *                busy-polling.
+ *
+ * Busy-polling removes the scheduler's wake-up latency from the reaction
+ * time to events arriving within the budget, at the cost of keeping a CPU
+ * busy for the whole budget on every wait. It's best used on isolated
+ * cores.
+ */
+void gpiod_line_request_set_busy_poll(struct gpiod_line_request *request,
+				      uint64_t spin_ns);
+
+/**
+ * @brief Get the busy-poll budget used when waiting for edge events.
+ * @param request GPIO line request.
+ * @return Busy-poll budget in nanoseconds, 0 if busy-polling is disabled.
+ */
+uint64_t gpiod_line_request_get_busy_poll(struct gpiod_line_request *request);
+
+/**
+ * @brief Get the statistics of waiting for edge events.
+ * @param request GPIO line request.
+ * @param num_spin_wakeups Optional pointer in which the number of waits
+ *                         that found an event while busy-polling is stored.
+ * @param num_sleep_wakeups Optional pointer in which the number of waits
+ *                          that found an event after sleeping in the kernel
+ *                          is stored.
+ * @param spin_ns Optional pointer in which the total time spent
+ *                busy-polling in nanoseconds is stored.
+ *
+ * Waits that timed out or failed are not counted.
+ */
+void gpiod_line_request_get_wait_stats(struct gpiod_line_request *request,
+				       uint64_t *num_spin_wakeups,
+				       uint64_t *num_sleep_wakeups,
+				       uint64_t *spin_ns);
+
 /**
  * @brief Read a number of edge events from a line request.
  * @param request GPIO line request.
@@ -1192,14 +1741,205 @@ int gpiod_line_request_read_edge_events(struct gpiod_line_request *request,
 					size_t max_events);
 
 /**
- * @}
- *
- * @defgroup edge_event Line edge events handling
- * @{
- *
- * Functions and data types for handling edge events.
- *
- * An edge event object contains information about a single line edge event.
+ * @brief Make reading edge events wait for larger batches.
+ * @param request GPIO line request.
+ * @param window_ns Maximum time in nanoseconds to wait after the first
+ *                  event becomes available before reading. 0, the default,
+ *                  reads events as soon as they are available.
+ * @param fill Number of events per read to aim for. 0 means as many as the
+ *             buffer can hold.
+ *
+ * At high event rates reading events as soon as they arrive returns them in
+ * batches of a few events at a time, which costs a system call per handful
+ * of events. With batching enabled, ::gpiod_line_request_read_edge_events
+ * waits for the first event and then lets more events accumulate in the
+ * kernel for up to the window before reading them all at once. This trades
+ * latency for lower CPU usage per event.
+ *
+ * The kernel doesn't tell how many events are queued without reading them.
+ * The time it takes for \p fill events to arrive is therefore estimated
+ * from an exponential moving average of the intervals between the events
+ * in previous batches, and the wait is cut short if the batch is expected
+ * to be full before the window closes. If events were already pending when
+ * the read started, the time elapsed since the previous read counts towards
+ * the estimate and no wait at all happens if it already covers the batch.
+ * The actual number of queued events is never checked, so a batch may be
+ * smaller than \p fill if the event rate drops. No wait happens if the
+ * batch is at most one event, be it because of the buffer capacity, the
+ * maximum number of events passed to the read or \p fill.
+ */
+void gpiod_line_request_set_read_batching(struct gpiod_line_request *request,
+					  uint64_t window_ns, size_t fill);
+
+/**
+ * @brief Get the statistics of reading edge events.
+ * @param request GPIO line request.
+ * @param num_reads Optional pointer in which the number of reads is stored.
+ * @param num_events Optional pointer in which the number of events read is
+ *                   stored.
+ * @param max_batch Optional pointer in which the largest number of events
+ *                  returned by a single read is stored.
+ *
+ * The mean batch size is \p num_events divided by \p num_reads. Reads that
+ * failed are not counted.
+ */
+void gpiod_line_request_get_read_stats(struct gpiod_line_request *request,
+				       uint64_t *num_reads, uint64_t *num_events,
+				       size_t *max_batch);
+
+/**
+ * @brief Responses that can be awaited by ::gpiod_line_request_handshake.
+ */
+enum gpiod_line_response {
+	GPIOD_LINE_RESPONSE_RISING_EDGE = 1,
+	/**< Wait for a rising edge event. */
+	GPIOD_LINE_RESPONSE_FALLING_EDGE,
+	/**< Wait for a falling edge event. */
+	GPIOD_LINE_RESPONSE_ACTIVE,
+	/**< Wait for the line to be active. */
+	GPIOD_LINE_RESPONSE_INACTIVE,
+	/**< Wait for the line to be inactive. */
+};
+
+/**
+ * @brief Set the values of a subset of requested lines and wait for
+ *        a response on an input line.
+ * @param request GPIO line request on which to set the values.
+ * @param num_values Number of lines for which to set values.
+ * @param offsets Array of offsets identifying the requested lines for which
+ *                to set values.
+ * @param values Array of values to set, one for each entry in \p offsets.
+ * @param response_request GPIO line request containing the response line.
+ *                         May be the same object as \p request.
+ * @param response_offset Offset of the line on which to wait for the
+ *                        response.
+ * @param response Response to wait for.
+ * @param timeout_ns Wait time limit in nanoseconds, counted from the moment
+ *                   the values are set. If set to 0, only the responses
+ *                   already available once the values have been set are
+ *                   considered. If set to a negative number, the function
+ *                   blocks indefinitely until the response arrives.
+ * @param buffer Optional edge event buffer. If not NULL, it receives the
+ *               edge event that satisfied the wait or no events if the
+ *               response was a level that had already been reached.
+ * @param turnaround_ns Optional pointer in which the time elapsed between
+ *                      setting the values and observing the response is
+ *                      stored, as measured on the monotonic clock.
+ * @return 1 if the response has been observed, 0 if the wait timed out and
+ *         -1 on error.
+ *
+ * This combines ::gpiod_line_request_set_values_subset and waiting for edge
+ * events in a single call in order to minimize the latency of handshakes
+ * such as asserting a request line and waiting for an acknowledge edge.
+ *
+ * The response line must have edge detection enabled for the edges the
+ * response implies - rising for ::GPIOD_LINE_RESPONSE_RISING_EDGE and
+ * ::GPIOD_LINE_RESPONSE_ACTIVE, falling for the others. Level responses are
+ * checked against the current value of the line right after the values have
+ * been set and only waited for if not yet reached.
+ *
+ * @note Edge events pending on \p response_request before the values are set,
+ *       as well as events not matching the response received while waiting,
+ *       are consumed and discarded.
+ */
+int gpiod_line_request_handshake(struct gpiod_line_request *request,
+				 size_t num_values,
+				 const unsigned int *offsets,
+				 const enum gpiod_line_value *values,
+				 struct gpiod_line_request *response_request,
+				 unsigned int response_offset,
+				 enum gpiod_line_response response,
+				 int64_t timeout_ns,
+				 struct gpiod_edge_event_buffer *buffer,
+				 uint64_t *turnaround_ns);
+
+/**
+ * @brief Ways in which line values can be matched against a pattern.
+ */
+enum gpiod_line_match {
+	GPIOD_LINE_MATCH_ALL = 1,
+	/**< All lines in the mask must have the expected values. */
+	GPIOD_LINE_MATCH_ANY,
+	/**< At least one line in the mask must have its expected value. */
+};
+
+/**
+ * @brief Wait until the values of requested lines match a pattern.
+ * @param request GPIO line request.
+ * @param mask Bitmap of the lines to check. Bit N corresponds to the line at
+ *             index N in the array filled by
+ *             ::gpiod_line_request_get_requested_offsets.
+ * @param bits Bitmap of the expected values of the lines selected by
+ *             \p mask, laid out the same way.
+ * @param match Whether all or any of the masked lines must match.
+ * @param timeout_ns Wait time limit in nanoseconds. If set to 0, the edge
+ *                   events queued before the call are discarded and only
+ *                   the current values are checked. If set to a negative
+ *                   number, the function blocks indefinitely until the
+ *                   values match.
+ * @param buffer Optional edge event buffer. If not NULL, it receives the edge
+ *               event that satisfied the condition or no events if the
+ *               condition was already met when the function was called.
+ * @return 1 if the condition has been met, 0 if the wait timed out and -1 on
+ *         error.
+ *
+ * The current values are read once and the wait is then driven entirely by
+ * edge events, so all masked lines must have edge detection enabled for both
+ * edges. This replaces sleep-and-poll loops around
+ * ::gpiod_line_request_get_value.
+ *
+ * @note Edge events queued before the call are discarded without being
+ *       checked against the pattern, as they predate the snapshot of the
+ *       current values. Those read while waiting are consumed.
+ */
+int gpiod_line_request_wait_value(struct gpiod_line_request *request,
+				  uint64_t mask, uint64_t bits,
+				  enum gpiod_line_match match,
+				  int64_t timeout_ns,
+				  struct gpiod_edge_event_buffer *buffer);
+
+/**
+ * @brief Generate one or more pulses on a subset of requested lines.
+ * @param request GPIO line request.
+ * @param num_lines Number of lines to pulse.
+ * @param offsets Array of offsets identifying the requested output lines to
+ *                pulse.
+ * @param value Value of the lines during the pulse. The lines are set to the
+ *              opposite value at the end of each pulse.
+ * @param width_ns Pulse width in nanoseconds.
+ * @param spin_ns Length of the busy-wait performed at the end of each wait,
+ *                in nanoseconds. The wait is performed as an absolute-time
+ *                sleep until \p spin_ns before the deadline followed by
+ *                spinning on the clock. Larger values reduce jitter at the
+ *                cost of CPU time. 0 disables spinning.
+ * @param count Number of pulses to generate. Must be at least 1.
+ * @param period_ns Interval between the starts of consecutive pulses in
+ *                  nanoseconds. Must be larger than \p width_ns if
+ *                  \p count is larger than 1, ignored otherwise.
+ * @param widths_ns Optional array of at least \p count entries in which the
+ *                  achieved width of each pulse is stored. The width is
+ *                  estimated from the monotonic clock readings taken around
+ *                  the set ioctls.
+ * @return 0 on success, -1 on failure.
+ *
+ * All pulses are scheduled relative to the moment of the call so that the
+ * timing errors of one pulse do not accumulate over the following ones.
+ */
+int gpiod_line_request_pulse(struct gpiod_line_request *request,
+			     size_t num_lines, const unsigned int *offsets,
+			     enum gpiod_line_value value, uint64_t width_ns,
+			     uint64_t spin_ns, unsigned int count,
+			     uint64_t period_ns, uint64_t *widths_ns);
+
+/**
+ * @}
+ *
+ * @defgroup edge_event Line edge events handling
+ * @{
+ *
+ * Functions and data types for handling edge events.
+ *
+ * An edge event object contains information about a single line edge event.
  * It contains the event type, timestamp and the offset of the line on which
  * the event occurred as well as two sequence numbers (global for all lines
  * in the associated request and local for this line only).
@@ -1274,6 +2014,38 @@ unsigned long gpiod_edge_event_get_global_seqno(struct gpiod_edge_event *event);
  */
 unsigned long gpiod_edge_event_get_line_seqno(struct gpiod_edge_event *event);
 
+/**
+ * @brief Plain copy of the contents of an edge event object.
+ *
+ * New fields are only ever appended at the end of the structure. Users pass
+ * the size of the structure as they know it to the export functions which
+ * fill in all the fields both sides know about and zero the rest.
+ */
+struct gpiod_edge_event_data {
+	enum gpiod_edge_event_type event_type;
+	/**< Type of the event. */
+	unsigned int line_offset;
+	/**< Offset of the line which triggered the event. */
+	uint64_t timestamp_ns;
+	/**< Timestamp of the event in nanoseconds. */
+	unsigned long global_seqno;
+	/**< Sequence number of the event across all lines of the request. */
+	unsigned long line_seqno;
+	/**< Sequence number of the event for this line only. */
+};
+
+/**
+ * @brief Copy the contents of an edge event object into a plain structure.
+ * @param event GPIO edge event.
+ * @param data Structure to fill.
+ * @param size Size of the structure as known to the caller. Should be
+ *             sizeof(struct gpiod_edge_event_data).
+ * @return 0 on success, -1 on failure. Fails with EINVAL if size is smaller
+ *         than the first version of the structure.
+ */
+int gpiod_edge_event_export(struct gpiod_edge_event *event,
+			    struct gpiod_edge_event_data *data, size_t size);
+
 /**
  * @brief Create a new edge event buffer.
  * @param capacity Number of events the buffer can store (min = 1, max = 1024).
@@ -1330,6 +2102,1685 @@ gpiod_edge_event_buffer_get_event(struct gpiod_edge_event_buffer *buffer,
 size_t
 gpiod_edge_event_buffer_get_num_events(struct gpiod_edge_event_buffer *buffer);
 
+/**
+ * @brief Copy the events stored in the buffer into an array of plain
+ *        structures.
+ * @param buffer Edge event buffer.
+ * @param data Array to fill.
+ * @param size Size of a single array element as known to the caller. Should
+ *             be sizeof(struct gpiod_edge_event_data).
+ * @param max_events Maximum number of events to export.
+ * @return Number of events exported or -1 on failure. Fails with EINVAL if
+ *         size is smaller than the first version of the structure.
+ *
+ * Events are exported in the order they are stored in the buffer, starting
+ * with the first one.
+ */
+int gpiod_edge_event_buffer_export(struct gpiod_edge_event_buffer *buffer,
+				   struct gpiod_edge_event_data *data,
+				   size_t size, size_t max_events);
+
+/**
+ * @}
+ *
+ * @defgroup line_bus Parallel line buses
+ * @{
+ *
+ * Functions for reading and writing groups of lines as integer words.
+ *
+ * A line bus maps an ordered list of requested lines onto the bits of an
+ * integer word: the first line added is bit 0, the next one bit 1 and so on,
+ * for up to 64 lines. The lines may be spread over several line requests, in
+ * which case reading or writing the bus takes one ioctl per request.
+ *
+ * The mapping is precomputed as a list of shift-and-mask operations, one for
+ * each run of lines that occupy consecutive bits in both the word and the
+ * request, so converting a word costs next to nothing when the lines are
+ * added in the order they were requested.
+ *
+ * @note The bus only holds references to the line requests. The requests must
+ *       outlive the bus.
+ */
+
+/**
+ * @brief Create a new, empty line bus.
+ * @return New line bus object or NULL if an error occurred. The returned
+ *         object must be freed by the caller using ::gpiod_line_bus_free.
+ */
+struct gpiod_line_bus *gpiod_line_bus_new(void);
+
+/**
+ * @brief Free the line bus object and release all associated resources.
+ * @param bus Line bus to free.
+ */
+void gpiod_line_bus_free(struct gpiod_line_bus *bus);
+
+/**
+ * @brief Append lines to the bus.
+ * @param bus Line bus object.
+ * @param request Line request the lines belong to.
+ * @param num_lines Number of lines to append.
+ * @param offsets Offsets of the lines. The first one becomes the lowest of
+ *                the new bits of the bus word.
+ * @return 0 on success, -1 on failure.
+ *
+ * Fails with EINVAL if any of the lines is not part of the request, is
+ * already on the bus or if the bus would grow wider than 64 bits. The bus is
+ * not modified on failure.
+ */
+int gpiod_line_bus_add_lines(struct gpiod_line_bus *bus,
+			     struct gpiod_line_request *request,
+			     size_t num_lines, const unsigned int *offsets);
+
+/**
+ * @brief Get the number of lines on the bus.
+ * @param bus Line bus object.
+ * @return Width of the bus in bits.
+ */
+size_t gpiod_line_bus_get_width(struct gpiod_line_bus *bus);
+
+/**
+ * @brief Set the values of all lines on the bus.
+ * @param bus Line bus object.
+ * @param word Value to write. Bit N is the value of the N-th line of the bus,
+ *             1 meaning active. Bits beyond the width of the bus are ignored.
+ * @return 0 on success, -1 on failure.
+ *
+ * All lines must be requested as outputs. The lines of each request are set
+ * atomically, but requests are updated one after another.
+ */
+int gpiod_line_bus_write(struct gpiod_line_bus *bus, uint64_t word);
+
+/**
+ * @brief Read the values of all lines on the bus.
+ * @param bus Line bus object.
+ * @param word Buffer in which the value is stored. Bit N is the value of the
+ *             N-th line of the bus, 1 meaning active.
+ * @return 0 on success, -1 on failure.
+ */
+int gpiod_line_bus_read(struct gpiod_line_bus *bus, uint64_t *word);
+
+/**
+ * @}
+ *
+ * @defgroup line_program Line operation programs
+ * @{
+ *
+ * Functions for running precompiled sequences of line operations.
+ *
+ * A line program is a list of operations - setting and reading lines,
+ * sleeping, waiting for edges and looping - built once and then run in its
+ * entirety by a single library call. This is meant for bit-banging custom
+ * protocols, especially from the language bindings, where the per-call
+ * overhead would otherwise dominate.
+ *
+ * Line values are specified as bitmaps in which bit N corresponds to the
+ * N-th line as returned by ::gpiod_line_request_get_requested_offsets. The
+ * operations may act on any number of line requests.
+ *
+ * Reads and edge waits store one value each in the results array, in the
+ * order in which they are executed.
+ *
+ * @note The program only holds references to the line requests. The
+ *       requests must outlive the program.
+ */
+
+/**
+ * @brief Create a new, empty line program.
+ * @return New program object or NULL if an error occurred. The returned
+ *         object must be freed by the caller using ::gpiod_line_program_free.
+ */
+struct gpiod_line_program *gpiod_line_program_new(void);
+
+/**
+ * @brief Free the program object and release all associated resources.
+ * @param program Program to free.
+ */
+void gpiod_line_program_free(struct gpiod_line_program *program);
+
+/**
+ * @brief Append an operation setting the values of requested lines.
+ * @param program Program object.
+ * @param request Line request the lines belong to.
+ * @param mask Bitmap of the lines to set.
+ * @param bits Bitmap of the values to set, 1 meaning active.
+ * @return 0 on success, -1 on failure.
+ */
+int gpiod_line_program_add_set(struct gpiod_line_program *program,
+			       struct gpiod_line_request *request,
+			       uint64_t mask, uint64_t bits);
+
+/**
+ * @brief Append an operation reading the values of requested lines.
+ * @param program Program object.
+ * @param request Line request the lines belong to.
+ * @param mask Bitmap of the lines to read.
+ * @return 0 on success, -1 on failure. Fails with EOVERFLOW if a run of the
+ *         program would produce more than INT_MAX results.
+ *
+ * When run, the operation stores the bitmap of the values of the masked
+ * lines in the next slot of the results array.
+ */
+int gpiod_line_program_add_get(struct gpiod_line_program *program,
+			       struct gpiod_line_request *request,
+			       uint64_t mask);
+
+/**
+ * @brief Append an operation sleeping until a point in time.
+ * @param program Program object.
+ * @param offset_ns Wake-up time in nanoseconds, relative to the start of the
+ *                  current iteration of the innermost loop or to the start of
+ *                  the program if not inside a loop.
+ * @return 0 on success, -1 on failure.
+ *
+ * The next iteration of a loop starts at the deadline of the last sleep of
+ * the previous iteration, if any, so that periodic loops don't accumulate
+ * wake-up latency.
+ */
+int gpiod_line_program_add_sleep_until(struct gpiod_line_program *program,
+				       uint64_t offset_ns);
+
+/**
+ * @brief Append an operation waiting for an edge event.
+ * @param program Program object.
+ * @param request Line request the lines belong to. The lines must have edge
+ *                detection enabled.
+ * @param mask Bitmap of the lines to watch.
+ * @param edge Type of the edge to wait for.
+ * @param timeout_ns Wait time limit in nanoseconds. If set to 0, the function
+ *                   returns immediately. If set to a negative number, the
+ *                   function blocks indefinitely until an event becomes
+ *                   available.
+ * @return 0 on success, -1 on failure. Fails with EOVERFLOW if a run of the
+ *         program would produce more than INT_MAX results.
+ *
+ * When run, events on other lines or with other edges are consumed and
+ * discarded. The timestamp of the matching event is stored in the next slot
+ * of the results array. If the wait times out, the program is aborted with
+ * errno set to ETIMEDOUT.
+ */
+int gpiod_line_program_add_wait_edge(struct gpiod_line_program *program,
+				     struct gpiod_line_request *request,
+				     uint64_t mask, enum gpiod_line_edge edge,
+				     int64_t timeout_ns);
+
+/**
+ * @brief Start a loop.
+ * @param program Program object.
+ * @param count Number of iterations. Must be at least 1.
+ * @return 0 on success, -1 on failure. Fails with EOVERFLOW if the total
+ *         number of iterations of the operations inside the loop would
+ *         exceed INT_MAX.
+ *
+ * All operations added until the matching ::gpiod_line_program_end_loop are
+ * repeated \p count times. Loops can be nested up to 8 levels deep.
+ */
+int gpiod_line_program_begin_loop(struct gpiod_line_program *program,
+				  unsigned int count);
+
+/**
+ * @brief End the innermost loop.
+ * @param program Program object.
+ * @return 0 on success, -1 on failure.
+ */
+int gpiod_line_program_end_loop(struct gpiod_line_program *program);
+
+/**
+ * @brief Get the number of results a run of the program produces.
+ * @param program Program object.
+ * @return Number of slots the results array passed to
+ *         ::gpiod_line_program_run must have.
+ */
+size_t gpiod_line_program_get_num_results(struct gpiod_line_program *program);
+
+/**
+ * @brief Run the program.
+ * @param program Program object.
+ * @param results Array in which the results are stored. May be NULL if the
+ *                program produces no results.
+ * @param max_results Size of the results array. Must be at least the value
+ *                    returned by ::gpiod_line_program_get_num_results.
+ * @return Number of results stored on success, -1 on failure.
+ *
+ * Fails with EINVAL without running anything if a loop is left open or the
+ * results array is too small. If an operation fails, the program is aborted
+ * and the lines are left in whatever state the preceding operations put
+ * them in.
+ */
+int gpiod_line_program_run(struct gpiod_line_program *program,
+			   uint64_t *results, size_t max_results);
+
+/**
+ * @}
+ *
+ * @defgroup line_pwm Software PWM
+ * @{
+ *
+ * Functions for generating pulse-width modulated signals on requested
+ * output lines.
+ *
+ * A PWM engine drives any number of channels, each being a single output
+ * line of a line request with its own period and duty cycle. All channels
+ * are serviced by a single timer thread. Edges of all channels that are due
+ * at the same time are merged into one set-values operation per request, so
+ * channels sharing a period and a request cost the same as a single one.
+ *
+ * The period and the duty cycle of a channel can be changed while the engine
+ * is running. The new values take effect at the start of the next period of
+ * that channel.
+ *
+ * @note The engine only holds references to the line requests it drives.
+ *       The requests must not be released while the engine is running.
+ */
+
+/**
+ * @brief Create a new software PWM engine.
+ * @return New PWM engine object or NULL if an error occurred. The returned
+ *         object must be freed by the caller using ::gpiod_pwm_free.
+ */
+struct gpiod_pwm *gpiod_pwm_new(void);
+
+/**
+ * @brief Free the PWM engine and release all associated resources.
+ * @param pwm PWM engine to free.
+ *
+ * The engine is stopped first if it is running.
+ */
+void gpiod_pwm_free(struct gpiod_pwm *pwm);
+
+/**
+ * @brief Add a channel to the PWM engine.
+ * @param pwm PWM engine.
+ * @param request Line request the channel's line belongs to. The line must
+ *                be requested as output.
+ * @param offset Offset of the line driven by the channel.
+ * @param period_ns Period of the signal in nanoseconds. Must be between 1 and
+ *                  UINT32_MAX.
+ * @param duty_ns Time the line is active during each period in nanoseconds.
+ *                Must not be larger than \p period_ns.
+ * @return Index of the new channel on success, -1 on failure.
+ *
+ * Channels can only be added while the engine is stopped. Each line can only
+ * be driven by one channel.
+ */
+int gpiod_pwm_add_channel(struct gpiod_pwm *pwm,
+			  struct gpiod_line_request *request,
+			  unsigned int offset, uint64_t period_ns,
+			  uint64_t duty_ns);
+
+/**
+ * @brief Get the number of channels of the PWM engine.
+ * @param pwm PWM engine.
+ * @return Number of channels added to the engine.
+ */
+size_t gpiod_pwm_get_num_channels(struct gpiod_pwm *pwm);
+
+/**
+ * @brief Update the period and the duty cycle of a channel.
+ * @param pwm PWM engine.
+ * @param channel Index of the channel.
+ * @param period_ns New period in nanoseconds.
+ * @param duty_ns New duty cycle in nanoseconds.
+ * @return 0 on success, -1 on failure.
+ *
+ * This function doesn't take any locks and may be called at any time,
+ * including while the engine is running.
+ */
+int gpiod_pwm_set_channel(struct gpiod_pwm *pwm, unsigned int channel,
+			  uint64_t period_ns, uint64_t duty_ns);
+
+/**
+ * @brief Set the busy-wait budget of the timer thread.
+ * @param pwm PWM engine.
+ * @param spin_ns Length of the busy-wait performed before each edge in
+ *                nanoseconds. The timer thread sleeps until \p spin_ns before
+ *                the edge and spins on the clock for the remainder. Larger
+ *                values reduce jitter at the cost of CPU time. Defaults to 0.
+ *
+ * Only takes effect when the engine is next started.
+ */
+void gpiod_pwm_set_spin(struct gpiod_pwm *pwm, uint64_t spin_ns);
+
+/**
+ * @brief Start generating the signals.
+ * @param pwm PWM engine.
+ * @return 0 on success, -1 on failure.
+ *
+ * Spawns the timer thread. All channels start their first period at the
+ * same time. Statistics are reset.
+ */
+int gpiod_pwm_start(struct gpiod_pwm *pwm);
+
+/**
+ * @brief Stop generating the signals.
+ * @param pwm PWM engine.
+ * @return 0 on success, -1 on failure or if the timer thread had stopped
+ *         because of an error, in which case errno is set to the error that
+ *         occurred.
+ *
+ * Joins the timer thread and sets all lines driven by the engine to inactive.
+ */
+int gpiod_pwm_stop(struct gpiod_pwm *pwm);
+
+/**
+ * @brief Check whether the timer thread has stopped because of an error.
+ * @param pwm PWM engine.
+ * @return 0 if no error occurred since the engine was last started,
+ *         otherwise the errno value of the error that stopped the timer
+ *         thread.
+ *
+ * May be called at any time, including while the engine is running, to
+ * detect failures without stopping the engine. The engine still needs to be
+ * stopped with ::gpiod_pwm_stop after an error.
+ */
+int gpiod_pwm_get_error(struct gpiod_pwm *pwm);
+
+/**
+ * @brief Get the statistics of a channel.
+ * @param pwm PWM engine.
+ * @param channel Index of the channel.
+ * @param frequency Optional pointer in which the achieved frequency in Hz,
+ *                  averaged since the engine was started, is stored.
+ * @param jitter_ns Optional pointer in which the mean jitter in nanoseconds
+ *                  is stored.
+ * @param max_jitter_ns Optional pointer in which the largest observed jitter
+ *                      in nanoseconds is stored.
+ * @return 0 on success, -1 on failure.
+ *
+ * Jitter is the absolute difference between the measured interval separating
+ * two consecutive period starts and the nominal period. The start of a period
+ * is timestamped with the midpoint of the clock readings taken around the
+ * set-values operation. All values are 0 until the channel has completed its
+ * first period.
+ *
+ * May be called at any time, including while the engine is running.
+ */
+int gpiod_pwm_get_stats(struct gpiod_pwm *pwm, unsigned int channel,
+			double *frequency, uint64_t *jitter_ns,
+			uint64_t *max_jitter_ns);
+
+/**
+ * @}
+ *
+ * @defgroup bitbang Bit-banged serial bus
+ * @{
+ *
+ * Functions for clocking data in and out of SPI peripherals and shift
+ * register chains using requested lines.
+ *
+ * A bit-bang bus drives a clock line and optionally a data-out, a data-in
+ * and a chip-select line, all of which must belong to the same line request.
+ * The output values for every clock phase of every possible byte are
+ * precomputed when the bus is configured, so a transfer boils down to one
+ * set-values ioctl per clock phase, plus one get-values ioctl per bit if
+ * data is being read.
+ *
+ * The chip-select line is driven active for the duration of a transfer.
+ * Lines that are physically active-low (as is the case for most chip-select
+ * inputs) should be requested with the active-low setting.
+ */
+
+/**
+ * @brief SPI clock modes.
+ *
+ * Bit 1 of the mode is the clock polarity (CPOL) and bit 0 the clock phase
+ * (CPHA), as is customary.
+ */
+enum gpiod_bitbang_mode {
+	GPIOD_BITBANG_MODE_0 = 0,
+	/**< Clock idles inactive, data sampled on the rising edge. */
+	GPIOD_BITBANG_MODE_1,
+	/**< Clock idles inactive, data sampled on the falling edge. */
+	GPIOD_BITBANG_MODE_2,
+	/**< Clock idles active, data sampled on the falling edge. */
+	GPIOD_BITBANG_MODE_3,
+	/**< Clock idles active, data sampled on the rising edge. */
+};
+
+/**
+ * @brief Order in which the bits of each byte are shifted.
+ */
+enum gpiod_bitbang_bit_order {
+	GPIOD_BITBANG_BIT_ORDER_MSB_FIRST = 1,
+	/**< Most significant bit first. */
+	GPIOD_BITBANG_BIT_ORDER_LSB_FIRST,
+	/**< Least significant bit first. */
+};
+
+/**
+ * @brief Create a new bit-banged serial bus.
+ * @param request Line request the bus lines belong to.
+ * @param clock_offset Offset of the clock line. The line must be requested
+ *                     as output.
+ * @return New bus object or NULL if an error occurred. The returned object
+ *         must be freed by the caller using ::gpiod_bitbang_free.
+ *
+ * The bus defaults to mode 0, MSB first and no delay between clock phases.
+ */
+struct gpiod_bitbang *gpiod_bitbang_new(struct gpiod_line_request *request,
+					unsigned int clock_offset);
+
+/**
+ * @brief Free the bus object and release all associated resources.
+ * @param bb Bus to free.
+ */
+void gpiod_bitbang_free(struct gpiod_bitbang *bb);
+
+/**
+ * @brief Set the data output (MOSI) line of the bus.
+ * @param bb Bus object.
+ * @param offset Offset of the line. The line must be requested as output.
+ * @return 0 on success, -1 on failure.
+ */
+int gpiod_bitbang_set_data_out(struct gpiod_bitbang *bb, unsigned int offset);
+
+/**
+ * @brief Set the data input (MISO) line of the bus.
+ * @param bb Bus object.
+ * @param offset Offset of the line. The line must be requested as input.
+ * @return 0 on success, -1 on failure.
+ */
+int gpiod_bitbang_set_data_in(struct gpiod_bitbang *bb, unsigned int offset);
+
+/**
+ * @brief Set the chip-select line of the bus.
+ * @param bb Bus object.
+ * @param offset Offset of the line. The line must be requested as output.
+ * @return 0 on success, -1 on failure.
+ *
+ * For shift registers such as the 74HC595 the storage register clock can be
+ * used as the chip-select line, requested as active-low, so that the data
+ * is latched at the end of each transfer.
+ */
+int gpiod_bitbang_set_chip_select(struct gpiod_bitbang *bb,
+				  unsigned int offset);
+
+/**
+ * @brief Set the clock mode of the bus.
+ * @param bb Bus object.
+ * @param mode Clock mode.
+ * @return 0 on success, -1 on failure.
+ */
+int gpiod_bitbang_set_mode(struct gpiod_bitbang *bb,
+			   enum gpiod_bitbang_mode mode);
+
+/**
+ * @brief Set the bit order of the bus.
+ * @param bb Bus object.
+ * @param order Bit order.
+ * @return 0 on success, -1 on failure.
+ */
+int gpiod_bitbang_set_bit_order(struct gpiod_bitbang *bb,
+				enum gpiod_bitbang_bit_order order);
+
+/**
+ * @brief Set the minimum duration of each clock phase.
+ * @param bb Bus object.
+ * @param half_period_ns Half of the clock period in nanoseconds. 0, which is
+ *                       the default, clocks the data as fast as the ioctls
+ *                       allow.
+ *
+ * The phases are timed by busy-waiting on the monotonic clock.
+ */
+void gpiod_bitbang_set_half_period(struct gpiod_bitbang *bb,
+				   uint64_t half_period_ns);
+
+/**
+ * @brief Perform a full-duplex transfer.
+ * @param bb Bus object.
+ * @param tx Bytes to shift out or NULL to shift out zeroes.
+ * @param rx Buffer for the bytes shifted in or NULL if the input should be
+ *           ignored. Requires the data input line to be set.
+ * @param len Number of bytes to transfer.
+ * @return 0 on success, -1 on failure.
+ */
+int gpiod_bitbang_transfer(struct gpiod_bitbang *bb, const uint8_t *tx,
+			   uint8_t *rx, size_t len);
+
+/**
+ * @}
+ *
+ * @defgroup reflex Reflex rules
+ * @{
+ *
+ * Functions for reacting to input edges by driving output lines without
+ * going through the application.
+ *
+ * A reflex engine evaluates a set of rules, each of which ties an edge on a
+ * single line of a trigger request to a set-values operation on a target
+ * request, optionally carried out after a fixed delay. The rules are
+ * evaluated on a dedicated thread that sleeps on the file descriptors of
+ * all trigger requests and which can be given a real-time scheduling
+ * priority. Actions of all rules fired by the same batch of events are
+ * merged into one set-values operation per target request.
+ *
+ * The engine measures the reaction latency of every action as the time
+ * elapsed between the timestamp of the triggering event and the completion
+ * of the set-values operation for immediate actions and as the time elapsed
+ * between the scheduled and the actual completion time for delayed ones.
+ * The former assumes that the trigger lines use the monotonic event clock.
+ *
+ * @note The engine only holds references to the line requests it uses.
+ *       The requests must not be released while the engine is running and
+ *       no other edge events must be read from the trigger requests in the
+ *       meantime.
+ */
+
+/**
+ * @brief Create a new reflex engine.
+ * @return New reflex engine object or NULL if an error occurred. The
+ *         returned object must be freed by the caller using
+ *         ::gpiod_reflex_free.
+ */
+struct gpiod_reflex *gpiod_reflex_new(void);
+
+/**
+ * @brief Free the reflex engine and release all associated resources.
+ * @param reflex Reflex engine to free.
+ *
+ * The engine is stopped first if it is running.
+ */
+void gpiod_reflex_free(struct gpiod_reflex *reflex);
+
+/**
+ * @brief Add a rule to the reflex engine.
+ * @param reflex Reflex engine.
+ * @param trigger Line request the trigger line belongs to. Edge detection
+ *                must be enabled on the trigger line.
+ * @param offset Offset of the trigger line.
+ * @param edge Edge of the trigger line firing the rule. Must not be
+ *             ::GPIOD_LINE_EDGE_NONE.
+ * @param target Line request to drive when the rule fires. The lines must
+ *               be requested as output.
+ * @param mask Bitmap of the lines of the target request to set, where bit N
+ *             corresponds to the N-th requested line.
+ * @param bits Values to set. Bits not in \p mask are ignored.
+ * @param delay_ns Time between the edge and the action in nanoseconds. 0
+ *                 means the action is carried out immediately. The delay
+ *                 is counted on the monotonic clock from the moment the
+ *                 engine reads the event, not from the event timestamp,
+ *                 so it works with any event clock of the trigger.
+ * @return Index of the new rule on success, -1 on failure.
+ *
+ * Rules can only be added while the engine is stopped. If several rules
+ * fired at the same time drive the same line, the one added last wins.
+ */
+int gpiod_reflex_add_rule(struct gpiod_reflex *reflex,
+			  struct gpiod_line_request *trigger,
+			  unsigned int offset, enum gpiod_line_edge edge,
+			  struct gpiod_line_request *target, uint64_t mask,
+			  uint64_t bits, uint64_t delay_ns);
+
+/**
+ * @brief Get the number of rules of the reflex engine.
+ * @param reflex Reflex engine.
+ * @return Number of rules added to the engine.
+ */
+size_t gpiod_reflex_get_num_rules(struct gpiod_reflex *reflex);
+
+/**
+ * @brief Set the real-time priority of the reflex thread.
+ * @param reflex Reflex engine.
+ * @param priority SCHED_FIFO priority of the thread or 0 to inherit the
+ *                 scheduling policy of the thread starting the engine.
+ * @return 0 on success, -1 on failure.
+ *
+ * Only takes effect when the engine is next started. Starting the engine
+ * fails with EPERM if the process is not allowed to use real-time
+ * scheduling.
+ */
+int gpiod_reflex_set_priority(struct gpiod_reflex *reflex, int priority);
+
+/**
+ * @brief Set the busy-wait budget used for delayed actions.
+ * @param reflex Reflex engine.
+ * @param spin_ns Length of the busy-wait performed before each delayed
+ *                action in nanoseconds. Defaults to 0.
+ *
+ * Only takes effect when the engine is next started.
+ */
+void gpiod_reflex_set_spin(struct gpiod_reflex *reflex, uint64_t spin_ns);
+
+/**
+ * @brief Start evaluating the rules.
+ * @param reflex Reflex engine.
+ * @return 0 on success, -1 on failure.
+ *
+ * Spawns the reflex thread. Statistics are reset.
+ */
+int gpiod_reflex_start(struct gpiod_reflex *reflex);
+
+/**
+ * @brief Stop evaluating the rules.
+ * @param reflex Reflex engine.
+ * @return 0 on success, -1 on failure or if the reflex thread had stopped
+ *         because of an error, in which case errno is set to the error that
+ *         occurred.
+ *
+ * Joins the reflex thread. Delayed actions that haven't been carried out
+ * yet are discarded. The output lines are left as they are.
+ */
+int gpiod_reflex_stop(struct gpiod_reflex *reflex);
+
+/**
+ * @brief Get the statistics of a rule.
+ * @param reflex Reflex engine.
+ * @param rule Index of the rule.
+ * @param num_triggers Optional pointer in which the number of times the
+ *                     rule's action has been carried out is stored.
+ * @param last_latency_ns Optional pointer in which the reaction latency of
+ *                        the most recent action in nanoseconds is stored.
+ * @param avg_latency_ns Optional pointer in which the mean reaction latency
+ *                       in nanoseconds is stored.
+ * @param max_latency_ns Optional pointer in which the largest observed
+ *                       reaction latency in nanoseconds is stored.
+ * @return 0 on success, -1 on failure.
+ *
+ * May be called at any time, including while the engine is running.
+ */
+int gpiod_reflex_get_stats(struct gpiod_reflex *reflex, unsigned int rule,
+			   uint64_t *num_triggers, uint64_t *last_latency_ns,
+			   uint64_t *avg_latency_ns, uint64_t *max_latency_ns);
+
+/**
+ * @}
+ *
+ * @defgroup quadrature Quadrature decoder
+ * @{
+ *
+ * Functions for decoding the signals of incremental rotary encoders.
+ *
+ * A quadrature decoder tracks any number of encoders, each connected to two
+ * input lines (channels A and B) with edge detection enabled on both edges.
+ * Edge events are consumed straight from an edge event buffer and every
+ * edge is decoded with a single lookup in a state transition table, which
+ * counts four steps per encoder cycle. The position increases when channel
+ * A leads channel B.
+ *
+ * Edges that can't be explained by a single step, for instance because an
+ * event was lost after the kernel event buffer overflowed, are counted as
+ * errors and don't change the position.
+ *
+ * The velocity is measured in steps per second over consecutive windows of
+ * event timestamps and is only updated as new steps are decoded. It is not
+ * decayed when the encoder stops turning.
+ *
+ * @note Events are matched to encoders by line offsets only. All events fed
+ *       to a decoder should come from the same line request.
+ */
+
+/**
+ * @brief Create a new quadrature decoder.
+ * @return New decoder object or NULL if an error occurred. The returned
+ *         object must be freed by the caller using ::gpiod_quadrature_free.
+ */
+struct gpiod_quadrature *gpiod_quadrature_new(void);
+
+/**
+ * @brief Free the quadrature decoder and release all associated resources.
+ * @param quad Decoder to free.
+ */
+void gpiod_quadrature_free(struct gpiod_quadrature *quad);
+
+/**
+ * @brief Add an encoder to the quadrature decoder.
+ * @param quad Quadrature decoder.
+ * @param offset_a Offset of the line connected to channel A.
+ * @param offset_b Offset of the line connected to channel B.
+ * @return Index of the new encoder on success, -1 on failure.
+ *
+ * Each line can only be used by a single encoder. Until the decoder is
+ * synchronized with ::gpiod_quadrature_sync, the levels of the channels are
+ * learned from their first edges, which are not counted.
+ */
+int gpiod_quadrature_add_encoder(struct gpiod_quadrature *quad,
+				 unsigned int offset_a, unsigned int offset_b);
+
+/**
+ * @brief Get the number of encoders tracked by the quadrature decoder.
+ * @param quad Quadrature decoder.
+ * @return Number of encoders added to the decoder.
+ */
+size_t gpiod_quadrature_get_num_encoders(struct gpiod_quadrature *quad);
+
+/**
+ * @brief Set the length of the velocity measurement window.
+ * @param quad Quadrature decoder.
+ * @param window_ns Minimum time span of the steps over which the velocity
+ *                  is measured in nanoseconds. 0 restores the default of
+ *                  10 milliseconds.
+ */
+void gpiod_quadrature_set_velocity_window(struct gpiod_quadrature *quad,
+					  uint64_t window_ns);
+
+/**
+ * @brief Synchronize the decoder with the current levels of the lines.
+ * @param quad Quadrature decoder.
+ * @param request Line request the encoder lines belong to.
+ * @return Number of synchronized encoders on success, -1 on failure.
+ *
+ * Reads the values of the lines of all encoders whose both channels belong
+ * to the request. Encoders using other lines are left alone. Should be
+ * called after requesting the lines and before reading any edge events.
+ */
+int gpiod_quadrature_sync(struct gpiod_quadrature *quad,
+			  struct gpiod_line_request *request);
+
+/**
+ * @brief Decode all edge events stored in a buffer.
+ * @param quad Quadrature decoder.
+ * @param buffer Edge event buffer filled by
+ *               ::gpiod_line_request_read_edge_events.
+ * @return Number of events that belonged to one of the encoders.
+ *
+ * Events on lines not used by any of the encoders are ignored.
+ */
+size_t gpiod_quadrature_process(struct gpiod_quadrature *quad,
+				struct gpiod_edge_event_buffer *buffer);
+
+/**
+ * @brief Get the state of an encoder.
+ * @param quad Quadrature decoder.
+ * @param encoder Index of the encoder.
+ * @param position Optional pointer in which the position of the encoder in
+ *                 steps is stored.
+ * @param velocity Optional pointer in which the velocity of the encoder in
+ *                 steps per second is stored.
+ * @param num_errors Optional pointer in which the number of invalid
+ *                   transitions is stored.
+ * @return 0 on success, -1 on failure.
+ */
+int gpiod_quadrature_get_state(struct gpiod_quadrature *quad,
+			       unsigned int encoder, int64_t *position,
+			       double *velocity, uint64_t *num_errors);
+
+/**
+ * @brief Reset the state of an encoder.
+ * @param quad Quadrature decoder.
+ * @param encoder Index of the encoder.
+ * @param position New position of the encoder.
+ * @return 0 on success, -1 on failure.
+ *
+ * Sets the position, clears the error count and restarts the velocity
+ * measurement.
+ */
+int gpiod_quadrature_reset(struct gpiod_quadrature *quad,
+			   unsigned int encoder, int64_t position);
+
+/**
+ * @}
+ *
+ * @defgroup edge_decoder Edge stream decoders
+ * @{
+ *
+ * Functions for decoding serial protocols from the timestamps of edge
+ * events.
+ *
+ * An edge stream decoder consumes whole edge event buffers and turns the
+ * edges seen on its lines into frames of up to 64 bits, which are queued in
+ * the decoder until popped by the user. Each decoder implements a single
+ * protocol and only looks at the events of its own lines, so several
+ * decoders can be fed from the same buffer.
+ *
+ * Protocols in which the end of a frame isn't marked by an edge need to be
+ * told how much time has passed since the last event with
+ * ::gpiod_edge_decoder_flush. The time must be read from the clock used for
+ * the event timestamps of the lines.
+ *
+ * All decoders work on logical line values and expect the lines to idle
+ * high (active).
+ */
+
+/**
+ * @brief Parity settings of the UART decoder.
+ */
+enum gpiod_edge_decoder_parity {
+	GPIOD_EDGE_DECODER_PARITY_NONE = 1,
+	/**< No parity bit. */
+	GPIOD_EDGE_DECODER_PARITY_EVEN,
+	/**< Even parity. */
+	GPIOD_EDGE_DECODER_PARITY_ODD,
+	/**< Odd parity. */
+};
+
+/**
+ * @brief Error flags of decoded frames.
+ */
+enum gpiod_edge_decoder_frame_flags {
+	GPIOD_EDGE_DECODER_FRAME_PARITY_ERROR = 1 << 0,
+	/**< The parity of the frame doesn't match. */
+	GPIOD_EDGE_DECODER_FRAME_FRAMING_ERROR = 1 << 1,
+	/**< A stop bit was low. */
+};
+
+/**
+ * @brief Create a new UART receiver.
+ * @param offset Offset of the RX line.
+ * @param baud_rate Bit rate of the link.
+ * @param data_bits Number of data bits in a frame (5 - 9).
+ * @param parity Parity of the frames.
+ * @param stop_bits Number of stop bits in a frame (1 or 2).
+ * @return New decoder object or NULL if an error occurred. The returned
+ *         object must be freed by the caller using ::gpiod_edge_decoder_free.
+ *
+ * Every frame is reconstructed by sampling the line level in the middle of
+ * each bit period measured from the falling edge of the start bit. The
+ * frame data contains the data bits, least significant bit first on the
+ * wire. The timestamp of the frame is the one of its start bit. As the
+ * stop bits of the last frame of a transmission produce no edges, that
+ * frame is only completed by ::gpiod_edge_decoder_flush.
+ */
+struct gpiod_edge_decoder *
+gpiod_edge_decoder_new_uart(unsigned int offset, unsigned int baud_rate,
+			    unsigned int data_bits,
+			    enum gpiod_edge_decoder_parity parity,
+			    unsigned int stop_bits);
+
+/**
+ * @brief Create a new Wiegand receiver.
+ * @param offset_d0 Offset of the DATA0 line.
+ * @param offset_d1 Offset of the DATA1 line.
+ * @param timeout_ns Gap after the last bit ending a frame in nanoseconds.
+ *                   0 selects the default of 25 milliseconds.
+ * @return New decoder object or NULL if an error occurred. The returned
+ *         object must be freed by the caller using ::gpiod_edge_decoder_free.
+ *
+ * A low pulse on DATA0 is a 0 bit and a low pulse on DATA1 is a 1 bit. The
+ * frame data contains the received bits with the first one as the most
+ * significant. Frames of an even length of at least 4 bits are checked
+ * for the standard leading even and trailing odd parity bits, which are
+ * left in the data.
+ */
+struct gpiod_edge_decoder *
+gpiod_edge_decoder_new_wiegand(unsigned int offset_d0, unsigned int offset_d1,
+			       uint64_t timeout_ns);
+
+/**
+ * @brief Free the decoder and release all associated resources.
+ * @param decoder Decoder to free.
+ */
+void gpiod_edge_decoder_free(struct gpiod_edge_decoder *decoder);
+
+/**
+ * @brief Decode all edge events stored in a buffer.
+ * @param decoder Edge stream decoder.
+ * @param buffer Edge event buffer filled by
+ *               ::gpiod_line_request_read_edge_events.
+ * @return Number of frames completed by the events on success, -1 on
+ *         failure.
+ */
+int gpiod_edge_decoder_process(struct gpiod_edge_decoder *decoder,
+			       struct gpiod_edge_event_buffer *buffer);
+
+/**
+ * @brief Advance the time of the decoder without any new edges.
+ * @param decoder Edge stream decoder.
+ * @param timestamp_ns Current time of the event clock in nanoseconds.
+ * @return Number of frames completed on success, -1 on failure.
+ */
+int gpiod_edge_decoder_flush(struct gpiod_edge_decoder *decoder,
+			     uint64_t timestamp_ns);
+
+/**
+ * @brief Get the number of decoded frames waiting to be popped.
+ * @param decoder Edge stream decoder.
+ * @return Number of queued frames.
+ */
+size_t gpiod_edge_decoder_get_num_frames(struct gpiod_edge_decoder *decoder);
+
+/**
+ * @brief Remove the oldest decoded frame from the queue.
+ * @param decoder Edge stream decoder.
+ * @param data Optional pointer in which the frame data is stored.
+ * @param num_bits Optional pointer in which the number of bits of the frame
+ *                 is stored.
+ * @param timestamp_ns Optional pointer in which the timestamp of the first
+ *                     edge of the frame is stored.
+ * @param flags Optional pointer in which the error flags of the frame are
+ *              stored.
+ * @return True if a frame was popped, false if the queue was empty.
+ */
+bool gpiod_edge_decoder_pop_frame(struct gpiod_edge_decoder *decoder,
+				  uint64_t *data, unsigned int *num_bits,
+				  uint64_t *timestamp_ns, unsigned int *flags);
+
+/**
+ * @}
+ *
+ * @defgroup keypad Matrix keypad scanner
+ * @{
+ *
+ * Functions for scanning matrix keypads.
+ *
+ * The scanner drives one row line at a time active, with all other row
+ * lines inactive, and reads all column lines with a single get-values
+ * operation per row. A key is considered down while its column line reads
+ * active with its row driven, so the lines should be configured
+ * accordingly (e.g. active-low open-drain rows and active-low pulled-up
+ * columns). The row and column lines may belong to the same request or to
+ * two separate ones.
+ *
+ * Keys are numbered row by row: the key at row R and column C has the
+ * index R * number_of_columns + C. Up to 64 keys are supported and the
+ * state of all keys is debounced at once: a key changes state after it has
+ * been seen in the new state in a configurable number of consecutive
+ * scans.
+ *
+ * Key state changes are queued as events which can be read from a file
+ * descriptor suitable for polling. Scans can be performed either by the
+ * caller with ::gpiod_keypad_scan or periodically by a dedicated thread.
+ *
+ * @note The row lines are left driven as set by the last scan.
+ */
+
+/**
+ * @brief Create a new keypad scanner.
+ * @param rows_request Line request the row lines belong to. The lines must
+ *                     be requested as outputs.
+ * @param row_offsets Offsets of the row lines.
+ * @param num_rows Number of rows.
+ * @param cols_request Line request the column lines belong to. The lines
+ *                     must be requested as inputs.
+ * @param col_offsets Offsets of the column lines.
+ * @param num_cols Number of columns.
+ * @return New keypad scanner or NULL if an error occurred. The returned
+ *         object must be freed by the caller using ::gpiod_keypad_free.
+ *
+ * The scanner defaults to a scan period of 10 milliseconds, no settle time
+ * and debouncing over 3 scans.
+ */
+struct gpiod_keypad *
+gpiod_keypad_new(struct gpiod_line_request *rows_request,
+		 const unsigned int *row_offsets, size_t num_rows,
+		 struct gpiod_line_request *cols_request,
+		 const unsigned int *col_offsets, size_t num_cols);
+
+/**
+ * @brief Free the keypad scanner and release all associated resources.
+ * @param keypad Keypad scanner to free.
+ *
+ * The scanning thread is stopped first if it is running.
+ */
+void gpiod_keypad_free(struct gpiod_keypad *keypad);
+
+/**
+ * @brief Set the period of the scanning thread.
+ * @param keypad Keypad scanner.
+ * @param period_ns Time between the starts of consecutive scans in
+ *                  nanoseconds. 0 restores the default.
+ */
+void gpiod_keypad_set_scan_period(struct gpiod_keypad *keypad,
+				  uint64_t period_ns);
+
+/**
+ * @brief Set the time to wait between driving a row and reading the columns.
+ * @param keypad Keypad scanner.
+ * @param settle_ns Settle time in nanoseconds.
+ */
+void gpiod_keypad_set_settle_time(struct gpiod_keypad *keypad,
+				  uint64_t settle_ns);
+
+/**
+ * @brief Set the number of scans over which the keys are debounced.
+ * @param keypad Keypad scanner.
+ * @param num_scans Number of consecutive scans a key must be seen in its
+ *                  new state before the change is reported (1 - 8).
+ * @return 0 on success, -1 on failure.
+ */
+int gpiod_keypad_set_debounce(struct gpiod_keypad *keypad,
+			      unsigned int num_scans);
+
+/**
+ * @brief Scan the keypad once.
+ * @param keypad Keypad scanner.
+ * @return 0 on success, -1 on failure.
+ *
+ * Fails with EBUSY if the scanning thread is running.
+ */
+int gpiod_keypad_scan(struct gpiod_keypad *keypad);
+
+/**
+ * @brief Start scanning the keypad periodically.
+ * @param keypad Keypad scanner.
+ * @return 0 on success, -1 on failure.
+ */
+int gpiod_keypad_start(struct gpiod_keypad *keypad);
+
+/**
+ * @brief Stop the scanning thread.
+ * @param keypad Keypad scanner.
+ * @return 0 on success, -1 on failure or if the scanning thread had stopped
+ *         because of an error, in which case errno is set to the error that
+ *         occurred.
+ */
+int gpiod_keypad_stop(struct gpiod_keypad *keypad);
+
+/**
+ * @brief Get the file descriptor on which key events are delivered.
+ * @param keypad Keypad scanner.
+ * @return File descriptor that becomes readable when key events are
+ *         pending. It is owned by the scanner and must not be closed by the
+ *         caller.
+ */
+int gpiod_keypad_get_fd(struct gpiod_keypad *keypad);
+
+/**
+ * @brief Read a single key event.
+ * @param keypad Keypad scanner.
+ * @param key Optional pointer in which the index of the key is stored.
+ * @param pressed Optional pointer in which true is stored if the key went
+ *                down and false if it went up.
+ * @param timestamp_ns Optional pointer in which the time of the scan that
+ *                     detected the change is stored, read from the
+ *                     monotonic clock.
+ * @return 0 on success, -1 on failure.
+ *
+ * Blocks if no events are pending.
+ */
+int gpiod_keypad_read_event(struct gpiod_keypad *keypad, unsigned int *key,
+			    bool *pressed, uint64_t *timestamp_ns);
+
+/**
+ * @brief Get the debounced state of all keys.
+ * @param keypad Keypad scanner.
+ * @return Bitmap in which bit N is set if key N is down.
+ */
+uint64_t gpiod_keypad_get_state(struct gpiod_keypad *keypad);
+
+/**
+ * @brief Get the number of key events that were dropped.
+ * @param keypad Keypad scanner.
+ * @return Number of events that couldn't be queued because too many events
+ *         were pending.
+ */
+uint64_t gpiod_keypad_get_num_dropped(struct gpiod_keypad *keypad);
+
+/**
+ * @}
+ *
+ * @defgroup edge_limiter Edge rate limiting
+ * @{
+ *
+ * Functions for limiting the rate of edge events per line.
+ *
+ * An edge limiter filters edge event buffers read from a line request in
+ * place so that a single misbehaving line can't flood the consumer with
+ * events. Each limited line has its own token bucket: every edge passed
+ * through takes a token, tokens are refilled at the configured rate and
+ * edges arriving when the bucket is empty are removed from the buffer.
+ * The bucket is driven by the event timestamps so the limiting doesn't
+ * depend on when the events are read.
+ *
+ * Suppressed edges are not lost without a trace: the limiter counts them
+ * per line and per edge type together with the type and timestamp of the
+ * last one, so that the consumer can learn the current level of a line
+ * whose edges were dropped.
+ *
+ * A limiter is meant to be used with the buffers of a single line request.
+ */
+
+/**
+ * @brief Create a new edge limiter.
+ * @return New edge limiter or NULL if an error occurred. The returned
+ *         object must be freed by the caller using ::gpiod_edge_limiter_free.
+ *
+ * No line is limited until a limit is set.
+ */
+struct gpiod_edge_limiter *gpiod_edge_limiter_new(void);
+
+/**
+ * @brief Free the edge limiter and release all associated resources.
+ * @param limiter Edge limiter to free.
+ */
+void gpiod_edge_limiter_free(struct gpiod_edge_limiter *limiter);
+
+/**
+ * @brief Limit the rate of edges of a single line.
+ * @param limiter Edge limiter.
+ * @param offset Offset of the line.
+ * @param events_per_sec Sustained number of edges per second let through.
+ * @param burst Number of edges let through back-to-back after the line
+ *              has been quiet.
+ * @return 0 on success, -1 on failure.
+ *
+ * Overrides the default limit for this line.
+ */
+int gpiod_edge_limiter_set_limit(struct gpiod_edge_limiter *limiter,
+				 unsigned int offset, uint64_t events_per_sec,
+				 unsigned int burst);
+
+/**
+ * @brief Limit the rate of edges of every line without a limit of its own.
+ * @param limiter Edge limiter.
+ * @param events_per_sec Sustained number of edges per second let through
+ *                       on each line. 0 removes the default limit.
+ * @param burst Number of edges let through back-to-back after a line
+ *              has been quiet.
+ * @return 0 on success, -1 on failure.
+ */
+int gpiod_edge_limiter_set_default_limit(struct gpiod_edge_limiter *limiter,
+					 uint64_t events_per_sec,
+					 unsigned int burst);
+
+/**
+ * @brief Remove the over-limit edges from a buffer.
+ * @param limiter Edge limiter.
+ * @param buffer Edge event buffer filled by
+ *               ::gpiod_line_request_read_edge_events.
+ * @return Number of events left in the buffer.
+ *
+ * The remaining events keep their order. Event pointers retrieved from the
+ * buffer before the call are no longer valid.
+ */
+int gpiod_edge_limiter_process(struct gpiod_edge_limiter *limiter,
+			       struct gpiod_edge_event_buffer *buffer);
+
+/**
+ * @brief Get the offsets of lines with suppressed edges not yet summarized.
+ * @param limiter Edge limiter.
+ * @param offsets Array to store the offsets in.
+ * @param max_offsets Number of offsets that fit in the array.
+ * @return Number of offsets stored.
+ */
+size_t
+gpiod_edge_limiter_get_suppressed_offsets(struct gpiod_edge_limiter *limiter,
+					  unsigned int *offsets,
+					  size_t max_offsets);
+
+/**
+ * @brief Get and reset the summary of suppressed edges of a line.
+ * @param limiter Edge limiter.
+ * @param offset Offset of the line.
+ * @param num_rising Optional pointer in which the number of rising edges
+ *                   suppressed since the last call is stored.
+ * @param num_falling Optional pointer in which the number of falling edges
+ *                    suppressed since the last call is stored.
+ * @param last_type Optional pointer in which the type of the last
+ *                  suppressed edge is stored.
+ * @param last_timestamp_ns Optional pointer in which the timestamp of the
+ *                          last suppressed edge is stored.
+ * @return 0 on success, -1 on failure.
+ *
+ * The type and timestamp of the last suppressed edge are only meaningful
+ * if any edges were suppressed. Fails with EINVAL if the line isn't
+ * tracked by the limiter.
+ */
+int gpiod_edge_limiter_take_summary(struct gpiod_edge_limiter *limiter,
+				    unsigned int offset, uint64_t *num_rising,
+				    uint64_t *num_falling,
+				    enum gpiod_edge_event_type *last_type,
+				    uint64_t *last_timestamp_ns);
+
+/**
+ * @brief Get the statistics of a line.
+ * @param limiter Edge limiter.
+ * @param offset Offset of the line.
+ * @param num_passed Optional pointer in which the total number of edges
+ *                   let through is stored.
+ * @param num_suppressed Optional pointer in which the total number of
+ *                       suppressed edges is stored.
+ * @param limiting Optional pointer in which true is stored if the last
+ *                 edge of the line was suppressed.
+ * @return 0 on success, -1 on failure.
+ *
+ * Fails with EINVAL if the line isn't tracked by the limiter.
+ */
+int gpiod_edge_limiter_get_stats(struct gpiod_edge_limiter *limiter,
+				 unsigned int offset, uint64_t *num_passed,
+				 uint64_t *num_suppressed, bool *limiting);
+
+/**
+ * @}
+ *
+ * @defgroup line_config_table Precompiled line configs
+ * @{
+ *
+ * Functions for switching a line request between a fixed set of line
+ * configs.
+ *
+ * Protocols that turn lines around, such as bidirectional data buses or
+ * emulated open-drain outputs, keep reconfiguring the same request between
+ * a small number of configs. ::gpiod_line_request_reconfigure_lines
+ * translates the line config into the kernel format on every call. A line
+ * config table does it once when a config is added, after which switching
+ * to it is a single ioctl.
+ *
+ * The table refers to the request it was created for, which must outlive
+ * it. Changing the line configs after adding them to the table doesn't
+ * affect the stored copies.
+ */
+
+/**
+ * @brief Create a new line config table.
+ * @param request Line request the configs will be applied to.
+ * @return New line config table or NULL if an error occurred. The returned
+ *         object must be freed by the caller using
+ *         ::gpiod_line_config_table_free.
+ */
+struct gpiod_line_config_table *
+gpiod_line_config_table_new(struct gpiod_line_request *request);
+
+/**
+ * @brief Free the line config table and release all associated resources.
+ * @param table Line config table to free.
+ */
+void gpiod_line_config_table_free(struct gpiod_line_config_table *table);
+
+/**
+ * @brief Translate a line config and store it in the table.
+ * @param table Line config table.
+ * @param config Line config to store. Must configure exactly the lines of
+ *               the request, in the same order.
+ * @return Index of the stored config on success, -1 on failure.
+ */
+int gpiod_line_config_table_add_config(struct gpiod_line_config_table *table,
+				       struct gpiod_line_config *config);
+
+/**
+ * @brief Get the number of configs stored in the table.
+ * @param table Line config table.
+ * @return Number of stored configs.
+ */
+size_t
+gpiod_line_config_table_get_num_configs(struct gpiod_line_config_table *table);
+
+/**
+ * @brief Reconfigure the lines of the request with a stored config.
+ * @param table Line config table.
+ * @param index Index of the config.
+ * @return 0 on success, -1 on failure.
+ *
+ * Output lines are driven to the values stored with the config.
+ */
+int gpiod_line_config_table_apply(struct gpiod_line_config_table *table,
+				  unsigned int index);
+
+/**
+ * @brief Reconfigure the lines of the request with a stored config and
+ *        new output values.
+ * @param table Line config table.
+ * @param index Index of the config.
+ * @param values Array of values to drive the output lines to, one for each
+ *               requested line in the order in which the lines were
+ *               requested. Values of lines the config doesn't make outputs
+ *               are ignored.
+ * @return 0 on success, -1 on failure.
+ *
+ * The stored config is not modified.
+ */
+int
+gpiod_line_config_table_apply_with_values(struct gpiod_line_config_table *table,
+					  unsigned int index,
+					  const enum gpiod_line_value *values);
+
+/**
+ * @}
+ *
+ * @defgroup output_journal Output change journal
+ * @{
+ *
+ * Functions for recording the values driven onto the lines of a request.
+ *
+ * Once a journal is attached to a line request, every successful call
+ * setting output values of the request stores an entry in the journal.
+ * Each entry holds the time of the call read from the monotonic clock, the
+ * bitmaps of the lines that were set and of the values they were set to,
+ * and a tag chosen by the user. In both bitmaps bit N stands for the N-th
+ * requested line, in the order in which the lines were requested.
+ *
+ * The journal is a fixed-size ring buffer: the oldest entries are
+ * overwritten by new ones. Recording doesn't take any locks, so the
+ * journal may be read while other threads are setting values. Entries are
+ * numbered from 0 in the order in which they were recorded. If concurrent
+ * writers lap the ring, an entry whose slot has already been taken by a
+ * newer one is dropped rather than mixed with it.
+ */
+
+/**
+ * @brief Create a new output journal.
+ * @param num_entries Minimum number of entries the journal holds. Rounded
+ *                    up to the next power of two.
+ * @return New output journal or NULL if an error occurred. The returned
+ *         object must be freed by the caller using
+ *         ::gpiod_output_journal_free.
+ */
+struct gpiod_output_journal *gpiod_output_journal_new(size_t num_entries);
+
+/**
+ * @brief Free the output journal and release all associated resources.
+ * @param journal Output journal to free.
+ * @note The journal must first be detached from its request, or the request
+ *       released.
+ */
+void gpiod_output_journal_free(struct gpiod_output_journal *journal);
+
+/**
+ * @brief Start or stop recording the output values set on a request.
+ * @param request Line request.
+ * @param journal Output journal to record into or NULL to detach the
+ *                current one.
+ * @return 0 on success, -1 on failure.
+ *
+ * A journal can only be attached to a single request at a time; attaching
+ * one that is in use fails with EBUSY. A journal attached to a request
+ * replaces the previous one, which is detached.
+ */
+int gpiod_line_request_attach_journal(struct gpiod_line_request *request,
+				      struct gpiod_output_journal *journal);
+
+/**
+ * @brief Set the tag stored with the entries recorded from now on.
+ * @param journal Output journal.
+ * @param tag Arbitrary value identifying the code setting the values.
+ */
+void gpiod_output_journal_set_tag(struct gpiod_output_journal *journal,
+				  unsigned int tag);
+
+/**
+ * @brief Get the number of entries the journal holds.
+ * @param journal Output journal.
+ * @return Capacity of the journal.
+ */
+size_t gpiod_output_journal_get_capacity(struct gpiod_output_journal *journal);
+
+/**
+ * @brief Get the number of entries recorded so far.
+ * @param journal Output journal.
+ * @return Number of entries recorded since the journal was created,
+ *         including the ones since overwritten. It's also the number of the
+ *         next entry to be recorded.
+ */
+uint64_t
+gpiod_output_journal_get_num_entries(struct gpiod_output_journal *journal);
+
+/**
+ * @brief Read a single journal entry.
+ * @param journal Output journal.
+ * @param seqno Number of the entry.
+ * @param timestamp_ns Optional pointer in which the time at which the
+ *                     values were set is stored.
+ * @param mask Optional pointer in which the bitmap of lines that were set
+ *             is stored.
+ * @param bits Optional pointer in which the bitmap of the values the lines
+ *             were set to is stored.
+ * @param tag Optional pointer in which the tag of the entry is stored.
+ * @return 0 on success, -1 on failure. Fails with ENOENT if the entry
+ *         hasn't been recorded yet or has already been overwritten.
+ */
+int gpiod_output_journal_get_entry(struct gpiod_output_journal *journal,
+				   uint64_t seqno, uint64_t *timestamp_ns,
+				   uint64_t *mask, uint64_t *bits,
+				   unsigned int *tag);
+
+/**
+ * @brief Write the journal to a file descriptor as a stream of edge events.
+ * @param journal Output journal.
+ * @param fd File descriptor to write to.
+ * @return Number of edge events written on success, -1 on failure.
+ *
+ * The entries still held by the journal are converted into one edge event
+ * for every line whose value changed, or which was set for the first time,
+ * and written in the binary format in which the kernel delivers edge
+ * events on line request file descriptors (struct gpio_v2_line_event from
+ * linux/gpio.h). Rising edges stand for lines set to active, falling edges
+ * for lines set to inactive. The sequence numbers are counted from the
+ * first exported entry. This allows merging the export with raw event
+ * captures of the input lines to put both on a single timeline. Tags are
+ * not exported.
+ */
+int gpiod_output_journal_export(struct gpiod_output_journal *journal, int fd);
+
+/**
+ * @}
+ *
+ * @defgroup request_group Request groups
+ * @{
+ *
+ * Functions for setting and reading the values of lines spread over several
+ * requests - typically on different chips - at the same time.
+ *
+ * Setting the values request by request makes the lines on the last chip
+ * change long after the ones on the first when the chips sit on slow buses.
+ * A request group keeps a worker thread for every request but the first one,
+ * which is handled by the calling thread, and issues the operations on all
+ * requests concurrently. The time bracket of every operation is recorded so
+ * that users can check the skew that was actually achieved.
+ *
+ * The group doesn't take ownership of the requests which must outlive it.
+ */
+
+/**
+ * @brief Create a new, empty request group.
+ * @return New request group or NULL on error. The returned object must be
+ *         freed by the caller using ::gpiod_request_group_free.
+ */
+struct gpiod_request_group *gpiod_request_group_new(void);
+
+/**
+ * @brief Free the request group and stop its worker threads.
+ * @param group Request group to free.
+ */
+void gpiod_request_group_free(struct gpiod_request_group *group);
+
+/**
+ * @brief Add a request to the group.
+ * @param group Request group.
+ * @param request Line request to add.
+ * @return Index of the request within the group on success, -1 on failure.
+ *         Fails with EEXIST if the request already is in the group.
+ *
+ * Starts a new worker thread unless this is the first request.
+ */
+int gpiod_request_group_add_request(struct gpiod_request_group *group,
+				    struct gpiod_line_request *request);
+
+/**
+ * @brief Get the number of requests in the group.
+ * @param group Request group.
+ * @return Number of requests.
+ */
+size_t gpiod_request_group_get_num_requests(struct gpiod_request_group *group);
+
+/**
+ * @brief Set the values of all lines of all requests in the group.
+ * @param group Request group.
+ * @param values Array of values with an entry for every requested line of
+ *               every request, in the order the requests were added and, for
+ *               each request, in the order the lines were requested.
+ * @return 0 on success, -1 on failure. If setting the values failed on
+ *         more than one request, errno is set for the first one of them.
+ *
+ * The values are set on all requests concurrently.
+ */
+int gpiod_request_group_set_values(struct gpiod_request_group *group,
+				   const enum gpiod_line_value *values);
+
+/**
+ * @brief Read the values of all lines of all requests in the group.
+ * @param group Request group.
+ * @param values Array in which the values are stored. Laid out like for
+ *               ::gpiod_request_group_set_values.
+ * @return 0 on success, -1 on failure.
+ *
+ * The values are read from all requests concurrently.
+ */
+int gpiod_request_group_get_values(struct gpiod_request_group *group,
+				   enum gpiod_line_value *values);
+
+/**
+ * @brief Get the time bracket of the last operation on a request.
+ * @param group Request group.
+ * @param index Index of the request within the group.
+ * @param start_ns Optional pointer in which the time at which the operation
+ *                 was started is stored.
+ * @param end_ns Optional pointer in which the time at which the operation
+ *               completed is stored.
+ * @return 0 on success, -1 on failure.
+ *
+ * Timestamps are read from the monotonic clock.
+ */
+int gpiod_request_group_get_timestamps(struct gpiod_request_group *group,
+				       size_t index, uint64_t *start_ns,
+				       uint64_t *end_ns);
+
+/**
+ * @brief Get the outcome of the last operation on a request.
+ * @param group Request group.
+ * @param index Index of the request within the group.
+ * @return 0 if the last operation on the request succeeded, the errno value
+ *         it failed with otherwise or -1 if \p index is out of range, in
+ *         which case errno is set to EINVAL.
+ *
+ * Allows finding out which of the requests made an operation on the group
+ * fail.
+ */
+int gpiod_request_group_get_error(struct gpiod_request_group *group,
+				  size_t index);
+
+/**
+ * @brief Get the skew of the last operation.
+ * @param group Request group.
+ * @return Time between the start of the earliest and the end of the latest
+ *         operation on any request of the group, in nanoseconds.
+ *
+ * This is the upper bound of the time that passed between the values of
+ * any two lines of the group being set or read.
+ */
+uint64_t gpiod_request_group_get_skew_ns(struct gpiod_request_group *group);
+
+/**
+ * @}
+ *
+ * @defgroup scheduler Deadline scheduler
+ * @{
+ *
+ * Functions for setting line values at given points in time.
+ *
+ * A scheduler holds entries, each of which sets the values of some lines
+ * of a request at an absolute deadline on the monotonic clock. The entries
+ * are carried out by a thread woken up by a timer armed for the earliest
+ * deadline. The thread can optionally busy-wait for the last stretch before
+ * the deadline to absorb the scheduler's wake-up latency. All entries that
+ * are due by the time the earliest one is carried out are executed as a
+ * batch in which the entries for a single request are merged into a single
+ * set-values operation. Entries with later deadlines, or added later for
+ * the same deadline, take precedence on the lines they share.
+ *
+ * Entries may be added from any thread at any time, including while the
+ * scheduler is running. The requests referenced by the entries must outlive
+ * the scheduler or at least stay valid until it's stopped.
+ */
+
+/**
+ * @brief Create a new scheduler.
+ * @return New scheduler object or NULL if an error occurred. The returned
+ *         object must be freed by the caller using ::gpiod_scheduler_free.
+ */
+struct gpiod_scheduler *gpiod_scheduler_new(void);
+
+/**
+ * @brief Free the scheduler and release all associated resources.
+ * @param sched Scheduler to free.
+ *
+ * Stops the scheduler if it's running.
+ */
+void gpiod_scheduler_free(struct gpiod_scheduler *sched);
+
+/**
+ * @brief Set the real-time priority of the scheduler thread.
+ * @param sched Scheduler.
+ * @param priority SCHED_FIFO priority of the thread or 0 to inherit the
+ *                 scheduling policy of the thread starting the scheduler.
+ * @return 0 on success, -1 on failure.
+ *
+ * Only takes effect when the scheduler is next started. Starting the
+ * scheduler fails with EPERM if the process is not allowed to use real-time
+ * scheduling.
+ */
+int gpiod_scheduler_set_priority(struct gpiod_scheduler *sched, int priority);
+
+/**
+ * @brief Set the busy-wait budget used before each deadline.
+ * @param sched Scheduler.
+ * @param spin_ns Length of the busy-wait performed before each deadline in
+ *                nanoseconds. Defaults to 0.
+ *
+ * Should only be changed while the scheduler is stopped.
+ */
+void gpiod_scheduler_set_spin(struct gpiod_scheduler *sched, uint64_t spin_ns);
+
+/**
+ * @brief Schedule setting the values of a set of lines.
+ * @param sched Scheduler.
+ * @param deadline_ns Absolute time on the monotonic clock at which to set
+ *                    the values. Deadlines that already passed are carried
+ *                    out as soon as possible.
+ * @param request Line request to set the values on.
+ * @param mask Bitmap of lines to set, bit N stands for the N-th requested
+ *             line.
+ * @param bits Bitmap of values to set the lines to, bit N set means active.
+ * @return 0 on success, -1 on failure.
+ *
+ * May be called from any thread. Entries added while the scheduler is
+ * stopped are carried out once it's started.
+ */
+int gpiod_scheduler_add(struct gpiod_scheduler *sched, uint64_t deadline_ns,
+			struct gpiod_line_request *request, uint64_t mask,
+			uint64_t bits);
+
+/**
+ * @brief Get the number of entries waiting for their deadline.
+ * @param sched Scheduler.
+ * @return Number of pending entries.
+ */
+size_t gpiod_scheduler_get_num_pending(struct gpiod_scheduler *sched);
+
+/**
+ * @brief Start carrying out the entries.
+ * @param sched Scheduler.
+ * @return 0 on success, -1 on failure.
+ *
+ * Spawns the scheduler thread. Statistics are reset.
+ */
+int gpiod_scheduler_start(struct gpiod_scheduler *sched);
+
+/**
+ * @brief Stop carrying out the entries.
+ * @param sched Scheduler.
+ * @return 0 on success, -1 on failure or if setting the values failed at
+ *         any point while the scheduler was running, in which case errno is
+ *         set to the last error that occurred.
+ *
+ * Joins the scheduler thread. Entries that haven't been carried out yet are
+ * discarded. The output lines are left as they are.
+ */
+int gpiod_scheduler_stop(struct gpiod_scheduler *sched);
+
+/**
+ * @brief Get the statistics of the scheduler.
+ * @param sched Scheduler.
+ * @param num_executed Optional pointer in which the number of entries that
+ *                     have been carried out is stored.
+ * @param num_batches Optional pointer in which the number of set-values
+ *                    operations issued for them is stored.
+ * @param last_lateness_ns Optional pointer in which the time by which the
+ *                         most recent entry missed its deadline in
+ *                         nanoseconds is stored.
+ * @param avg_lateness_ns Optional pointer in which the mean lateness in
+ *                        nanoseconds is stored.
+ * @param max_lateness_ns Optional pointer in which the largest observed
+ *                        lateness in nanoseconds is stored.
+ *
+ * The lateness of an entry is measured from its deadline to the completion
+ * of the operation setting its values. May be called at any time, including
+ * while the scheduler is running.
+ */
+void gpiod_scheduler_get_stats(struct gpiod_scheduler *sched,
+			       uint64_t *num_executed, uint64_t *num_batches,
+			       uint64_t *last_lateness_ns,
+			       uint64_t *avg_lateness_ns,
+			       uint64_t *max_lateness_ns);
+
 /**
  * @}
  *
@@ -0,0 +1,297 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <assert.h>
+#include <errno.h>
+#include <gpiod.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "internal.h"
+
+/* Two clock phases per bit, eight bits per byte. */
+#define BITBANG_PHASES_PER_BYTE	16
+
+#define BITBANG_MODE_CPHA	0x1
+#define BITBANG_MODE_CPOL	0x2
+
+struct gpiod_bitbang {
+	struct gpiod_line_request *request;
+	uint64_t clock_bit;
+	uint64_t data_out_bit;
+	uint64_t data_in_bit;
+	uint64_t chip_select_bit;
+	enum gpiod_bitbang_mode mode;
+	enum gpiod_bitbang_bit_order bit_order;
+	uint64_t half_period_ns;
+	bool table_valid;
+	/* Line bits for every clock phase of every possible byte value. */
+	uint64_t table[256][BITBANG_PHASES_PER_BYTE];
+};
+
+/* Assign a line to one of the bus signals. Each line can only have one. */
+static int bitbang_set_signal(struct gpiod_bitbang *bb, unsigned int offset,
+			      uint64_t *signal)
+{
+	uint64_t bit, used;
+	int ret;
+
+	ret = gpiod_line_request_offsets_to_mask(bb->request, 1, &offset, &bit);
+	if (ret)
+		return -1;
+
+	used = bb->clock_bit | bb->data_out_bit | bb->data_in_bit |
+	       bb->chip_select_bit;
+	if ((used & ~*signal) & bit) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	*signal = bit;
+	bb->table_valid = false;
+
+	return 0;
+}
+
+GPIOD_API struct gpiod_bitbang *
+gpiod_bitbang_new(struct gpiod_line_request *request, unsigned int clock_offset)
+{
+	struct gpiod_bitbang *bb;
+	int ret;
+
+	assert(request);
+
+	bb = malloc(sizeof(*bb));
+	if (!bb)
+		return NULL;
+
+	memset(bb, 0, sizeof(*bb));
+	bb->request = request;
+	bb->mode = GPIOD_BITBANG_MODE_0;
+	bb->bit_order = GPIOD_BITBANG_BIT_ORDER_MSB_FIRST;
+
+	ret = bitbang_set_signal(bb, clock_offset, &bb->clock_bit);
+	if (ret) {
+		free(bb);
+		return NULL;
+	}
+
+	return bb;
+}
+
+GPIOD_API void gpiod_bitbang_free(struct gpiod_bitbang *bb)
+{
+	free(bb);
+}
+
+GPIOD_API int gpiod_bitbang_set_data_out(struct gpiod_bitbang *bb,
+					 unsigned int offset)
+{
+	assert(bb);
+
+	return bitbang_set_signal(bb, offset, &bb->data_out_bit);
+}
+
+GPIOD_API int gpiod_bitbang_set_data_in(struct gpiod_bitbang *bb,
+					unsigned int offset)
+{
+	assert(bb);
+
+	return bitbang_set_signal(bb, offset, &bb->data_in_bit);
+}
+
+GPIOD_API int gpiod_bitbang_set_chip_select(struct gpiod_bitbang *bb,
+					    unsigned int offset)
+{
+	assert(bb);
+
+	return bitbang_set_signal(bb, offset, &bb->chip_select_bit);
+}
+
+GPIOD_API int gpiod_bitbang_set_mode(struct gpiod_bitbang *bb,
+				     enum gpiod_bitbang_mode mode)
+{
+	assert(bb);
+
+	switch (mode) {
+	case GPIOD_BITBANG_MODE_0:
+	case GPIOD_BITBANG_MODE_1:
+	case GPIOD_BITBANG_MODE_2:
+	case GPIOD_BITBANG_MODE_3:
+		break;
+	default:
+		errno = EINVAL;
+		return -1;
+	}
+
+	bb->mode = mode;
+	bb->table_valid = false;
+
+	return 0;
+}
+
+GPIOD_API int gpiod_bitbang_set_bit_order(struct gpiod_bitbang *bb,
+					  enum gpiod_bitbang_bit_order order)
+{
+	assert(bb);
+
+	switch (order) {
+	case GPIOD_BITBANG_BIT_ORDER_MSB_FIRST:
+	case GPIOD_BITBANG_BIT_ORDER_LSB_FIRST:
+		break;
+	default:
+		errno = EINVAL;
+		return -1;
+	}
+
+	bb->bit_order = order;
+	bb->table_valid = false;
+
+	return 0;
+}
+
+GPIOD_API void gpiod_bitbang_set_half_period(struct gpiod_bitbang *bb,
+					     uint64_t half_period_ns)
+{
+	assert(bb);
+
+	bb->half_period_ns = half_period_ns;
+}
+
+static uint64_t bitbang_clock_idle(struct gpiod_bitbang *bb)
+{
+	return bb->mode & BITBANG_MODE_CPOL ? bb->clock_bit : 0;
+}
+
+static unsigned int bitbang_bit_shift(struct gpiod_bitbang *bb,
+				      unsigned int i)
+{
+	return bb->bit_order == GPIOD_BITBANG_BIT_ORDER_MSB_FIRST ? 7 - i : i;
+}
+
+/*
+ * Precompute the line bits for both clock phases of every bit of every byte
+ * value, so that the transfer loop only has to look the words up.
+ */
+static void bitbang_build_table(struct gpiod_bitbang *bb)
+{
+	uint64_t idle, active, first, second, data;
+	unsigned int val, i;
+
+	idle = bitbang_clock_idle(bb) | bb->chip_select_bit;
+	active = (idle ^ bb->clock_bit) | bb->chip_select_bit;
+
+	/*
+	 * With CPHA=0 the data is shifted out while the clock is idle and
+	 * sampled on the leading edge. With CPHA=1 it's shifted out on the
+	 * leading edge and sampled on the trailing edge. Either way the
+	 * sampling edge is the second phase of each bit.
+	 */
+	first = bb->mode & BITBANG_MODE_CPHA ? active : idle;
+	second = first ^ bb->clock_bit;
+
+	for (val = 0; val < 256; val++) {
+		for (i = 0; i < 8; i++) {
+			data = (val >> bitbang_bit_shift(bb, i)) & 1 ?
+						bb->data_out_bit : 0;
+			bb->table[val][2 * i] = first | data;
+			bb->table[val][2 * i + 1] = second | data;
+		}
+	}
+
+	bb->table_valid = true;
+}
+
+static int bitbang_emit(struct gpiod_bitbang *bb, uint64_t mask, uint64_t bits,
+			uint64_t *deadline)
+{
+	if (bb->half_period_ns) {
+		/* Phases are too short for the scheduler, so busy-wait. */
+		gpiod_sleep_until(*deadline, UINT64_MAX);
+		*deadline += bb->half_period_ns;
+	}
+
+	return gpiod_line_request_set_bits(bb->request, mask, bits);
+}
+
+GPIOD_API int gpiod_bitbang_transfer(struct gpiod_bitbang *bb,
+				     const uint8_t *tx, uint8_t *rx,
+				     size_t len)
+{
+	uint64_t mask, idle, in, deadline = 0;
+	const uint64_t *phases;
+	unsigned int p;
+	uint8_t byte;
+	size_t n;
+	int ret;
+
+	assert(bb);
+
+	if (rx && !bb->data_in_bit) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (!len)
+		return 0;
+
+	if (!bb->table_valid)
+		bitbang_build_table(bb);
+
+	mask = bb->clock_bit | bb->data_out_bit | bb->chip_select_bit;
+	idle = bitbang_clock_idle(bb) | bb->chip_select_bit;
+
+	if (bb->half_period_ns)
+		deadline = gpiod_monotonic_ns();
+
+	/*
+	 * With CPHA=1 the first phase is already a clock edge so assert the
+	 * chip-select with the clock at its idle level first.
+	 */
+	if (bb->mode & BITBANG_MODE_CPHA) {
+		ret = bitbang_emit(bb, mask, idle, &deadline);
+		if (ret)
+			return -1;
+	}
+
+	for (n = 0; n < len; n++) {
+		phases = bb->table[tx ? tx[n] : 0];
+		byte = 0;
+
+		for (p = 0; p < BITBANG_PHASES_PER_BYTE; p++) {
+			ret = bitbang_emit(bb, mask, phases[p], &deadline);
+			if (ret)
+				return -1;
+
+			if (!rx || !(p & 1))
+				continue;
+
+			ret = gpiod_line_request_get_bits(bb->request,
+							  bb->data_in_bit, &in);
+			if (ret)
+				return -1;
+
+			if (in)
+				byte |= 1 << bitbang_bit_shift(bb, p / 2);
+		}
+
+		if (rx)
+			rx[n] = byte;
+	}
+
+	/* With CPHA=0 the last phase leaves the clock active. */
+	if (!(bb->mode & BITBANG_MODE_CPHA)) {
+		ret = bitbang_emit(bb, mask, idle, &deadline);
+		if (ret)
+			return -1;
+	}
+
+	if (bb->chip_select_bit) {
+		ret = bitbang_emit(bb, mask, idle & ~bb->chip_select_bit,
+				   &deadline);
+		if (ret)
+			return -1;
+	}
+
+	return 0;
+}
@@ -40,6 +40,25 @@ GPIOD_API size_t gpiod_chip_info_get_num_lines(struct gpiod_chip_info *info)
 	return info->num_lines;
 }
 
+GPIOD_API int gpiod_chip_info_export(struct gpiod_chip_info *info,
+				     struct gpiod_chip_info_data *data,
+				     size_t size)
+{
+	struct gpiod_chip_info_data tmp;
+
+	assert(info);
+
+	memset(&tmp, 0, sizeof(tmp));
+
+	tmp.num_lines = info->num_lines;
+	memcpy(tmp.name, info->name, sizeof(tmp.name));
+	memcpy(tmp.label, info->label, sizeof(tmp.label));
+
+	return gpiod_export_struct(data, size, &tmp, sizeof(tmp),
+				   GPIOD_OFFSETOFEND(struct gpiod_chip_info_data,
+						     label));
+}
+
 struct gpiod_chip_info *
 gpiod_chip_info_from_uapi(struct gpiochip_info *uapi_info)
 {
@@ -0,0 +1,221 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <assert.h>
+#include <errno.h>
+#include <gpiod.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "internal.h"
+
+/* Number of info events consumed from the chip file descriptor per read(). */
+#define MIRROR_EVENT_BATCH_SIZE 16
+
+struct gpiod_chip_mirror {
+	struct gpiod_chip *chip;
+	size_t num_lines;
+	struct gpiod_line_info **lines;
+	gpiod_chip_mirror_callback callback;
+	void *callback_data;
+	struct gpio_v2_line_info_changed event_data[MIRROR_EVENT_BATCH_SIZE];
+};
+
+static void mirror_free_lines(struct gpiod_chip_mirror *mirror)
+{
+	size_t i;
+
+	for (i = 0; i < mirror->num_lines; i++)
+		gpiod_line_info_free(mirror->lines[i]);
+
+	free(mirror->lines);
+}
+
+GPIOD_API struct gpiod_chip_mirror *gpiod_chip_mirror_new(const char *path)
+{
+	struct gpiod_chip_mirror *mirror;
+	struct gpiod_chip_info *info;
+	size_t num_lines, i;
+
+	mirror = malloc(sizeof(*mirror));
+	if (!mirror)
+		return NULL;
+
+	memset(mirror, 0, sizeof(*mirror));
+
+	mirror->chip = gpiod_chip_open(path);
+	if (!mirror->chip)
+		goto err_free_mirror;
+
+	info = gpiod_chip_get_info(mirror->chip);
+	if (!info)
+		goto err_close_chip;
+
+	num_lines = gpiod_chip_info_get_num_lines(info);
+	gpiod_chip_info_free(info);
+
+	mirror->lines = calloc(num_lines, sizeof(*mirror->lines));
+	if (!mirror->lines && num_lines)
+		goto err_close_chip;
+
+	/*
+	 * The kernel has no bulk line info read so the initial snapshot is
+	 * taken by arming the watch on every line, which returns the current
+	 * line info as a side-effect. From then on the mirror is only updated
+	 * from info events.
+	 */
+	for (i = 0; i < num_lines; i++) {
+		mirror->lines[i] = gpiod_chip_watch_line_info(mirror->chip, i);
+		if (!mirror->lines[i])
+			goto err_free_lines;
+
+		mirror->num_lines++;
+	}
+
+	return mirror;
+
+err_free_lines:
+	mirror_free_lines(mirror);
+err_close_chip:
+	gpiod_chip_close(mirror->chip);
+err_free_mirror:
+	free(mirror);
+
+	return NULL;
+}
+
+GPIOD_API void gpiod_chip_mirror_free(struct gpiod_chip_mirror *mirror)
+{
+	if (!mirror)
+		return;
+
+	mirror_free_lines(mirror);
+	gpiod_chip_close(mirror->chip);
+	free(mirror);
+}
+
+GPIOD_API const char *
+gpiod_chip_mirror_get_chip_path(struct gpiod_chip_mirror *mirror)
+{
+	assert(mirror);
+
+	return gpiod_chip_get_path(mirror->chip);
+}
+
+GPIOD_API size_t
+gpiod_chip_mirror_get_num_lines(struct gpiod_chip_mirror *mirror)
+{
+	assert(mirror);
+
+	return mirror->num_lines;
+}
+
+GPIOD_API struct gpiod_line_info *
+gpiod_chip_mirror_get_line_info(struct gpiod_chip_mirror *mirror,
+				unsigned int offset)
+{
+	assert(mirror);
+
+	if (offset >= mirror->num_lines) {
+		errno = EINVAL;
+		return NULL;
+	}
+
+	return mirror->lines[offset];
+}
+
+GPIOD_API void
+gpiod_chip_mirror_set_callback(struct gpiod_chip_mirror *mirror,
+			       gpiod_chip_mirror_callback callback,
+			       void *user_data)
+{
+	assert(mirror);
+
+	mirror->callback = callback;
+	mirror->callback_data = user_data;
+}
+
+GPIOD_API int gpiod_chip_mirror_get_fd(struct gpiod_chip_mirror *mirror)
+{
+	assert(mirror);
+
+	return gpiod_chip_get_fd(mirror->chip);
+}
+
+GPIOD_API int
+gpiod_chip_mirror_wait_info_events(struct gpiod_chip_mirror *mirror,
+				   int64_t timeout_ns)
+{
+	assert(mirror);
+
+	return gpiod_chip_wait_info_event(mirror->chip, timeout_ns);
+}
+
+static int mirror_apply_event(struct gpiod_chip_mirror *mirror,
+			      struct gpio_v2_line_info_changed *uapi_evt)
+{
+	struct gpiod_info_event *event;
+
+	/* Can't happen unless there's a bug in the kernel. */
+	if (uapi_evt->info.offset >= mirror->num_lines) {
+		errno = ERANGE;
+		return -1;
+	}
+
+	gpiod_line_info_update_from_uapi(mirror->lines[uapi_evt->info.offset],
+					 &uapi_evt->info);
+
+	if (!mirror->callback)
+		return 0;
+
+	event = gpiod_info_event_from_uapi(uapi_evt);
+	if (!event)
+		return -1;
+
+	mirror->callback(event, mirror->callback_data);
+	gpiod_info_event_free(event);
+
+	return 0;
+}
+
+GPIOD_API int
+gpiod_chip_mirror_process_info_events(struct gpiod_chip_mirror *mirror)
+{
+	size_t num_read, i;
+	int fd, ret, total = 0;
+	ssize_t rd;
+
+	assert(mirror);
+
+	fd = gpiod_chip_get_fd(mirror->chip);
+
+	for (;;) {
+		ret = gpiod_poll_fd(fd, 0);
+		if (ret < 0)
+			return -1;
+		else if (ret == 0)
+			break;
+
+		rd = read(fd, mirror->event_data, sizeof(mirror->event_data));
+		if (rd < 0) {
+			return -1;
+		} else if ((size_t)rd < sizeof(*mirror->event_data)) {
+			errno = EIO;
+			return -1;
+		}
+
+		num_read = rd / sizeof(*mirror->event_data);
+
+		for (i = 0; i < num_read; i++) {
+			ret = mirror_apply_event(mirror,
+						 &mirror->event_data[i]);
+			if (ret)
+				return -1;
+
+			total++;
+		}
+	}
+
+	return total;
+}
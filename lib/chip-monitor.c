@@ -0,0 +1,287 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <assert.h>
+#include <errno.h>
+#include <gpiod.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "internal.h"
+
+#define MONITOR_DEV_DIR		"/dev"
+#define MONITOR_CHIP_PREFIX	"gpiochip"
+#define MONITOR_WATCH_MASK	(IN_CREATE | IN_DELETE | \
+				 IN_MOVED_TO | IN_MOVED_FROM)
+#define MONITOR_BUF_SIZE	4096
+
+struct gpiod_chip_monitor_event {
+	enum gpiod_chip_monitor_event_type event_type;
+	char path[sizeof(MONITOR_DEV_DIR "/") + NAME_MAX];
+	char label[GPIO_MAX_NAME_SIZE];
+};
+
+struct gpiod_chip_monitor {
+	int fd;
+	size_t buf_len;
+	size_t buf_pos;
+	bool has_pending;
+	struct gpiod_chip_monitor_event pending;
+	char buf[MONITOR_BUF_SIZE]
+		__attribute__((aligned(__alignof__(struct inotify_event))));
+};
+
+GPIOD_API struct gpiod_chip_monitor *gpiod_chip_monitor_new(void)
+{
+	struct gpiod_chip_monitor *monitor;
+	int ret;
+
+	monitor = malloc(sizeof(*monitor));
+	if (!monitor)
+		return NULL;
+
+	memset(monitor, 0, sizeof(*monitor));
+
+	monitor->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (monitor->fd < 0)
+		goto err_free_monitor;
+
+	ret = inotify_add_watch(monitor->fd, MONITOR_DEV_DIR,
+				MONITOR_WATCH_MASK);
+	if (ret < 0)
+		goto err_close_fd;
+
+	return monitor;
+
+err_close_fd:
+	close(monitor->fd);
+err_free_monitor:
+	free(monitor);
+
+	return NULL;
+}
+
+GPIOD_API void gpiod_chip_monitor_free(struct gpiod_chip_monitor *monitor)
+{
+	if (!monitor)
+		return;
+
+	close(monitor->fd);
+	free(monitor);
+}
+
+GPIOD_API int gpiod_chip_monitor_get_fd(struct gpiod_chip_monitor *monitor)
+{
+	assert(monitor);
+
+	return monitor->fd;
+}
+
+static void read_chip_label(struct gpiod_chip_monitor_event *event)
+{
+	struct gpiod_chip_info *info;
+	struct gpiod_chip *chip;
+
+	/*
+	 * The label is best-effort: the device node may not be accessible
+	 * yet if udev has not finished setting its permissions.
+	 */
+	chip = gpiod_chip_open(event->path);
+	if (!chip)
+		return;
+
+	info = gpiod_chip_get_info(chip);
+	if (info) {
+		strncpy(event->label, gpiod_chip_info_get_label(info),
+			sizeof(event->label) - 1);
+		gpiod_chip_info_free(info);
+	}
+
+	gpiod_chip_close(chip);
+}
+
+/* The kernel always names GPIO character devices gpiochipN. */
+static bool is_chip_name(const char *name)
+{
+	size_t len = strlen(MONITOR_CHIP_PREFIX);
+
+	if (strncmp(name, MONITOR_CHIP_PREFIX, len) != 0 || name[len] == '\0')
+		return false;
+
+	for (name += len; *name; name++) {
+		if (*name < '0' || *name > '9')
+			return false;
+	}
+
+	return true;
+}
+
+static bool parse_inotify_event(struct inotify_event *in_evt,
+				struct gpiod_chip_monitor_event *event)
+{
+	memset(event, 0, sizeof(*event));
+
+	/* Events were lost, the user must rescan the chips. */
+	if (in_evt->mask & IN_Q_OVERFLOW) {
+		event->event_type = GPIOD_CHIP_MONITOR_EVENT_OVERFLOW;
+		return true;
+	}
+
+	if (!in_evt->len || !is_chip_name(in_evt->name))
+		return false;
+
+	snprintf(event->path, sizeof(event->path), MONITOR_DEV_DIR "/%s",
+		 in_evt->name);
+
+	if (in_evt->mask & (IN_CREATE | IN_MOVED_TO)) {
+		if (!gpiod_check_gpiochip_device(event->path, false))
+			return false;
+
+		event->event_type = GPIOD_CHIP_MONITOR_EVENT_CHIP_ADDED;
+		read_chip_label(event);
+	} else if (in_evt->mask & (IN_DELETE | IN_MOVED_FROM)) {
+		/* The device is gone so we can only go by its name. */
+		event->event_type = GPIOD_CHIP_MONITOR_EVENT_CHIP_REMOVED;
+	} else {
+		return false;
+	}
+
+	return true;
+}
+
+/*
+ * Walk the buffered inotify events until one concerning a GPIO chip is found.
+ * Returns true if such an event has been stored as pending.
+ */
+static bool monitor_parse_buffer(struct gpiod_chip_monitor *monitor)
+{
+	struct inotify_event *in_evt;
+
+	while (monitor->buf_pos < monitor->buf_len) {
+		in_evt = (struct inotify_event *)(monitor->buf +
+						  monitor->buf_pos);
+		monitor->buf_pos += sizeof(*in_evt) + in_evt->len;
+
+		if (parse_inotify_event(in_evt, &monitor->pending)) {
+			monitor->has_pending = true;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static int monitor_fill_buffer(struct gpiod_chip_monitor *monitor)
+{
+	ssize_t rd;
+
+	rd = read(monitor->fd, monitor->buf, sizeof(monitor->buf));
+	if (rd < 0) {
+		if (errno == EAGAIN)
+			return 0;
+
+		return -1;
+	}
+
+	monitor->buf_len = rd;
+	monitor->buf_pos = 0;
+
+	return 0;
+}
+
+GPIOD_API int gpiod_chip_monitor_wait_event(struct gpiod_chip_monitor *monitor,
+					    int64_t timeout_ns)
+{
+	uint64_t deadline = 0, now;
+	int ret;
+
+	assert(monitor);
+
+	if (monitor->has_pending || monitor_parse_buffer(monitor))
+		return 1;
+
+	if (timeout_ns > 0)
+		deadline = gpiod_monotonic_ns() + timeout_ns;
+
+	/*
+	 * The watched directory sees all device nodes coming and going, so
+	 * keep waiting until an event relevant to GPIO chips shows up or the
+	 * time runs out.
+	 */
+	for (;;) {
+		ret = gpiod_poll_fd(monitor->fd, timeout_ns);
+		if (ret <= 0)
+			return ret;
+
+		ret = monitor_fill_buffer(monitor);
+		if (ret)
+			return -1;
+
+		if (monitor_parse_buffer(monitor))
+			return 1;
+
+		if (timeout_ns > 0) {
+			now = gpiod_monotonic_ns();
+			if (now >= deadline)
+				return 0;
+
+			timeout_ns = deadline - now;
+		}
+	}
+}
+
+GPIOD_API struct gpiod_chip_monitor_event *
+gpiod_chip_monitor_read_event(struct gpiod_chip_monitor *monitor)
+{
+	struct gpiod_chip_monitor_event *event;
+	int ret;
+
+	assert(monitor);
+
+	ret = gpiod_chip_monitor_wait_event(monitor, -1);
+	if (ret < 0)
+		return NULL;
+
+	event = malloc(sizeof(*event));
+	if (!event)
+		return NULL;
+
+	memcpy(event, &monitor->pending, sizeof(*event));
+	monitor->has_pending = false;
+
+	return event;
+}
+
+GPIOD_API void
+gpiod_chip_monitor_event_free(struct gpiod_chip_monitor_event *event)
+{
+	free(event);
+}
+
+GPIOD_API enum gpiod_chip_monitor_event_type
+gpiod_chip_monitor_event_get_event_type(struct gpiod_chip_monitor_event *event)
+{
+	assert(event);
+
+	return event->event_type;
+}
+
+GPIOD_API const char *
+gpiod_chip_monitor_event_get_chip_path(struct gpiod_chip_monitor_event *event)
+{
+	assert(event);
+
+	return event->path;
+}
+
+GPIOD_API const char *
+gpiod_chip_monitor_event_get_chip_label(struct gpiod_chip_monitor_event *event)
+{
+	assert(event);
+
+	return event->label[0] == '\0' ? NULL : event->label;
+}
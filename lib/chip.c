@@ -144,6 +144,48 @@ gpiod_chip_watch_line_info(struct gpiod_chip *chip, unsigned int offset)
 	return chip_get_line_info(chip, offset, true);
 }
 
+GPIOD_API int
+gpiod_chip_read_line_info_data(struct gpiod_chip *chip, unsigned int offset,
+			       size_t num_lines,
+			       struct gpiod_line_info_data *data, size_t size)
+{
+	struct gpio_v2_line_info info;
+	struct gpiochip_info chinfo;
+	char *pos = (char *)data;
+	size_t i;
+	int ret;
+
+	assert(chip);
+
+	if (size < GPIOD_OFFSETOFEND(struct gpiod_line_info_data,
+				     debounce_period_us)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	ret = read_chip_info(chip->fd, &chinfo);
+	if (ret)
+		return -1;
+
+	if (offset >= chinfo.lines || num_lines > chinfo.lines - offset) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	for (i = 0; i < num_lines; i++, pos += size) {
+		ret = chip_read_line_info(chip->fd, offset + i, &info, false);
+		if (ret)
+			return -1;
+
+		ret = gpiod_line_info_export_uapi(&info,
+				(struct gpiod_line_info_data *)pos, size);
+		if (ret)
+			return -1;
+	}
+
+	return 0;
+}
+
 GPIOD_API int gpiod_chip_unwatch_line_info(struct gpiod_chip *chip,
 					   unsigned int offset)
 {
@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <errno.h>
+#include <gpiod.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "internal.h"
+
+#define UNUSED	__attribute__((unused))
+
+struct uart_decoder {
+	unsigned int offset;
+	unsigned int baud_rate;
+	unsigned int data_bits;
+	enum gpiod_edge_decoder_parity parity;
+	/* Data and parity bits. */
+	unsigned int payload_bits;
+	/* Start, data, parity and stop bits. */
+	unsigned int frame_bits;
+	bool level;
+	bool in_frame;
+	uint64_t start;
+	unsigned int next_bit;
+	uint64_t payload;
+	unsigned int flags;
+};
+
+/* Middle of the given bit of the frame that started at uart->start. */
+static uint64_t uart_sample_time(struct uart_decoder *uart, unsigned int bit)
+{
+	return uart->start +
+	       (2ULL * bit + 1) * 1000000000ULL / (2ULL * uart->baud_rate);
+}
+
+static int uart_end_frame(struct gpiod_edge_decoder *decoder,
+			  struct uart_decoder *uart)
+{
+	unsigned int ones;
+
+	uart->in_frame = false;
+
+	if (uart->parity != GPIOD_EDGE_DECODER_PARITY_NONE) {
+		ones = __builtin_popcountll(uart->payload);
+		if ((ones & 1) != (uart->parity == GPIOD_EDGE_DECODER_PARITY_ODD))
+			uart->flags |= GPIOD_EDGE_DECODER_FRAME_PARITY_ERROR;
+	}
+
+	return gpiod_edge_decoder_push_frame(decoder,
+				uart->payload & ((1ULL << uart->data_bits) - 1),
+				uart->data_bits, uart->start, uart->flags);
+}
+
+/* Sample all bits whose middle falls before the given time. */
+static int uart_sample_until(struct gpiod_edge_decoder *decoder,
+			     struct uart_decoder *uart, uint64_t timestamp)
+{
+	unsigned int bit;
+
+	while (uart->in_frame &&
+	       uart_sample_time(uart, uart->next_bit) < timestamp) {
+		bit = uart->next_bit++;
+
+		if (bit == 0) {
+			/* Too short to be a start bit, must have been a glitch. */
+			if (uart->level)
+				uart->in_frame = false;
+		} else if (bit <= uart->payload_bits) {
+			/* Least significant bit first. */
+			if (uart->level)
+				uart->payload |= 1ULL << (bit - 1);
+		} else {
+			if (!uart->level)
+				uart->flags |=
+					GPIOD_EDGE_DECODER_FRAME_FRAMING_ERROR;
+
+			if (uart->next_bit == uart->frame_bits)
+				return uart_end_frame(decoder, uart);
+		}
+	}
+
+	return 0;
+}
+
+static int uart_edge(struct gpiod_edge_decoder *decoder,
+		     unsigned int offset UNUSED, bool rising,
+		     uint64_t timestamp_ns)
+{
+	struct uart_decoder *uart = gpiod_edge_decoder_get_priv(decoder);
+	int ret;
+
+	ret = uart_sample_until(decoder, uart, timestamp_ns);
+	if (ret)
+		return -1;
+
+	uart->level = rising;
+
+	if (!uart->in_frame && !rising) {
+		uart->in_frame = true;
+		uart->start = timestamp_ns;
+		uart->next_bit = 0;
+		uart->payload = 0;
+		uart->flags = 0;
+	}
+
+	return 0;
+}
+
+static int uart_flush(struct gpiod_edge_decoder *decoder,
+		      uint64_t timestamp_ns)
+{
+	return uart_sample_until(decoder, gpiod_edge_decoder_get_priv(decoder),
+				 timestamp_ns);
+}
+
+static bool uart_uses_offset(struct gpiod_edge_decoder *decoder,
+			     unsigned int offset)
+{
+	struct uart_decoder *uart = gpiod_edge_decoder_get_priv(decoder);
+
+	return uart->offset == offset;
+}
+
+static const struct gpiod_edge_decoder_ops uart_ops = {
+	.edge = uart_edge,
+	.flush = uart_flush,
+	.uses_offset = uart_uses_offset,
+};
+
+GPIOD_API struct gpiod_edge_decoder *
+gpiod_edge_decoder_new_uart(unsigned int offset, unsigned int baud_rate,
+			    unsigned int data_bits,
+			    enum gpiod_edge_decoder_parity parity,
+			    unsigned int stop_bits)
+{
+	struct gpiod_edge_decoder *decoder;
+	struct uart_decoder *uart;
+
+	if (!baud_rate || baud_rate > 1000000000 || data_bits < 5 ||
+	    data_bits > 9 || stop_bits < 1 || stop_bits > 2 ||
+	    parity < GPIOD_EDGE_DECODER_PARITY_NONE ||
+	    parity > GPIOD_EDGE_DECODER_PARITY_ODD) {
+		errno = EINVAL;
+		return NULL;
+	}
+
+	uart = malloc(sizeof(*uart));
+	if (!uart)
+		return NULL;
+
+	memset(uart, 0, sizeof(*uart));
+	uart->offset = offset;
+	uart->baud_rate = baud_rate;
+	uart->data_bits = data_bits;
+	uart->parity = parity;
+	uart->payload_bits = data_bits +
+			     (parity != GPIOD_EDGE_DECODER_PARITY_NONE);
+	uart->frame_bits = 1 + uart->payload_bits + stop_bits;
+	/* The line idles high. */
+	uart->level = true;
+
+	decoder = gpiod_edge_decoder_new(&uart_ops, uart);
+	if (!decoder) {
+		free(uart);
+		return NULL;
+	}
+
+	return decoder;
+}
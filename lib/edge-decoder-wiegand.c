@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <errno.h>
+#include <gpiod.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "internal.h"
+
+/* Default gap between bits ending a frame. */
+#define WIEGAND_TIMEOUT_NS	25000000ULL
+#define WIEGAND_MAX_BITS	64
+
+struct wiegand_decoder {
+	unsigned int offset_d0;
+	unsigned int offset_d1;
+	uint64_t timeout_ns;
+	uint64_t data;
+	unsigned int num_bits;
+	uint64_t start;
+	uint64_t last;
+};
+
+/*
+ * The first bit is the even parity of the first half of the remaining bits,
+ * the last bit is the odd parity of the second half.
+ */
+static bool wiegand_parity_ok(uint64_t data, unsigned int num_bits)
+{
+	unsigned int half = (num_bits - 2) / 2;
+	uint64_t low, high;
+
+	/* Bits are stored MSB first, the last one received is bit 0. */
+	low = data & ((1ULL << (half + 1)) - 1);
+	high = (data >> (half + 1)) & ((1ULL << (half + 1)) - 1);
+
+	return !(__builtin_popcountll(high) & 1) &&
+	       (__builtin_popcountll(low) & 1);
+}
+
+static int wiegand_end_frame(struct gpiod_edge_decoder *decoder,
+			     struct wiegand_decoder *wg)
+{
+	unsigned int flags = 0;
+	int ret;
+
+	if (wg->num_bits >= 4 && !(wg->num_bits % 2) &&
+	    !wiegand_parity_ok(wg->data, wg->num_bits))
+		flags |= GPIOD_EDGE_DECODER_FRAME_PARITY_ERROR;
+
+	ret = gpiod_edge_decoder_push_frame(decoder, wg->data, wg->num_bits,
+					    wg->start, flags);
+	wg->data = 0;
+	wg->num_bits = 0;
+
+	return ret;
+}
+
+static int wiegand_flush(struct gpiod_edge_decoder *decoder,
+			 uint64_t timestamp_ns)
+{
+	struct wiegand_decoder *wg = gpiod_edge_decoder_get_priv(decoder);
+
+	if (!wg->num_bits || timestamp_ns < wg->last ||
+	    timestamp_ns - wg->last <= wg->timeout_ns)
+		return 0;
+
+	return wiegand_end_frame(decoder, wg);
+}
+
+static int wiegand_edge(struct gpiod_edge_decoder *decoder,
+			unsigned int offset, bool rising,
+			uint64_t timestamp_ns)
+{
+	struct wiegand_decoder *wg = gpiod_edge_decoder_get_priv(decoder);
+	int ret;
+
+	ret = wiegand_flush(decoder, timestamp_ns);
+	if (ret)
+		return -1;
+
+	/* Both lines idle high, a low pulse on one of them is a bit. */
+	if (rising)
+		return 0;
+
+	if (!wg->num_bits)
+		wg->start = timestamp_ns;
+
+	wg->data = (wg->data << 1) | (offset == wg->offset_d1);
+	wg->num_bits++;
+	wg->last = timestamp_ns;
+
+	if (wg->num_bits == WIEGAND_MAX_BITS)
+		return wiegand_end_frame(decoder, wg);
+
+	return 0;
+}
+
+static bool wiegand_uses_offset(struct gpiod_edge_decoder *decoder,
+				unsigned int offset)
+{
+	struct wiegand_decoder *wg = gpiod_edge_decoder_get_priv(decoder);
+
+	return wg->offset_d0 == offset || wg->offset_d1 == offset;
+}
+
+static const struct gpiod_edge_decoder_ops wiegand_ops = {
+	.edge = wiegand_edge,
+	.flush = wiegand_flush,
+	.uses_offset = wiegand_uses_offset,
+};
+
+GPIOD_API struct gpiod_edge_decoder *
+gpiod_edge_decoder_new_wiegand(unsigned int offset_d0, unsigned int offset_d1,
+			       uint64_t timeout_ns)
+{
+	struct gpiod_edge_decoder *decoder;
+	struct wiegand_decoder *wg;
+
+	if (offset_d0 == offset_d1) {
+		errno = EINVAL;
+		return NULL;
+	}
+
+	wg = malloc(sizeof(*wg));
+	if (!wg)
+		return NULL;
+
+	memset(wg, 0, sizeof(*wg));
+	wg->offset_d0 = offset_d0;
+	wg->offset_d1 = offset_d1;
+	wg->timeout_ns = timeout_ns ?: WIEGAND_TIMEOUT_NS;
+
+	decoder = gpiod_edge_decoder_new(&wiegand_ops, wg);
+	if (!decoder) {
+		free(wg);
+		return NULL;
+	}
+
+	return decoder;
+}
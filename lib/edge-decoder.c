@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <assert.h>
+#include <errno.h>
+#include <gpiod.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "internal.h"
+
+#define EDGE_DECODER_MIN_FRAMES	16
+
+struct edge_decoder_frame {
+	uint64_t data;
+	unsigned int num_bits;
+	uint64_t timestamp;
+	unsigned int flags;
+};
+
+struct gpiod_edge_decoder {
+	const struct gpiod_edge_decoder_ops *ops;
+	void *priv;
+	/* Decoded frames not yet popped by the user, oldest at head. */
+	struct edge_decoder_frame *frames;
+	size_t head;
+	size_t num_frames;
+	size_t max_frames;
+	size_t num_new;
+};
+
+struct gpiod_edge_decoder *
+gpiod_edge_decoder_new(const struct gpiod_edge_decoder_ops *ops, void *priv)
+{
+	struct gpiod_edge_decoder *decoder;
+
+	decoder = malloc(sizeof(*decoder));
+	if (!decoder)
+		return NULL;
+
+	memset(decoder, 0, sizeof(*decoder));
+	decoder->ops = ops;
+	decoder->priv = priv;
+
+	return decoder;
+}
+
+void *gpiod_edge_decoder_get_priv(struct gpiod_edge_decoder *decoder)
+{
+	return decoder->priv;
+}
+
+int gpiod_edge_decoder_push_frame(struct gpiod_edge_decoder *decoder,
+				  uint64_t data, unsigned int num_bits,
+				  uint64_t timestamp_ns, unsigned int flags)
+{
+	struct edge_decoder_frame *frames, *frame;
+	size_t max;
+
+	if (decoder->head && decoder->head + decoder->num_frames ==
+			     decoder->max_frames) {
+		memmove(decoder->frames, &decoder->frames[decoder->head],
+			decoder->num_frames * sizeof(*frames));
+		decoder->head = 0;
+	}
+
+	if (decoder->num_frames == decoder->max_frames) {
+		max = decoder->max_frames * 2 ?: EDGE_DECODER_MIN_FRAMES;
+		frames = realloc(decoder->frames, max * sizeof(*frames));
+		if (!frames)
+			return -1;
+
+		decoder->frames = frames;
+		decoder->max_frames = max;
+	}
+
+	frame = &decoder->frames[decoder->head + decoder->num_frames];
+	frame->data = data;
+	frame->num_bits = num_bits;
+	frame->timestamp = timestamp_ns;
+	frame->flags = flags;
+	decoder->num_frames++;
+	decoder->num_new++;
+
+	return 0;
+}
+
+GPIOD_API void gpiod_edge_decoder_free(struct gpiod_edge_decoder *decoder)
+{
+	if (!decoder)
+		return;
+
+	free(decoder->frames);
+	free(decoder->priv);
+	free(decoder);
+}
+
+GPIOD_API int gpiod_edge_decoder_process(struct gpiod_edge_decoder *decoder,
+					 struct gpiod_edge_event_buffer *buffer)
+{
+	const struct gpiod_edge_decoder_ops *ops;
+	struct gpiod_edge_event *event;
+	size_t num_events, i;
+	unsigned int offset;
+	int ret;
+
+	assert(decoder);
+	assert(buffer);
+
+	ops = decoder->ops;
+	decoder->num_new = 0;
+	num_events = gpiod_edge_event_buffer_get_num_events(buffer);
+
+	for (i = 0; i < num_events; i++) {
+		event = gpiod_edge_event_buffer_get_event(buffer, i);
+		offset = gpiod_edge_event_get_line_offset(event);
+
+		if (!ops->uses_offset(decoder, offset))
+			continue;
+
+		ret = ops->edge(decoder, offset,
+				gpiod_edge_event_get_event_type(event) ==
+					GPIOD_EDGE_EVENT_RISING_EDGE,
+				gpiod_edge_event_get_timestamp_ns(event));
+		if (ret)
+			return -1;
+	}
+
+	return decoder->num_new;
+}
+
+GPIOD_API int gpiod_edge_decoder_flush(struct gpiod_edge_decoder *decoder,
+				       uint64_t timestamp_ns)
+{
+	int ret;
+
+	assert(decoder);
+
+	decoder->num_new = 0;
+
+	ret = decoder->ops->flush(decoder, timestamp_ns);
+	if (ret)
+		return -1;
+
+	return decoder->num_new;
+}
+
+GPIOD_API size_t
+gpiod_edge_decoder_get_num_frames(struct gpiod_edge_decoder *decoder)
+{
+	assert(decoder);
+
+	return decoder->num_frames;
+}
+
+GPIOD_API bool gpiod_edge_decoder_pop_frame(struct gpiod_edge_decoder *decoder,
+					    uint64_t *data,
+					    unsigned int *num_bits,
+					    uint64_t *timestamp_ns,
+					    unsigned int *flags)
+{
+	struct edge_decoder_frame *frame;
+
+	assert(decoder);
+
+	if (!decoder->num_frames)
+		return false;
+
+	frame = &decoder->frames[decoder->head];
+
+	if (data)
+		*data = frame->data;
+	if (num_bits)
+		*num_bits = frame->num_bits;
+	if (timestamp_ns)
+		*timestamp_ns = frame->timestamp;
+	if (flags)
+		*flags = frame->flags;
+
+	decoder->num_frames--;
+	decoder->head = decoder->num_frames ? decoder->head + 1 : 0;
+
+	return true;
+}
@@ -30,7 +30,7 @@ struct gpiod_edge_event_buffer {
 
 GPIOD_API void gpiod_edge_event_free(struct gpiod_edge_event *event)
 {
-	free(event);
+	gpiod_slab_free(GPIOD_SLAB_EDGE_EVENT, event);
 }
 
 GPIOD_API struct gpiod_edge_event *
@@ -40,7 +40,7 @@ gpiod_edge_event_copy(struct gpiod_edge_event *event)
 
 	assert(event);
 
-	copy = malloc(sizeof(*event));
+	copy = gpiod_slab_alloc(GPIOD_SLAB_EDGE_EVENT, sizeof(*event));
 	if (!copy)
 		return NULL;
 
@@ -89,6 +89,35 @@ gpiod_edge_event_get_line_seqno(struct gpiod_edge_event *event)
 	return event->line_seqno;
 }
 
+#define EDGE_EVENT_DATA_SIZE_V1 \
+	GPIOD_OFFSETOFEND(struct gpiod_edge_event_data, line_seqno)
+
+static void edge_event_to_data(struct gpiod_edge_event *event,
+			       struct gpiod_edge_event_data *data)
+{
+	memset(data, 0, sizeof(*data));
+
+	data->event_type = event->event_type;
+	data->line_offset = event->line_offset;
+	data->timestamp_ns = event->timestamp;
+	data->global_seqno = event->global_seqno;
+	data->line_seqno = event->line_seqno;
+}
+
+GPIOD_API int gpiod_edge_event_export(struct gpiod_edge_event *event,
+				      struct gpiod_edge_event_data *data,
+				      size_t size)
+{
+	struct gpiod_edge_event_data tmp;
+
+	assert(event);
+
+	edge_event_to_data(event, &tmp);
+
+	return gpiod_export_struct(data, size, &tmp, sizeof(tmp),
+				   EDGE_EVENT_DATA_SIZE_V1);
+}
+
 GPIOD_API struct gpiod_edge_event_buffer *
 gpiod_edge_event_buffer_new(size_t capacity)
 {
@@ -163,13 +192,75 @@ gpiod_edge_event_buffer_get_num_events(struct gpiod_edge_event_buffer *buffer)
 	return buffer->num_events;
 }
 
+GPIOD_API int
+gpiod_edge_event_buffer_export(struct gpiod_edge_event_buffer *buffer,
+			       struct gpiod_edge_event_data *data, size_t size,
+			       size_t max_events)
+{
+	struct gpiod_edge_event_data tmp;
+	size_t num_events, i;
+	char *pos;
+	int ret;
+
+	assert(buffer);
+
+	if (!data || size < EDGE_EVENT_DATA_SIZE_V1) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	num_events = buffer->num_events < max_events ? buffer->num_events :
+						       max_events;
+
+	for (i = 0, pos = (char *)data; i < num_events; i++, pos += size) {
+		edge_event_to_data(&buffer->events[i], &tmp);
+
+		ret = gpiod_export_struct(pos, size, &tmp, sizeof(tmp),
+					  EDGE_EVENT_DATA_SIZE_V1);
+		if (ret)
+			return -1;
+	}
+
+	return num_events;
+}
+
+static void edge_event_from_uapi(struct gpiod_edge_event *event,
+				 struct gpio_v2_line_event *uapi_evt)
+{
+	event->line_offset = uapi_evt->offset;
+	event->event_type = uapi_evt->id == GPIO_V2_LINE_EVENT_RISING_EDGE ?
+					GPIOD_EDGE_EVENT_RISING_EDGE :
+					GPIOD_EDGE_EVENT_FALLING_EDGE;
+	event->timestamp = uapi_evt->timestamp_ns;
+	event->global_seqno = uapi_evt->seqno;
+	event->line_seqno = uapi_evt->line_seqno;
+}
+
+static void buffer_convert_events(struct gpiod_edge_event_buffer *buffer)
+{
+	size_t i;
+
+	for (i = 0; i < buffer->num_events; i++)
+		edge_event_from_uapi(&buffer->events[i],
+				     &buffer->event_data[i]);
+}
+
+void gpiod_edge_event_buffer_store_uapi(struct gpiod_edge_event_buffer *buffer,
+					struct gpio_v2_line_event *events,
+					size_t num_events)
+{
+	if (num_events > buffer->capacity)
+		num_events = buffer->capacity;
+
+	memcpy(buffer->event_data, events, sizeof(*events) * num_events);
+	buffer->num_events = num_events;
+	buffer_convert_events(buffer);
+}
+
 int gpiod_edge_event_buffer_read_fd(int fd,
 				    struct gpiod_edge_event_buffer *buffer,
 				    size_t max_events)
 {
-	struct gpio_v2_line_event *curr;
-	struct gpiod_edge_event *event;
-	size_t i;
 	ssize_t rd;
 
 	if (!buffer) {
@@ -194,19 +285,31 @@ int gpiod_edge_event_buffer_read_fd(int fd,
 	}
 
 	buffer->num_events = rd / sizeof(*buffer->event_data);
+	buffer_convert_events(buffer);
+
+	return buffer->num_events;
+}
+
+size_t gpiod_edge_event_buffer_retain(struct gpiod_edge_event_buffer *buffer,
+				      bool (*keep)(struct gpiod_edge_event *,
+						   void *),
+				      void *data)
+{
+	size_t i, num_kept = 0;
 
 	for (i = 0; i < buffer->num_events; i++) {
-		curr = &buffer->event_data[i];
-		event = &buffer->events[i];
-
-		event->line_offset = curr->offset;
-		event->event_type = curr->id == GPIO_V2_LINE_EVENT_RISING_EDGE ?
-					    GPIOD_EDGE_EVENT_RISING_EDGE :
-					    GPIOD_EDGE_EVENT_FALLING_EDGE;
-		event->timestamp = curr->timestamp_ns;
-		event->global_seqno = curr->seqno;
-		event->line_seqno = curr->line_seqno;
+		if (!keep(&buffer->events[i], data))
+			continue;
+
+		if (num_kept != i) {
+			buffer->events[num_kept] = buffer->events[i];
+			buffer->event_data[num_kept] = buffer->event_data[i];
+		}
+
+		num_kept++;
 	}
 
-	return i;
+	buffer->num_events = num_kept;
+
+	return num_kept;
 }
@@ -0,0 +1,324 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <assert.h>
+#include <errno.h>
+#include <gpiod.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "internal.h"
+
+struct limiter_line {
+	unsigned int offset;
+	/* Time it takes for a single token to be refilled. */
+	uint64_t interval_ns;
+	/* How far ahead of the current time the bucket may be drained. */
+	uint64_t burst_ns;
+	/* Time at which the bucket will be full again. */
+	uint64_t full_at;
+	bool explicit;
+	bool limiting;
+	uint64_t num_passed;
+	uint64_t num_suppressed;
+	/* Suppressed edges not yet taken by the user. */
+	uint64_t num_rising;
+	uint64_t num_falling;
+	enum gpiod_edge_event_type last_type;
+	uint64_t last_timestamp;
+};
+
+struct gpiod_edge_limiter {
+	struct limiter_line lines[GPIO_V2_LINES_MAX];
+	size_t num_lines;
+	/* Index of the last line looked up, events tend to come in runs. */
+	size_t last;
+	uint64_t default_interval_ns;
+	uint64_t default_burst_ns;
+};
+
+GPIOD_API struct gpiod_edge_limiter *gpiod_edge_limiter_new(void)
+{
+	struct gpiod_edge_limiter *limiter;
+
+	limiter = malloc(sizeof(*limiter));
+	if (!limiter)
+		return NULL;
+
+	memset(limiter, 0, sizeof(*limiter));
+
+	return limiter;
+}
+
+GPIOD_API void gpiod_edge_limiter_free(struct gpiod_edge_limiter *limiter)
+{
+	free(limiter);
+}
+
+static struct limiter_line *
+limiter_find_line(struct gpiod_edge_limiter *limiter, unsigned int offset)
+{
+	size_t i;
+
+	if (limiter->last < limiter->num_lines &&
+	    limiter->lines[limiter->last].offset == offset)
+		return &limiter->lines[limiter->last];
+
+	for (i = 0; i < limiter->num_lines; i++) {
+		if (limiter->lines[i].offset == offset) {
+			limiter->last = i;
+			return &limiter->lines[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct limiter_line *
+limiter_add_line(struct gpiod_edge_limiter *limiter, unsigned int offset)
+{
+	struct limiter_line *line;
+
+	if (limiter->num_lines == GPIO_V2_LINES_MAX) {
+		errno = ENOSPC;
+		return NULL;
+	}
+
+	line = &limiter->lines[limiter->num_lines++];
+	memset(line, 0, sizeof(*line));
+	line->offset = offset;
+
+	return line;
+}
+
+static int limiter_rate_to_ns(uint64_t events_per_sec, unsigned int burst,
+			      uint64_t *interval_ns, uint64_t *burst_ns)
+{
+	if (!events_per_sec || events_per_sec > 1000000000ULL || !burst) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	*interval_ns = 1000000000ULL / events_per_sec;
+	*burst_ns = *interval_ns * (burst - 1);
+
+	return 0;
+}
+
+GPIOD_API int gpiod_edge_limiter_set_limit(struct gpiod_edge_limiter *limiter,
+					   unsigned int offset,
+					   uint64_t events_per_sec,
+					   unsigned int burst)
+{
+	uint64_t interval_ns, burst_ns;
+	struct limiter_line *line;
+	int ret;
+
+	assert(limiter);
+
+	ret = limiter_rate_to_ns(events_per_sec, burst,
+				 &interval_ns, &burst_ns);
+	if (ret)
+		return -1;
+
+	line = limiter_find_line(limiter, offset);
+	if (!line) {
+		line = limiter_add_line(limiter, offset);
+		if (!line)
+			return -1;
+	}
+
+	line->explicit = true;
+	line->interval_ns = interval_ns;
+	line->burst_ns = burst_ns;
+	line->full_at = 0;
+
+	return 0;
+}
+
+GPIOD_API int
+gpiod_edge_limiter_set_default_limit(struct gpiod_edge_limiter *limiter,
+				     uint64_t events_per_sec,
+				     unsigned int burst)
+{
+	uint64_t interval_ns = 0, burst_ns = 0;
+	struct limiter_line *line;
+	size_t i;
+	int ret;
+
+	assert(limiter);
+
+	if (events_per_sec) {
+		ret = limiter_rate_to_ns(events_per_sec, burst,
+					 &interval_ns, &burst_ns);
+		if (ret)
+			return -1;
+	}
+
+	limiter->default_interval_ns = interval_ns;
+	limiter->default_burst_ns = burst_ns;
+
+	for (i = 0; i < limiter->num_lines; i++) {
+		line = &limiter->lines[i];
+
+		if (line->explicit)
+			continue;
+
+		line->interval_ns = interval_ns;
+		line->burst_ns = burst_ns;
+		line->full_at = 0;
+	}
+
+	return 0;
+}
+
+/*
+ * Token bucket expressed in time: every passed edge moves the refill time
+ * of the bucket by one token interval and edges are let through as long as
+ * the bucket isn't emptier than the burst allows.
+ */
+static bool limiter_keep_event(struct gpiod_edge_event *event, void *data)
+{
+	struct gpiod_edge_limiter *limiter = data;
+	enum gpiod_edge_event_type type;
+	struct limiter_line *line;
+	unsigned int offset;
+	uint64_t now;
+
+	offset = gpiod_edge_event_get_line_offset(event);
+
+	line = limiter_find_line(limiter, offset);
+	if (!line) {
+		if (!limiter->default_interval_ns)
+			return true;
+
+		/*
+		 * Only possible with offsets from more than one request, let
+		 * the event through rather than fail the whole batch.
+		 */
+		line = limiter_add_line(limiter, offset);
+		if (!line)
+			return true;
+
+		line->interval_ns = limiter->default_interval_ns;
+		line->burst_ns = limiter->default_burst_ns;
+		limiter->last = limiter->num_lines - 1;
+	}
+
+	if (!line->interval_ns) {
+		line->num_passed++;
+		return true;
+	}
+
+	now = gpiod_edge_event_get_timestamp_ns(event);
+	if (line->full_at < now)
+		line->full_at = now;
+
+	if (line->full_at - now > line->burst_ns) {
+		line->limiting = true;
+		line->num_suppressed++;
+		type = gpiod_edge_event_get_event_type(event);
+		if (type == GPIOD_EDGE_EVENT_RISING_EDGE)
+			line->num_rising++;
+		else
+			line->num_falling++;
+		line->last_type = type;
+		line->last_timestamp = now;
+		return false;
+	}
+
+	line->full_at += line->interval_ns;
+	line->limiting = false;
+	line->num_passed++;
+
+	return true;
+}
+
+GPIOD_API int gpiod_edge_limiter_process(struct gpiod_edge_limiter *limiter,
+					 struct gpiod_edge_event_buffer *buffer)
+{
+	assert(limiter);
+	assert(buffer);
+
+	return gpiod_edge_event_buffer_retain(buffer, limiter_keep_event,
+					      limiter);
+}
+
+GPIOD_API size_t
+gpiod_edge_limiter_get_suppressed_offsets(struct gpiod_edge_limiter *limiter,
+					  unsigned int *offsets,
+					  size_t max_offsets)
+{
+	struct limiter_line *line;
+	size_t i, num = 0;
+
+	assert(limiter);
+	assert(offsets || !max_offsets);
+
+	for (i = 0; i < limiter->num_lines && num < max_offsets; i++) {
+		line = &limiter->lines[i];
+
+		if (line->num_rising || line->num_falling)
+			offsets[num++] = line->offset;
+	}
+
+	return num;
+}
+
+GPIOD_API int
+gpiod_edge_limiter_take_summary(struct gpiod_edge_limiter *limiter,
+				unsigned int offset, uint64_t *num_rising,
+				uint64_t *num_falling,
+				enum gpiod_edge_event_type *last_type,
+				uint64_t *last_timestamp_ns)
+{
+	struct limiter_line *line;
+
+	assert(limiter);
+
+	line = limiter_find_line(limiter, offset);
+	if (!line) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (num_rising)
+		*num_rising = line->num_rising;
+	if (num_falling)
+		*num_falling = line->num_falling;
+	if (last_type)
+		*last_type = line->last_type;
+	if (last_timestamp_ns)
+		*last_timestamp_ns = line->last_timestamp;
+
+	line->num_rising = 0;
+	line->num_falling = 0;
+
+	return 0;
+}
+
+GPIOD_API int gpiod_edge_limiter_get_stats(struct gpiod_edge_limiter *limiter,
+					   unsigned int offset,
+					   uint64_t *num_passed,
+					   uint64_t *num_suppressed,
+					   bool *limiting)
+{
+	struct limiter_line *line;
+
+	assert(limiter);
+
+	line = limiter_find_line(limiter, offset);
+	if (!line) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (num_passed)
+		*num_passed = line->num_passed;
+	if (num_suppressed)
+		*num_suppressed = line->num_suppressed;
+	if (limiting)
+		*limiting = line->limiting;
+
+	return 0;
+}
@@ -3,6 +3,8 @@
 
 #include <errno.h>
 #include <poll.h>
+#include <pthread.h>
+#include <sched.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -11,6 +13,7 @@
 #include <sys/stat.h>
 #include <sys/sysmacros.h>
 #include <sys/types.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "internal.h"
@@ -82,6 +85,50 @@ out:
 	return ret;
 }
 
+bool gpiod_thread_priority_valid(int priority)
+{
+	return !priority ||
+	       (priority >= sched_get_priority_min(SCHED_FIFO) &&
+		priority <= sched_get_priority_max(SCHED_FIFO));
+}
+
+/*
+ * Spawn a thread running with the given SCHED_FIFO priority or, if it's 0,
+ * with the scheduling policy inherited from the calling thread.
+ */
+int gpiod_thread_create(pthread_t *thread, int priority,
+			void *(*func)(void *), void *data)
+{
+	struct sched_param param;
+	pthread_attr_t attr;
+	int ret;
+
+	ret = pthread_attr_init(&attr);
+	if (ret)
+		return ret;
+
+	if (priority) {
+		memset(&param, 0, sizeof(param));
+		param.sched_priority = priority;
+
+		ret = pthread_attr_setinheritsched(&attr,
+						   PTHREAD_EXPLICIT_SCHED);
+		if (!ret)
+			ret = pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+		if (!ret)
+			ret = pthread_attr_setschedparam(&attr, &param);
+		if (ret)
+			goto out;
+	}
+
+	ret = pthread_create(thread, &attr, func, data);
+
+out:
+	pthread_attr_destroy(&attr);
+
+	return ret;
+}
+
 int gpiod_poll_fd(int fd, int64_t timeout_ns)
 {
 	struct timespec ts;
@@ -106,6 +153,55 @@ int gpiod_poll_fd(int fd, int64_t timeout_ns)
 	return 1;
 }
 
+uint64_t gpiod_monotonic_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* Tell the CPU we're in a spin loop, if it has a way of hearing it. */
+void gpiod_cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__) || \
+      (defined(__arm__) && (__ARM_ARCH >= 7 || defined(__ARM_ARCH_6K__) || \
+			    defined(__ARM_ARCH_6KZ__)))
+	/* The yield hint only exists since ARMv6K. */
+	__asm__ __volatile__("yield" ::: "memory");
+#else
+	__asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+void gpiod_sleep_until(uint64_t deadline_ns, uint64_t spin_ns)
+{
+	struct timespec ts;
+	uint64_t wake;
+	int ret;
+
+	/*
+	 * Sleep on the absolute deadline minus the spin budget and busy-wait
+	 * for the remainder to absorb the scheduler's wake-up latency.
+	 */
+	if (deadline_ns > spin_ns) {
+		wake = deadline_ns - spin_ns;
+		ts.tv_sec = wake / 1000000000ULL;
+		ts.tv_nsec = wake % 1000000000ULL;
+
+		do {
+			ret = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME,
+					      &ts, NULL);
+		} while (ret == EINTR);
+	}
+
+	while (gpiod_monotonic_ns() < deadline_ns)
+		;
+}
+
 int gpiod_set_output_value(enum gpiod_line_value in, enum gpiod_line_value *out)
 {
 	switch (in) {
@@ -134,6 +230,29 @@ int gpiod_ioctl(int fd, unsigned long request, void *arg)
 	return -1;
 }
 
+/*
+ * Copy a structure which only ever grows at the end to a user whose idea of
+ * its size may be older or newer than ours. Fields unknown to the library
+ * are zeroed.
+ */
+int gpiod_export_struct(void *dst, size_t dst_size, const void *src,
+			size_t src_size, size_t min_size)
+{
+	if (!dst || dst_size < min_size) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (dst_size <= src_size) {
+		memcpy(dst, src, dst_size);
+	} else {
+		memcpy(dst, src, src_size);
+		memset((char *)dst + src_size, 0, dst_size - src_size);
+	}
+
+	return 0;
+}
+
 void gpiod_line_mask_zero(uint64_t *mask)
 {
 	*mask = 0ULL;
@@ -5,6 +5,7 @@
 #define __LIBGPIOD_GPIOD_INTERNAL_H__
 
 #include <gpiod.h>
+#include <pthread.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -14,6 +15,8 @@
 
 #define GPIOD_API	__attribute__((visibility("default")))
 #define GPIOD_BIT(nr)	(1UL << (nr))
+#define GPIOD_OFFSETOFEND(type, member) \
+	(offsetof(type, member) + sizeof(((type *)0)->member))
 
 bool gpiod_check_gpiochip_device(const char *path, bool set_errno);
 
@@ -21,6 +24,10 @@ struct gpiod_chip_info *
 gpiod_chip_info_from_uapi(struct gpiochip_info *uapi_info);
 struct gpiod_line_info *
 gpiod_line_info_from_uapi(struct gpio_v2_line_info *uapi_info);
+void gpiod_line_info_update_from_uapi(struct gpiod_line_info *info,
+				      struct gpio_v2_line_info *uapi_info);
+int gpiod_line_info_export_uapi(struct gpio_v2_line_info *uapi_info,
+				struct gpiod_line_info_data *data, size_t size);
 void gpiod_request_config_to_uapi(struct gpiod_request_config *config,
 				  struct gpio_v2_line_request *uapi_req);
 int gpiod_line_config_to_uapi(struct gpiod_line_config *config,
@@ -28,17 +35,82 @@ int gpiod_line_config_to_uapi(struct gpiod_line_config *config,
 struct gpiod_line_request *
 gpiod_line_request_from_uapi(struct gpio_v2_line_request *uapi_req,
 			     const char *chip_name);
+int gpiod_line_request_offsets_to_mask(struct gpiod_line_request *request,
+				       size_t num_offsets,
+				       const unsigned int *offsets,
+				       uint64_t *mask);
+int gpiod_line_request_get_bits(struct gpiod_line_request *request,
+				uint64_t mask, uint64_t *bits);
+int gpiod_line_request_set_bits(struct gpiod_line_request *request,
+				uint64_t mask, uint64_t bits);
+int gpiod_line_request_read_uapi_event(struct gpiod_line_request *request,
+				       struct gpio_v2_line_event *event);
+bool gpiod_line_request_offsets_equal(struct gpiod_line_request *request,
+				      struct gpio_v2_line_request *uapi_cfg);
+int gpiod_line_request_set_uapi_config(struct gpiod_line_request *request,
+				       struct gpio_v2_line_config *uapi_cfg);
+int gpiod_output_journal_bind(struct gpiod_output_journal *journal,
+			      const unsigned int *offsets, size_t num_lines);
+void gpiod_output_journal_unbind(struct gpiod_output_journal *journal);
+void gpiod_output_journal_record(struct gpiod_output_journal *journal,
+				 uint64_t mask, uint64_t bits);
 int gpiod_edge_event_buffer_read_fd(int fd,
 				    struct gpiod_edge_event_buffer *buffer,
 				    size_t max_events);
+void gpiod_edge_event_buffer_store_uapi(struct gpiod_edge_event_buffer *buffer,
+					struct gpio_v2_line_event *events,
+					size_t num_events);
+/* Drop the events for which keep() returns false, preserving the order. */
+size_t gpiod_edge_event_buffer_retain(struct gpiod_edge_event_buffer *buffer,
+				      bool (*keep)(struct gpiod_edge_event *,
+						   void *),
+				      void *data);
 struct gpiod_info_event *
 gpiod_info_event_from_uapi(struct gpio_v2_line_info_changed *uapi_evt);
 struct gpiod_info_event *gpiod_info_event_read_fd(int fd);
 
+struct gpiod_edge_decoder_ops {
+	/* Called for every edge on one of the lines of the decoder. */
+	int (*edge)(struct gpiod_edge_decoder *decoder, unsigned int offset,
+		    bool rising, uint64_t timestamp_ns);
+	/* Called to tell the decoder how far the time has advanced. */
+	int (*flush)(struct gpiod_edge_decoder *decoder,
+		     uint64_t timestamp_ns);
+	bool (*uses_offset)(struct gpiod_edge_decoder *decoder,
+			    unsigned int offset);
+};
+
+struct gpiod_edge_decoder *
+gpiod_edge_decoder_new(const struct gpiod_edge_decoder_ops *ops, void *priv);
+void *gpiod_edge_decoder_get_priv(struct gpiod_edge_decoder *decoder);
+int gpiod_edge_decoder_push_frame(struct gpiod_edge_decoder *decoder,
+				  uint64_t data, unsigned int num_bits,
+				  uint64_t timestamp_ns, unsigned int flags);
+
+enum {
+	GPIOD_SLAB_EDGE_EVENT = 0,
+	GPIOD_SLAB_LINE_INFO,
+	GPIOD_SLAB_NUM_CACHES,
+};
+
+/* All objects of a cache must be of the same size. */
+void *gpiod_slab_alloc(unsigned int cache_id, size_t size);
+void gpiod_slab_free(unsigned int cache_id, void *obj);
+
+bool gpiod_thread_priority_valid(int priority);
+/* Returns an errno value like pthread_create(). */
+int gpiod_thread_create(pthread_t *thread, int priority,
+			void *(*func)(void *), void *data);
+
 int gpiod_poll_fd(int fd, int64_t timeout);
+uint64_t gpiod_monotonic_ns(void);
+void gpiod_cpu_relax(void);
+void gpiod_sleep_until(uint64_t deadline_ns, uint64_t spin_ns);
 int gpiod_set_output_value(enum gpiod_line_value in,
 			   enum gpiod_line_value *out);
 int gpiod_ioctl(int fd, unsigned long request, void *arg);
+int gpiod_export_struct(void *dst, size_t dst_size, const void *src,
+			size_t src_size, size_t min_size);
 
 void gpiod_line_mask_zero(uint64_t *mask);
 bool gpiod_line_mask_test_bit(const uint64_t *mask, int nr);
@@ -0,0 +1,452 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <gpiod.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "internal.h"
+
+#define KEYPAD_MAX_KEYS			64
+#define KEYPAD_MAX_DEBOUNCE		8
+#define KEYPAD_DEFAULT_DEBOUNCE		3
+#define KEYPAD_DEFAULT_PERIOD_NS	10000000ULL
+/* Longest part of the settle time that is busy-waited. */
+#define KEYPAD_SPIN_NS			50000ULL
+
+/* Record written to the event pipe. */
+struct keypad_event {
+	uint64_t timestamp;
+	uint32_t key;
+	uint32_t pressed;
+};
+
+struct gpiod_keypad {
+	struct gpiod_line_request *rows_request;
+	struct gpiod_line_request *cols_request;
+	size_t num_rows;
+	size_t num_cols;
+	uint64_t rows_mask;
+	uint64_t cols_mask;
+	/* Request bits of every row and column. */
+	uint64_t row_bits[KEYPAD_MAX_KEYS];
+	uint64_t col_bits[KEYPAD_MAX_KEYS];
+	uint64_t period_ns;
+	uint64_t settle_ns;
+	/* Raw key bitmaps of the last debounce_scans scans. */
+	uint64_t samples[KEYPAD_MAX_DEBOUNCE];
+	unsigned int debounce_scans;
+	unsigned int next_sample;
+	uint64_t state;
+	uint64_t num_dropped;
+	int event_fds[2];
+	pthread_t thread;
+	int stop_fd;
+	bool running;
+	int error;
+};
+
+static int keypad_offsets_to_bits(struct gpiod_line_request *request,
+				  const unsigned int *offsets, size_t num_lines,
+				  uint64_t *bits, uint64_t *mask)
+{
+	size_t i;
+	int ret;
+
+	*mask = 0;
+
+	for (i = 0; i < num_lines; i++) {
+		ret = gpiod_line_request_offsets_to_mask(request, 1,
+							 &offsets[i], &bits[i]);
+		if (ret)
+			return -1;
+
+		/* Each line can only be used once. */
+		if (*mask & bits[i]) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		*mask |= bits[i];
+	}
+
+	return 0;
+}
+
+GPIOD_API struct gpiod_keypad *
+gpiod_keypad_new(struct gpiod_line_request *rows_request,
+		 const unsigned int *row_offsets, size_t num_rows,
+		 struct gpiod_line_request *cols_request,
+		 const unsigned int *col_offsets, size_t num_cols)
+{
+	struct gpiod_keypad *keypad;
+	int ret;
+
+	assert(rows_request);
+	assert(row_offsets);
+	assert(cols_request);
+	assert(col_offsets);
+
+	/* Bound the factors first so that the product can't overflow. */
+	if (!num_rows || !num_cols || num_rows > KEYPAD_MAX_KEYS ||
+	    num_cols > KEYPAD_MAX_KEYS || num_rows * num_cols > KEYPAD_MAX_KEYS) {
+		errno = EINVAL;
+		return NULL;
+	}
+
+	keypad = malloc(sizeof(*keypad));
+	if (!keypad)
+		return NULL;
+
+	memset(keypad, 0, sizeof(*keypad));
+	keypad->rows_request = rows_request;
+	keypad->cols_request = cols_request;
+	keypad->num_rows = num_rows;
+	keypad->num_cols = num_cols;
+	keypad->period_ns = KEYPAD_DEFAULT_PERIOD_NS;
+	keypad->debounce_scans = KEYPAD_DEFAULT_DEBOUNCE;
+	keypad->stop_fd = -1;
+
+	ret = keypad_offsets_to_bits(rows_request, row_offsets, num_rows,
+				     keypad->row_bits, &keypad->rows_mask);
+	if (ret)
+		goto err_free;
+
+	ret = keypad_offsets_to_bits(cols_request, col_offsets, num_cols,
+				     keypad->col_bits, &keypad->cols_mask);
+	if (ret)
+		goto err_free;
+
+	if (rows_request == cols_request &&
+	    (keypad->rows_mask & keypad->cols_mask)) {
+		errno = EINVAL;
+		goto err_free;
+	}
+
+	ret = pipe2(keypad->event_fds, O_CLOEXEC);
+	if (ret)
+		goto err_free;
+
+	/* Never block the scanner on a reader that doesn't keep up. */
+	ret = fcntl(keypad->event_fds[1], F_SETFL, O_NONBLOCK);
+	if (ret)
+		goto err_close;
+
+	return keypad;
+
+err_close:
+	close(keypad->event_fds[0]);
+	close(keypad->event_fds[1]);
+err_free:
+	free(keypad);
+	return NULL;
+}
+
+GPIOD_API void gpiod_keypad_free(struct gpiod_keypad *keypad)
+{
+	if (!keypad)
+		return;
+
+	if (keypad->running)
+		gpiod_keypad_stop(keypad);
+
+	close(keypad->event_fds[0]);
+	close(keypad->event_fds[1]);
+	free(keypad);
+}
+
+GPIOD_API void gpiod_keypad_set_scan_period(struct gpiod_keypad *keypad,
+					    uint64_t period_ns)
+{
+	assert(keypad);
+
+	keypad->period_ns = period_ns ?: KEYPAD_DEFAULT_PERIOD_NS;
+}
+
+GPIOD_API void gpiod_keypad_set_settle_time(struct gpiod_keypad *keypad,
+					    uint64_t settle_ns)
+{
+	assert(keypad);
+
+	keypad->settle_ns = settle_ns;
+}
+
+GPIOD_API int gpiod_keypad_set_debounce(struct gpiod_keypad *keypad,
+					unsigned int num_scans)
+{
+	assert(keypad);
+
+	if (keypad->running) {
+		errno = EBUSY;
+		return -1;
+	}
+
+	if (!num_scans || num_scans > KEYPAD_MAX_DEBOUNCE) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	keypad->debounce_scans = num_scans;
+	keypad->next_sample = 0;
+	memset(keypad->samples, 0, sizeof(keypad->samples));
+
+	return 0;
+}
+
+static void keypad_emit(struct gpiod_keypad *keypad, uint64_t changed,
+			uint64_t state, uint64_t timestamp)
+{
+	struct keypad_event event;
+	unsigned int key;
+	ssize_t wr;
+
+	memset(&event, 0, sizeof(event));
+	event.timestamp = timestamp;
+
+	while (changed) {
+		key = __builtin_ctzll(changed);
+		changed &= changed - 1;
+
+		event.key = key;
+		event.pressed = !!(state & (1ULL << key));
+
+		/*
+		 * Records are smaller than PIPE_BUF so they're written whole
+		 * or not at all. If the pipe is full, the event is dropped.
+		 */
+		wr = write(keypad->event_fds[1], &event, sizeof(event));
+		if (wr < 0)
+			__atomic_add_fetch(&keypad->num_dropped, 1,
+					   __ATOMIC_RELAXED);
+	}
+}
+
+static int keypad_do_scan(struct gpiod_keypad *keypad)
+{
+	uint64_t raw = 0, cols, pressed, released, state, deadline;
+	size_t row, col;
+	unsigned int i;
+	int ret;
+
+	for (row = 0; row < keypad->num_rows; row++) {
+		ret = gpiod_line_request_set_bits(keypad->rows_request,
+						  keypad->rows_mask,
+						  keypad->row_bits[row]);
+		if (ret)
+			return -1;
+
+		if (keypad->settle_ns) {
+			deadline = gpiod_monotonic_ns() + keypad->settle_ns;
+			gpiod_sleep_until(deadline,
+					  keypad->settle_ns < KEYPAD_SPIN_NS ?
+					  keypad->settle_ns : KEYPAD_SPIN_NS);
+		}
+
+		ret = gpiod_line_request_get_bits(keypad->cols_request,
+						  keypad->cols_mask, &cols);
+		if (ret)
+			return -1;
+
+		if (!cols)
+			continue;
+
+		for (col = 0; col < keypad->num_cols; col++) {
+			if (cols & keypad->col_bits[col])
+				raw |= 1ULL << (row * keypad->num_cols + col);
+		}
+	}
+
+	keypad->samples[keypad->next_sample] = raw;
+	keypad->next_sample = (keypad->next_sample + 1) %
+			      keypad->debounce_scans;
+
+	/*
+	 * Debounce all keys at once: a key changes state once it has been
+	 * seen in the new state in every one of the recent scans.
+	 */
+	pressed = ~0ULL;
+	released = 0;
+	for (i = 0; i < keypad->debounce_scans; i++) {
+		pressed &= keypad->samples[i];
+		released |= keypad->samples[i];
+	}
+
+	state = (keypad->state | pressed) & released;
+	if (state != keypad->state) {
+		keypad_emit(keypad, state ^ keypad->state, state,
+			    gpiod_monotonic_ns());
+		__atomic_store_n(&keypad->state, state, __ATOMIC_RELAXED);
+	}
+
+	return 0;
+}
+
+GPIOD_API int gpiod_keypad_scan(struct gpiod_keypad *keypad)
+{
+	assert(keypad);
+
+	if (keypad->running) {
+		errno = EBUSY;
+		return -1;
+	}
+
+	return keypad_do_scan(keypad);
+}
+
+static void *keypad_thread_func(void *data)
+{
+	struct gpiod_keypad *keypad = data;
+	uint64_t deadline, now;
+	struct pollfd pfd;
+	struct timespec ts;
+	int ret;
+
+	pfd.fd = keypad->stop_fd;
+	pfd.events = POLLIN;
+
+	deadline = gpiod_monotonic_ns();
+
+	for (;;) {
+		ret = keypad_do_scan(keypad);
+		if (ret)
+			goto err;
+
+		deadline += keypad->period_ns;
+		now = gpiod_monotonic_ns();
+		/* Don't try to catch up after falling behind. */
+		if (deadline < now)
+			deadline = now;
+
+		ts.tv_sec = (deadline - now) / 1000000000ULL;
+		ts.tv_nsec = (deadline - now) % 1000000000ULL;
+
+		ret = ppoll(&pfd, 1, &ts, NULL);
+		if (ret < 0 && errno != EINTR)
+			goto err;
+		if (ret > 0)
+			break;
+	}
+
+	return NULL;
+
+err:
+	__atomic_store_n(&keypad->error, errno, __ATOMIC_RELAXED);
+	return NULL;
+}
+
+GPIOD_API int gpiod_keypad_start(struct gpiod_keypad *keypad)
+{
+	int ret;
+
+	assert(keypad);
+
+	if (keypad->running) {
+		errno = EBUSY;
+		return -1;
+	}
+
+	keypad->stop_fd = eventfd(0, EFD_CLOEXEC);
+	if (keypad->stop_fd < 0)
+		return -1;
+
+	keypad->error = 0;
+
+	ret = pthread_create(&keypad->thread, NULL, keypad_thread_func, keypad);
+	if (ret) {
+		close(keypad->stop_fd);
+		keypad->stop_fd = -1;
+		errno = ret;
+		return -1;
+	}
+
+	keypad->running = true;
+
+	return 0;
+}
+
+GPIOD_API int gpiod_keypad_stop(struct gpiod_keypad *keypad)
+{
+	uint64_t one = 1;
+	ssize_t wr;
+
+	assert(keypad);
+
+	if (!keypad->running) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	wr = write(keypad->stop_fd, &one, sizeof(one));
+	if (wr < 0)
+		return -1;
+
+	pthread_join(keypad->thread, NULL);
+	close(keypad->stop_fd);
+	keypad->stop_fd = -1;
+	keypad->running = false;
+
+	if (keypad->error) {
+		errno = keypad->error;
+		return -1;
+	}
+
+	return 0;
+}
+
+GPIOD_API int gpiod_keypad_get_fd(struct gpiod_keypad *keypad)
+{
+	assert(keypad);
+
+	return keypad->event_fds[0];
+}
+
+GPIOD_API int gpiod_keypad_read_event(struct gpiod_keypad *keypad,
+				      unsigned int *key, bool *pressed,
+				      uint64_t *timestamp_ns)
+{
+	struct keypad_event event;
+	ssize_t rd;
+
+	assert(keypad);
+
+	do {
+		rd = read(keypad->event_fds[0], &event, sizeof(event));
+	} while (rd < 0 && errno == EINTR);
+	if (rd < 0)
+		return -1;
+
+	if (rd != sizeof(event)) {
+		errno = EIO;
+		return -1;
+	}
+
+	if (key)
+		*key = event.key;
+	if (pressed)
+		*pressed = event.pressed;
+	if (timestamp_ns)
+		*timestamp_ns = event.timestamp;
+
+	return 0;
+}
+
+GPIOD_API uint64_t gpiod_keypad_get_state(struct gpiod_keypad *keypad)
+{
+	assert(keypad);
+
+	return __atomic_load_n(&keypad->state, __ATOMIC_RELAXED);
+}
+
+GPIOD_API uint64_t gpiod_keypad_get_num_dropped(struct gpiod_keypad *keypad)
+{
+	assert(keypad);
+
+	return __atomic_load_n(&keypad->num_dropped, __ATOMIC_RELAXED);
+}
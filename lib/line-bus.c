@@ -0,0 +1,221 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <assert.h>
+#include <errno.h>
+#include <gpiod.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "internal.h"
+
+#define LINE_BUS_MAX_WIDTH	64
+
+struct line_bus_segment {
+	struct gpiod_line_request *request;
+	/* Bits of the request covered by the bus. */
+	uint64_t mask;
+};
+
+/*
+ * A run of consecutive bus bits that map onto consecutive bits of the same
+ * request and so can be converted with a single shift.
+ */
+struct line_bus_run {
+	size_t segment;
+	/* Bits of the bus word covered by the run. */
+	uint64_t mask;
+	/* Request bit index minus bus bit index. */
+	int shift;
+};
+
+struct gpiod_line_bus {
+	size_t width;
+	struct line_bus_segment segments[LINE_BUS_MAX_WIDTH];
+	size_t num_segments;
+	struct line_bus_run runs[LINE_BUS_MAX_WIDTH];
+	size_t num_runs;
+};
+
+GPIOD_API struct gpiod_line_bus *gpiod_line_bus_new(void)
+{
+	struct gpiod_line_bus *bus;
+
+	bus = malloc(sizeof(*bus));
+	if (!bus)
+		return NULL;
+
+	memset(bus, 0, sizeof(*bus));
+
+	return bus;
+}
+
+GPIOD_API void gpiod_line_bus_free(struct gpiod_line_bus *bus)
+{
+	free(bus);
+}
+
+static size_t line_bus_get_segment(struct gpiod_line_bus *bus,
+				   struct gpiod_line_request *request)
+{
+	size_t i;
+
+	for (i = 0; i < bus->num_segments; i++) {
+		if (bus->segments[i].request == request)
+			return i;
+	}
+
+	bus->segments[i].request = request;
+	bus->segments[i].mask = 0;
+	bus->num_segments++;
+
+	return i;
+}
+
+static void line_bus_append_bit(struct gpiod_line_bus *bus, size_t segment,
+				unsigned int req_bit)
+{
+	struct line_bus_run *run = NULL;
+	int shift = (int)req_bit - (int)bus->width;
+
+	if (bus->num_runs)
+		run = &bus->runs[bus->num_runs - 1];
+
+	if (!run || run->segment != segment || run->shift != shift) {
+		run = &bus->runs[bus->num_runs++];
+		run->segment = segment;
+		run->mask = 0;
+		run->shift = shift;
+	}
+
+	gpiod_line_mask_set_bit(&run->mask, bus->width);
+	gpiod_line_mask_set_bit(&bus->segments[segment].mask, req_bit);
+	bus->width++;
+}
+
+GPIOD_API int gpiod_line_bus_add_lines(struct gpiod_line_bus *bus,
+				       struct gpiod_line_request *request,
+				       size_t num_lines,
+				       const unsigned int *offsets)
+{
+	unsigned int req_bits[LINE_BUS_MAX_WIDTH];
+	uint64_t mask, bit;
+	size_t i, segment;
+	int ret;
+
+	assert(bus);
+	assert(request);
+
+	if (!offsets || !num_lines ||
+	    num_lines > LINE_BUS_MAX_WIDTH - bus->width) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Validate everything up front so that a failure leaves no trace. */
+	gpiod_line_mask_zero(&mask);
+	for (i = 0; i < bus->num_segments; i++) {
+		if (bus->segments[i].request == request)
+			mask = bus->segments[i].mask;
+	}
+
+	for (i = 0; i < num_lines; i++) {
+		ret = gpiod_line_request_offsets_to_mask(request, 1,
+							 &offsets[i], &bit);
+		if (ret)
+			return -1;
+
+		if (mask & bit) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		mask |= bit;
+		req_bits[i] = __builtin_ctzll(bit);
+	}
+
+	segment = line_bus_get_segment(bus, request);
+
+	for (i = 0; i < num_lines; i++)
+		line_bus_append_bit(bus, segment, req_bits[i]);
+
+	return 0;
+}
+
+GPIOD_API size_t gpiod_line_bus_get_width(struct gpiod_line_bus *bus)
+{
+	assert(bus);
+
+	return bus->width;
+}
+
+static uint64_t line_bus_shift(uint64_t val, int shift)
+{
+	return shift >= 0 ? val << shift : val >> -shift;
+}
+
+GPIOD_API int gpiod_line_bus_write(struct gpiod_line_bus *bus, uint64_t word)
+{
+	uint64_t bits[LINE_BUS_MAX_WIDTH];
+	struct line_bus_run *run;
+	size_t i;
+	int ret;
+
+	assert(bus);
+
+	if (!bus->width) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	memset(bits, 0, bus->num_segments * sizeof(*bits));
+
+	for (i = 0; i < bus->num_runs; i++) {
+		run = &bus->runs[i];
+		bits[run->segment] |= line_bus_shift(word & run->mask,
+						     run->shift);
+	}
+
+	for (i = 0; i < bus->num_segments; i++) {
+		ret = gpiod_line_request_set_bits(bus->segments[i].request,
+						  bus->segments[i].mask,
+						  bits[i]);
+		if (ret)
+			return -1;
+	}
+
+	return 0;
+}
+
+GPIOD_API int gpiod_line_bus_read(struct gpiod_line_bus *bus, uint64_t *word)
+{
+	uint64_t bits[LINE_BUS_MAX_WIDTH], val = 0;
+	struct line_bus_run *run;
+	size_t i;
+	int ret;
+
+	assert(bus);
+
+	if (!word || !bus->width) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	for (i = 0; i < bus->num_segments; i++) {
+		ret = gpiod_line_request_get_bits(bus->segments[i].request,
+						  bus->segments[i].mask,
+						  &bits[i]);
+		if (ret)
+			return -1;
+	}
+
+	for (i = 0; i < bus->num_runs; i++) {
+		run = &bus->runs[i];
+		val |= line_bus_shift(bits[run->segment], -run->shift) &
+		       run->mask;
+	}
+
+	*word = val;
+
+	return 0;
+}
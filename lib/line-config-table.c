@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <assert.h>
+#include <errno.h>
+#include <gpiod.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "internal.h"
+
+#define LINE_CONFIG_TABLE_MIN_CONFIGS	4
+
+struct gpiod_line_config_table {
+	struct gpiod_line_request *request;
+	/* Configs converted once, ready to be passed to the kernel. */
+	struct gpio_v2_line_config *configs;
+	size_t num_configs;
+	size_t max_configs;
+};
+
+GPIOD_API struct gpiod_line_config_table *
+gpiod_line_config_table_new(struct gpiod_line_request *request)
+{
+	struct gpiod_line_config_table *table;
+
+	assert(request);
+
+	table = malloc(sizeof(*table));
+	if (!table)
+		return NULL;
+
+	memset(table, 0, sizeof(*table));
+	table->request = request;
+
+	return table;
+}
+
+GPIOD_API void
+gpiod_line_config_table_free(struct gpiod_line_config_table *table)
+{
+	if (!table)
+		return;
+
+	free(table->configs);
+	free(table);
+}
+
+GPIOD_API int
+gpiod_line_config_table_add_config(struct gpiod_line_config_table *table,
+				   struct gpiod_line_config *config)
+{
+	struct gpio_v2_line_request uapi_cfg;
+	struct gpio_v2_line_config *configs;
+	size_t max;
+	int ret;
+
+	assert(table);
+
+	if (!config) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	memset(&uapi_cfg, 0, sizeof(uapi_cfg));
+
+	ret = gpiod_line_config_to_uapi(config, &uapi_cfg);
+	if (ret)
+		return -1;
+
+	if (!gpiod_line_request_offsets_equal(table->request, &uapi_cfg)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (table->num_configs == table->max_configs) {
+		max = table->max_configs * 2 ?: LINE_CONFIG_TABLE_MIN_CONFIGS;
+		configs = realloc(table->configs, max * sizeof(*configs));
+		if (!configs)
+			return -1;
+
+		table->configs = configs;
+		table->max_configs = max;
+	}
+
+	table->configs[table->num_configs] = uapi_cfg.config;
+
+	return table->num_configs++;
+}
+
+GPIOD_API size_t
+gpiod_line_config_table_get_num_configs(struct gpiod_line_config_table *table)
+{
+	assert(table);
+
+	return table->num_configs;
+}
+
+GPIOD_API int
+gpiod_line_config_table_apply(struct gpiod_line_config_table *table,
+			      unsigned int index)
+{
+	assert(table);
+
+	if (index >= table->num_configs) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return gpiod_line_request_set_uapi_config(table->request,
+						  &table->configs[index]);
+}
+
+GPIOD_API int
+gpiod_line_config_table_apply_with_values(struct gpiod_line_config_table *table,
+					  unsigned int index,
+					  const enum gpiod_line_value *values)
+{
+	struct gpio_v2_line_config_attribute *attr;
+	struct gpio_v2_line_config uapi_cfg;
+	size_t num_lines, i;
+	uint64_t bits = 0;
+
+	assert(table);
+
+	if (index >= table->num_configs || !values) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	num_lines = gpiod_line_request_get_num_requested_lines(table->request);
+
+	for (i = 0; i < num_lines; i++) {
+		switch (values[i]) {
+		case GPIOD_LINE_VALUE_ACTIVE:
+			bits |= 1ULL << i;
+			break;
+		case GPIOD_LINE_VALUE_INACTIVE:
+			break;
+		default:
+			errno = EINVAL;
+			return -1;
+		}
+	}
+
+	uapi_cfg = table->configs[index];
+
+	/*
+	 * If any line is an output, the output values are always the first
+	 * attribute of the config. Without outputs there's nothing to set.
+	 */
+	attr = &uapi_cfg.attrs[0];
+	if (uapi_cfg.num_attrs &&
+	    attr->attr.id == GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES)
+		attr->attr.values = bits & attr->mask;
+
+	return gpiod_line_request_set_uapi_config(table->request, &uapi_cfg);
+}
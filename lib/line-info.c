@@ -3,7 +3,6 @@
 
 #include <assert.h>
 #include <gpiod.h>
-#include <stdlib.h>
 #include <string.h>
 
 #include "internal.h"
@@ -25,7 +24,7 @@ struct gpiod_line_info {
 
 GPIOD_API void gpiod_line_info_free(struct gpiod_line_info *info)
 {
-	free(info);
+	gpiod_slab_free(GPIOD_SLAB_LINE_INFO, info);
 }
 
 GPIOD_API struct gpiod_line_info *
@@ -35,7 +34,7 @@ gpiod_line_info_copy(struct gpiod_line_info *info)
 
 	assert(info);
 
-	copy = malloc(sizeof(*info));
+	copy = gpiod_slab_alloc(GPIOD_SLAB_LINE_INFO, sizeof(*info));
 	if (!copy)
 		return NULL;
 
@@ -134,17 +133,40 @@ gpiod_line_info_get_debounce_period_us(struct gpiod_line_info *info)
 	return info->debounce_period_us;
 }
 
-struct gpiod_line_info *
-gpiod_line_info_from_uapi(struct gpio_v2_line_info *uapi_info)
+GPIOD_API int gpiod_line_info_export(struct gpiod_line_info *info,
+				     struct gpiod_line_info_data *data,
+				     size_t size)
+{
+	struct gpiod_line_info_data tmp;
+
+	assert(info);
+
+	memset(&tmp, 0, sizeof(tmp));
+
+	tmp.offset = info->offset;
+	memcpy(tmp.name, info->name, sizeof(tmp.name));
+	memcpy(tmp.consumer, info->consumer, sizeof(tmp.consumer));
+	tmp.used = info->used;
+	tmp.active_low = info->active_low;
+	tmp.debounced = info->debounced;
+	tmp.direction = info->direction;
+	tmp.bias = info->bias;
+	tmp.drive = info->drive;
+	tmp.edge_detection = info->edge;
+	tmp.event_clock = info->event_clock;
+	tmp.debounce_period_us = info->debounce_period_us;
+
+	return gpiod_export_struct(data, size, &tmp, sizeof(tmp),
+				   GPIOD_OFFSETOFEND(struct gpiod_line_info_data,
+						     debounce_period_us));
+}
+
+void gpiod_line_info_update_from_uapi(struct gpiod_line_info *info,
+				      struct gpio_v2_line_info *uapi_info)
 {
 	struct gpio_v2_line_attribute *attr;
-	struct gpiod_line_info *info;
 	size_t i;
 
-	info = malloc(sizeof(*info));
-	if (!info)
-		return NULL;
-
 	memset(info, 0, sizeof(*info));
 
 	info->offset = uapi_info->offset;
@@ -206,6 +228,28 @@ gpiod_line_info_from_uapi(struct gpio_v2_line_info *uapi_info)
 			info->debounce_period_us = attr->debounce_period_us;
 		}
 	}
+}
+
+struct gpiod_line_info *
+gpiod_line_info_from_uapi(struct gpio_v2_line_info *uapi_info)
+{
+	struct gpiod_line_info *info;
+
+	info = gpiod_slab_alloc(GPIOD_SLAB_LINE_INFO, sizeof(*info));
+	if (!info)
+		return NULL;
+
+	gpiod_line_info_update_from_uapi(info, uapi_info);
 
 	return info;
 }
+
+int gpiod_line_info_export_uapi(struct gpio_v2_line_info *uapi_info,
+				struct gpiod_line_info_data *data, size_t size)
+{
+	struct gpiod_line_info info;
+
+	gpiod_line_info_update_from_uapi(&info, uapi_info);
+
+	return gpiod_line_info_export(&info, data, size);
+}
@@ -0,0 +1,473 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <assert.h>
+#include <errno.h>
+#include <gpiod.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "internal.h"
+
+#define LINE_PROGRAM_MAX_LOOP_DEPTH	8
+
+enum line_program_op_type {
+	LINE_PROGRAM_OP_SET = 1,
+	LINE_PROGRAM_OP_GET,
+	LINE_PROGRAM_OP_SLEEP_UNTIL,
+	LINE_PROGRAM_OP_WAIT_EDGE,
+	LINE_PROGRAM_OP_LOOP,
+	LINE_PROGRAM_OP_END_LOOP,
+};
+
+struct line_program_op {
+	enum line_program_op_type type;
+	struct gpiod_line_request *request;
+	uint64_t mask;
+	uint64_t bits;
+	/* Sleep offset or wait timeout. */
+	int64_t time_ns;
+	enum gpiod_line_edge edge;
+	/* Iteration count for LOOP, index of the matching LOOP for END_LOOP. */
+	size_t arg;
+};
+
+struct gpiod_line_program {
+	struct line_program_op *ops;
+	size_t num_ops;
+	size_t max_ops;
+	/* Indices of the LOOP ops that haven't been closed yet. */
+	size_t open_loops[LINE_PROGRAM_MAX_LOOP_DEPTH];
+	size_t loop_depth;
+	size_t num_results;
+};
+
+struct line_program_loop {
+	size_t begin;
+	size_t remaining;
+	uint64_t iteration_start;
+	/* Deadline of the last sleep of the current iteration. */
+	uint64_t last_deadline;
+};
+
+GPIOD_API struct gpiod_line_program *gpiod_line_program_new(void)
+{
+	struct gpiod_line_program *program;
+
+	program = malloc(sizeof(*program));
+	if (!program)
+		return NULL;
+
+	memset(program, 0, sizeof(*program));
+
+	return program;
+}
+
+GPIOD_API void gpiod_line_program_free(struct gpiod_line_program *program)
+{
+	if (!program)
+		return;
+
+	free(program->ops);
+	free(program);
+}
+
+static struct line_program_op *
+line_program_append(struct gpiod_line_program *program,
+		    enum line_program_op_type type)
+{
+	struct line_program_op *ops, *op;
+	size_t max_ops;
+
+	if (program->num_ops == program->max_ops) {
+		max_ops = program->max_ops ? program->max_ops * 2 : 16;
+
+		ops = realloc(program->ops, max_ops * sizeof(*ops));
+		if (!ops)
+			return NULL;
+
+		program->ops = ops;
+		program->max_ops = max_ops;
+	}
+
+	op = &program->ops[program->num_ops++];
+	memset(op, 0, sizeof(*op));
+	op->type = type;
+
+	return op;
+}
+
+static int line_program_check_mask(struct gpiod_line_request *request,
+				   uint64_t mask)
+{
+	size_t num_lines = gpiod_line_request_get_num_requested_lines(request);
+
+	if (!mask || (num_lines < 64 && (mask >> num_lines))) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return 0;
+}
+
+/*
+ * Number of times the op about to be appended will run per program run.
+ * The number of results is returned as an int by gpiod_line_program_run(),
+ * so anything above INT_MAX is an overflow.
+ */
+static int line_program_multiplier(struct gpiod_line_program *program,
+				   size_t *mult)
+{
+	size_t i;
+
+	*mult = 1;
+
+	for (i = 0; i < program->loop_depth; i++) {
+		if (__builtin_mul_overflow(*mult,
+					   program->ops[program->open_loops[i]].arg,
+					   mult) ||
+		    *mult > INT_MAX) {
+			errno = EOVERFLOW;
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+/* Check that an op storing a result can be appended and count its results. */
+static int line_program_add_results(struct gpiod_line_program *program,
+				    size_t *num_results)
+{
+	size_t mult;
+
+	if (line_program_multiplier(program, &mult))
+		return -1;
+
+	if (__builtin_add_overflow(program->num_results, mult, num_results) ||
+	    *num_results > INT_MAX) {
+		errno = EOVERFLOW;
+		return -1;
+	}
+
+	return 0;
+}
+
+GPIOD_API int gpiod_line_program_add_set(struct gpiod_line_program *program,
+					 struct gpiod_line_request *request,
+					 uint64_t mask, uint64_t bits)
+{
+	struct line_program_op *op;
+
+	assert(program);
+	assert(request);
+
+	if (line_program_check_mask(request, mask))
+		return -1;
+
+	op = line_program_append(program, LINE_PROGRAM_OP_SET);
+	if (!op)
+		return -1;
+
+	op->request = request;
+	op->mask = mask;
+	op->bits = bits & mask;
+
+	return 0;
+}
+
+GPIOD_API int gpiod_line_program_add_get(struct gpiod_line_program *program,
+					 struct gpiod_line_request *request,
+					 uint64_t mask)
+{
+	struct line_program_op *op;
+	size_t num_results;
+
+	assert(program);
+	assert(request);
+
+	if (line_program_check_mask(request, mask))
+		return -1;
+
+	if (line_program_add_results(program, &num_results))
+		return -1;
+
+	op = line_program_append(program, LINE_PROGRAM_OP_GET);
+	if (!op)
+		return -1;
+
+	op->request = request;
+	op->mask = mask;
+	program->num_results = num_results;
+
+	return 0;
+}
+
+GPIOD_API int
+gpiod_line_program_add_sleep_until(struct gpiod_line_program *program,
+				   uint64_t offset_ns)
+{
+	struct line_program_op *op;
+
+	assert(program);
+
+	if (offset_ns > INT64_MAX) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	op = line_program_append(program, LINE_PROGRAM_OP_SLEEP_UNTIL);
+	if (!op)
+		return -1;
+
+	op->time_ns = offset_ns;
+
+	return 0;
+}
+
+GPIOD_API int
+gpiod_line_program_add_wait_edge(struct gpiod_line_program *program,
+				 struct gpiod_line_request *request,
+				 uint64_t mask, enum gpiod_line_edge edge,
+				 int64_t timeout_ns)
+{
+	struct line_program_op *op;
+	size_t num_results;
+
+	assert(program);
+	assert(request);
+
+	if (line_program_check_mask(request, mask))
+		return -1;
+
+	switch (edge) {
+	case GPIOD_LINE_EDGE_RISING:
+	case GPIOD_LINE_EDGE_FALLING:
+	case GPIOD_LINE_EDGE_BOTH:
+		break;
+	default:
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (line_program_add_results(program, &num_results))
+		return -1;
+
+	op = line_program_append(program, LINE_PROGRAM_OP_WAIT_EDGE);
+	if (!op)
+		return -1;
+
+	op->request = request;
+	op->mask = mask;
+	op->edge = edge;
+	op->time_ns = timeout_ns;
+	program->num_results = num_results;
+
+	return 0;
+}
+
+GPIOD_API int gpiod_line_program_begin_loop(struct gpiod_line_program *program,
+					    unsigned int count)
+{
+	struct line_program_op *op;
+	size_t mult;
+
+	assert(program);
+
+	if (!count || program->loop_depth == LINE_PROGRAM_MAX_LOOP_DEPTH) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (line_program_multiplier(program, &mult))
+		return -1;
+
+	if (__builtin_mul_overflow(mult, (size_t)count, &mult) ||
+	    mult > INT_MAX) {
+		errno = EOVERFLOW;
+		return -1;
+	}
+
+	op = line_program_append(program, LINE_PROGRAM_OP_LOOP);
+	if (!op)
+		return -1;
+
+	op->arg = count;
+	program->open_loops[program->loop_depth++] = program->num_ops - 1;
+
+	return 0;
+}
+
+GPIOD_API int gpiod_line_program_end_loop(struct gpiod_line_program *program)
+{
+	struct line_program_op *op;
+
+	assert(program);
+
+	if (!program->loop_depth) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	op = line_program_append(program, LINE_PROGRAM_OP_END_LOOP);
+	if (!op)
+		return -1;
+
+	op->arg = program->open_loops[--program->loop_depth];
+
+	return 0;
+}
+
+GPIOD_API size_t
+gpiod_line_program_get_num_results(struct gpiod_line_program *program)
+{
+	assert(program);
+
+	return program->num_results;
+}
+
+static bool line_program_edge_matches(struct line_program_op *op,
+				      struct gpio_v2_line_event *event)
+{
+	uint64_t bit;
+	int ret;
+
+	ret = gpiod_line_request_offsets_to_mask(op->request, 1, &event->offset,
+						 &bit);
+	if (ret || !(bit & op->mask))
+		return false;
+
+	if (op->edge == GPIOD_LINE_EDGE_RISING)
+		return event->id == GPIO_V2_LINE_EVENT_RISING_EDGE;
+	if (op->edge == GPIOD_LINE_EDGE_FALLING)
+		return event->id == GPIO_V2_LINE_EVENT_FALLING_EDGE;
+
+	return true;
+}
+
+static int line_program_wait_edge(struct line_program_op *op,
+				  uint64_t *timestamp)
+{
+	struct gpio_v2_line_event event;
+	int64_t timeout_ns = op->time_ns;
+	uint64_t deadline = 0, now;
+	int fd, ret;
+
+	fd = gpiod_line_request_get_fd(op->request);
+
+	if (timeout_ns > 0)
+		deadline = gpiod_monotonic_ns() + timeout_ns;
+
+	for (;;) {
+		ret = gpiod_poll_fd(fd, timeout_ns);
+		if (ret < 0)
+			return -1;
+		if (ret == 0)
+			goto timed_out;
+
+		ret = gpiod_line_request_read_uapi_event(op->request, &event);
+		if (ret)
+			return -1;
+
+		if (line_program_edge_matches(op, &event)) {
+			*timestamp = event.timestamp_ns;
+			return 0;
+		}
+
+		if (timeout_ns > 0) {
+			now = gpiod_monotonic_ns();
+			if (now >= deadline)
+				goto timed_out;
+
+			timeout_ns = deadline - now;
+		}
+	}
+
+timed_out:
+	errno = ETIMEDOUT;
+	return -1;
+}
+
+GPIOD_API int gpiod_line_program_run(struct gpiod_line_program *program,
+				     uint64_t *results, size_t max_results)
+{
+	struct line_program_loop loops[LINE_PROGRAM_MAX_LOOP_DEPTH];
+	uint64_t start, deadline, *result = results;
+	struct line_program_loop *loop;
+	struct line_program_op *op;
+	size_t pc, depth = 0;
+	int ret;
+
+	assert(program);
+
+	if (program->loop_depth ||
+	    (program->num_results && (!results ||
+				      max_results < program->num_results))) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	start = gpiod_monotonic_ns();
+
+	for (pc = 0; pc < program->num_ops; pc++) {
+		op = &program->ops[pc];
+
+		switch (op->type) {
+		case LINE_PROGRAM_OP_SET:
+			ret = gpiod_line_request_set_bits(op->request, op->mask,
+							  op->bits);
+			if (ret)
+				return -1;
+			break;
+		case LINE_PROGRAM_OP_GET:
+			ret = gpiod_line_request_get_bits(op->request, op->mask,
+							  result++);
+			if (ret)
+				return -1;
+			break;
+		case LINE_PROGRAM_OP_SLEEP_UNTIL:
+			/* Relative to the start of the innermost iteration. */
+			if (depth) {
+				loop = &loops[depth - 1];
+				deadline = loop->iteration_start + op->time_ns;
+				loop->last_deadline = deadline;
+			} else {
+				deadline = start + op->time_ns;
+			}
+
+			gpiod_sleep_until(deadline, 0);
+			break;
+		case LINE_PROGRAM_OP_WAIT_EDGE:
+			ret = line_program_wait_edge(op, result++);
+			if (ret)
+				return -1;
+			break;
+		case LINE_PROGRAM_OP_LOOP:
+			loop = &loops[depth++];
+			loop->begin = pc;
+			loop->remaining = op->arg;
+			loop->iteration_start = gpiod_monotonic_ns();
+			loop->last_deadline = 0;
+			break;
+		case LINE_PROGRAM_OP_END_LOOP:
+			loop = &loops[depth - 1];
+			if (--loop->remaining) {
+				pc = loop->begin;
+				/*
+				 * Chain the iterations on the sleep deadlines
+				 * rather than on the wake-up times so that
+				 * periodic loops don't drift.
+				 */
+				loop->iteration_start = loop->last_deadline ?:
+							gpiod_monotonic_ns();
+				loop->last_deadline = 0;
+			} else {
+				depth--;
+			}
+			break;
+		}
+	}
+
+	return result - results;
+}
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <assert.h>
+#include <errno.h>
+#include <gpiod.h>
+
+#include "internal.h"
+
+GPIOD_API int gpiod_line_request_pulse(struct gpiod_line_request *request,
+				       size_t num_lines,
+				       const unsigned int *offsets,
+				       enum gpiod_line_value value,
+				       uint64_t width_ns, uint64_t spin_ns,
+				       unsigned int count, uint64_t period_ns,
+				       uint64_t *widths_ns)
+{
+	uint64_t mask, on_bits, off_bits, start, on_before, on_after,
+		 off_before, off_after;
+	unsigned int i;
+	int ret;
+
+	assert(request);
+
+	if (!offsets || !num_lines || !count ||
+	    (count > 1 && period_ns <= width_ns) ||
+	    (value != GPIOD_LINE_VALUE_ACTIVE &&
+	     value != GPIOD_LINE_VALUE_INACTIVE)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	ret = gpiod_line_request_offsets_to_mask(request, num_lines, offsets,
+						 &mask);
+	if (ret)
+		return -1;
+
+	on_bits = value == GPIOD_LINE_VALUE_ACTIVE ? mask : 0;
+	off_bits = ~on_bits & mask;
+
+	start = gpiod_monotonic_ns();
+
+	for (i = 0; i < count; i++) {
+		gpiod_sleep_until(start + i * period_ns, spin_ns);
+
+		on_before = gpiod_monotonic_ns();
+		ret = gpiod_line_request_set_bits(request, mask, on_bits);
+		on_after = gpiod_monotonic_ns();
+		if (ret)
+			return -1;
+
+		gpiod_sleep_until(on_before + width_ns, spin_ns);
+
+		off_before = gpiod_monotonic_ns();
+		ret = gpiod_line_request_set_bits(request, mask, off_bits);
+		off_after = gpiod_monotonic_ns();
+		if (ret)
+			return -1;
+
+		/*
+		 * The edges happen somewhere within the ioctls so take the
+		 * midpoints of the brackets as the best estimate.
+		 */
+		if (widths_ns)
+			widths_ns[i] = ((off_before + off_after) -
+					(on_before + on_after)) / 2;
+	}
+
+	return 0;
+}
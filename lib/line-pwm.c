@@ -0,0 +1,544 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <assert.h>
+#include <errno.h>
+#include <gpiod.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "internal.h"
+
+/*
+ * Upper bound on a single sleep of the timer thread so that a stop request
+ * is noticed even if all channels have long periods.
+ */
+#define PWM_MAX_SLEEP_NS	100000000ULL
+
+/*
+ * The period and the duty cycle of a channel are packed into a single word
+ * so that they can be updated together atomically without taking a lock.
+ */
+#define PWM_CONFIG_PACK(period, duty) (((uint64_t)(period) << 32) | (duty))
+#define PWM_CONFIG_PERIOD(config) ((uint64_t)(config) >> 32)
+#define PWM_CONFIG_DUTY(config) ((uint64_t)(config) & 0xffffffffULL)
+
+enum pwm_phase {
+	PWM_PHASE_START = 0,
+	PWM_PHASE_END_OF_DUTY,
+};
+
+struct pwm_request {
+	struct gpiod_line_request *request;
+	uint64_t mask;
+	uint64_t bits;
+	uint64_t timestamp;
+};
+
+struct pwm_channel {
+	size_t req_idx;
+	unsigned int offset;
+	uint64_t bit;
+	/* Written by the user, read by the timer thread. */
+	uint64_t config;
+	/* Only accessed by the timer thread. */
+	enum pwm_phase phase;
+	uint64_t next_edge;
+	uint64_t period_start;
+	uint64_t period;
+	uint64_t prev_period;
+	bool started;
+	/* Written by the timer thread, read by the user. */
+	uint64_t num_periods;
+	uint64_t first_start;
+	uint64_t last_start;
+	uint64_t jitter_sum;
+	uint64_t jitter_max;
+};
+
+struct gpiod_pwm {
+	struct pwm_request *requests;
+	size_t num_requests;
+	struct pwm_channel *channels;
+	size_t num_channels;
+	uint64_t spin_ns;
+	pthread_t thread;
+	bool running;
+	int stop;
+	int error;
+};
+
+GPIOD_API struct gpiod_pwm *gpiod_pwm_new(void)
+{
+	struct gpiod_pwm *pwm;
+
+	pwm = malloc(sizeof(*pwm));
+	if (!pwm)
+		return NULL;
+
+	memset(pwm, 0, sizeof(*pwm));
+
+	return pwm;
+}
+
+GPIOD_API void gpiod_pwm_free(struct gpiod_pwm *pwm)
+{
+	if (!pwm)
+		return;
+
+	if (pwm->running)
+		gpiod_pwm_stop(pwm);
+
+	free(pwm->channels);
+	free(pwm->requests);
+	free(pwm);
+}
+
+static int pwm_check_config(uint64_t period_ns, uint64_t duty_ns)
+{
+	if (!period_ns || duty_ns > period_ns) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (period_ns > UINT32_MAX) {
+		errno = ERANGE;
+		return -1;
+	}
+
+	return 0;
+}
+
+static int pwm_get_request_idx(struct gpiod_pwm *pwm,
+			       struct gpiod_line_request *request)
+{
+	struct pwm_request *requests;
+	size_t i;
+
+	for (i = 0; i < pwm->num_requests; i++) {
+		if (pwm->requests[i].request == request)
+			return i;
+	}
+
+	requests = realloc(pwm->requests,
+			   (pwm->num_requests + 1) * sizeof(*requests));
+	if (!requests)
+		return -1;
+
+	pwm->requests = requests;
+	memset(&requests[i], 0, sizeof(*requests));
+	requests[i].request = request;
+	pwm->num_requests++;
+
+	return i;
+}
+
+GPIOD_API int gpiod_pwm_add_channel(struct gpiod_pwm *pwm,
+				    struct gpiod_line_request *request,
+				    unsigned int offset, uint64_t period_ns,
+				    uint64_t duty_ns)
+{
+	struct pwm_channel *channels, *channel;
+	uint64_t bit;
+	size_t i;
+	int ret;
+
+	assert(pwm);
+	assert(request);
+
+	if (pwm->running) {
+		errno = EBUSY;
+		return -1;
+	}
+
+	ret = pwm_check_config(period_ns, duty_ns);
+	if (ret)
+		return -1;
+
+	ret = gpiod_line_request_offsets_to_mask(request, 1, &offset, &bit);
+	if (ret)
+		return -1;
+
+	for (i = 0; i < pwm->num_channels; i++) {
+		channel = &pwm->channels[i];
+
+		if (pwm->requests[channel->req_idx].request == request &&
+		    channel->offset == offset) {
+			errno = EINVAL;
+			return -1;
+		}
+	}
+
+	ret = pwm_get_request_idx(pwm, request);
+	if (ret < 0)
+		return -1;
+
+	channels = realloc(pwm->channels,
+			   (pwm->num_channels + 1) * sizeof(*channels));
+	if (!channels)
+		return -1;
+
+	pwm->channels = channels;
+	channel = &channels[pwm->num_channels];
+	memset(channel, 0, sizeof(*channel));
+	channel->req_idx = ret;
+	channel->offset = offset;
+	channel->bit = bit;
+	channel->config = PWM_CONFIG_PACK(period_ns, duty_ns);
+
+	return pwm->num_channels++;
+}
+
+GPIOD_API size_t gpiod_pwm_get_num_channels(struct gpiod_pwm *pwm)
+{
+	assert(pwm);
+
+	return pwm->num_channels;
+}
+
+GPIOD_API int gpiod_pwm_set_channel(struct gpiod_pwm *pwm,
+				    unsigned int channel, uint64_t period_ns,
+				    uint64_t duty_ns)
+{
+	int ret;
+
+	assert(pwm);
+
+	if (channel >= pwm->num_channels) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	ret = pwm_check_config(period_ns, duty_ns);
+	if (ret)
+		return -1;
+
+	__atomic_store_n(&pwm->channels[channel].config,
+			 PWM_CONFIG_PACK(period_ns, duty_ns), __ATOMIC_RELAXED);
+
+	return 0;
+}
+
+GPIOD_API void gpiod_pwm_set_spin(struct gpiod_pwm *pwm, uint64_t spin_ns)
+{
+	assert(pwm);
+
+	pwm->spin_ns = spin_ns;
+}
+
+static void pwm_record_period_start(struct pwm_channel *channel,
+				    uint64_t timestamp)
+{
+	uint64_t interval, deviation;
+
+	/*
+	 * Jitter is the deviation of the measured interval between two
+	 * consecutive period starts from the nominal period.
+	 */
+	if (channel->started) {
+		interval = timestamp - channel->last_start;
+		deviation = interval > channel->prev_period ?
+				interval - channel->prev_period :
+				channel->prev_period - interval;
+
+		__atomic_store_n(&channel->jitter_sum,
+				 channel->jitter_sum + deviation,
+				 __ATOMIC_RELAXED);
+		if (deviation > channel->jitter_max)
+			__atomic_store_n(&channel->jitter_max, deviation,
+					 __ATOMIC_RELAXED);
+	} else {
+		__atomic_store_n(&channel->first_start, timestamp,
+				 __ATOMIC_RELAXED);
+		channel->started = true;
+	}
+
+	__atomic_store_n(&channel->last_start, timestamp, __ATOMIC_RELAXED);
+	__atomic_store_n(&channel->num_periods, channel->num_periods + 1,
+			 __ATOMIC_RELEASE);
+}
+
+/*
+ * Compute the level of a channel whose edge is due and schedule its next
+ * edge. Returns the value of the line bit.
+ */
+static uint64_t pwm_fire_channel(struct pwm_channel *channel, uint64_t now)
+{
+	uint64_t config, period, duty;
+
+	if (channel->phase == PWM_PHASE_END_OF_DUTY) {
+		channel->phase = PWM_PHASE_START;
+		channel->next_edge = channel->period_start + channel->period;
+		return 0;
+	}
+
+	/* New parameters only ever take effect at the start of a period. */
+	config = __atomic_load_n(&channel->config, __ATOMIC_RELAXED);
+	period = PWM_CONFIG_PERIOD(config);
+	duty = PWM_CONFIG_DUTY(config);
+
+	/*
+	 * If we fell behind by more than a whole period, don't try to catch
+	 * up with a burst of short periods but restart the schedule from now.
+	 */
+	channel->period_start = now - channel->next_edge >= period ?
+						now : channel->next_edge;
+	channel->prev_period = channel->period;
+	channel->period = period;
+
+	if (duty > 0 && duty < period) {
+		channel->phase = PWM_PHASE_END_OF_DUTY;
+		channel->next_edge = channel->period_start + duty;
+	} else {
+		channel->next_edge = channel->period_start + period;
+	}
+
+	return duty ? channel->bit : 0;
+}
+
+static void pwm_set_error(struct gpiod_pwm *pwm)
+{
+	__atomic_store_n(&pwm->error, errno, __ATOMIC_RELAXED);
+}
+
+static void *pwm_thread_func(void *data)
+{
+	struct gpiod_pwm *pwm = data;
+	struct pwm_channel *channel;
+	struct pwm_request *req;
+	uint64_t now, next, before, after, spin = pwm->spin_ns;
+	bool *starting;
+	size_t i;
+	int ret;
+
+	starting = calloc(pwm->num_channels, sizeof(*starting));
+	if (!starting) {
+		pwm_set_error(pwm);
+		return NULL;
+	}
+
+	now = gpiod_monotonic_ns();
+
+	/* All channels share the origin so that equal periods stay aligned. */
+	for (i = 0; i < pwm->num_channels; i++)
+		pwm->channels[i].next_edge = now;
+
+	while (!__atomic_load_n(&pwm->stop, __ATOMIC_RELAXED)) {
+		next = now + PWM_MAX_SLEEP_NS;
+		for (i = 0; i < pwm->num_channels; i++) {
+			if (pwm->channels[i].next_edge < next)
+				next = pwm->channels[i].next_edge;
+		}
+
+		gpiod_sleep_until(next, spin);
+		now = gpiod_monotonic_ns();
+
+		for (i = 0; i < pwm->num_requests; i++) {
+			pwm->requests[i].mask = 0;
+			pwm->requests[i].bits = 0;
+		}
+
+		/*
+		 * Every edge that is due by now is merged into a single set
+		 * operation on its request, no matter which channel it
+		 * belongs to.
+		 */
+		for (i = 0; i < pwm->num_channels; i++) {
+			channel = &pwm->channels[i];
+			starting[i] = false;
+
+			if (channel->next_edge > now)
+				continue;
+
+			if (channel->phase == PWM_PHASE_START)
+				starting[i] = true;
+
+			req = &pwm->requests[channel->req_idx];
+			req->mask |= channel->bit;
+			req->bits |= pwm_fire_channel(channel, now);
+		}
+
+		for (i = 0; i < pwm->num_requests; i++) {
+			req = &pwm->requests[i];
+			if (!req->mask)
+				continue;
+
+			before = gpiod_monotonic_ns();
+			ret = gpiod_line_request_set_bits(req->request,
+							  req->mask, req->bits);
+			after = gpiod_monotonic_ns();
+			if (ret) {
+				pwm_set_error(pwm);
+				goto out;
+			}
+
+			req->timestamp = (before + after) / 2;
+		}
+
+		for (i = 0; i < pwm->num_channels; i++) {
+			channel = &pwm->channels[i];
+			if (!starting[i])
+				continue;
+
+			req = &pwm->requests[channel->req_idx];
+			pwm_record_period_start(channel, req->timestamp);
+		}
+	}
+
+out:
+	free(starting);
+
+	return NULL;
+}
+
+static int pwm_drive_inactive(struct gpiod_pwm *pwm)
+{
+	struct pwm_request *req;
+	size_t i;
+	int ret;
+
+	for (i = 0; i < pwm->num_requests; i++) {
+		pwm->requests[i].mask = 0;
+		pwm->requests[i].bits = 0;
+	}
+
+	for (i = 0; i < pwm->num_channels; i++) {
+		req = &pwm->requests[pwm->channels[i].req_idx];
+		req->mask |= pwm->channels[i].bit;
+	}
+
+	for (i = 0; i < pwm->num_requests; i++) {
+		req = &pwm->requests[i];
+
+		ret = gpiod_line_request_set_bits(req->request, req->mask, 0);
+		if (ret)
+			return -1;
+	}
+
+	return 0;
+}
+
+GPIOD_API int gpiod_pwm_start(struct gpiod_pwm *pwm)
+{
+	struct pwm_channel *channel;
+	size_t i;
+	int ret;
+
+	assert(pwm);
+
+	if (pwm->running) {
+		errno = EBUSY;
+		return -1;
+	}
+
+	if (!pwm->num_channels) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	for (i = 0; i < pwm->num_channels; i++) {
+		channel = &pwm->channels[i];
+
+		channel->phase = PWM_PHASE_START;
+		channel->period = 0;
+		channel->started = false;
+		channel->num_periods = 0;
+		channel->first_start = 0;
+		channel->last_start = 0;
+		channel->jitter_sum = 0;
+		channel->jitter_max = 0;
+	}
+
+	pwm->stop = 0;
+	pwm->error = 0;
+
+	ret = gpiod_thread_create(&pwm->thread, 0, pwm_thread_func, pwm);
+	if (ret) {
+		errno = ret;
+		return -1;
+	}
+
+	pwm->running = true;
+
+	return 0;
+}
+
+GPIOD_API int gpiod_pwm_stop(struct gpiod_pwm *pwm)
+{
+	int ret;
+
+	assert(pwm);
+
+	if (!pwm->running) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	__atomic_store_n(&pwm->stop, 1, __ATOMIC_RELAXED);
+	pthread_join(pwm->thread, NULL);
+	pwm->running = false;
+
+	ret = pwm_drive_inactive(pwm);
+
+	if (pwm->error) {
+		errno = pwm->error;
+		return -1;
+	}
+
+	return ret;
+}
+
+GPIOD_API int gpiod_pwm_get_error(struct gpiod_pwm *pwm)
+{
+	assert(pwm);
+
+	return __atomic_load_n(&pwm->error, __ATOMIC_RELAXED);
+}
+
+GPIOD_API int gpiod_pwm_get_stats(struct gpiod_pwm *pwm, unsigned int channel,
+				  double *frequency, uint64_t *jitter_ns,
+				  uint64_t *max_jitter_ns)
+{
+	uint64_t num_periods, first, last, sum, max;
+	struct pwm_channel *chan;
+
+	assert(pwm);
+
+	if (channel >= pwm->num_channels) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	chan = &pwm->channels[channel];
+
+	/*
+	 * The values are sampled one by one while the timer thread keeps
+	 * updating them so they may be off by one period relative to each
+	 * other. That's good enough for statistics.
+	 */
+	num_periods = __atomic_load_n(&chan->num_periods, __ATOMIC_ACQUIRE);
+	first = __atomic_load_n(&chan->first_start, __ATOMIC_RELAXED);
+	last = __atomic_load_n(&chan->last_start, __ATOMIC_RELAXED);
+	sum = __atomic_load_n(&chan->jitter_sum, __ATOMIC_RELAXED);
+	max = __atomic_load_n(&chan->jitter_max, __ATOMIC_RELAXED);
+
+	if (num_periods < 2 || last <= first) {
+		sum = 0;
+		max = 0;
+		if (frequency)
+			*frequency = 0.0;
+	} else {
+		sum /= num_periods - 1;
+		if (frequency)
+			*frequency = (num_periods - 1) * 1000000000.0 /
+				     (last - first);
+	}
+
+	if (jitter_ns)
+		*jitter_ns = sum;
+	if (max_jitter_ns)
+		*max_jitter_ns = max;
+
+	return 0;
+}
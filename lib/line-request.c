@@ -16,6 +16,20 @@ struct gpiod_line_request {
 	unsigned int offsets[GPIO_V2_LINES_MAX];
 	size_t num_lines;
 	int fd;
+	struct gpiod_output_journal *journal;
+	uint64_t busy_poll_ns;
+	uint64_t num_spin_wakeups;
+	uint64_t num_sleep_wakeups;
+	uint64_t spin_ns;
+	uint64_t batch_window_ns;
+	size_t batch_fill;
+	/* Smoothed time between consecutive events, 0 if not known yet. */
+	uint64_t event_interval_ns;
+	/* When the previous batched read returned, 0 if there was none. */
+	uint64_t last_read_ns;
+	uint64_t num_reads;
+	uint64_t num_events_read;
+	size_t max_batch;
 };
 
 struct gpiod_line_request *
@@ -49,6 +63,9 @@ GPIOD_API void gpiod_line_request_release(struct gpiod_line_request *request)
 	if (!request)
 		return;
 
+	if (request->journal)
+		gpiod_output_journal_unbind(request->journal);
+
 	close(request->fd);
 	free(request->chip_name);
 	free(request);
@@ -120,6 +137,68 @@ static int offset_to_bit(struct gpiod_line_request *request,
 	return -1;
 }
 
+int gpiod_line_request_offsets_to_mask(struct gpiod_line_request *request,
+				       size_t num_offsets,
+				       const unsigned int *offsets,
+				       uint64_t *mask)
+{
+	size_t i;
+	int bit;
+
+	gpiod_line_mask_zero(mask);
+
+	for (i = 0; i < num_offsets; i++) {
+		bit = offset_to_bit(request, offsets[i]);
+		if (bit < 0) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		gpiod_line_mask_set_bit(mask, bit);
+	}
+
+	return 0;
+}
+
+int gpiod_line_request_get_bits(struct gpiod_line_request *request,
+				uint64_t mask, uint64_t *bits)
+{
+	struct gpio_v2_line_values uapi_values;
+	int ret;
+
+	uapi_values.mask = mask;
+	uapi_values.bits = 0;
+
+	ret = gpiod_ioctl(request->fd, GPIO_V2_LINE_GET_VALUES_IOCTL,
+			  &uapi_values);
+	if (ret)
+		return -1;
+
+	*bits = uapi_values.bits & mask;
+
+	return 0;
+}
+
+int gpiod_line_request_set_bits(struct gpiod_line_request *request,
+				uint64_t mask, uint64_t bits)
+{
+	struct gpio_v2_line_values uapi_values;
+	int ret;
+
+	uapi_values.mask = mask;
+	uapi_values.bits = bits & mask;
+
+	ret = gpiod_ioctl(request->fd, GPIO_V2_LINE_SET_VALUES_IOCTL,
+			  &uapi_values);
+	if (ret)
+		return -1;
+
+	if (request->journal)
+		gpiod_output_journal_record(request->journal, mask, bits);
+
+	return 0;
+}
+
 GPIOD_API int
 gpiod_line_request_get_values_subset(struct gpiod_line_request *request,
 				     size_t num_values,
@@ -194,7 +273,7 @@ gpiod_line_request_set_values_subset(struct gpiod_line_request *request,
 	struct gpio_v2_line_values uapi_values;
 	uint64_t mask = 0, bits = 0;
 	size_t i;
-	int bit;
+	int bit, ret;
 
 	assert(request);
 
@@ -218,8 +297,38 @@ gpiod_line_request_set_values_subset(struct gpiod_line_request *request,
 	uapi_values.mask = mask;
 	uapi_values.bits = bits;
 
-	return gpiod_ioctl(request->fd, GPIO_V2_LINE_SET_VALUES_IOCTL,
-			   &uapi_values);
+	ret = gpiod_ioctl(request->fd, GPIO_V2_LINE_SET_VALUES_IOCTL,
+			  &uapi_values);
+	if (ret)
+		return -1;
+
+	if (request->journal)
+		gpiod_output_journal_record(request->journal, mask, bits);
+
+	return 0;
+}
+
+GPIOD_API int
+gpiod_line_request_attach_journal(struct gpiod_line_request *request,
+				  struct gpiod_output_journal *journal)
+{
+	int ret;
+
+	assert(request);
+
+	if (journal) {
+		ret = gpiod_output_journal_bind(journal, request->offsets,
+						request->num_lines);
+		if (ret)
+			return -1;
+	}
+
+	if (request->journal)
+		gpiod_output_journal_unbind(request->journal);
+
+	request->journal = journal;
+
+	return 0;
 }
 
 GPIOD_API int gpiod_line_request_set_values(struct gpiod_line_request *request,
@@ -231,8 +340,8 @@ GPIOD_API int gpiod_line_request_set_values(struct gpiod_line_request *request,
 						    request->offsets, values);
 }
 
-static bool offsets_equal(struct gpiod_line_request *request,
-			  struct gpio_v2_line_request *uapi_cfg)
+bool gpiod_line_request_offsets_equal(struct gpiod_line_request *request,
+				      struct gpio_v2_line_request *uapi_cfg)
 {
 	size_t i;
 
@@ -247,6 +356,13 @@ static bool offsets_equal(struct gpiod_line_request *request,
 	return true;
 }
 
+int gpiod_line_request_set_uapi_config(struct gpiod_line_request *request,
+				       struct gpio_v2_line_config *uapi_cfg)
+{
+	return gpiod_ioctl(request->fd, GPIO_V2_LINE_SET_CONFIG_IOCTL,
+			   uapi_cfg);
+}
+
 GPIOD_API int
 gpiod_line_request_reconfigure_lines(struct gpiod_line_request *request,
 				     struct gpiod_line_config *config)
@@ -267,13 +383,12 @@ gpiod_line_request_reconfigure_lines(struct gpiod_line_request *request,
 	if (ret)
 		return ret;
 
-	if (!offsets_equal(request, &uapi_cfg)) {
+	if (!gpiod_line_request_offsets_equal(request, &uapi_cfg)) {
 		errno = EINVAL;
 		return -1;
 	}
 
-	ret = gpiod_ioctl(request->fd, GPIO_V2_LINE_SET_CONFIG_IOCTL,
-			  &uapi_cfg.config);
+	ret = gpiod_line_request_set_uapi_config(request, &uapi_cfg.config);
 	if (ret)
 		return ret;
 
@@ -287,13 +402,172 @@ GPIOD_API int gpiod_line_request_get_fd(struct gpiod_line_request *request)
 	return request->fd;
 }
 
+GPIOD_API void
+gpiod_line_request_set_busy_poll(struct gpiod_line_request *request,
+				 uint64_t spin_ns)
+{
+	assert(request);
+
+	request->busy_poll_ns = spin_ns;
+}
+
+GPIOD_API uint64_t
+gpiod_line_request_get_busy_poll(struct gpiod_line_request *request)
+{
+	assert(request);
+
+	return request->busy_poll_ns;
+}
+
+GPIOD_API void
+gpiod_line_request_get_wait_stats(struct gpiod_line_request *request,
+				  uint64_t *num_spin_wakeups,
+				  uint64_t *num_sleep_wakeups,
+				  uint64_t *spin_ns)
+{
+	assert(request);
+
+	if (num_spin_wakeups)
+		*num_spin_wakeups = request->num_spin_wakeups;
+	if (num_sleep_wakeups)
+		*num_sleep_wakeups = request->num_sleep_wakeups;
+	if (spin_ns)
+		*spin_ns = request->spin_ns;
+}
+
+/*
+ * Check the fd without blocking until an event is pending or the budget
+ * runs out. Returns the time spent spinning through elapsed.
+ */
+static int line_request_busy_poll(struct gpiod_line_request *request,
+				  uint64_t budget, uint64_t *elapsed)
+{
+	uint64_t start, now;
+	int ret;
+
+	start = gpiod_monotonic_ns();
+
+	for (;;) {
+		ret = gpiod_poll_fd(request->fd, 0);
+		now = gpiod_monotonic_ns();
+		if (ret || now - start >= budget)
+			break;
+
+		gpiod_cpu_relax();
+	}
+
+	*elapsed = now - start;
+	request->spin_ns += *elapsed;
+
+	return ret;
+}
+
 GPIOD_API int
 gpiod_line_request_wait_edge_events(struct gpiod_line_request *request,
 				    int64_t timeout_ns)
 {
+	uint64_t budget, elapsed;
+	int ret;
+
 	assert(request);
 
-	return gpiod_poll_fd(request->fd, timeout_ns);
+	if (request->busy_poll_ns && timeout_ns) {
+		budget = request->busy_poll_ns;
+		if (timeout_ns > 0 && (uint64_t)timeout_ns < budget)
+			budget = timeout_ns;
+
+		ret = line_request_busy_poll(request, budget, &elapsed);
+		if (ret > 0)
+			request->num_spin_wakeups++;
+		if (ret)
+			return ret;
+
+		if (timeout_ns > 0) {
+			timeout_ns -= elapsed;
+			if (timeout_ns <= 0)
+				return 0;
+		}
+	}
+
+	ret = gpiod_poll_fd(request->fd, timeout_ns);
+	if (ret > 0)
+		request->num_sleep_wakeups++;
+
+	return ret;
+}
+
+GPIOD_API void
+gpiod_line_request_set_read_batching(struct gpiod_line_request *request,
+				     uint64_t window_ns, size_t fill)
+{
+	assert(request);
+
+	request->batch_window_ns = window_ns;
+	request->batch_fill = fill;
+	request->event_interval_ns = 0;
+	request->last_read_ns = 0;
+}
+
+GPIOD_API void
+gpiod_line_request_get_read_stats(struct gpiod_line_request *request,
+				  uint64_t *num_reads, uint64_t *num_events,
+				  size_t *max_batch)
+{
+	assert(request);
+
+	if (num_reads)
+		*num_reads = request->num_reads;
+	if (num_events)
+		*num_events = request->num_events_read;
+	if (max_batch)
+		*max_batch = request->max_batch;
+}
+
+/*
+ * Estimate how long it takes for the batch to fill up from the rate at
+ * which events arrived in the previous batches, minus the time for which
+ * events have already been accumulating. The number of queued events is
+ * never checked, it's only inferred from the smoothed event interval.
+ */
+static uint64_t line_request_batch_wait(struct gpiod_line_request *request,
+					size_t fill, uint64_t elapsed)
+{
+	uint64_t wait = request->batch_window_ns;
+
+	if (request->event_interval_ns &&
+	    request->event_interval_ns < wait / (fill - 1)) {
+		wait = request->event_interval_ns * (fill - 1);
+		wait = elapsed < wait ? wait - elapsed : 0;
+	}
+
+	return wait;
+}
+
+static void line_request_update_interval(struct gpiod_line_request *request,
+					 struct gpiod_edge_event_buffer *buffer,
+					 size_t num_events)
+{
+	uint64_t first, last, interval;
+
+	if (num_events < 2)
+		return;
+
+	first = gpiod_edge_event_get_timestamp_ns(
+			gpiod_edge_event_buffer_get_event(buffer, 0));
+	last = gpiod_edge_event_get_timestamp_ns(
+			gpiod_edge_event_buffer_get_event(buffer,
+							  num_events - 1));
+	if (last <= first)
+		return;
+
+	interval = (last - first) / (num_events - 1);
+
+	/* Exponential moving average with a weight of 1/4. */
+	if (request->event_interval_ns)
+		request->event_interval_ns = (3 * request->event_interval_ns +
+					      interval) / 4;
+	else
+		request->event_interval_ns = interval;
 }
 
 GPIOD_API int
@@ -301,7 +575,302 @@ gpiod_line_request_read_edge_events(struct gpiod_line_request *request,
 				    struct gpiod_edge_event_buffer *buffer,
 				    size_t max_events)
 {
+	uint64_t now, elapsed, wait;
+	size_t fill = 0;
+	int ret, pending;
+
+	assert(request);
+
+	if (request->batch_window_ns && buffer) {
+		fill = gpiod_edge_event_buffer_get_capacity(buffer);
+		if (max_events < fill)
+			fill = max_events;
+		if (request->batch_fill && request->batch_fill < fill)
+			fill = request->batch_fill;
+	}
+
+	/* There's nothing to wait for if a single event fills the batch. */
+	if (fill > 1) {
+		/*
+		 * If events are already pending, they may have been
+		 * accumulating ever since the previous read. Otherwise block
+		 * until the first event like read() would.
+		 */
+		pending = gpiod_poll_fd(request->fd, 0);
+		if (pending < 0)
+			return -1;
+
+		if (!pending && gpiod_poll_fd(request->fd, -1) < 0)
+			return -1;
+
+		now = gpiod_monotonic_ns();
+		elapsed = 0;
+		if (pending && request->last_read_ns)
+			elapsed = now - request->last_read_ns;
+
+		wait = line_request_batch_wait(request, fill, elapsed);
+		if (wait)
+			gpiod_sleep_until(now + wait, 0);
+	}
+
+	ret = gpiod_edge_event_buffer_read_fd(request->fd, buffer, max_events);
+	if (ret < 0)
+		return -1;
+
+	request->num_reads++;
+	request->num_events_read += ret;
+	if ((size_t)ret > request->max_batch)
+		request->max_batch = ret;
+
+	if (fill > 1) {
+		line_request_update_interval(request, buffer, ret);
+		request->last_read_ns = gpiod_monotonic_ns();
+	}
+
+	return ret;
+}
+
+static int drain_edge_events(int fd)
+{
+	struct gpio_v2_line_event events[16];
+	ssize_t rd;
+	int ret;
+
+	for (;;) {
+		ret = gpiod_poll_fd(fd, 0);
+		if (ret <= 0)
+			return ret;
+
+		rd = read(fd, events, sizeof(events));
+		if (rd < 0)
+			return -1;
+	}
+}
+
+int gpiod_line_request_read_uapi_event(struct gpiod_line_request *request,
+				       struct gpio_v2_line_event *event)
+{
+	ssize_t rd;
+
+	rd = read(request->fd, event, sizeof(*event));
+	if (rd < 0) {
+		return -1;
+	} else if ((size_t)rd < sizeof(*event)) {
+		errno = EIO;
+		return -1;
+	}
+
+	return 0;
+}
+
+static bool response_matches(enum gpiod_line_response response,
+			     struct gpio_v2_line_event *event)
+{
+	if (response == GPIOD_LINE_RESPONSE_RISING_EDGE ||
+	    response == GPIOD_LINE_RESPONSE_ACTIVE)
+		return event->id == GPIO_V2_LINE_EVENT_RISING_EDGE;
+
+	return event->id == GPIO_V2_LINE_EVENT_FALLING_EDGE;
+}
+
+GPIOD_API int
+gpiod_line_request_handshake(struct gpiod_line_request *request,
+			     size_t num_values, const unsigned int *offsets,
+			     const enum gpiod_line_value *values,
+			     struct gpiod_line_request *response_request,
+			     unsigned int response_offset,
+			     enum gpiod_line_response response,
+			     int64_t timeout_ns,
+			     struct gpiod_edge_event_buffer *buffer,
+			     uint64_t *turnaround_ns)
+{
+	enum gpiod_line_value expected, value;
+	struct gpio_v2_line_event uapi_evt;
+	uint64_t start, deadline = 0, now;
+	int ret;
+
+	assert(request);
+
+	if (!response_request ||
+	    offset_to_bit(response_request, response_offset) < 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	switch (response) {
+	case GPIOD_LINE_RESPONSE_RISING_EDGE:
+	case GPIOD_LINE_RESPONSE_FALLING_EDGE:
+	case GPIOD_LINE_RESPONSE_ACTIVE:
+	case GPIOD_LINE_RESPONSE_INACTIVE:
+		break;
+	default:
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (buffer)
+		gpiod_edge_event_buffer_store_uapi(buffer, &uapi_evt, 0);
+
+	/*
+	 * Anything already queued happened before the outputs changed so it
+	 * cannot be a response to them.
+	 */
+	ret = drain_edge_events(response_request->fd);
+	if (ret < 0)
+		return -1;
+
+	start = gpiod_monotonic_ns();
+
+	ret = gpiod_line_request_set_values_subset(request, num_values,
+						   offsets, values);
+	if (ret)
+		return -1;
+
+	if (response == GPIOD_LINE_RESPONSE_ACTIVE ||
+	    response == GPIOD_LINE_RESPONSE_INACTIVE) {
+		expected = response == GPIOD_LINE_RESPONSE_ACTIVE ?
+					GPIOD_LINE_VALUE_ACTIVE :
+					GPIOD_LINE_VALUE_INACTIVE;
+
+		value = gpiod_line_request_get_value(response_request,
+						     response_offset);
+		if (value == GPIOD_LINE_VALUE_ERROR)
+			return -1;
+
+		if (value == expected) {
+			if (turnaround_ns)
+				*turnaround_ns = gpiod_monotonic_ns() - start;
+
+			return 1;
+		}
+	}
+
+	if (timeout_ns > 0)
+		deadline = start + timeout_ns;
+
+	for (;;) {
+		/*
+		 * The deadline counts from before the outputs were set, so
+		 * the time that took is already spent. If nothing is left,
+		 * still check the events that are already queued.
+		 */
+		if (timeout_ns > 0) {
+			now = gpiod_monotonic_ns();
+			timeout_ns = now < deadline ? deadline - now : 0;
+		}
+
+		ret = gpiod_poll_fd(response_request->fd, timeout_ns);
+		if (ret <= 0)
+			return ret;
+
+		/*
+		 * Read one event at a time so that nothing past the response
+		 * is consumed.
+		 */
+		ret = gpiod_line_request_read_uapi_event(response_request,
+							 &uapi_evt);
+		if (ret)
+			return -1;
+
+		if (uapi_evt.offset == response_offset &&
+		    response_matches(response, &uapi_evt)) {
+			now = gpiod_monotonic_ns();
+
+			if (buffer)
+				gpiod_edge_event_buffer_store_uapi(buffer,
+								   &uapi_evt,
+								   1);
+			if (turnaround_ns)
+				*turnaround_ns = now - start;
+
+			return 1;
+		}
+
+		if (deadline && gpiod_monotonic_ns() >= deadline)
+			return 0;
+	}
+}
+
+static bool values_match(uint64_t values, uint64_t mask, uint64_t bits,
+			 enum gpiod_line_match match)
+{
+	uint64_t equal = ~(values ^ bits) & mask;
+
+	if (match == GPIOD_LINE_MATCH_ALL)
+		return equal == mask;
+
+	return equal != 0;
+}
+
+GPIOD_API int
+gpiod_line_request_wait_value(struct gpiod_line_request *request,
+			      uint64_t mask, uint64_t bits,
+			      enum gpiod_line_match match, int64_t timeout_ns,
+			      struct gpiod_edge_event_buffer *buffer)
+{
+	struct gpio_v2_line_event uapi_evt;
+	uint64_t deadline = 0, now, values;
+	int ret, bit;
+
 	assert(request);
 
-	return gpiod_edge_event_buffer_read_fd(request->fd, buffer, max_events);
+	if (!mask || (request->num_lines < 64 &&
+		      (mask >> request->num_lines) != 0) ||
+	    (match != GPIOD_LINE_MATCH_ALL && match != GPIOD_LINE_MATCH_ANY)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (buffer)
+		gpiod_edge_event_buffer_store_uapi(buffer, &uapi_evt, 0);
+
+	/*
+	 * Pending events predate the snapshot of the values taken below and
+	 * would corrupt the tracked state if applied on top of it.
+	 */
+	ret = drain_edge_events(request->fd);
+	if (ret < 0)
+		return -1;
+
+	ret = gpiod_line_request_get_bits(request, mask, &values);
+	if (ret)
+		return -1;
+
+	if (values_match(values, mask, bits, match))
+		return 1;
+
+	if (timeout_ns > 0)
+		deadline = gpiod_monotonic_ns() + timeout_ns;
+
+	for (;;) {
+		ret = gpiod_poll_fd(request->fd, timeout_ns);
+		if (ret <= 0)
+			return ret;
+
+		ret = gpiod_line_request_read_uapi_event(request, &uapi_evt);
+		if (ret)
+			return -1;
+
+		bit = offset_to_bit(request, uapi_evt.offset);
+		if (bit >= 0 && gpiod_line_mask_test_bit(&mask, bit)) {
+			gpiod_line_mask_assign_bit(&values, bit,
+				uapi_evt.id == GPIO_V2_LINE_EVENT_RISING_EDGE);
+
+			if (values_match(values, mask, bits, match)) {
+				if (buffer)
+					gpiod_edge_event_buffer_store_uapi(
+							buffer, &uapi_evt, 1);
+
+				return 1;
+			}
+		}
+
+		if (timeout_ns > 0) {
+			now = gpiod_monotonic_ns();
+			if (now >= deadline)
+				return 0;
+
+			timeout_ns = deadline - now;
+		}
+	}
 }
@@ -0,0 +1,295 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <assert.h>
+#include <errno.h>
+#include <gpiod.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "internal.h"
+
+#define JOURNAL_EXPORT_CHUNK	64
+
+/*
+ * Every entry is guarded by its own sequence counter: 2 * seqno + 1 while
+ * entry number seqno is being written, 2 * (seqno + 1) once it's complete.
+ * Writers claim the entry by moving the counter forward, so a writer that
+ * has been lapped by a newer one never overwrites its data.
+ */
+struct journal_entry {
+	uint64_t seq;
+	uint64_t timestamp;
+	uint64_t mask;
+	uint64_t bits;
+	unsigned int tag;
+};
+
+struct gpiod_output_journal {
+	struct journal_entry *entries;
+	/* Power of two so that the index is a mask away from the seqno. */
+	size_t num_entries;
+	uint64_t head;
+	unsigned int tag;
+	bool bound;
+	unsigned int offsets[GPIO_V2_LINES_MAX];
+	size_t num_lines;
+};
+
+GPIOD_API struct gpiod_output_journal *
+gpiod_output_journal_new(size_t num_entries)
+{
+	struct gpiod_output_journal *journal;
+	size_t size = 1;
+
+	if (!num_entries ||
+	    num_entries > SIZE_MAX / 2 / sizeof(*journal->entries)) {
+		errno = EINVAL;
+		return NULL;
+	}
+
+	while (size < num_entries)
+		size <<= 1;
+
+	journal = malloc(sizeof(*journal));
+	if (!journal)
+		return NULL;
+
+	memset(journal, 0, sizeof(*journal));
+
+	journal->entries = calloc(size, sizeof(*journal->entries));
+	if (!journal->entries) {
+		free(journal);
+		return NULL;
+	}
+
+	journal->num_entries = size;
+
+	return journal;
+}
+
+GPIOD_API void gpiod_output_journal_free(struct gpiod_output_journal *journal)
+{
+	if (!journal)
+		return;
+
+	free(journal->entries);
+	free(journal);
+}
+
+int gpiod_output_journal_bind(struct gpiod_output_journal *journal,
+			      const unsigned int *offsets, size_t num_lines)
+{
+	if (journal->bound) {
+		errno = EBUSY;
+		return -1;
+	}
+
+	memcpy(journal->offsets, offsets, sizeof(*offsets) * num_lines);
+	journal->num_lines = num_lines;
+	journal->bound = true;
+
+	return 0;
+}
+
+void gpiod_output_journal_unbind(struct gpiod_output_journal *journal)
+{
+	journal->bound = false;
+}
+
+void gpiod_output_journal_record(struct gpiod_output_journal *journal,
+				 uint64_t mask, uint64_t bits)
+{
+	struct journal_entry *entry;
+	uint64_t seqno, seq;
+
+	seqno = __atomic_fetch_add(&journal->head, 1, __ATOMIC_RELAXED);
+	entry = &journal->entries[seqno & (journal->num_entries - 1)];
+
+	seq = __atomic_load_n(&entry->seq, __ATOMIC_RELAXED);
+	for (;;) {
+		/* A newer entry already took the slot, this one is stale. */
+		if (seq > 2 * seqno + 1)
+			return;
+
+		/* Wait for the writer of an older entry to finish. */
+		if (seq & 1) {
+			gpiod_cpu_relax();
+			seq = __atomic_load_n(&entry->seq, __ATOMIC_RELAXED);
+			continue;
+		}
+
+		if (__atomic_compare_exchange_n(&entry->seq, &seq,
+						2 * seqno + 1, false,
+						__ATOMIC_RELAXED,
+						__ATOMIC_RELAXED))
+			break;
+	}
+
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	__atomic_store_n(&entry->timestamp, gpiod_monotonic_ns(),
+			 __ATOMIC_RELAXED);
+	__atomic_store_n(&entry->mask, mask, __ATOMIC_RELAXED);
+	__atomic_store_n(&entry->bits, bits & mask, __ATOMIC_RELAXED);
+	__atomic_store_n(&entry->tag,
+			 __atomic_load_n(&journal->tag, __ATOMIC_RELAXED),
+			 __ATOMIC_RELAXED);
+
+	__atomic_store_n(&entry->seq, 2 * seqno + 2, __ATOMIC_RELEASE);
+}
+
+GPIOD_API void gpiod_output_journal_set_tag(struct gpiod_output_journal *journal,
+					    unsigned int tag)
+{
+	assert(journal);
+
+	__atomic_store_n(&journal->tag, tag, __ATOMIC_RELAXED);
+}
+
+GPIOD_API size_t
+gpiod_output_journal_get_capacity(struct gpiod_output_journal *journal)
+{
+	assert(journal);
+
+	return journal->num_entries;
+}
+
+GPIOD_API uint64_t
+gpiod_output_journal_get_num_entries(struct gpiod_output_journal *journal)
+{
+	assert(journal);
+
+	return __atomic_load_n(&journal->head, __ATOMIC_ACQUIRE);
+}
+
+GPIOD_API int
+gpiod_output_journal_get_entry(struct gpiod_output_journal *journal,
+			       uint64_t seqno, uint64_t *timestamp_ns,
+			       uint64_t *mask, uint64_t *bits,
+			       unsigned int *tag)
+{
+	struct journal_entry *entry, copy;
+	uint64_t seq;
+
+	assert(journal);
+
+	entry = &journal->entries[seqno & (journal->num_entries - 1)];
+
+	seq = __atomic_load_n(&entry->seq, __ATOMIC_ACQUIRE);
+	if (seq != 2 * seqno + 2) {
+		/* Not written yet, overwritten or being overwritten. */
+		errno = ENOENT;
+		return -1;
+	}
+
+	copy.timestamp = __atomic_load_n(&entry->timestamp, __ATOMIC_RELAXED);
+	copy.mask = __atomic_load_n(&entry->mask, __ATOMIC_RELAXED);
+	copy.bits = __atomic_load_n(&entry->bits, __ATOMIC_RELAXED);
+	copy.tag = __atomic_load_n(&entry->tag, __ATOMIC_RELAXED);
+
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	if (__atomic_load_n(&entry->seq, __ATOMIC_RELAXED) != seq) {
+		errno = ENOENT;
+		return -1;
+	}
+
+	if (timestamp_ns)
+		*timestamp_ns = copy.timestamp;
+	if (mask)
+		*mask = copy.mask;
+	if (bits)
+		*bits = copy.bits;
+	if (tag)
+		*tag = copy.tag;
+
+	return 0;
+}
+
+static int journal_write_all(int fd, const void *buf, size_t len)
+{
+	const char *pos = buf;
+	ssize_t wr;
+
+	while (len) {
+		wr = write(fd, pos, len);
+		if (wr < 0) {
+			if (errno == EINTR)
+				continue;
+
+			return -1;
+		}
+
+		pos += wr;
+		len -= wr;
+	}
+
+	return 0;
+}
+
+GPIOD_API int gpiod_output_journal_export(struct gpiod_output_journal *journal,
+					  int fd)
+{
+	struct gpio_v2_line_event events[JOURNAL_EXPORT_CHUNK];
+	uint32_t line_seqnos[GPIO_V2_LINES_MAX];
+	uint64_t seqno, head, ts, mask, bits, changed;
+	uint64_t known = 0, state = 0;
+	struct gpio_v2_line_event *event;
+	size_t num_events = 0;
+	uint32_t global_seqno = 0;
+	unsigned int bit;
+	int ret;
+
+	assert(journal);
+
+	memset(line_seqnos, 0, sizeof(line_seqnos));
+
+	head = gpiod_output_journal_get_num_entries(journal);
+	seqno = head > journal->num_entries ? head - journal->num_entries : 0;
+
+	for (; seqno < head; seqno++) {
+		ret = gpiod_output_journal_get_entry(journal, seqno, &ts,
+						     &mask, &bits, NULL);
+		if (ret)
+			continue;
+
+		/* Lines driven for the first time count as changed. */
+		changed = (mask & ~known) | (mask & (state ^ bits));
+		known |= mask;
+		state = (state & ~mask) | bits;
+
+		while (changed) {
+			bit = __builtin_ctzll(changed);
+			changed &= changed - 1;
+
+			if (bit >= journal->num_lines)
+				continue;
+
+			event = &events[num_events++];
+			memset(event, 0, sizeof(*event));
+			event->timestamp_ns = ts;
+			event->id = bits & (1ULL << bit) ?
+					GPIO_V2_LINE_EVENT_RISING_EDGE :
+					GPIO_V2_LINE_EVENT_FALLING_EDGE;
+			event->offset = journal->offsets[bit];
+			event->seqno = ++global_seqno;
+			event->line_seqno = ++line_seqnos[bit];
+
+			if (num_events == JOURNAL_EXPORT_CHUNK) {
+				ret = journal_write_all(fd, events,
+							sizeof(events));
+				if (ret)
+					return -1;
+
+				num_events = 0;
+			}
+		}
+	}
+
+	ret = journal_write_all(fd, events, num_events * sizeof(*events));
+	if (ret)
+		return -1;
+
+	return global_seqno;
+}
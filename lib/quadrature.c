@@ -0,0 +1,326 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <assert.h>
+#include <errno.h>
+#include <gpiod.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "internal.h"
+
+#define QUAD_ERR	2
+
+/* Default length of the window over which the velocity is measured. */
+#define QUAD_VELOCITY_WINDOW_NS	10000000ULL
+
+#define QUAD_CHAN_A	GPIOD_BIT(1)
+#define QUAD_CHAN_B	GPIOD_BIT(0)
+
+/*
+ * Position change indexed by (old_state << 2 | new_state) where the state is
+ * (A << 1 | B). Moving forward, the channels go through 00, 10, 11, 01.
+ * A single edge can't leave the state unchanged (a missed edge) nor change
+ * both channels at once.
+ */
+static const int8_t quad_table[16] = {
+	QUAD_ERR,	-1,		1,		QUAD_ERR,
+	1,		QUAD_ERR,	QUAD_ERR,	-1,
+	-1,		QUAD_ERR,	QUAD_ERR,	1,
+	QUAD_ERR,	1,		-1,		QUAD_ERR,
+};
+
+struct quad_encoder {
+	unsigned int offset_a;
+	unsigned int offset_b;
+	unsigned int state;
+	/* Channels for which the level is known. */
+	unsigned int known;
+	int64_t position;
+	uint64_t num_errors;
+	double velocity;
+	bool window_open;
+	uint64_t window_start;
+	int64_t window_position;
+};
+
+struct gpiod_quadrature {
+	struct quad_encoder *encoders;
+	size_t num_encoders;
+	uint64_t window_ns;
+};
+
+GPIOD_API struct gpiod_quadrature *gpiod_quadrature_new(void)
+{
+	struct gpiod_quadrature *quad;
+
+	quad = malloc(sizeof(*quad));
+	if (!quad)
+		return NULL;
+
+	memset(quad, 0, sizeof(*quad));
+	quad->window_ns = QUAD_VELOCITY_WINDOW_NS;
+
+	return quad;
+}
+
+GPIOD_API void gpiod_quadrature_free(struct gpiod_quadrature *quad)
+{
+	if (!quad)
+		return;
+
+	free(quad->encoders);
+	free(quad);
+}
+
+static bool quad_offset_used(struct gpiod_quadrature *quad,
+			     unsigned int offset)
+{
+	struct quad_encoder *enc;
+	size_t i;
+
+	for (i = 0; i < quad->num_encoders; i++) {
+		enc = &quad->encoders[i];
+
+		if (enc->offset_a == offset || enc->offset_b == offset)
+			return true;
+	}
+
+	return false;
+}
+
+GPIOD_API int gpiod_quadrature_add_encoder(struct gpiod_quadrature *quad,
+					   unsigned int offset_a,
+					   unsigned int offset_b)
+{
+	struct quad_encoder *encoders, *enc;
+
+	assert(quad);
+
+	if (offset_a == offset_b || quad_offset_used(quad, offset_a) ||
+	    quad_offset_used(quad, offset_b)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	encoders = realloc(quad->encoders,
+			   (quad->num_encoders + 1) * sizeof(*encoders));
+	if (!encoders)
+		return -1;
+
+	quad->encoders = encoders;
+	enc = &encoders[quad->num_encoders];
+	memset(enc, 0, sizeof(*enc));
+	enc->offset_a = offset_a;
+	enc->offset_b = offset_b;
+
+	return quad->num_encoders++;
+}
+
+GPIOD_API size_t gpiod_quadrature_get_num_encoders(struct gpiod_quadrature *quad)
+{
+	assert(quad);
+
+	return quad->num_encoders;
+}
+
+GPIOD_API void gpiod_quadrature_set_velocity_window(struct gpiod_quadrature *quad,
+						    uint64_t window_ns)
+{
+	assert(quad);
+
+	quad->window_ns = window_ns ?: QUAD_VELOCITY_WINDOW_NS;
+}
+
+GPIOD_API int gpiod_quadrature_sync(struct gpiod_quadrature *quad,
+				    struct gpiod_line_request *request)
+{
+	uint64_t mask_a, mask_b, bits;
+	struct quad_encoder *enc;
+	int ret, num_synced = 0;
+	size_t i;
+
+	assert(quad);
+	assert(request);
+
+	for (i = 0; i < quad->num_encoders; i++) {
+		enc = &quad->encoders[i];
+
+		/* Skip encoders whose lines belong to other requests. */
+		if (gpiod_line_request_offsets_to_mask(request, 1,
+						       &enc->offset_a,
+						       &mask_a) ||
+		    gpiod_line_request_offsets_to_mask(request, 1,
+						       &enc->offset_b,
+						       &mask_b))
+			continue;
+
+		ret = gpiod_line_request_get_bits(request, mask_a | mask_b,
+						  &bits);
+		if (ret)
+			return -1;
+
+		enc->state = (bits & mask_a ? QUAD_CHAN_A : 0) |
+			     (bits & mask_b ? QUAD_CHAN_B : 0);
+		enc->known = QUAD_CHAN_A | QUAD_CHAN_B;
+		num_synced++;
+	}
+
+	return num_synced;
+}
+
+static void quad_update_velocity(struct quad_encoder *enc, uint64_t timestamp,
+				 uint64_t window_ns)
+{
+	uint64_t elapsed;
+
+	if (!enc->window_open) {
+		enc->window_open = true;
+		enc->window_start = timestamp;
+		enc->window_position = enc->position;
+		return;
+	}
+
+	if (timestamp < enc->window_start)
+		return;
+
+	elapsed = timestamp - enc->window_start;
+	if (elapsed < window_ns)
+		return;
+
+	enc->velocity = (double)(enc->position - enc->window_position) *
+			1000000000.0 / (double)elapsed;
+	enc->window_start = timestamp;
+	enc->window_position = enc->position;
+}
+
+static struct quad_encoder *
+quad_find_encoder(struct gpiod_quadrature *quad, unsigned int offset,
+		  unsigned int *chan)
+{
+	struct quad_encoder *enc;
+	size_t i;
+
+	for (i = 0; i < quad->num_encoders; i++) {
+		enc = &quad->encoders[i];
+
+		if (enc->offset_a == offset) {
+			*chan = QUAD_CHAN_A;
+			return enc;
+		}
+
+		if (enc->offset_b == offset) {
+			*chan = QUAD_CHAN_B;
+			return enc;
+		}
+	}
+
+	return NULL;
+}
+
+GPIOD_API size_t
+gpiod_quadrature_process(struct gpiod_quadrature *quad,
+			 struct gpiod_edge_event_buffer *buffer)
+{
+	struct quad_encoder *enc = NULL;
+	struct gpiod_edge_event *event;
+	unsigned int offset, last_offset = 0, chan = 0, state;
+	size_t num_events, i, num_decoded = 0;
+	int8_t delta;
+
+	assert(quad);
+	assert(buffer);
+
+	num_events = gpiod_edge_event_buffer_get_num_events(buffer);
+
+	for (i = 0; i < num_events; i++) {
+		event = gpiod_edge_event_buffer_get_event(buffer, i);
+		offset = gpiod_edge_event_get_line_offset(event);
+
+		/* Consecutive events tend to come from the same encoder. */
+		if (!enc || offset != last_offset) {
+			enc = quad_find_encoder(quad, offset, &chan);
+			last_offset = offset;
+		}
+
+		if (!enc)
+			continue;
+
+		num_decoded++;
+
+		if (gpiod_edge_event_get_event_type(event) ==
+		    GPIOD_EDGE_EVENT_RISING_EDGE)
+			state = enc->state | chan;
+		else
+			state = enc->state & ~chan;
+
+		if (enc->known != (QUAD_CHAN_A | QUAD_CHAN_B)) {
+			/* Learn the levels from the first edges. */
+			enc->known |= chan;
+			enc->state = state;
+			continue;
+		}
+
+		delta = quad_table[enc->state << 2 | state];
+		enc->state = state;
+
+		if (delta == QUAD_ERR) {
+			enc->num_errors++;
+			continue;
+		}
+
+		enc->position += delta;
+		quad_update_velocity(enc,
+				     gpiod_edge_event_get_timestamp_ns(event),
+				     quad->window_ns);
+	}
+
+	return num_decoded;
+}
+
+GPIOD_API int gpiod_quadrature_get_state(struct gpiod_quadrature *quad,
+					 unsigned int encoder,
+					 int64_t *position, double *velocity,
+					 uint64_t *num_errors)
+{
+	struct quad_encoder *enc;
+
+	assert(quad);
+
+	if (encoder >= quad->num_encoders) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	enc = &quad->encoders[encoder];
+
+	if (position)
+		*position = enc->position;
+	if (velocity)
+		*velocity = enc->velocity;
+	if (num_errors)
+		*num_errors = enc->num_errors;
+
+	return 0;
+}
+
+GPIOD_API int gpiod_quadrature_reset(struct gpiod_quadrature *quad,
+				     unsigned int encoder, int64_t position)
+{
+	struct quad_encoder *enc;
+
+	assert(quad);
+
+	if (encoder >= quad->num_encoders) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	enc = &quad->encoders[encoder];
+	enc->position = position;
+	enc->num_errors = 0;
+	enc->velocity = 0;
+	enc->window_open = false;
+
+	return 0;
+}
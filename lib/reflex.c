@@ -0,0 +1,625 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <assert.h>
+#include <errno.h>
+#include <gpiod.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "internal.h"
+
+/* Number of events read from a trigger request in one go. */
+#define REFLEX_EVENT_BATCH	16
+
+struct reflex_request {
+	struct gpiod_line_request *request;
+	uint64_t mask;
+	uint64_t bits;
+};
+
+struct reflex_rule {
+	size_t trigger;
+	unsigned int offset;
+	enum gpiod_line_edge edge;
+	size_t target;
+	uint64_t mask;
+	uint64_t bits;
+	uint64_t delay_ns;
+	/* Written by the reflex thread, read by the user. */
+	uint64_t num_triggers;
+	uint64_t last_latency;
+	uint64_t max_latency;
+	uint64_t latency_sum;
+};
+
+/* An action scheduled by a rule, due at the given time. */
+struct reflex_action {
+	size_t rule;
+	uint64_t due;
+};
+
+struct gpiod_reflex {
+	struct reflex_request *triggers;
+	size_t num_triggers;
+	struct reflex_request *targets;
+	size_t num_targets;
+	struct reflex_rule *rules;
+	size_t num_rules;
+	int priority;
+	uint64_t spin_ns;
+	pthread_t thread;
+	int stop_fd;
+	bool running;
+	int error;
+};
+
+GPIOD_API struct gpiod_reflex *gpiod_reflex_new(void)
+{
+	struct gpiod_reflex *reflex;
+
+	reflex = malloc(sizeof(*reflex));
+	if (!reflex)
+		return NULL;
+
+	memset(reflex, 0, sizeof(*reflex));
+	reflex->stop_fd = -1;
+
+	return reflex;
+}
+
+GPIOD_API void gpiod_reflex_free(struct gpiod_reflex *reflex)
+{
+	if (!reflex)
+		return;
+
+	if (reflex->running)
+		gpiod_reflex_stop(reflex);
+
+	free(reflex->rules);
+	free(reflex->targets);
+	free(reflex->triggers);
+	free(reflex);
+}
+
+static int reflex_get_request_idx(struct reflex_request **requests,
+				  size_t *num_requests,
+				  struct gpiod_line_request *request)
+{
+	struct reflex_request *reqs;
+	size_t i;
+
+	for (i = 0; i < *num_requests; i++) {
+		if ((*requests)[i].request == request)
+			return i;
+	}
+
+	reqs = realloc(*requests, (*num_requests + 1) * sizeof(*reqs));
+	if (!reqs)
+		return -1;
+
+	*requests = reqs;
+	memset(&reqs[i], 0, sizeof(*reqs));
+	reqs[i].request = request;
+	(*num_requests)++;
+
+	return i;
+}
+
+GPIOD_API int gpiod_reflex_add_rule(struct gpiod_reflex *reflex,
+				    struct gpiod_line_request *trigger,
+				    unsigned int offset,
+				    enum gpiod_line_edge edge,
+				    struct gpiod_line_request *target,
+				    uint64_t mask, uint64_t bits,
+				    uint64_t delay_ns)
+{
+	struct reflex_rule *rules, *rule;
+	size_t num_lines;
+	uint64_t bit;
+	int trig, targ, ret;
+
+	assert(reflex);
+	assert(trigger);
+	assert(target);
+
+	if (reflex->running) {
+		errno = EBUSY;
+		return -1;
+	}
+
+	switch (edge) {
+	case GPIOD_LINE_EDGE_RISING:
+	case GPIOD_LINE_EDGE_FALLING:
+	case GPIOD_LINE_EDGE_BOTH:
+		break;
+	default:
+		errno = EINVAL;
+		return -1;
+	}
+
+	ret = gpiod_line_request_offsets_to_mask(trigger, 1, &offset, &bit);
+	if (ret)
+		return -1;
+
+	num_lines = gpiod_line_request_get_num_requested_lines(target);
+	if (!mask || (num_lines < 64 && (mask >> num_lines))) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	trig = reflex_get_request_idx(&reflex->triggers, &reflex->num_triggers,
+				      trigger);
+	if (trig < 0)
+		return -1;
+
+	targ = reflex_get_request_idx(&reflex->targets, &reflex->num_targets,
+				      target);
+	if (targ < 0)
+		return -1;
+
+	rules = realloc(reflex->rules,
+			(reflex->num_rules + 1) * sizeof(*rules));
+	if (!rules)
+		return -1;
+
+	reflex->rules = rules;
+	rule = &rules[reflex->num_rules];
+	memset(rule, 0, sizeof(*rule));
+	rule->trigger = trig;
+	rule->offset = offset;
+	rule->edge = edge;
+	rule->target = targ;
+	rule->mask = mask;
+	rule->bits = bits & mask;
+	rule->delay_ns = delay_ns;
+
+	return reflex->num_rules++;
+}
+
+GPIOD_API size_t gpiod_reflex_get_num_rules(struct gpiod_reflex *reflex)
+{
+	assert(reflex);
+
+	return reflex->num_rules;
+}
+
+GPIOD_API int gpiod_reflex_set_priority(struct gpiod_reflex *reflex,
+					int priority)
+{
+	assert(reflex);
+
+	if (!gpiod_thread_priority_valid(priority)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	reflex->priority = priority;
+
+	return 0;
+}
+
+GPIOD_API void gpiod_reflex_set_spin(struct gpiod_reflex *reflex,
+				     uint64_t spin_ns)
+{
+	assert(reflex);
+
+	reflex->spin_ns = spin_ns;
+}
+
+static bool reflex_rule_matches(struct reflex_rule *rule, size_t trigger,
+				struct gpio_v2_line_event *event)
+{
+	if (rule->trigger != trigger || rule->offset != event->offset)
+		return false;
+
+	if (rule->edge == GPIOD_LINE_EDGE_RISING)
+		return event->id == GPIO_V2_LINE_EVENT_RISING_EDGE;
+	if (rule->edge == GPIOD_LINE_EDGE_FALLING)
+		return event->id == GPIO_V2_LINE_EVENT_FALLING_EDGE;
+
+	return true;
+}
+
+static void reflex_record_latency(struct reflex_rule *rule, uint64_t latency)
+{
+	__atomic_store_n(&rule->last_latency, latency, __ATOMIC_RELAXED);
+	__atomic_store_n(&rule->latency_sum, rule->latency_sum + latency,
+			 __ATOMIC_RELAXED);
+	if (latency > rule->max_latency)
+		__atomic_store_n(&rule->max_latency, latency,
+				 __ATOMIC_RELAXED);
+	__atomic_store_n(&rule->num_triggers, rule->num_triggers + 1,
+			 __ATOMIC_RELEASE);
+}
+
+/*
+ * Carry out a set of actions. Actions hitting the same target request are
+ * merged into a single set-values operation with later rules taking
+ * precedence on the lines they share.
+ */
+static int reflex_apply(struct gpiod_reflex *reflex,
+			struct reflex_action *actions, size_t num_actions)
+{
+	struct reflex_request *target;
+	struct reflex_rule *rule;
+	uint64_t done;
+	size_t i;
+	int ret;
+
+	if (!num_actions)
+		return 0;
+
+	for (i = 0; i < reflex->num_targets; i++) {
+		reflex->targets[i].mask = 0;
+		reflex->targets[i].bits = 0;
+	}
+
+	for (i = 0; i < num_actions; i++) {
+		rule = &reflex->rules[actions[i].rule];
+		target = &reflex->targets[rule->target];
+
+		target->mask |= rule->mask;
+		target->bits = (target->bits & ~rule->mask) | rule->bits;
+	}
+
+	for (i = 0; i < reflex->num_targets; i++) {
+		target = &reflex->targets[i];
+		if (!target->mask)
+			continue;
+
+		ret = gpiod_line_request_set_bits(target->request,
+						  target->mask, target->bits);
+		if (ret)
+			return -1;
+	}
+
+	done = gpiod_monotonic_ns();
+
+	for (i = 0; i < num_actions; i++)
+		reflex_record_latency(&reflex->rules[actions[i].rule],
+				      done > actions[i].due ?
+						done - actions[i].due : 0);
+
+	return 0;
+}
+
+struct reflex_thread_ctx {
+	struct pollfd *pfds;
+	/* Actions triggered by the current batch of events. */
+	struct reflex_action *batch;
+	size_t max_batch;
+	/* Delayed actions waiting for their deadline. */
+	struct reflex_action *pending;
+	size_t num_pending;
+	size_t max_pending;
+};
+
+static int reflex_schedule(struct reflex_thread_ctx *ctx, size_t rule,
+			   uint64_t due)
+{
+	struct reflex_action *pending;
+	size_t max;
+
+	if (ctx->num_pending == ctx->max_pending) {
+		max = ctx->max_pending ? ctx->max_pending * 2 : 16;
+
+		pending = realloc(ctx->pending, max * sizeof(*pending));
+		if (!pending)
+			return -1;
+
+		ctx->pending = pending;
+		ctx->max_pending = max;
+	}
+
+	ctx->pending[ctx->num_pending].rule = rule;
+	ctx->pending[ctx->num_pending].due = due;
+	ctx->num_pending++;
+
+	return 0;
+}
+
+static int reflex_handle_events(struct gpiod_reflex *reflex,
+				struct reflex_thread_ctx *ctx, size_t trigger)
+{
+	struct gpio_v2_line_event events[REFLEX_EVENT_BATCH];
+	struct gpio_v2_line_event *event;
+	size_t i, j, num_events, num_batch = 0;
+	struct reflex_rule *rule;
+	uint64_t now;
+	ssize_t rd;
+	int ret;
+
+	rd = read(ctx->pfds[trigger].fd, events, sizeof(events));
+	if (rd < 0) {
+		if (errno == EAGAIN)
+			return 0;
+
+		return -1;
+	}
+
+	/*
+	 * Delays are counted from the time the events were read and not from
+	 * their timestamps: the latter may come from the realtime or HTE
+	 * clock while the pending actions are checked against the monotonic
+	 * clock.
+	 */
+	now = gpiod_monotonic_ns();
+	num_events = rd / sizeof(*events);
+
+	for (i = 0; i < num_events; i++) {
+		event = &events[i];
+
+		for (j = 0; j < reflex->num_rules; j++) {
+			rule = &reflex->rules[j];
+			if (!reflex_rule_matches(rule, trigger, event))
+				continue;
+
+			if (rule->delay_ns) {
+				ret = reflex_schedule(ctx, j,
+						      now + rule->delay_ns);
+				if (ret)
+					return -1;
+			} else {
+				ctx->batch[num_batch].rule = j;
+				ctx->batch[num_batch].due = event->timestamp_ns;
+				num_batch++;
+			}
+		}
+	}
+
+	return reflex_apply(reflex, ctx->batch, num_batch);
+}
+
+/* Carry out all delayed actions that are due by the given time. */
+static int reflex_fire_pending(struct gpiod_reflex *reflex,
+			       struct reflex_thread_ctx *ctx, uint64_t until)
+{
+	size_t i, num_batch;
+	uint64_t next, now;
+	int ret;
+
+	while (ctx->num_pending) {
+		next = UINT64_MAX;
+		for (i = 0; i < ctx->num_pending; i++) {
+			if (ctx->pending[i].due < next)
+				next = ctx->pending[i].due;
+		}
+
+		if (next > until)
+			break;
+
+		gpiod_sleep_until(next, reflex->spin_ns);
+		now = gpiod_monotonic_ns();
+
+		/* Everything that became due in the meantime goes together. */
+		for (i = 0, num_batch = 0;
+		     i < ctx->num_pending && num_batch < ctx->max_batch; ) {
+			if (ctx->pending[i].due > now) {
+				i++;
+				continue;
+			}
+
+			ctx->batch[num_batch++] = ctx->pending[i];
+			ctx->pending[i] = ctx->pending[--ctx->num_pending];
+		}
+
+		ret = reflex_apply(reflex, ctx->batch, num_batch);
+		if (ret)
+			return -1;
+	}
+
+	return 0;
+}
+
+static int64_t reflex_poll_timeout(struct gpiod_reflex *reflex,
+				   struct reflex_thread_ctx *ctx)
+{
+	uint64_t next = UINT64_MAX, now;
+	size_t i;
+
+	if (!ctx->num_pending)
+		return -1;
+
+	for (i = 0; i < ctx->num_pending; i++) {
+		if (ctx->pending[i].due < next)
+			next = ctx->pending[i].due;
+	}
+
+	/* Wake up early enough to busy-wait for the remainder. */
+	next = next > reflex->spin_ns ? next - reflex->spin_ns : 0;
+	now = gpiod_monotonic_ns();
+
+	return next > now ? (int64_t)(next - now) : 0;
+}
+
+static void *reflex_thread_func(void *data)
+{
+	struct reflex_thread_ctx ctx;
+	struct gpiod_reflex *reflex = data;
+	size_t i, num_fds = reflex->num_triggers + 1;
+	struct timespec ts, *tsp;
+	int64_t timeout;
+	int ret;
+
+	memset(&ctx, 0, sizeof(ctx));
+
+	ctx.pfds = calloc(num_fds, sizeof(*ctx.pfds));
+	/* Each event of a batch can trigger every rule at most once. */
+	ctx.max_batch = REFLEX_EVENT_BATCH * reflex->num_rules;
+	ctx.batch = calloc(ctx.max_batch, sizeof(*ctx.batch));
+	if (!ctx.pfds || !ctx.batch)
+		goto err;
+
+	for (i = 0; i < reflex->num_triggers; i++) {
+		ctx.pfds[i].fd = gpiod_line_request_get_fd(
+					reflex->triggers[i].request);
+		ctx.pfds[i].events = POLLIN | POLLPRI;
+	}
+
+	ctx.pfds[i].fd = reflex->stop_fd;
+	ctx.pfds[i].events = POLLIN;
+
+	for (;;) {
+		timeout = reflex_poll_timeout(reflex, &ctx);
+		if (timeout >= 0) {
+			ts.tv_sec = timeout / 1000000000ULL;
+			ts.tv_nsec = timeout % 1000000000ULL;
+			tsp = &ts;
+		} else {
+			tsp = NULL;
+		}
+
+		ret = ppoll(ctx.pfds, num_fds, tsp, NULL);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+
+			goto err;
+		}
+
+		if (ctx.pfds[reflex->num_triggers].revents)
+			break;
+
+		for (i = 0; i < reflex->num_triggers; i++) {
+			if (!ctx.pfds[i].revents)
+				continue;
+
+			ret = reflex_handle_events(reflex, &ctx, i);
+			if (ret)
+				goto err;
+		}
+
+		ret = reflex_fire_pending(reflex, &ctx,
+					  gpiod_monotonic_ns() +
+					  reflex->spin_ns);
+		if (ret)
+			goto err;
+	}
+
+	goto out;
+
+err:
+	__atomic_store_n(&reflex->error, errno, __ATOMIC_RELAXED);
+out:
+	free(ctx.pending);
+	free(ctx.batch);
+	free(ctx.pfds);
+
+	return NULL;
+}
+
+GPIOD_API int gpiod_reflex_start(struct gpiod_reflex *reflex)
+{
+	struct reflex_rule *rule;
+	size_t i;
+	int ret;
+
+	assert(reflex);
+
+	if (reflex->running) {
+		errno = EBUSY;
+		return -1;
+	}
+
+	if (!reflex->num_rules) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	for (i = 0; i < reflex->num_rules; i++) {
+		rule = &reflex->rules[i];
+
+		rule->num_triggers = 0;
+		rule->last_latency = 0;
+		rule->max_latency = 0;
+		rule->latency_sum = 0;
+	}
+
+	reflex->stop_fd = eventfd(0, EFD_CLOEXEC);
+	if (reflex->stop_fd < 0)
+		return -1;
+
+	reflex->error = 0;
+
+	ret = gpiod_thread_create(&reflex->thread, reflex->priority,
+				  reflex_thread_func, reflex);
+	if (ret) {
+		close(reflex->stop_fd);
+		reflex->stop_fd = -1;
+		errno = ret;
+		return -1;
+	}
+
+	reflex->running = true;
+
+	return 0;
+}
+
+GPIOD_API int gpiod_reflex_stop(struct gpiod_reflex *reflex)
+{
+	uint64_t one = 1;
+	ssize_t wr;
+
+	assert(reflex);
+
+	if (!reflex->running) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	wr = write(reflex->stop_fd, &one, sizeof(one));
+	if (wr < 0)
+		return -1;
+
+	pthread_join(reflex->thread, NULL);
+	close(reflex->stop_fd);
+	reflex->stop_fd = -1;
+	reflex->running = false;
+
+	if (reflex->error) {
+		errno = reflex->error;
+		return -1;
+	}
+
+	return 0;
+}
+
+GPIOD_API int gpiod_reflex_get_stats(struct gpiod_reflex *reflex,
+				     unsigned int rule, uint64_t *num_triggers,
+				     uint64_t *last_latency_ns,
+				     uint64_t *avg_latency_ns,
+				     uint64_t *max_latency_ns)
+{
+	struct reflex_rule *r;
+	uint64_t num, sum;
+
+	assert(reflex);
+
+	if (rule >= reflex->num_rules) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	r = &reflex->rules[rule];
+
+	num = __atomic_load_n(&r->num_triggers, __ATOMIC_ACQUIRE);
+	sum = __atomic_load_n(&r->latency_sum, __ATOMIC_RELAXED);
+
+	if (num_triggers)
+		*num_triggers = num;
+	if (last_latency_ns)
+		*last_latency_ns = __atomic_load_n(&r->last_latency,
+						   __ATOMIC_RELAXED);
+	if (avg_latency_ns)
+		*avg_latency_ns = num ? sum / num : 0;
+	if (max_latency_ns)
+		*max_latency_ns = __atomic_load_n(&r->max_latency,
+						  __ATOMIC_RELAXED);
+
+	return 0;
+}
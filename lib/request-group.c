@@ -0,0 +1,318 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <assert.h>
+#include <errno.h>
+#include <gpiod.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "internal.h"
+
+enum {
+	GROUP_OP_GET_VALUES = 1,
+	GROUP_OP_SET_VALUES,
+	GROUP_OP_EXIT,
+};
+
+struct group_member {
+	struct gpiod_request_group *group;
+	struct gpiod_line_request *request;
+	/* Index of the first value of this request in the user's array. */
+	size_t values_idx;
+	pthread_t thread;
+	bool has_thread;
+	/* Generation of the last operation seen by the worker. */
+	unsigned long generation;
+	/* Results of the last operation. */
+	uint64_t start_ns;
+	uint64_t end_ns;
+	int error;
+};
+
+/*
+ * The first request is always handled by the calling thread, every other
+ * one by its own worker thread living as long as the group does.
+ */
+struct gpiod_request_group {
+	struct group_member **members;
+	size_t num_members;
+	size_t num_values;
+	pthread_mutex_t lock;
+	pthread_cond_t start_cond;
+	pthread_cond_t done_cond;
+	unsigned long generation;
+	int op;
+	enum gpiod_line_value *values;
+	unsigned int num_arrived;
+	size_t num_done;
+};
+
+GPIOD_API struct gpiod_request_group *gpiod_request_group_new(void)
+{
+	struct gpiod_request_group *group;
+
+	group = malloc(sizeof(*group));
+	if (!group)
+		return NULL;
+
+	memset(group, 0, sizeof(*group));
+	pthread_mutex_init(&group->lock, NULL);
+	pthread_cond_init(&group->start_cond, NULL);
+	pthread_cond_init(&group->done_cond, NULL);
+
+	return group;
+}
+
+static void group_start_op(struct gpiod_request_group *group, int op,
+			   enum gpiod_line_value *values)
+{
+	pthread_mutex_lock(&group->lock);
+	group->op = op;
+	group->values = values;
+	group->num_arrived = 0;
+	group->num_done = 0;
+	group->generation++;
+	pthread_cond_broadcast(&group->start_cond);
+	pthread_mutex_unlock(&group->lock);
+}
+
+GPIOD_API void gpiod_request_group_free(struct gpiod_request_group *group)
+{
+	size_t i;
+
+	if (!group)
+		return;
+
+	group_start_op(group, GROUP_OP_EXIT, NULL);
+
+	for (i = 0; i < group->num_members; i++) {
+		if (group->members[i]->has_thread)
+			pthread_join(group->members[i]->thread, NULL);
+
+		free(group->members[i]);
+	}
+
+	pthread_cond_destroy(&group->done_cond);
+	pthread_cond_destroy(&group->start_cond);
+	pthread_mutex_destroy(&group->lock);
+	free(group->members);
+	free(group);
+}
+
+static void group_run_op(struct gpiod_request_group *group,
+			 struct group_member *member, int op)
+{
+	enum gpiod_line_value *values = group->values + member->values_idx;
+	int ret;
+
+	/*
+	 * Waking up the threads takes much longer than the scatter of their
+	 * ioctls we're after. Line everyone up before touching the hardware.
+	 */
+	__atomic_add_fetch(&group->num_arrived, 1, __ATOMIC_ACQ_REL);
+	while (__atomic_load_n(&group->num_arrived, __ATOMIC_ACQUIRE) <
+	       group->num_members)
+		sched_yield();
+
+	member->start_ns = gpiod_monotonic_ns();
+
+	if (op == GROUP_OP_SET_VALUES)
+		ret = gpiod_line_request_set_values(member->request, values);
+	else
+		ret = gpiod_line_request_get_values(member->request, values);
+
+	member->end_ns = gpiod_monotonic_ns();
+	member->error = ret ? errno : 0;
+
+	pthread_mutex_lock(&group->lock);
+	if (++group->num_done == group->num_members)
+		pthread_cond_signal(&group->done_cond);
+	pthread_mutex_unlock(&group->lock);
+}
+
+static void *group_worker(void *data)
+{
+	struct group_member *member = data;
+	struct gpiod_request_group *group = member->group;
+	int op;
+
+	for (;;) {
+		pthread_mutex_lock(&group->lock);
+		while (group->generation == member->generation)
+			pthread_cond_wait(&group->start_cond, &group->lock);
+		member->generation = group->generation;
+		op = group->op;
+		pthread_mutex_unlock(&group->lock);
+
+		if (op == GROUP_OP_EXIT)
+			return NULL;
+
+		group_run_op(group, member, op);
+	}
+}
+
+GPIOD_API int
+gpiod_request_group_add_request(struct gpiod_request_group *group,
+				struct gpiod_line_request *request)
+{
+	struct group_member **members, *member;
+	size_t i;
+	int ret;
+
+	assert(group);
+	assert(request);
+
+	for (i = 0; i < group->num_members; i++) {
+		if (group->members[i]->request == request) {
+			errno = EEXIST;
+			return -1;
+		}
+	}
+
+	members = realloc(group->members,
+			  (group->num_members + 1) * sizeof(*members));
+	if (!members)
+		return -1;
+
+	group->members = members;
+
+	member = malloc(sizeof(*member));
+	if (!member)
+		return -1;
+
+	memset(member, 0, sizeof(*member));
+	member->group = group;
+	member->request = request;
+	member->values_idx = group->num_values;
+	member->generation = group->generation;
+
+	if (group->num_members) {
+		ret = pthread_create(&member->thread, NULL,
+				     group_worker, member);
+		if (ret) {
+			free(member);
+			errno = ret;
+			return -1;
+		}
+
+		member->has_thread = true;
+	}
+
+	group->num_values += gpiod_line_request_get_num_requested_lines(request);
+	members[group->num_members] = member;
+
+	return group->num_members++;
+}
+
+GPIOD_API size_t
+gpiod_request_group_get_num_requests(struct gpiod_request_group *group)
+{
+	assert(group);
+
+	return group->num_members;
+}
+
+static int group_execute(struct gpiod_request_group *group, int op,
+			 enum gpiod_line_value *values)
+{
+	size_t i;
+
+	if (!group->num_members || !values) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	group_start_op(group, op, values);
+	group_run_op(group, group->members[0], op);
+
+	pthread_mutex_lock(&group->lock);
+	while (group->num_done < group->num_members)
+		pthread_cond_wait(&group->done_cond, &group->lock);
+	pthread_mutex_unlock(&group->lock);
+
+	for (i = 0; i < group->num_members; i++) {
+		if (group->members[i]->error) {
+			errno = group->members[i]->error;
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+GPIOD_API int
+gpiod_request_group_set_values(struct gpiod_request_group *group,
+			       const enum gpiod_line_value *values)
+{
+	assert(group);
+
+	/* Only ever read from in set mode. */
+	return group_execute(group, GROUP_OP_SET_VALUES,
+			     (enum gpiod_line_value *)values);
+}
+
+GPIOD_API int
+gpiod_request_group_get_values(struct gpiod_request_group *group,
+			       enum gpiod_line_value *values)
+{
+	assert(group);
+
+	return group_execute(group, GROUP_OP_GET_VALUES, values);
+}
+
+GPIOD_API int
+gpiod_request_group_get_timestamps(struct gpiod_request_group *group,
+				   size_t index, uint64_t *start_ns,
+				   uint64_t *end_ns)
+{
+	assert(group);
+
+	if (index >= group->num_members) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (start_ns)
+		*start_ns = group->members[index]->start_ns;
+	if (end_ns)
+		*end_ns = group->members[index]->end_ns;
+
+	return 0;
+}
+
+GPIOD_API int gpiod_request_group_get_error(struct gpiod_request_group *group,
+					    size_t index)
+{
+	assert(group);
+
+	if (index >= group->num_members) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return group->members[index]->error;
+}
+
+GPIOD_API uint64_t
+gpiod_request_group_get_skew_ns(struct gpiod_request_group *group)
+{
+	uint64_t first = UINT64_MAX, last = 0;
+	struct group_member *member;
+	size_t i;
+
+	assert(group);
+
+	for (i = 0; i < group->num_members; i++) {
+		member = group->members[i];
+
+		if (member->start_ns < first)
+			first = member->start_ns;
+		if (member->end_ns > last)
+			last = member->end_ns;
+	}
+
+	return last > first ? last - first : 0;
+}
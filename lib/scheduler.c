@@ -0,0 +1,580 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <assert.h>
+#include <errno.h>
+#include <gpiod.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include "internal.h"
+
+#define SCHED_MIN_ENTRIES	16
+
+struct sched_entry {
+	uint64_t deadline;
+	/* Keeps entries with equal deadlines in the order they were added. */
+	uint64_t seqno;
+	struct gpiod_line_request *request;
+	uint64_t mask;
+	uint64_t bits;
+};
+
+/* Values merged from all entries due for a single request. */
+struct sched_target {
+	struct gpiod_line_request *request;
+	uint64_t mask;
+	uint64_t bits;
+};
+
+struct gpiod_scheduler {
+	pthread_mutex_t lock;
+	/* Binary min-heap ordered by deadline, then seqno. */
+	struct sched_entry *entries;
+	size_t num_entries;
+	size_t max_entries;
+	uint64_t next_seqno;
+	int priority;
+	uint64_t spin_ns;
+	pthread_t thread;
+	int timer_fd;
+	int stop_fd;
+	bool running;
+	int error;
+	/* Statistics, protected by the lock. */
+	uint64_t num_executed;
+	uint64_t num_batches;
+	uint64_t last_lateness;
+	uint64_t max_lateness;
+	uint64_t lateness_sum;
+};
+
+GPIOD_API struct gpiod_scheduler *gpiod_scheduler_new(void)
+{
+	struct gpiod_scheduler *sched;
+
+	sched = malloc(sizeof(*sched));
+	if (!sched)
+		return NULL;
+
+	memset(sched, 0, sizeof(*sched));
+	pthread_mutex_init(&sched->lock, NULL);
+	sched->timer_fd = -1;
+	sched->stop_fd = -1;
+
+	return sched;
+}
+
+GPIOD_API void gpiod_scheduler_free(struct gpiod_scheduler *sched)
+{
+	if (!sched)
+		return;
+
+	if (sched->running)
+		gpiod_scheduler_stop(sched);
+
+	pthread_mutex_destroy(&sched->lock);
+	free(sched->entries);
+	free(sched);
+}
+
+GPIOD_API int gpiod_scheduler_set_priority(struct gpiod_scheduler *sched,
+					   int priority)
+{
+	assert(sched);
+
+	if (!gpiod_thread_priority_valid(priority)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	sched->priority = priority;
+
+	return 0;
+}
+
+GPIOD_API void gpiod_scheduler_set_spin(struct gpiod_scheduler *sched,
+					uint64_t spin_ns)
+{
+	assert(sched);
+
+	sched->spin_ns = spin_ns;
+}
+
+static bool sched_entry_before(struct sched_entry *a, struct sched_entry *b)
+{
+	if (a->deadline != b->deadline)
+		return a->deadline < b->deadline;
+
+	return a->seqno < b->seqno;
+}
+
+static void sched_swap(struct sched_entry *a, struct sched_entry *b)
+{
+	struct sched_entry tmp = *a;
+
+	*a = *b;
+	*b = tmp;
+}
+
+static void sched_heap_push(struct gpiod_scheduler *sched,
+			    struct sched_entry *entry)
+{
+	struct sched_entry *entries = sched->entries;
+	size_t pos = sched->num_entries++, parent;
+
+	entries[pos] = *entry;
+
+	while (pos) {
+		parent = (pos - 1) / 2;
+		if (!sched_entry_before(&entries[pos], &entries[parent]))
+			break;
+
+		sched_swap(&entries[pos], &entries[parent]);
+		pos = parent;
+	}
+}
+
+static void sched_heap_pop(struct gpiod_scheduler *sched,
+			   struct sched_entry *entry)
+{
+	struct sched_entry *entries = sched->entries;
+	size_t pos = 0, child;
+
+	*entry = entries[0];
+	entries[0] = entries[--sched->num_entries];
+
+	for (;;) {
+		child = 2 * pos + 1;
+		if (child >= sched->num_entries)
+			break;
+
+		if (child + 1 < sched->num_entries &&
+		    sched_entry_before(&entries[child + 1], &entries[child]))
+			child++;
+
+		if (!sched_entry_before(&entries[child], &entries[pos]))
+			break;
+
+		sched_swap(&entries[pos], &entries[child]);
+		pos = child;
+	}
+}
+
+/* Must be called with the lock held. */
+static int sched_arm_timer(struct gpiod_scheduler *sched)
+{
+	struct itimerspec its;
+	uint64_t wake;
+
+	memset(&its, 0, sizeof(its));
+
+	if (sched->num_entries) {
+		/* Wake up early enough to busy-wait for the remainder. */
+		wake = sched->entries[0].deadline;
+		wake = wake > sched->spin_ns ? wake - sched->spin_ns : 0;
+		/* A zero expiration would disarm the timer. */
+		if (!wake)
+			wake = 1;
+
+		its.it_value.tv_sec = wake / 1000000000ULL;
+		its.it_value.tv_nsec = wake % 1000000000ULL;
+	}
+
+	return timerfd_settime(sched->timer_fd, TFD_TIMER_ABSTIME, &its, NULL);
+}
+
+GPIOD_API int gpiod_scheduler_add(struct gpiod_scheduler *sched,
+				  uint64_t deadline_ns,
+				  struct gpiod_line_request *request,
+				  uint64_t mask, uint64_t bits)
+{
+	struct sched_entry entry, *entries;
+	size_t num_lines, max;
+	int ret = 0;
+
+	assert(sched);
+	assert(request);
+
+	num_lines = gpiod_line_request_get_num_requested_lines(request);
+	if (!mask || (num_lines < 64 && (mask >> num_lines))) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	pthread_mutex_lock(&sched->lock);
+
+	if (sched->num_entries == sched->max_entries) {
+		max = sched->max_entries * 2 ?: SCHED_MIN_ENTRIES;
+		entries = realloc(sched->entries, max * sizeof(*entries));
+		if (!entries) {
+			pthread_mutex_unlock(&sched->lock);
+			return -1;
+		}
+
+		sched->entries = entries;
+		sched->max_entries = max;
+	}
+
+	entry.deadline = deadline_ns;
+	entry.seqno = sched->next_seqno++;
+	entry.request = request;
+	entry.mask = mask;
+	entry.bits = bits & mask;
+
+	sched_heap_push(sched, &entry);
+
+	/* Only a new earliest entry changes the time to wake up. */
+	if (sched->running && sched->entries[0].seqno == entry.seqno)
+		ret = sched_arm_timer(sched);
+
+	pthread_mutex_unlock(&sched->lock);
+
+	return ret;
+}
+
+GPIOD_API size_t
+gpiod_scheduler_get_num_pending(struct gpiod_scheduler *sched)
+{
+	size_t num;
+
+	assert(sched);
+
+	pthread_mutex_lock(&sched->lock);
+	num = sched->num_entries;
+	pthread_mutex_unlock(&sched->lock);
+
+	return num;
+}
+
+struct sched_thread_ctx {
+	/* Entries taken off the heap for the current batch. */
+	struct sched_entry *batch;
+	size_t max_batch;
+	struct sched_target *targets;
+	size_t max_targets;
+};
+
+static int sched_ctx_reserve(struct sched_thread_ctx *ctx, size_t num)
+{
+	struct sched_target *targets;
+	struct sched_entry *batch;
+
+	if (num <= ctx->max_batch)
+		return 0;
+
+	batch = realloc(ctx->batch, num * sizeof(*batch));
+	if (!batch)
+		return -1;
+
+	/*
+	 * The new buffer is kept even if the second allocation fails but the
+	 * sizes are only bumped once both buffers have grown.
+	 */
+	ctx->batch = batch;
+
+	/* There can't be more targets than entries. */
+	targets = realloc(ctx->targets, num * sizeof(*targets));
+	if (!targets)
+		return -1;
+
+	ctx->targets = targets;
+	ctx->max_batch = num;
+	ctx->max_targets = num;
+
+	return 0;
+}
+
+/*
+ * Set the values of a batch of entries. Entries hitting the same request
+ * are merged into a single ioctl() with later entries taking precedence on
+ * the lines they share.
+ */
+static void sched_execute(struct gpiod_scheduler *sched,
+			  struct sched_thread_ctx *ctx, size_t num_batch)
+{
+	size_t i, j, num_targets = 0;
+	struct sched_target *target;
+	struct sched_entry *entry;
+	uint64_t done, lateness;
+	int ret, error = 0;
+
+	for (i = 0; i < num_batch; i++) {
+		entry = &ctx->batch[i];
+
+		for (j = 0; j < num_targets; j++) {
+			if (ctx->targets[j].request == entry->request)
+				break;
+		}
+
+		target = &ctx->targets[j];
+		if (j == num_targets) {
+			target->request = entry->request;
+			target->mask = 0;
+			target->bits = 0;
+			num_targets++;
+		}
+
+		target->mask |= entry->mask;
+		target->bits = (target->bits & ~entry->mask) | entry->bits;
+	}
+
+	for (i = 0; i < num_targets; i++) {
+		target = &ctx->targets[i];
+
+		ret = gpiod_line_request_set_bits(target->request,
+						  target->mask, target->bits);
+		if (ret)
+			error = errno;
+	}
+
+	done = gpiod_monotonic_ns();
+
+	pthread_mutex_lock(&sched->lock);
+
+	if (error)
+		sched->error = error;
+
+	for (i = 0; i < num_batch; i++) {
+		entry = &ctx->batch[i];
+
+		lateness = done > entry->deadline ? done - entry->deadline : 0;
+		sched->last_lateness = lateness;
+		sched->lateness_sum += lateness;
+		if (lateness > sched->max_lateness)
+			sched->max_lateness = lateness;
+	}
+
+	sched->num_executed += num_batch;
+	sched->num_batches += num_targets;
+
+	pthread_mutex_unlock(&sched->lock);
+}
+
+/* Execute everything that's due within the spin budget. */
+static int sched_run_due(struct gpiod_scheduler *sched,
+			 struct sched_thread_ctx *ctx)
+{
+	size_t num_batch;
+	uint64_t now;
+	int ret;
+
+	pthread_mutex_lock(&sched->lock);
+
+	while (sched->num_entries &&
+	       sched->entries[0].deadline <=
+				gpiod_monotonic_ns() + sched->spin_ns) {
+		now = sched->entries[0].deadline;
+		pthread_mutex_unlock(&sched->lock);
+
+		gpiod_sleep_until(now, sched->spin_ns);
+		now = gpiod_monotonic_ns();
+
+		pthread_mutex_lock(&sched->lock);
+
+		ret = sched_ctx_reserve(ctx, sched->num_entries);
+		if (ret) {
+			pthread_mutex_unlock(&sched->lock);
+			return -1;
+		}
+
+		/* Everything that became due in the meantime goes together. */
+		for (num_batch = 0;
+		     sched->num_entries && sched->entries[0].deadline <= now;
+		     num_batch++)
+			sched_heap_pop(sched, &ctx->batch[num_batch]);
+
+		pthread_mutex_unlock(&sched->lock);
+
+		sched_execute(sched, ctx, num_batch);
+
+		pthread_mutex_lock(&sched->lock);
+	}
+
+	ret = sched_arm_timer(sched);
+
+	pthread_mutex_unlock(&sched->lock);
+
+	return ret;
+}
+
+static void *sched_thread_func(void *data)
+{
+	struct gpiod_scheduler *sched = data;
+	struct sched_thread_ctx ctx;
+	struct pollfd pfds[2];
+	uint64_t expirations;
+	ssize_t rd;
+	int ret;
+
+	memset(&ctx, 0, sizeof(ctx));
+	memset(pfds, 0, sizeof(pfds));
+
+	pfds[0].fd = sched->timer_fd;
+	pfds[0].events = POLLIN;
+	pfds[1].fd = sched->stop_fd;
+	pfds[1].events = POLLIN;
+
+	for (;;) {
+		ret = poll(pfds, 2, -1);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+
+			goto err;
+		}
+
+		if (pfds[1].revents)
+			break;
+
+		if (pfds[0].revents) {
+			rd = read(sched->timer_fd, &expirations,
+				  sizeof(expirations));
+			if (rd < 0 && errno != EAGAIN)
+				goto err;
+		}
+
+		ret = sched_run_due(sched, &ctx);
+		if (ret)
+			goto err;
+	}
+
+	goto out;
+
+err:
+	pthread_mutex_lock(&sched->lock);
+	sched->error = errno;
+	pthread_mutex_unlock(&sched->lock);
+out:
+	free(ctx.targets);
+	free(ctx.batch);
+
+	return NULL;
+}
+
+GPIOD_API int gpiod_scheduler_start(struct gpiod_scheduler *sched)
+{
+	int ret;
+
+	assert(sched);
+
+	if (sched->running) {
+		errno = EBUSY;
+		return -1;
+	}
+
+	sched->timer_fd = timerfd_create(CLOCK_MONOTONIC,
+					 TFD_CLOEXEC | TFD_NONBLOCK);
+	if (sched->timer_fd < 0)
+		return -1;
+
+	sched->stop_fd = eventfd(0, EFD_CLOEXEC);
+	if (sched->stop_fd < 0)
+		goto err_close_timer;
+
+	pthread_mutex_lock(&sched->lock);
+
+	sched->error = 0;
+	sched->num_executed = 0;
+	sched->num_batches = 0;
+	sched->last_lateness = 0;
+	sched->max_lateness = 0;
+	sched->lateness_sum = 0;
+
+	/* Entries added while stopped are carried out now. */
+	ret = sched_arm_timer(sched);
+	if (ret) {
+		pthread_mutex_unlock(&sched->lock);
+		goto err_close_stop;
+	}
+
+	sched->running = true;
+
+	pthread_mutex_unlock(&sched->lock);
+
+	ret = gpiod_thread_create(&sched->thread, sched->priority,
+				  sched_thread_func, sched);
+	if (ret) {
+		sched->running = false;
+		errno = ret;
+		goto err_close_stop;
+	}
+
+	return 0;
+
+err_close_stop:
+	close(sched->stop_fd);
+	sched->stop_fd = -1;
+err_close_timer:
+	close(sched->timer_fd);
+	sched->timer_fd = -1;
+
+	return -1;
+}
+
+GPIOD_API int gpiod_scheduler_stop(struct gpiod_scheduler *sched)
+{
+	uint64_t one = 1;
+	ssize_t wr;
+
+	assert(sched);
+
+	if (!sched->running) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	wr = write(sched->stop_fd, &one, sizeof(one));
+	if (wr < 0)
+		return -1;
+
+	pthread_join(sched->thread, NULL);
+
+	pthread_mutex_lock(&sched->lock);
+	sched->running = false;
+	sched->num_entries = 0;
+	pthread_mutex_unlock(&sched->lock);
+
+	close(sched->stop_fd);
+	sched->stop_fd = -1;
+	close(sched->timer_fd);
+	sched->timer_fd = -1;
+
+	if (sched->error) {
+		errno = sched->error;
+		return -1;
+	}
+
+	return 0;
+}
+
+GPIOD_API void gpiod_scheduler_get_stats(struct gpiod_scheduler *sched,
+					 uint64_t *num_executed,
+					 uint64_t *num_batches,
+					 uint64_t *last_lateness_ns,
+					 uint64_t *avg_lateness_ns,
+					 uint64_t *max_lateness_ns)
+{
+	assert(sched);
+
+	pthread_mutex_lock(&sched->lock);
+
+	if (num_executed)
+		*num_executed = sched->num_executed;
+	if (num_batches)
+		*num_batches = sched->num_batches;
+	if (last_lateness_ns)
+		*last_lateness_ns = sched->last_lateness;
+	if (avg_lateness_ns)
+		*avg_lateness_ns = sched->num_executed ?
+				sched->lateness_sum / sched->num_executed : 0;
+	if (max_lateness_ns)
+		*max_lateness_ns = sched->max_lateness;
+
+	pthread_mutex_unlock(&sched->lock);
+}
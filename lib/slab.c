@@ -0,0 +1,254 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+/*
+ * Caches of small fixed-size objects which are allocated and freed often,
+ * such as copies of edge events retained by the user.
+ *
+ * Objects are carved out of slabs holding SLAB_NUM_OBJECTS of them and,
+ * when freed, are kept on a free list of the thread that freed them, so
+ * that the common case doesn't touch the heap or take any lock. Threads
+ * holding too many free objects hand a batch over to the shared list of
+ * the cache, from which threads that run out take batches back. The free
+ * objects of exiting threads go to the shared list too.
+ *
+ * Slabs are never returned to the system: the caches stay at the size
+ * they grew to when the most objects were in use.
+ *
+ * Recycled objects hide double frees and uses after free from memory
+ * checkers, so the caches are replaced with plain malloc() and free() when
+ * building with AddressSanitizer or when configured with --disable-slab.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "internal.h"
+
+#if defined(__SANITIZE_ADDRESS__)
+#define GPIOD_NO_SLAB 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define GPIOD_NO_SLAB 1
+#endif
+#endif
+
+#ifdef GPIOD_NO_SLAB
+
+#define UNUSED	__attribute__((unused))
+
+void *gpiod_slab_alloc(unsigned int cache_id UNUSED, size_t size)
+{
+	return malloc(size);
+}
+
+void gpiod_slab_free(unsigned int cache_id UNUSED, void *obj)
+{
+	free(obj);
+}
+
+#else /* GPIOD_NO_SLAB */
+
+#define SLAB_NUM_OBJECTS	32
+/* Free objects a thread may hold before handing a batch to the cache. */
+#define SLAB_LOCAL_MAX		(2 * SLAB_NUM_OBJECTS)
+#define SLAB_ALIGN		16
+
+struct slab_object {
+	struct slab_object *next;
+};
+
+struct slab_list {
+	struct slab_object *head;
+	size_t num_objects;
+};
+
+struct slab_cache {
+	pthread_mutex_t lock;
+	struct slab_list free;
+};
+
+struct slab_thread {
+	struct slab_list free[GPIOD_SLAB_NUM_CACHES];
+};
+
+static struct slab_cache slab_caches[GPIOD_SLAB_NUM_CACHES] = {
+	[0 ... GPIOD_SLAB_NUM_CACHES - 1] = {
+		.lock = PTHREAD_MUTEX_INITIALIZER,
+	},
+};
+
+static pthread_once_t slab_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t slab_key;
+static bool slab_key_ok;
+
+static void slab_list_push(struct slab_list *list, struct slab_object *obj)
+{
+	obj->next = list->head;
+	list->head = obj;
+	list->num_objects++;
+}
+
+static struct slab_object *slab_list_pop(struct slab_list *list)
+{
+	struct slab_object *obj = list->head;
+
+	list->head = obj->next;
+	list->num_objects--;
+
+	return obj;
+}
+
+/* Move up to num objects from one list to the other. */
+static void slab_list_move(struct slab_list *to, struct slab_list *from,
+			   size_t num)
+{
+	while (num-- && from->num_objects)
+		slab_list_push(to, slab_list_pop(from));
+}
+
+static void slab_thread_exit(void *data)
+{
+	struct slab_thread *thread = data;
+	struct slab_cache *cache;
+	unsigned int i;
+
+	for (i = 0; i < GPIOD_SLAB_NUM_CACHES; i++) {
+		cache = &slab_caches[i];
+
+		pthread_mutex_lock(&cache->lock);
+		slab_list_move(&cache->free, &thread->free[i],
+			       thread->free[i].num_objects);
+		pthread_mutex_unlock(&cache->lock);
+	}
+
+	free(thread);
+}
+
+static void slab_key_create(void)
+{
+	slab_key_ok = !pthread_key_create(&slab_key, slab_thread_exit);
+}
+
+/*
+ * Release the key when the library is unloaded so that the destructor of
+ * the thread data doesn't point into unmapped code. Only the free objects
+ * of the calling thread can be handed back to the caches at this point.
+ */
+static void __attribute__((destructor)) slab_key_delete(void)
+{
+	struct slab_thread *thread;
+
+	if (!__atomic_load_n(&slab_key_ok, __ATOMIC_ACQUIRE))
+		return;
+
+	__atomic_store_n(&slab_key_ok, false, __ATOMIC_RELEASE);
+
+	thread = pthread_getspecific(slab_key);
+	if (thread) {
+		pthread_setspecific(slab_key, NULL);
+		slab_thread_exit(thread);
+	}
+
+	pthread_key_delete(slab_key);
+}
+
+static struct slab_thread *slab_get_thread(void)
+{
+	struct slab_thread *thread;
+
+	pthread_once(&slab_key_once, slab_key_create);
+	if (!__atomic_load_n(&slab_key_ok, __ATOMIC_ACQUIRE))
+		return NULL;
+
+	thread = pthread_getspecific(slab_key);
+	if (thread)
+		return thread;
+
+	thread = calloc(1, sizeof(*thread));
+	if (!thread)
+		return NULL;
+
+	if (pthread_setspecific(slab_key, thread)) {
+		free(thread);
+		return NULL;
+	}
+
+	return thread;
+}
+
+static int slab_grow(struct slab_list *list, size_t size)
+{
+	size_t obj_size, i;
+	char *slab;
+
+	obj_size = (size + SLAB_ALIGN - 1) & ~((size_t)SLAB_ALIGN - 1);
+
+	slab = malloc(obj_size * SLAB_NUM_OBJECTS);
+	if (!slab)
+		return -1;
+
+	for (i = 0; i < SLAB_NUM_OBJECTS; i++)
+		slab_list_push(list,
+			       (struct slab_object *)(slab + i * obj_size));
+
+	return 0;
+}
+
+void *gpiod_slab_alloc(unsigned int cache_id, size_t size)
+{
+	struct slab_cache *cache = &slab_caches[cache_id];
+	struct slab_object *obj = NULL;
+	struct slab_list *local = NULL;
+	struct slab_thread *thread;
+
+	thread = slab_get_thread();
+	if (thread) {
+		local = &thread->free[cache_id];
+		if (local->num_objects)
+			return slab_list_pop(local);
+	}
+
+	pthread_mutex_lock(&cache->lock);
+
+	if (cache->free.num_objects || !slab_grow(&cache->free, size)) {
+		obj = slab_list_pop(&cache->free);
+		/* Refill the thread's list while holding the lock anyway. */
+		if (local)
+			slab_list_move(local, &cache->free,
+				       SLAB_NUM_OBJECTS - 1);
+	}
+
+	pthread_mutex_unlock(&cache->lock);
+
+	return obj;
+}
+
+void gpiod_slab_free(unsigned int cache_id, void *obj)
+{
+	struct slab_cache *cache = &slab_caches[cache_id];
+	struct slab_thread *thread;
+	struct slab_list *list;
+
+	if (!obj)
+		return;
+
+	thread = slab_get_thread();
+	if (!thread) {
+		pthread_mutex_lock(&cache->lock);
+		slab_list_push(&cache->free, obj);
+		pthread_mutex_unlock(&cache->lock);
+		return;
+	}
+
+	list = &thread->free[cache_id];
+	slab_list_push(list, obj);
+
+	if (list->num_objects > SLAB_LOCAL_MAX) {
+		pthread_mutex_lock(&cache->lock);
+		slab_list_move(&cache->free, list, SLAB_NUM_OBJECTS);
+		pthread_mutex_unlock(&cache->lock);
+	}
+}
+
+#endif /* GPIOD_NO_SLAB */
@@ -39,3 +39,35 @@ GVariant *gpiod_test_package_hogs(const GPIOSimHog *hogs)
 
 	return g_variant_ref_sink(g_variant_new("a(usi)", builder));
 }
+
+/*
+ * Request lines with the same settings. Fails the test and returns NULL if
+ * the request can't be made.
+ */
+struct gpiod_line_request *
+gpiod_test_request_lines(struct gpiod_chip *chip, const guint *offsets,
+			 gsize num_offsets, enum gpiod_line_direction direction,
+			 enum gpiod_line_edge edge, enum gpiod_line_value value)
+{
+	g_autoptr(struct_gpiod_line_settings) settings = NULL;
+	g_autoptr(struct_gpiod_line_config) line_cfg = NULL;
+	gint ret;
+
+	settings = gpiod_line_settings_new();
+	line_cfg = gpiod_line_config_new();
+	g_assert_nonnull(settings);
+	g_assert_nonnull(line_cfg);
+	if (g_test_failed())
+		return NULL;
+
+	gpiod_line_settings_set_direction(settings, direction);
+	gpiod_line_settings_set_edge_detection(settings, edge);
+	gpiod_line_settings_set_output_value(settings, value);
+	ret = gpiod_line_config_add_line_settings(line_cfg, offsets,
+						  num_offsets, settings);
+	g_assert_cmpint(ret, ==, 0);
+	if (g_test_failed())
+		return NULL;
+
+	return gpiod_chip_request_lines(chip, NULL, line_cfg);
+}
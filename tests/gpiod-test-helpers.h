@@ -27,6 +27,18 @@ G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_line_info, gpiod_line_info_free);
 typedef struct gpiod_info_event struct_gpiod_info_event;
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_info_event, gpiod_info_event_free);
 
+typedef struct gpiod_chip_mirror struct_gpiod_chip_mirror;
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_chip_mirror,
+			      gpiod_chip_mirror_free);
+
+typedef struct gpiod_chip_monitor struct_gpiod_chip_monitor;
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_chip_monitor,
+			      gpiod_chip_monitor_free);
+
+typedef struct gpiod_chip_monitor_event struct_gpiod_chip_monitor_event;
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_chip_monitor_event,
+			      gpiod_chip_monitor_event_free);
+
 typedef struct gpiod_line_config struct_gpiod_line_config;
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_line_config, gpiod_line_config_free);
 
@@ -49,6 +61,51 @@ typedef struct gpiod_edge_event_buffer struct_gpiod_edge_event_buffer;
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_edge_event_buffer,
 			      gpiod_edge_event_buffer_free);
 
+typedef struct gpiod_pwm struct_gpiod_pwm;
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_pwm, gpiod_pwm_free);
+
+typedef struct gpiod_bitbang struct_gpiod_bitbang;
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_bitbang, gpiod_bitbang_free);
+
+typedef struct gpiod_line_bus struct_gpiod_line_bus;
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_line_bus, gpiod_line_bus_free);
+
+typedef struct gpiod_line_program struct_gpiod_line_program;
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_line_program,
+			      gpiod_line_program_free);
+
+typedef struct gpiod_reflex struct_gpiod_reflex;
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_reflex, gpiod_reflex_free);
+
+typedef struct gpiod_quadrature struct_gpiod_quadrature;
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_quadrature, gpiod_quadrature_free);
+
+typedef struct gpiod_edge_decoder struct_gpiod_edge_decoder;
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_edge_decoder,
+			      gpiod_edge_decoder_free);
+
+typedef struct gpiod_keypad struct_gpiod_keypad;
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_keypad, gpiod_keypad_free);
+
+typedef struct gpiod_edge_limiter struct_gpiod_edge_limiter;
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_edge_limiter,
+			      gpiod_edge_limiter_free);
+
+typedef struct gpiod_line_config_table struct_gpiod_line_config_table;
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_line_config_table,
+			      gpiod_line_config_table_free);
+
+typedef struct gpiod_output_journal struct_gpiod_output_journal;
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_output_journal,
+			      gpiod_output_journal_free);
+
+typedef struct gpiod_request_group struct_gpiod_request_group;
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_request_group,
+			      gpiod_request_group_free);
+
+typedef struct gpiod_scheduler struct_gpiod_scheduler;
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_scheduler, gpiod_scheduler_free);
+
 #define gpiod_test_return_if_failed() \
 	do { \
 		if (g_test_failed()) \
@@ -175,6 +232,30 @@ G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_edge_event_buffer,
 		_request; \
 	})
 
+#define gpiod_test_request_lines_or_fail(_chip, _offsets, _num_offsets, \
+					 _direction, _edge, _value) \
+	({ \
+		struct gpiod_line_request *_request = \
+			gpiod_test_request_lines(_chip, _offsets, \
+						 _num_offsets, _direction, \
+						 _edge, _value); \
+		g_assert_nonnull(_request); \
+		gpiod_test_return_if_failed(); \
+		_request; \
+	})
+
+#define gpiod_test_request_outputs_or_fail(_chip, _offsets, _num_offsets, \
+					   _value) \
+	gpiod_test_request_lines_or_fail(_chip, _offsets, _num_offsets, \
+					 GPIOD_LINE_DIRECTION_OUTPUT, \
+					 GPIOD_LINE_EDGE_NONE, _value)
+
+#define gpiod_test_request_inputs_or_fail(_chip, _offsets, _num_offsets, \
+					  _edge) \
+	gpiod_test_request_lines_or_fail(_chip, _offsets, _num_offsets, \
+					 GPIOD_LINE_DIRECTION_INPUT, _edge, \
+					 GPIOD_LINE_VALUE_INACTIVE)
+
 #define gpiod_test_line_request_reconfigure_lines_or_fail(_request, _line_cfg) \
 	do { \
 		gint _ret = gpiod_line_request_reconfigure_lines(_request, \
@@ -183,6 +264,112 @@ G_DEFINE_AUTOPTR_CLEANUP_FUNC(struct_gpiod_edge_event_buffer,
 		gpiod_test_return_if_failed(); \
 	} while (0)
 
+#define gpiod_test_create_chip_mirror_or_fail(_path) \
+	({ \
+		struct gpiod_chip_mirror *_mirror = \
+				gpiod_chip_mirror_new(_path); \
+		g_assert_nonnull(_mirror); \
+		gpiod_test_return_if_failed(); \
+		_mirror; \
+	})
+
+#define gpiod_test_create_line_bus_or_fail() \
+	({ \
+		struct gpiod_line_bus *_bus = gpiod_line_bus_new(); \
+		g_assert_nonnull(_bus); \
+		gpiod_test_return_if_failed(); \
+		_bus; \
+	})
+
+#define gpiod_test_create_line_program_or_fail() \
+	({ \
+		struct gpiod_line_program *_program = \
+					gpiod_line_program_new(); \
+		g_assert_nonnull(_program); \
+		gpiod_test_return_if_failed(); \
+		_program; \
+	})
+
+#define gpiod_test_create_reflex_or_fail() \
+	({ \
+		struct gpiod_reflex *_reflex = gpiod_reflex_new(); \
+		g_assert_nonnull(_reflex); \
+		gpiod_test_return_if_failed(); \
+		_reflex; \
+	})
+
+#define gpiod_test_create_quadrature_or_fail() \
+	({ \
+		struct gpiod_quadrature *_quad = gpiod_quadrature_new(); \
+		g_assert_nonnull(_quad); \
+		gpiod_test_return_if_failed(); \
+		_quad; \
+	})
+
+#define gpiod_test_create_uart_decoder_or_fail(_offset) \
+	({ \
+		struct gpiod_edge_decoder *_decoder = \
+			gpiod_edge_decoder_new_uart(_offset, 100, 8, \
+					GPIOD_EDGE_DECODER_PARITY_NONE, 1); \
+		g_assert_nonnull(_decoder); \
+		gpiod_test_return_if_failed(); \
+		_decoder; \
+	})
+
+#define gpiod_test_create_keypad_or_fail(_request) \
+	({ \
+		struct gpiod_keypad *_keypad = \
+			gpiod_keypad_new(_request, row_offsets, 2, \
+					 _request, col_offsets, 3); \
+		g_assert_nonnull(_keypad); \
+		gpiod_test_return_if_failed(); \
+		_keypad; \
+	})
+
+#define gpiod_test_create_edge_limiter_or_fail() \
+	({ \
+		struct gpiod_edge_limiter *_limiter = \
+					gpiod_edge_limiter_new(); \
+		g_assert_nonnull(_limiter); \
+		gpiod_test_return_if_failed(); \
+		_limiter; \
+	})
+
+#define gpiod_test_create_line_config_table_or_fail(_request) \
+	({ \
+		struct gpiod_line_config_table *_table = \
+				gpiod_line_config_table_new(_request); \
+		g_assert_nonnull(_table); \
+		gpiod_test_return_if_failed(); \
+		_table; \
+	})
+
+#define gpiod_test_create_output_journal_or_fail(_num_entries) \
+	({ \
+		struct gpiod_output_journal *_journal = \
+			gpiod_output_journal_new(_num_entries); \
+		g_assert_nonnull(_journal); \
+		gpiod_test_return_if_failed(); \
+		_journal; \
+	})
+
+#define gpiod_test_create_request_group_or_fail() \
+	({ \
+		struct gpiod_request_group *_group = \
+					gpiod_request_group_new(); \
+		g_assert_nonnull(_group); \
+		gpiod_test_return_if_failed(); \
+		_group; \
+	})
+
+#define gpiod_test_create_scheduler_or_fail() \
+	({ \
+		struct gpiod_scheduler *_sched = gpiod_scheduler_new(); \
+		g_assert_nonnull(_sched); \
+		gpiod_test_return_if_failed(); \
+		_sched; \
+	})
+
 #define gpiod_test_expect_errno(_expected) \
 	g_assert_cmpint(_expected, ==, errno)
 
@@ -200,4 +387,9 @@ typedef struct {
 GVariant *gpiod_test_package_line_names(const GPIOSimLineName *names);
 GVariant *gpiod_test_package_hogs(const GPIOSimHog *hogs);
 
+struct gpiod_line_request *
+gpiod_test_request_lines(struct gpiod_chip *chip, const guint *offsets,
+			 gsize num_offsets, enum gpiod_line_direction direction,
+			 enum gpiod_line_edge edge, enum gpiod_line_value value);
+
 #endif /* __GPIOD_TEST_HELPERS_H__ */
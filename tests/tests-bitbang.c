@@ -0,0 +1,281 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <errno.h>
+#include <glib.h>
+#include <gpiod.h>
+
+#include "gpiod-test.h"
+#include "gpiod-test-helpers.h"
+#include "gpiod-test-sim.h"
+
+#define GPIOD_TEST_GROUP "bitbang"
+
+#define CLOCK_OFFSET		0
+#define DATA_OUT_OFFSET		1
+#define DATA_IN_OFFSET		2
+#define CHIP_SELECT_OFFSET	3
+
+/*
+ * Request the clock and data output lines as outputs, the data input line as
+ * input and the chip-select line as active-low output.
+ */
+static struct gpiod_line_request *request_bus(struct gpiod_chip *chip)
+{
+	static const guint outputs[] = { CLOCK_OFFSET, DATA_OUT_OFFSET };
+	static const guint input = DATA_IN_OFFSET;
+	static const guint chip_select = CHIP_SELECT_OFFSET;
+
+	g_autoptr(struct_gpiod_line_settings) settings = NULL;
+	g_autoptr(struct_gpiod_line_config) line_cfg = NULL;
+	gint ret;
+
+	settings = gpiod_line_settings_new();
+	line_cfg = gpiod_line_config_new();
+	g_assert_nonnull(settings);
+	g_assert_nonnull(line_cfg);
+	if (g_test_failed())
+		return NULL;
+
+	gpiod_line_settings_set_direction(settings,
+					  GPIOD_LINE_DIRECTION_OUTPUT);
+	ret = gpiod_line_config_add_line_settings(line_cfg, outputs, 2,
+						  settings);
+	g_assert_cmpint(ret, ==, 0);
+
+	gpiod_line_settings_set_active_low(settings, true);
+	ret = gpiod_line_config_add_line_settings(line_cfg, &chip_select, 1,
+						  settings);
+	g_assert_cmpint(ret, ==, 0);
+
+	gpiod_line_settings_reset(settings);
+	gpiod_line_settings_set_direction(settings,
+					  GPIOD_LINE_DIRECTION_INPUT);
+	ret = gpiod_line_config_add_line_settings(line_cfg, &input, 1,
+						  settings);
+	g_assert_cmpint(ret, ==, 0);
+	if (g_test_failed())
+		return NULL;
+
+	return gpiod_chip_request_lines(chip, NULL, line_cfg);
+}
+
+static struct gpiod_bitbang *create_bus(struct gpiod_line_request *request)
+{
+	struct gpiod_bitbang *bb;
+	gint ret;
+
+	bb = gpiod_bitbang_new(request, CLOCK_OFFSET);
+	g_assert_nonnull(bb);
+	if (g_test_failed())
+		return NULL;
+
+	ret = gpiod_bitbang_set_data_out(bb, DATA_OUT_OFFSET);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_bitbang_set_data_in(bb, DATA_IN_OFFSET);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_bitbang_set_chip_select(bb, CHIP_SELECT_OFFSET);
+	g_assert_cmpint(ret, ==, 0);
+
+	return bb;
+}
+
+GPIOD_TEST_CASE(clock_line_not_in_request)
+{
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 8, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_bitbang) bb = NULL;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = request_bus(chip);
+	g_assert_nonnull(request);
+	gpiod_test_return_if_failed();
+
+	bb = gpiod_bitbang_new(request, 7);
+	g_assert_null(bb);
+	gpiod_test_expect_errno(EINVAL);
+}
+
+GPIOD_TEST_CASE(line_used_for_two_signals)
+{
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 8, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_bitbang) bb = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = request_bus(chip);
+	g_assert_nonnull(request);
+	gpiod_test_return_if_failed();
+
+	bb = gpiod_bitbang_new(request, CLOCK_OFFSET);
+	g_assert_nonnull(bb);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_bitbang_set_data_out(bb, CLOCK_OFFSET);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	/* Reassigning a signal to another line is fine. */
+	ret = gpiod_bitbang_set_data_out(bb, CHIP_SELECT_OFFSET);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_bitbang_set_data_out(bb, DATA_OUT_OFFSET);
+	g_assert_cmpint(ret, ==, 0);
+}
+
+GPIOD_TEST_CASE(receive_without_data_in)
+{
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 8, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_bitbang) bb = NULL;
+	guint8 rx;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = request_bus(chip);
+	g_assert_nonnull(request);
+	gpiod_test_return_if_failed();
+
+	bb = gpiod_bitbang_new(request, CLOCK_OFFSET);
+	g_assert_nonnull(bb);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_bitbang_transfer(bb, NULL, &rx, 1);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+}
+
+GPIOD_TEST_CASE(lines_idle_after_transfer)
+{
+	static const guint8 tx[] = { 0xa5, 0x5a, 0xff };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 8, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_bitbang) bb = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = request_bus(chip);
+	g_assert_nonnull(request);
+	gpiod_test_return_if_failed();
+
+	bb = create_bus(request);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_bitbang_transfer(bb, tx, NULL, sizeof(tx));
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, CLOCK_OFFSET), ==,
+			G_GPIOSIM_VALUE_INACTIVE);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, CHIP_SELECT_OFFSET), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+
+	ret = gpiod_bitbang_set_mode(bb, GPIOD_BITBANG_MODE_3);
+	g_assert_cmpint(ret, ==, 0);
+
+	ret = gpiod_bitbang_transfer(bb, tx, NULL, sizeof(tx));
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, CLOCK_OFFSET), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, CHIP_SELECT_OFFSET), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+}
+
+GPIOD_TEST_CASE(sample_data_in)
+{
+	static const guint8 tx[] = { 0x12, 0x34 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 8, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_bitbang) bb = NULL;
+	guint8 rx[2];
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = request_bus(chip);
+	g_assert_nonnull(request);
+	gpiod_test_return_if_failed();
+
+	bb = create_bus(request);
+	gpiod_test_return_if_failed();
+
+	g_gpiosim_chip_set_pull(sim, DATA_IN_OFFSET, G_GPIOSIM_PULL_UP);
+	ret = gpiod_bitbang_transfer(bb, tx, rx, sizeof(rx));
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpuint(rx[0], ==, 0xff);
+	g_assert_cmpuint(rx[1], ==, 0xff);
+
+	g_gpiosim_chip_set_pull(sim, DATA_IN_OFFSET, G_GPIOSIM_PULL_DOWN);
+	ret = gpiod_bitbang_transfer(bb, tx, rx, sizeof(rx));
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpuint(rx[0], ==, 0x00);
+	g_assert_cmpuint(rx[1], ==, 0x00);
+}
+
+GPIOD_TEST_CASE(half_period_is_respected)
+{
+	static const guint8 tx[] = { 0x00, 0xff };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 8, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_bitbang) bb = NULL;
+	gint64 start, elapsed;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = request_bus(chip);
+	g_assert_nonnull(request);
+	gpiod_test_return_if_failed();
+
+	bb = create_bus(request);
+	gpiod_test_return_if_failed();
+
+	gpiod_bitbang_set_half_period(bb, 50000);
+
+	start = g_get_monotonic_time();
+	ret = gpiod_bitbang_transfer(bb, tx, NULL, sizeof(tx));
+	elapsed = g_get_monotonic_time() - start;
+	g_assert_cmpint(ret, ==, 0);
+
+	/* 32 clock phases plus the trailing idle phase, in microseconds. */
+	g_assert_cmpint(elapsed, >=, 33 * 50);
+}
+
+GPIOD_TEST_CASE(throughput)
+{
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 8, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_bitbang) bb = NULL;
+	g_autofree guint8 *tx = NULL;
+	gint64 start, elapsed;
+	gsize i, len = 4096;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = request_bus(chip);
+	g_assert_nonnull(request);
+	gpiod_test_return_if_failed();
+
+	bb = create_bus(request);
+	gpiod_test_return_if_failed();
+
+	tx = g_malloc(len);
+	for (i = 0; i < len; i++)
+		tx[i] = i;
+
+	start = g_get_monotonic_time();
+	ret = gpiod_bitbang_transfer(bb, tx, NULL, len);
+	elapsed = g_get_monotonic_time() - start;
+	g_assert_cmpint(ret, ==, 0);
+
+	/* Not an assertion: the throughput depends on the machine. */
+	g_test_message("%zu bytes in %.3f ms, %.0f set ioctls/s, %.0f bit/s",
+		       len, elapsed / 1000.0, len * 16 * 1000000.0 / elapsed,
+		       len * 8 * 1000000.0 / elapsed);
+}
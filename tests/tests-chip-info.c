@@ -37,6 +37,30 @@ GPIOD_TEST_CASE(get_chip_info_label)
 	g_assert_cmpstr(gpiod_chip_info_get_label(info), ==, "foobar");
 }
 
+GPIOD_TEST_CASE(export_chip_info)
+{
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 16,
+							"label", "foobar",
+							NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_chip_info) info = NULL;
+	struct gpiod_chip_info_data data;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	info = gpiod_test_chip_get_info_or_fail(chip);
+
+	ret = gpiod_chip_info_export(info, &data, sizeof(data));
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpuint(data.num_lines, ==, 16);
+	g_assert_cmpstr(data.name, ==, g_gpiosim_chip_get_name(sim));
+	g_assert_cmpstr(data.label, ==, "foobar");
+
+	ret = gpiod_chip_info_export(info, &data, 0);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+}
+
 GPIOD_TEST_CASE(get_num_lines)
 {
 	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 16, NULL);
@@ -0,0 +1,222 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <glib.h>
+#include <gpiod.h>
+
+#include "gpiod-test.h"
+#include "gpiod-test-helpers.h"
+#include "gpiod-test-sim.h"
+
+#define GPIOD_TEST_GROUP "chip-mirror"
+
+static struct gpiod_line_request *
+request_line(struct gpiod_chip *chip, guint offset, const gchar *consumer)
+{
+	g_autoptr(struct_gpiod_request_config) req_cfg = NULL;
+	g_autoptr(struct_gpiod_line_config) line_cfg = NULL;
+	gint ret;
+
+	req_cfg = gpiod_request_config_new();
+	line_cfg = gpiod_line_config_new();
+	g_assert_nonnull(req_cfg);
+	g_assert_nonnull(line_cfg);
+	if (g_test_failed())
+		return NULL;
+
+	gpiod_request_config_set_consumer(req_cfg, consumer);
+
+	ret = gpiod_line_config_add_line_settings(line_cfg, &offset, 1, NULL);
+	g_assert_cmpint(ret, ==, 0);
+	if (g_test_failed())
+		return NULL;
+
+	return gpiod_chip_request_lines(chip, req_cfg, line_cfg);
+}
+
+GPIOD_TEST_CASE(mirror_num_lines_and_path)
+{
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 8, NULL);
+	g_autoptr(struct_gpiod_chip_mirror) mirror = NULL;
+	const gchar *path = g_gpiosim_chip_get_dev_path(sim);
+
+	mirror = gpiod_test_create_chip_mirror_or_fail(path);
+
+	g_assert_cmpuint(gpiod_chip_mirror_get_num_lines(mirror), ==, 8);
+	g_assert_cmpstr(gpiod_chip_mirror_get_chip_path(mirror), ==, path);
+}
+
+GPIOD_TEST_CASE(mirror_fails_for_bad_path)
+{
+	g_autoptr(struct_gpiod_chip_mirror) mirror = NULL;
+
+	mirror = gpiod_chip_mirror_new("/dev/nonexistent_gpiochip");
+	g_assert_null(mirror);
+	gpiod_test_expect_errno(ENOENT);
+}
+
+GPIOD_TEST_CASE(mirror_offset_out_of_range)
+{
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 8, NULL);
+	g_autoptr(struct_gpiod_chip_mirror) mirror = NULL;
+	struct gpiod_line_info *info;
+
+	mirror = gpiod_test_create_chip_mirror_or_fail(
+					g_gpiosim_chip_get_dev_path(sim));
+
+	info = gpiod_chip_mirror_get_line_info(mirror, 8);
+	g_assert_null(info);
+	gpiod_test_expect_errno(EINVAL);
+}
+
+GPIOD_TEST_CASE(mirror_reflects_initial_state)
+{
+	static const GPIOSimLineName names[] = {
+		{ .offset = 1, .name = "foo", },
+		{ .offset = 4, .name = "bar", },
+		{ }
+	};
+
+	g_autoptr(GPIOSimChip) sim = NULL;
+	g_autoptr(GVariant) vnames = gpiod_test_package_line_names(names);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_chip_mirror) mirror = NULL;
+	struct gpiod_line_info *info;
+
+	sim = g_gpiosim_chip_new("num-lines", 8, "line-names", vnames, NULL);
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = request_line(chip, 4, "mirrored");
+	g_assert_nonnull(request);
+	gpiod_test_return_if_failed();
+
+	mirror = gpiod_test_create_chip_mirror_or_fail(
+					g_gpiosim_chip_get_dev_path(sim));
+
+	info = gpiod_chip_mirror_get_line_info(mirror, 1);
+	g_assert_nonnull(info);
+	gpiod_test_return_if_failed();
+	g_assert_cmpstr(gpiod_line_info_get_name(info), ==, "foo");
+	g_assert_false(gpiod_line_info_is_used(info));
+
+	info = gpiod_chip_mirror_get_line_info(mirror, 4);
+	g_assert_nonnull(info);
+	gpiod_test_return_if_failed();
+	g_assert_cmpstr(gpiod_line_info_get_name(info), ==, "bar");
+	g_assert_true(gpiod_line_info_is_used(info));
+	g_assert_cmpstr(gpiod_line_info_get_consumer(info), ==, "mirrored");
+}
+
+GPIOD_TEST_CASE(process_without_events_returns_zero)
+{
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip_mirror) mirror = NULL;
+	gint ret;
+
+	mirror = gpiod_test_create_chip_mirror_or_fail(
+					g_gpiosim_chip_get_dev_path(sim));
+
+	ret = gpiod_chip_mirror_wait_info_events(mirror, 10000000);
+	g_assert_cmpint(ret, ==, 0);
+
+	ret = gpiod_chip_mirror_process_info_events(mirror);
+	g_assert_cmpint(ret, ==, 0);
+}
+
+GPIOD_TEST_CASE(mirror_tracks_request_and_release)
+{
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 8, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_chip_mirror) mirror = NULL;
+	struct gpiod_line_request *request;
+	struct gpiod_line_info *info;
+	gint ret;
+
+	mirror = gpiod_test_create_chip_mirror_or_fail(
+					g_gpiosim_chip_get_dev_path(sim));
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+
+	info = gpiod_chip_mirror_get_line_info(mirror, 2);
+	g_assert_nonnull(info);
+	gpiod_test_return_if_failed();
+	g_assert_false(gpiod_line_info_is_used(info));
+
+	request = request_line(chip, 2, "tracked");
+	g_assert_nonnull(request);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_chip_mirror_wait_info_events(mirror, 1000000000);
+	g_assert_cmpint(ret, >, 0);
+	ret = gpiod_chip_mirror_process_info_events(mirror);
+	g_assert_cmpint(ret, ==, 1);
+
+	/* The pointer stays valid, the contents are updated in place. */
+	g_assert_true(info == gpiod_chip_mirror_get_line_info(mirror, 2));
+	g_assert_true(gpiod_line_info_is_used(info));
+	g_assert_cmpstr(gpiod_line_info_get_consumer(info), ==, "tracked");
+
+	gpiod_line_request_release(request);
+
+	ret = gpiod_chip_mirror_wait_info_events(mirror, 1000000000);
+	g_assert_cmpint(ret, >, 0);
+	ret = gpiod_chip_mirror_process_info_events(mirror);
+	g_assert_cmpint(ret, ==, 1);
+
+	g_assert_false(gpiod_line_info_is_used(info));
+}
+
+struct callback_ctx {
+	struct gpiod_chip_mirror *mirror;
+	guint num_events;
+	enum gpiod_info_event_type last_type;
+	guint last_offset;
+	gboolean used_in_mirror;
+};
+
+static void count_events(struct gpiod_info_event *event, gpointer data)
+{
+	struct callback_ctx *ctx = data;
+	struct gpiod_line_info *info;
+
+	info = gpiod_info_event_get_line_info(event);
+
+	ctx->num_events++;
+	ctx->last_type = gpiod_info_event_get_event_type(event);
+	ctx->last_offset = gpiod_line_info_get_offset(info);
+	ctx->used_in_mirror = gpiod_line_info_is_used(
+			gpiod_chip_mirror_get_line_info(ctx->mirror,
+							ctx->last_offset));
+}
+
+GPIOD_TEST_CASE(callback_is_called_after_update)
+{
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 8, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_chip_mirror) mirror = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	struct callback_ctx ctx;
+	gint ret;
+
+	mirror = gpiod_test_create_chip_mirror_or_fail(
+					g_gpiosim_chip_get_dev_path(sim));
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+
+	memset(&ctx, 0, sizeof(ctx));
+	ctx.mirror = mirror;
+	gpiod_chip_mirror_set_callback(mirror, count_events, &ctx);
+
+	request = request_line(chip, 5, "callback");
+	g_assert_nonnull(request);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_chip_mirror_wait_info_events(mirror, 1000000000);
+	g_assert_cmpint(ret, >, 0);
+	ret = gpiod_chip_mirror_process_info_events(mirror);
+	g_assert_cmpint(ret, ==, 1);
+
+	g_assert_cmpuint(ctx.num_events, ==, 1);
+	g_assert_cmpint(ctx.last_type, ==, GPIOD_INFO_EVENT_LINE_REQUESTED);
+	g_assert_cmpuint(ctx.last_offset, ==, 5);
+	g_assert_true(ctx.used_in_mirror);
+}
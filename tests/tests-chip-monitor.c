@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <glib.h>
+#include <gpiod.h>
+#include <poll.h>
+#include <string.h>
+
+#include "gpiod-test.h"
+#include "gpiod-test-helpers.h"
+#include "gpiod-test-sim.h"
+
+#define GPIOD_TEST_GROUP "chip-monitor"
+
+GPIOD_TEST_CASE(wait_timeout)
+{
+	g_autoptr(struct_gpiod_chip_monitor) monitor = NULL;
+	gint ret;
+
+	monitor = gpiod_chip_monitor_new();
+	g_assert_nonnull(monitor);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_chip_monitor_wait_event(monitor, 10000000);
+	g_assert_cmpint(ret, ==, 0);
+}
+
+GPIOD_TEST_CASE(chip_added_and_removed)
+{
+	g_autoptr(struct_gpiod_chip_monitor) monitor = NULL;
+	g_autoptr(struct_gpiod_chip_monitor_event) added = NULL;
+	g_autoptr(struct_gpiod_chip_monitor_event) removed = NULL;
+	g_autoptr(GPIOSimChip) sim = NULL;
+	g_autofree gchar *path = NULL;
+	gint ret;
+
+	monitor = gpiod_chip_monitor_new();
+	g_assert_nonnull(monitor);
+	gpiod_test_return_if_failed();
+
+	sim = g_gpiosim_chip_new("num-lines", 4, "label", "hotplugged", NULL);
+	path = g_strdup(g_gpiosim_chip_get_dev_path(sim));
+
+	ret = gpiod_chip_monitor_wait_event(monitor, 1000000000);
+	g_assert_cmpint(ret, ==, 1);
+	gpiod_test_return_if_failed();
+
+	added = gpiod_chip_monitor_read_event(monitor);
+	g_assert_nonnull(added);
+	gpiod_test_return_if_failed();
+
+	g_assert_cmpint(gpiod_chip_monitor_event_get_event_type(added), ==,
+			GPIOD_CHIP_MONITOR_EVENT_CHIP_ADDED);
+	g_assert_cmpstr(gpiod_chip_monitor_event_get_chip_path(added), ==,
+			path);
+	g_assert_cmpstr(gpiod_chip_monitor_event_get_chip_label(added), ==,
+			"hotplugged");
+
+	g_clear_object(&sim);
+
+	ret = gpiod_chip_monitor_wait_event(monitor, 1000000000);
+	g_assert_cmpint(ret, ==, 1);
+	gpiod_test_return_if_failed();
+
+	removed = gpiod_chip_monitor_read_event(monitor);
+	g_assert_nonnull(removed);
+	gpiod_test_return_if_failed();
+
+	g_assert_cmpint(gpiod_chip_monitor_event_get_event_type(removed), ==,
+			GPIOD_CHIP_MONITOR_EVENT_CHIP_REMOVED);
+	g_assert_cmpstr(gpiod_chip_monitor_event_get_chip_path(removed), ==,
+			path);
+	g_assert_null(gpiod_chip_monitor_event_get_chip_label(removed));
+}
+
+GPIOD_TEST_CASE(drain_after_poll)
+{
+	g_autoptr(struct_gpiod_chip_monitor) monitor = NULL;
+	g_autoptr(GPIOSimChip) sim0 = NULL;
+	g_autoptr(GPIOSimChip) sim1 = NULL;
+	struct gpiod_chip_monitor_event *event;
+	gboolean seen0 = FALSE, seen1 = FALSE;
+	struct pollfd pfd;
+	const gchar *path;
+	gint ret;
+
+	monitor = gpiod_chip_monitor_new();
+	g_assert_nonnull(monitor);
+	gpiod_test_return_if_failed();
+
+	/* Both chips appear before the monitor is polled. */
+	sim0 = g_gpiosim_chip_new("num-lines", 4, NULL);
+	sim1 = g_gpiosim_chip_new("num-lines", 4, NULL);
+
+	pfd.fd = gpiod_chip_monitor_get_fd(monitor);
+	pfd.events = POLLIN | POLLPRI;
+
+	while (!seen0 || !seen1) {
+		ret = poll(&pfd, 1, 1000);
+		g_assert_cmpint(ret, >, 0);
+		gpiod_test_return_if_failed();
+
+		while (gpiod_chip_monitor_wait_event(monitor, 0) > 0) {
+			event = gpiod_chip_monitor_read_event(monitor);
+			g_assert_nonnull(event);
+			gpiod_test_return_if_failed();
+
+			path = gpiod_chip_monitor_event_get_chip_path(event);
+			if (!strcmp(path, g_gpiosim_chip_get_dev_path(sim0)))
+				seen0 = TRUE;
+			if (!strcmp(path, g_gpiosim_chip_get_dev_path(sim1)))
+				seen1 = TRUE;
+
+			gpiod_chip_monitor_event_free(event);
+		}
+	}
+}
@@ -0,0 +1,265 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <errno.h>
+#include <glib.h>
+#include <gpiod.h>
+
+#include "gpiod-test.h"
+#include "gpiod-test-helpers.h"
+#include "gpiod-test-sim.h"
+
+#define GPIOD_TEST_GROUP "edge-decoder"
+
+static guint64 monotonic_ns(void)
+{
+	return g_get_monotonic_time() * 1000;
+}
+
+static void read_events(struct gpiod_line_request *request,
+			struct gpiod_edge_event_buffer *buffer)
+{
+	gint ret;
+
+	ret = gpiod_line_request_wait_edge_events(request, 1000000000);
+	g_assert_cmpint(ret, >, 0);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_line_request_read_edge_events(request, buffer, 1024);
+	g_assert_cmpint(ret, >, 0);
+}
+
+/* 8N1 at 100 baud, a bit lasts 10ms. */
+static void uart_send(GPIOSimChip *sim, guint offset, guint8 byte)
+{
+	guint i, bits = byte << 1 | 0x200;
+
+	for (i = 0; i < 10; i++) {
+		g_gpiosim_chip_set_pull(sim, offset,
+					bits & (1 << i) ? G_GPIOSIM_PULL_UP :
+							  G_GPIOSIM_PULL_DOWN);
+		g_usleep(10000);
+	}
+}
+
+GPIOD_TEST_CASE(uart_receive)
+{
+	static const guint offset = 2;
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_edge_event_buffer) buffer = NULL;
+	g_autoptr(struct_gpiod_edge_decoder) decoder = NULL;
+	guint64 data, timestamp;
+	guint num_bits, flags;
+	gint ret;
+
+	/* The line idles high. */
+	g_gpiosim_chip_set_pull(sim, offset, G_GPIOSIM_PULL_UP);
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_inputs_or_fail(chip, &offset, 1,
+						    GPIOD_LINE_EDGE_BOTH);
+
+	buffer = gpiod_test_create_edge_event_buffer_or_fail(1024);
+	decoder = gpiod_test_create_uart_decoder_or_fail(offset);
+
+	uart_send(sim, offset, 0xa5);
+	uart_send(sim, offset, 0x3c);
+
+	read_events(request, buffer);
+	gpiod_test_return_if_failed();
+
+	/* The first frame is completed by the start bit of the second one. */
+	ret = gpiod_edge_decoder_process(decoder, buffer);
+	g_assert_cmpint(ret, ==, 1);
+
+	ret = gpiod_edge_decoder_flush(decoder, monotonic_ns());
+	g_assert_cmpint(ret, ==, 1);
+	g_assert_cmpuint(gpiod_edge_decoder_get_num_frames(decoder), ==, 2);
+
+	g_assert_true(gpiod_edge_decoder_pop_frame(decoder, &data, &num_bits,
+						   &timestamp, &flags));
+	g_assert_cmpuint(data, ==, 0xa5);
+	g_assert_cmpuint(num_bits, ==, 8);
+	g_assert_cmpuint(flags, ==, 0);
+	g_assert_cmpuint(timestamp, >, 0);
+
+	g_assert_true(gpiod_edge_decoder_pop_frame(decoder, &data, NULL, NULL,
+						   &flags));
+	g_assert_cmpuint(data, ==, 0x3c);
+	g_assert_cmpuint(flags, ==, 0);
+
+	g_assert_false(gpiod_edge_decoder_pop_frame(decoder, NULL, NULL, NULL,
+						    NULL));
+}
+
+GPIOD_TEST_CASE(uart_framing_error)
+{
+	static const guint offset = 0;
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_edge_event_buffer) buffer = NULL;
+	g_autoptr(struct_gpiod_edge_decoder) decoder = NULL;
+	guint64 data;
+	guint flags;
+	gint ret;
+
+	g_gpiosim_chip_set_pull(sim, offset, G_GPIOSIM_PULL_UP);
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_inputs_or_fail(chip, &offset, 1,
+						    GPIOD_LINE_EDGE_BOTH);
+
+	buffer = gpiod_test_create_edge_event_buffer_or_fail(1024);
+	decoder = gpiod_test_create_uart_decoder_or_fail(offset);
+
+	/* Break condition: the line stays low past the stop bit. */
+	g_gpiosim_chip_set_pull(sim, offset, G_GPIOSIM_PULL_DOWN);
+	g_usleep(150000);
+	g_gpiosim_chip_set_pull(sim, offset, G_GPIOSIM_PULL_UP);
+
+	read_events(request, buffer);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_edge_decoder_process(decoder, buffer);
+	g_assert_cmpint(ret, ==, 1);
+
+	g_assert_true(gpiod_edge_decoder_pop_frame(decoder, &data, NULL, NULL,
+						   &flags));
+	g_assert_cmpuint(data, ==, 0);
+	g_assert_cmpuint(flags, ==, GPIOD_EDGE_DECODER_FRAME_FRAMING_ERROR);
+}
+
+GPIOD_TEST_CASE(uart_invalid_arguments)
+{
+	struct gpiod_edge_decoder *decoder;
+
+	decoder = gpiod_edge_decoder_new_uart(0, 0, 8,
+					      GPIOD_EDGE_DECODER_PARITY_NONE,
+					      1);
+	g_assert_null(decoder);
+	gpiod_test_expect_errno(EINVAL);
+
+	decoder = gpiod_edge_decoder_new_uart(0, 9600, 10,
+					      GPIOD_EDGE_DECODER_PARITY_NONE,
+					      1);
+	g_assert_null(decoder);
+	gpiod_test_expect_errno(EINVAL);
+
+	decoder = gpiod_edge_decoder_new_uart(0, 9600, 8,
+					      GPIOD_EDGE_DECODER_PARITY_EVEN,
+					      3);
+	g_assert_null(decoder);
+	gpiod_test_expect_errno(EINVAL);
+
+	decoder = gpiod_edge_decoder_new_uart(0, 9600, 8, 0, 1);
+	g_assert_null(decoder);
+	gpiod_test_expect_errno(EINVAL);
+}
+
+static void wiegand_send(GPIOSimChip *sim, guint offset_d0, guint offset_d1,
+			 guint64 bits, guint num_bits)
+{
+	guint offset, i;
+
+	for (i = 0; i < num_bits; i++) {
+		offset = bits & (1ULL << (num_bits - 1 - i)) ? offset_d1 :
+							       offset_d0;
+
+		g_gpiosim_chip_set_pull(sim, offset, G_GPIOSIM_PULL_DOWN);
+		g_usleep(100);
+		g_gpiosim_chip_set_pull(sim, offset, G_GPIOSIM_PULL_UP);
+		g_usleep(1000);
+	}
+}
+
+GPIOD_TEST_CASE(wiegand_26_bit)
+{
+	static const guint offsets[] = { 1, 3 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_edge_event_buffer) buffer = NULL;
+	g_autoptr(struct_gpiod_edge_decoder) decoder = NULL;
+	guint64 data;
+	guint num_bits, flags;
+	gint ret;
+
+	g_gpiosim_chip_set_pull(sim, 1, G_GPIOSIM_PULL_UP);
+	g_gpiosim_chip_set_pull(sim, 3, G_GPIOSIM_PULL_UP);
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_inputs_or_fail(chip, offsets, 2,
+						    GPIOD_LINE_EDGE_BOTH);
+
+	buffer = gpiod_test_create_edge_event_buffer_or_fail(1024);
+	decoder = gpiod_edge_decoder_new_wiegand(1, 3, 10000000);
+	g_assert_nonnull(decoder);
+	gpiod_test_return_if_failed();
+
+	/* Facility code 123, card number 4567 with valid parity bits. */
+	wiegand_send(sim, 1, 3, 0x2f623ae, 26);
+
+	read_events(request, buffer);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_edge_decoder_process(decoder, buffer);
+	g_assert_cmpint(ret, ==, 0);
+
+	g_usleep(20000);
+
+	ret = gpiod_edge_decoder_flush(decoder, monotonic_ns());
+	g_assert_cmpint(ret, ==, 1);
+
+	g_assert_true(gpiod_edge_decoder_pop_frame(decoder, &data, &num_bits,
+						   NULL, &flags));
+	g_assert_cmpuint(data, ==, 0x2f623ae);
+	g_assert_cmpuint(num_bits, ==, 26);
+	g_assert_cmpuint(flags, ==, 0);
+}
+
+GPIOD_TEST_CASE(wiegand_parity_error)
+{
+	static const guint offsets[] = { 0, 1 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 2, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_edge_event_buffer) buffer = NULL;
+	g_autoptr(struct_gpiod_edge_decoder) decoder = NULL;
+	guint flags;
+	gint ret;
+
+	g_gpiosim_chip_set_pull(sim, 0, G_GPIOSIM_PULL_UP);
+	g_gpiosim_chip_set_pull(sim, 1, G_GPIOSIM_PULL_UP);
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_inputs_or_fail(chip, offsets, 2,
+						    GPIOD_LINE_EDGE_BOTH);
+
+	buffer = gpiod_test_create_edge_event_buffer_or_fail(1024);
+	decoder = gpiod_edge_decoder_new_wiegand(0, 1, 10000000);
+	g_assert_nonnull(decoder);
+	gpiod_test_return_if_failed();
+
+	/* Same frame as above with the trailing parity bit flipped. */
+	wiegand_send(sim, 0, 1, 0x2f623af, 26);
+
+	read_events(request, buffer);
+	gpiod_test_return_if_failed();
+
+	gpiod_edge_decoder_process(decoder, buffer);
+	g_usleep(20000);
+
+	ret = gpiod_edge_decoder_flush(decoder, monotonic_ns());
+	g_assert_cmpint(ret, ==, 1);
+
+	g_assert_true(gpiod_edge_decoder_pop_frame(decoder, NULL, NULL, NULL,
+						   &flags));
+	g_assert_cmpuint(flags, ==, GPIOD_EDGE_DECODER_FRAME_PARITY_ERROR);
+}
@@ -55,6 +55,65 @@ GPIOD_TEST_CASE(edge_event_wait_timeout)
 	g_assert_cmpint(ret, ==, 0);
 }
 
+GPIOD_TEST_CASE(edge_event_wait_busy_poll)
+{
+	static const guint offset = 4;
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 8, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_config) line_cfg = NULL;
+	g_autoptr(struct_gpiod_line_settings) settings = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_edge_event_buffer) buffer = NULL;
+	guint64 num_spin, num_sleep, spin_ns;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	settings = gpiod_test_create_line_settings_or_fail();
+	line_cfg = gpiod_test_create_line_config_or_fail();
+	buffer = gpiod_test_create_edge_event_buffer_or_fail(64);
+
+	gpiod_line_settings_set_edge_detection(settings, GPIOD_LINE_EDGE_BOTH);
+	gpiod_test_line_config_add_line_settings_or_fail(line_cfg, &offset, 1,
+							 settings);
+
+	request = gpiod_test_chip_request_lines_or_fail(chip, NULL, line_cfg);
+
+	g_assert_cmpuint(gpiod_line_request_get_busy_poll(request), ==, 0);
+	gpiod_line_request_set_busy_poll(request, 2000000);
+	g_assert_cmpuint(gpiod_line_request_get_busy_poll(request), ==,
+			 2000000);
+
+	/* The whole timeout is shorter than the budget. */
+	ret = gpiod_line_request_wait_edge_events(request, 1000000);
+	g_assert_cmpint(ret, ==, 0);
+
+	gpiod_line_request_get_wait_stats(request, &num_spin, &num_sleep,
+					  &spin_ns);
+	g_assert_cmpuint(num_spin, ==, 0);
+	g_assert_cmpuint(num_sleep, ==, 0);
+	g_assert_cmpuint(spin_ns, >=, 1000000);
+
+	g_gpiosim_chip_set_pull(sim, 4, G_GPIOSIM_PULL_UP);
+
+	ret = gpiod_line_request_wait_edge_events(request, 1000000000);
+	g_assert_cmpint(ret, ==, 1);
+
+	ret = gpiod_line_request_read_edge_events(request, buffer, 1);
+	g_assert_cmpint(ret, ==, 1);
+
+	gpiod_line_request_set_busy_poll(request, 0);
+	g_gpiosim_chip_set_pull(sim, 4, G_GPIOSIM_PULL_DOWN);
+
+	ret = gpiod_line_request_wait_edge_events(request, 1000000000);
+	g_assert_cmpint(ret, ==, 1);
+
+	gpiod_line_request_get_wait_stats(request, &num_spin, &num_sleep,
+					  NULL);
+	g_assert_cmpuint(num_spin, ==, 1);
+	g_assert_cmpuint(num_sleep, ==, 1);
+}
+
 GPIOD_TEST_CASE(cannot_request_lines_in_output_mode_with_edge_detection)
 {
 	static const guint offset = 4;
@@ -173,6 +232,67 @@ GPIOD_TEST_CASE(read_both_events)
 	g_assert_cmpuint(ts_falling, >, ts_rising);
 }
 
+GPIOD_TEST_CASE(read_events_in_batches)
+{
+	static const guint offset = 2;
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 8, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_settings) settings = NULL;
+	g_autoptr(struct_gpiod_line_config) line_cfg = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(GThread) thread = NULL;
+	g_autoptr(struct_gpiod_edge_event_buffer) buffer = NULL;
+	guint64 num_reads, num_events;
+	gsize max_batch;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	settings = gpiod_test_create_line_settings_or_fail();
+	line_cfg = gpiod_test_create_line_config_or_fail();
+	buffer = gpiod_test_create_edge_event_buffer_or_fail(64);
+
+	gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_INPUT);
+	gpiod_line_settings_set_edge_detection(settings, GPIOD_LINE_EDGE_BOTH);
+
+	gpiod_test_line_config_add_line_settings_or_fail(line_cfg, &offset, 1,
+							 settings);
+
+	request = gpiod_test_chip_request_lines_or_fail(chip, NULL, line_cfg);
+
+	/* Both edges arrive within the window and are read at once. */
+	gpiod_line_request_set_read_batching(request, 200000000, 2);
+
+	thread = g_thread_new("request-release",
+			      falling_and_rising_edge_events, sim);
+	g_thread_ref(thread);
+
+	ret = gpiod_line_request_read_edge_events(request, buffer, 64);
+	g_assert_cmpint(ret, ==, 2);
+	gpiod_test_join_thread_and_return_if_failed(thread);
+
+	g_thread_join(thread);
+
+	g_assert_cmpint(gpiod_edge_event_get_event_type(
+				gpiod_edge_event_buffer_get_event(buffer, 0)),
+			==, GPIOD_EDGE_EVENT_RISING_EDGE);
+	g_assert_cmpint(gpiod_edge_event_get_event_type(
+				gpiod_edge_event_buffer_get_event(buffer, 1)),
+			==, GPIOD_EDGE_EVENT_FALLING_EDGE);
+
+	gpiod_line_request_set_read_batching(request, 0, 0);
+	g_gpiosim_chip_set_pull(sim, 2, G_GPIOSIM_PULL_UP);
+
+	ret = gpiod_line_request_read_edge_events(request, buffer, 64);
+	g_assert_cmpint(ret, ==, 1);
+
+	gpiod_line_request_get_read_stats(request, &num_reads, &num_events,
+					  &max_batch);
+	g_assert_cmpuint(num_reads, ==, 2);
+	g_assert_cmpuint(num_events, ==, 3);
+	g_assert_cmpuint(max_batch, ==, 2);
+}
+
 GPIOD_TEST_CASE(read_rising_edge_event)
 {
 	static const guint offset = 2;
@@ -563,6 +683,154 @@ GPIOD_TEST_CASE(event_copy)
 	g_assert_true(copy != event);
 }
 
+GPIOD_TEST_CASE(export_events)
+{
+	static const guint offset = 2;
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 8, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_settings) settings = NULL;
+	g_autoptr(struct_gpiod_line_config) line_cfg = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_edge_event_buffer) buffer = NULL;
+	struct gpiod_edge_event_data data[4], single;
+	struct gpiod_edge_event *event;
+	gint ret, i;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	settings = gpiod_test_create_line_settings_or_fail();
+	line_cfg = gpiod_test_create_line_config_or_fail();
+	buffer = gpiod_test_create_edge_event_buffer_or_fail(64);
+
+	gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_INPUT);
+	gpiod_line_settings_set_edge_detection(settings, GPIOD_LINE_EDGE_BOTH);
+
+	gpiod_test_line_config_add_line_settings_or_fail(line_cfg, &offset, 1,
+							 settings);
+
+	request = gpiod_test_chip_request_lines_or_fail(chip, NULL, line_cfg);
+
+	g_gpiosim_chip_set_pull(sim, 2, G_GPIOSIM_PULL_UP);
+	g_usleep(1000);
+	g_gpiosim_chip_set_pull(sim, 2, G_GPIOSIM_PULL_DOWN);
+	g_usleep(1000);
+
+	ret = gpiod_line_request_read_edge_events(request, buffer, 2);
+	g_assert_cmpint(ret, ==, 2);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_edge_event_buffer_export(buffer, data, sizeof(*data), 4);
+	g_assert_cmpint(ret, ==, 2);
+	gpiod_test_return_if_failed();
+
+	g_assert_cmpint(data[0].event_type, ==, GPIOD_EDGE_EVENT_RISING_EDGE);
+	g_assert_cmpint(data[1].event_type, ==, GPIOD_EDGE_EVENT_FALLING_EDGE);
+
+	for (i = 0; i < 2; i++) {
+		event = gpiod_edge_event_buffer_get_event(buffer, i);
+		g_assert_cmpuint(data[i].line_offset, ==, 2);
+		g_assert_cmpuint(data[i].timestamp_ns, ==,
+				 gpiod_edge_event_get_timestamp_ns(event));
+		g_assert_cmpuint(data[i].global_seqno, ==, i + 1);
+		g_assert_cmpuint(data[i].line_seqno, ==, i + 1);
+	}
+
+	ret = gpiod_edge_event_buffer_export(buffer, data, sizeof(*data), 1);
+	g_assert_cmpint(ret, ==, 1);
+
+	ret = gpiod_edge_event_buffer_export(buffer, data, 1, 4);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	event = gpiod_edge_event_buffer_get_event(buffer, 1);
+	ret = gpiod_edge_event_export(event, &single, sizeof(single));
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpint(single.event_type, ==, GPIOD_EDGE_EVENT_FALLING_EDGE);
+	g_assert_cmpuint(single.global_seqno, ==, 2);
+}
+
+#define NUM_EVENT_COPIES 1000
+
+static gpointer free_event_copies(gpointer data)
+{
+	struct gpiod_edge_event **copies = data;
+	guint i;
+
+	for (i = 0; i < NUM_EVENT_COPIES; i++)
+		gpiod_edge_event_free(copies[i]);
+
+	return NULL;
+}
+
+GPIOD_TEST_CASE(event_copies_freed_in_another_thread)
+{
+	static const guint offset = 2;
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 8, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_settings) settings = NULL;
+	g_autoptr(struct_gpiod_line_config) line_cfg = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_edge_event_buffer) buffer = NULL;
+	struct gpiod_edge_event *copies[NUM_EVENT_COPIES];
+	struct gpiod_edge_event *event;
+	GThread *thread;
+	guint i;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	settings = gpiod_test_create_line_settings_or_fail();
+	line_cfg = gpiod_test_create_line_config_or_fail();
+	buffer = gpiod_test_create_edge_event_buffer_or_fail(64);
+
+	gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_INPUT);
+	gpiod_line_settings_set_edge_detection(settings, GPIOD_LINE_EDGE_BOTH);
+
+	gpiod_test_line_config_add_line_settings_or_fail(line_cfg, &offset, 1,
+							 settings);
+
+	request = gpiod_test_chip_request_lines_or_fail(chip, NULL, line_cfg);
+
+	g_gpiosim_chip_set_pull(sim, 2, G_GPIOSIM_PULL_UP);
+
+	ret = gpiod_line_request_wait_edge_events(request, 1000000000);
+	g_assert_cmpint(ret, >, 0);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_line_request_read_edge_events(request, buffer, 1);
+	g_assert_cmpint(ret, ==, 1);
+	gpiod_test_return_if_failed();
+
+	event = gpiod_edge_event_buffer_get_event(buffer, 0);
+	g_assert_nonnull(event);
+	gpiod_test_return_if_failed();
+
+	/* Copies are cached per thread, retain more than a single batch. */
+	for (i = 0; i < NUM_EVENT_COPIES; i++) {
+		copies[i] = gpiod_edge_event_copy(event);
+		g_assert_nonnull(copies[i]);
+	}
+
+	if (g_test_failed())
+		goto out;
+
+	thread = g_thread_new("free-event-copies", free_event_copies, copies);
+	g_thread_join(thread);
+
+	/* The objects freed by the other thread are handed out again. */
+	for (i = 0; i < NUM_EVENT_COPIES; i++) {
+		copies[i] = gpiod_edge_event_copy(event);
+		g_assert_nonnull(copies[i]);
+		if (copies[i])
+			g_assert_cmpuint(
+				gpiod_edge_event_get_line_offset(copies[i]),
+				==, 2);
+	}
+
+out:
+	free_event_copies(copies);
+}
+
 GPIOD_TEST_CASE(reading_more_events_than_the_queue_contains_doesnt_block)
 {
 	static const guint offset = 2;
@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <errno.h>
+#include <glib.h>
+#include <gpiod.h>
+
+#include "gpiod-test.h"
+#include "gpiod-test-helpers.h"
+#include "gpiod-test-sim.h"
+
+#define GPIOD_TEST_GROUP "edge-limiter"
+
+static void toggle_line(GPIOSimChip *sim, guint offset, guint num_edges)
+{
+	guint i;
+
+	for (i = 0; i < num_edges; i++)
+		g_gpiosim_chip_set_pull(sim, offset,
+					i % 2 ? G_GPIOSIM_PULL_DOWN :
+						G_GPIOSIM_PULL_UP);
+}
+
+/* Read and filter all pending events, count the ones let through. */
+static void read_limited_events(struct gpiod_line_request *request,
+				struct gpiod_edge_limiter *limiter,
+				guint *counts, gsize num_counts)
+{
+	g_autoptr(struct_gpiod_edge_event_buffer) buffer = NULL;
+	struct gpiod_edge_event *event;
+	guint offset;
+	gint ret, i;
+
+	buffer = gpiod_edge_event_buffer_new(4);
+	g_assert_nonnull(buffer);
+	gpiod_test_return_if_failed();
+
+	for (;;) {
+		ret = gpiod_line_request_wait_edge_events(request, 100000000);
+		g_assert_cmpint(ret, >=, 0);
+		if (ret <= 0)
+			return;
+
+		ret = gpiod_line_request_read_edge_events(request, buffer, 4);
+		g_assert_cmpint(ret, >, 0);
+		gpiod_test_return_if_failed();
+
+		ret = gpiod_edge_limiter_process(limiter, buffer);
+		g_assert_cmpint(ret, ==,
+				gpiod_edge_event_buffer_get_num_events(buffer));
+
+		for (i = 0; i < ret; i++) {
+			event = gpiod_edge_event_buffer_get_event(buffer, i);
+			offset = gpiod_edge_event_get_line_offset(event);
+			g_assert_cmpuint(offset, <, num_counts);
+			gpiod_test_return_if_failed();
+			counts[offset]++;
+		}
+	}
+}
+
+GPIOD_TEST_CASE(invalid_arguments)
+{
+	g_autoptr(struct_gpiod_edge_limiter) limiter = NULL;
+	gint ret;
+
+	limiter = gpiod_test_create_edge_limiter_or_fail();
+
+	ret = gpiod_edge_limiter_set_limit(limiter, 0, 0, 1);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_edge_limiter_set_limit(limiter, 0, 10, 0);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_edge_limiter_set_default_limit(limiter, 10, 0);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_edge_limiter_set_default_limit(limiter, 0, 0);
+	g_assert_cmpint(ret, ==, 0);
+
+	ret = gpiod_edge_limiter_get_stats(limiter, 0, NULL, NULL, NULL);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_edge_limiter_take_summary(limiter, 0, NULL, NULL,
+					      NULL, NULL);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+}
+
+GPIOD_TEST_CASE(chattering_line_is_limited)
+{
+	static const guint offsets[] = { 0, 1 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_edge_limiter) limiter = NULL;
+	guint64 num_passed, num_suppressed, num_rising, num_falling, last_ts;
+	enum gpiod_edge_event_type last_type;
+	guint counts[2] = { 0, 0 };
+	guint suppressed[2];
+	bool limiting;
+	gsize num;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_inputs_or_fail(chip, offsets, 2,
+						    GPIOD_LINE_EDGE_BOTH);
+
+	limiter = gpiod_test_create_edge_limiter_or_fail();
+
+	ret = gpiod_edge_limiter_set_limit(limiter, 0, 1, 4);
+	g_assert_cmpint(ret, ==, 0);
+
+	toggle_line(sim, 0, 20);
+	toggle_line(sim, 1, 2);
+
+	read_limited_events(request, limiter, counts, 2);
+	gpiod_test_return_if_failed();
+
+	g_assert_cmpuint(counts[0], ==, 4);
+	g_assert_cmpuint(counts[1], ==, 2);
+
+	ret = gpiod_edge_limiter_get_stats(limiter, 0, &num_passed,
+					   &num_suppressed, &limiting);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpuint(num_passed, ==, 4);
+	g_assert_cmpuint(num_suppressed, ==, 16);
+	g_assert_true(limiting);
+
+	/* Lines without a limit are not tracked. */
+	ret = gpiod_edge_limiter_get_stats(limiter, 1, NULL, NULL, NULL);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	num = gpiod_edge_limiter_get_suppressed_offsets(limiter, suppressed, 2);
+	g_assert_cmpuint(num, ==, 1);
+	g_assert_cmpuint(suppressed[0], ==, 0);
+
+	ret = gpiod_edge_limiter_take_summary(limiter, 0, &num_rising,
+					      &num_falling, &last_type,
+					      &last_ts);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpuint(num_rising, ==, 8);
+	g_assert_cmpuint(num_falling, ==, 8);
+	g_assert_cmpint(last_type, ==, GPIOD_EDGE_EVENT_FALLING_EDGE);
+	g_assert_cmpuint(last_ts, >, 0);
+
+	num = gpiod_edge_limiter_get_suppressed_offsets(limiter, suppressed, 2);
+	g_assert_cmpuint(num, ==, 0);
+}
+
+GPIOD_TEST_CASE(default_limit_applies_per_line)
+{
+	static const guint offsets[] = { 0, 1, 2 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_edge_limiter) limiter = NULL;
+	guint counts[3] = { 0, 0, 0 };
+	guint64 num_suppressed;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_inputs_or_fail(chip, offsets, 3,
+						    GPIOD_LINE_EDGE_BOTH);
+
+	limiter = gpiod_test_create_edge_limiter_or_fail();
+
+	ret = gpiod_edge_limiter_set_default_limit(limiter, 1, 2);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_edge_limiter_set_limit(limiter, 2, 1, 6);
+	g_assert_cmpint(ret, ==, 0);
+
+	toggle_line(sim, 0, 10);
+	toggle_line(sim, 1, 10);
+	toggle_line(sim, 2, 10);
+
+	read_limited_events(request, limiter, counts, 3);
+	gpiod_test_return_if_failed();
+
+	g_assert_cmpuint(counts[0], ==, 2);
+	g_assert_cmpuint(counts[1], ==, 2);
+	g_assert_cmpuint(counts[2], ==, 6);
+
+	ret = gpiod_edge_limiter_get_stats(limiter, 1, NULL, &num_suppressed,
+					   NULL);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpuint(num_suppressed, ==, 8);
+}
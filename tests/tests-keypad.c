@@ -0,0 +1,252 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <errno.h>
+#include <glib.h>
+#include <gpiod.h>
+#include <poll.h>
+
+#include "gpiod-test.h"
+#include "gpiod-test-helpers.h"
+#include "gpiod-test-sim.h"
+
+#define GPIOD_TEST_GROUP "keypad"
+
+static const guint row_offsets[] = { 0, 1 };
+static const guint col_offsets[] = { 2, 3, 4 };
+
+static struct gpiod_line_request *request_keypad_lines(struct gpiod_chip *chip)
+{
+	g_autoptr(struct_gpiod_line_settings) settings = NULL;
+	g_autoptr(struct_gpiod_line_config) line_cfg = NULL;
+	gint ret;
+
+	settings = gpiod_line_settings_new();
+	line_cfg = gpiod_line_config_new();
+	g_assert_nonnull(settings);
+	g_assert_nonnull(line_cfg);
+	if (g_test_failed())
+		return NULL;
+
+	gpiod_line_settings_set_direction(settings,
+					  GPIOD_LINE_DIRECTION_OUTPUT);
+	ret = gpiod_line_config_add_line_settings(line_cfg, row_offsets, 2,
+						  settings);
+	g_assert_cmpint(ret, ==, 0);
+	if (g_test_failed())
+		return NULL;
+
+	gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_INPUT);
+	ret = gpiod_line_config_add_line_settings(line_cfg, col_offsets, 3,
+						  settings);
+	g_assert_cmpint(ret, ==, 0);
+	if (g_test_failed())
+		return NULL;
+
+	return gpiod_chip_request_lines(chip, NULL, line_cfg);
+}
+
+static void scan_times(struct gpiod_keypad *keypad, guint times)
+{
+	gint ret;
+
+	while (times--) {
+		ret = gpiod_keypad_scan(keypad);
+		g_assert_cmpint(ret, ==, 0);
+		gpiod_test_return_if_failed();
+	}
+}
+
+static void expect_event(struct gpiod_keypad *keypad, guint exp_key,
+			 gboolean exp_pressed)
+{
+	guint64 timestamp = 0;
+	gboolean pressed_ok;
+	bool pressed;
+	guint key;
+	gint ret;
+
+	ret = gpiod_keypad_read_event(keypad, &key, &pressed, &timestamp);
+	g_assert_cmpint(ret, ==, 0);
+	gpiod_test_return_if_failed();
+
+	pressed_ok = exp_pressed ? pressed : !pressed;
+	g_assert_cmpuint(key, ==, exp_key);
+	g_assert_true(pressed_ok);
+	g_assert_cmpuint(timestamp, >, 0);
+}
+
+GPIOD_TEST_CASE(invalid_arguments)
+{
+	static const guint dup_offsets[] = { 2, 2 };
+	static const guint bad_offset = 7;
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 8, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_keypad) keypad = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = request_keypad_lines(chip);
+	g_assert_nonnull(request);
+	gpiod_test_return_if_failed();
+
+	/* Line not in the request. */
+	keypad = gpiod_keypad_new(request, row_offsets, 2,
+				  request, &bad_offset, 1);
+	g_assert_null(keypad);
+	gpiod_test_expect_errno(EINVAL);
+
+	keypad = gpiod_keypad_new(request, row_offsets, 2,
+				  request, dup_offsets, 2);
+	g_assert_null(keypad);
+	gpiod_test_expect_errno(EINVAL);
+
+	/* Same line used as both a row and a column. */
+	keypad = gpiod_keypad_new(request, row_offsets, 2,
+				  request, row_offsets, 1);
+	g_assert_null(keypad);
+	gpiod_test_expect_errno(EINVAL);
+
+	keypad = gpiod_keypad_new(request, row_offsets, 0,
+				  request, col_offsets, 3);
+	g_assert_null(keypad);
+	gpiod_test_expect_errno(EINVAL);
+
+	keypad = gpiod_test_create_keypad_or_fail(request);
+
+	ret = gpiod_keypad_set_debounce(keypad, 0);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_keypad_set_debounce(keypad, 9);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_keypad_stop(keypad);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_keypad_start(keypad);
+	g_assert_cmpint(ret, ==, 0);
+
+	ret = gpiod_keypad_scan(keypad);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EBUSY);
+
+	ret = gpiod_keypad_set_debounce(keypad, 2);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EBUSY);
+
+	ret = gpiod_keypad_stop(keypad);
+	g_assert_cmpint(ret, ==, 0);
+}
+
+GPIOD_TEST_CASE(scan_is_debounced)
+{
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 8, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_keypad) keypad = NULL;
+	struct pollfd pfd;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = request_keypad_lines(chip);
+	g_assert_nonnull(request);
+	gpiod_test_return_if_failed();
+
+	keypad = gpiod_test_create_keypad_or_fail(request);
+
+	/*
+	 * The simulator doesn't connect rows to columns so a pulled-up column
+	 * reads as a key pressed in every row.
+	 */
+	g_gpiosim_chip_set_pull(sim, 3, G_GPIOSIM_PULL_UP);
+
+	scan_times(keypad, 2);
+	gpiod_test_return_if_failed();
+	g_assert_cmpuint(gpiod_keypad_get_state(keypad), ==, 0);
+
+	/* The last row is left driven. */
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 0), ==,
+			G_GPIOSIM_VALUE_INACTIVE);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 1), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+
+	pfd.fd = gpiod_keypad_get_fd(keypad);
+	pfd.events = POLLIN;
+	ret = poll(&pfd, 1, 0);
+	g_assert_cmpint(ret, ==, 0);
+
+	scan_times(keypad, 1);
+	gpiod_test_return_if_failed();
+	g_assert_cmpuint(gpiod_keypad_get_state(keypad), ==,
+			 (1 << 1) | (1 << 4));
+
+	ret = poll(&pfd, 1, 0);
+	g_assert_cmpint(ret, ==, 1);
+
+	expect_event(keypad, 1, TRUE);
+	expect_event(keypad, 4, TRUE);
+
+	/* A single bounce doesn't release the keys. */
+	g_gpiosim_chip_set_pull(sim, 3, G_GPIOSIM_PULL_DOWN);
+	scan_times(keypad, 1);
+	g_gpiosim_chip_set_pull(sim, 3, G_GPIOSIM_PULL_UP);
+	scan_times(keypad, 1);
+	gpiod_test_return_if_failed();
+	g_assert_cmpuint(gpiod_keypad_get_state(keypad), ==,
+			 (1 << 1) | (1 << 4));
+
+	g_gpiosim_chip_set_pull(sim, 3, G_GPIOSIM_PULL_DOWN);
+	scan_times(keypad, 3);
+	gpiod_test_return_if_failed();
+	g_assert_cmpuint(gpiod_keypad_get_state(keypad), ==, 0);
+
+	expect_event(keypad, 1, FALSE);
+	expect_event(keypad, 4, FALSE);
+	g_assert_cmpuint(gpiod_keypad_get_num_dropped(keypad), ==, 0);
+}
+
+GPIOD_TEST_CASE(scanning_thread_reports_keys)
+{
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 8, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_keypad) keypad = NULL;
+	struct pollfd pfd;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = request_keypad_lines(chip);
+	g_assert_nonnull(request);
+	gpiod_test_return_if_failed();
+
+	keypad = gpiod_test_create_keypad_or_fail(request);
+	gpiod_keypad_set_scan_period(keypad, 1000000);
+
+	ret = gpiod_keypad_set_debounce(keypad, 1);
+	g_assert_cmpint(ret, ==, 0);
+
+	ret = gpiod_keypad_start(keypad);
+	g_assert_cmpint(ret, ==, 0);
+	gpiod_test_return_if_failed();
+
+	g_gpiosim_chip_set_pull(sim, 2, G_GPIOSIM_PULL_UP);
+
+	pfd.fd = gpiod_keypad_get_fd(keypad);
+	pfd.events = POLLIN;
+	ret = poll(&pfd, 1, 1000);
+	g_assert_cmpint(ret, ==, 1);
+	gpiod_test_return_if_failed();
+
+	expect_event(keypad, 0, TRUE);
+	expect_event(keypad, 3, TRUE);
+
+	ret = gpiod_keypad_stop(keypad);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpuint(gpiod_keypad_get_state(keypad), ==,
+			 (1 << 0) | (1 << 3));
+}
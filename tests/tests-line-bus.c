@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <errno.h>
+#include <glib.h>
+#include <gpiod.h>
+
+#include "gpiod-test.h"
+#include "gpiod-test-helpers.h"
+#include "gpiod-test-sim.h"
+
+#define GPIOD_TEST_GROUP "line-bus"
+
+GPIOD_TEST_CASE(write_word)
+{
+	static const guint offsets[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 8, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_line_bus) bus = NULL;
+	guint i;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, offsets, 8,
+						     GPIOD_LINE_VALUE_INACTIVE);
+
+	bus = gpiod_test_create_line_bus_or_fail();
+
+	ret = gpiod_line_bus_add_lines(bus, request, 8, offsets);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpuint(gpiod_line_bus_get_width(bus), ==, 8);
+
+	ret = gpiod_line_bus_write(bus, 0xa5);
+	g_assert_cmpint(ret, ==, 0);
+	gpiod_test_return_if_failed();
+
+	for (i = 0; i < 8; i++)
+		g_assert_cmpint(g_gpiosim_chip_get_value(sim, i), ==,
+				(0xa5 >> i) & 1);
+}
+
+GPIOD_TEST_CASE(read_word_reversed_order)
+{
+	static const guint offsets[] = { 0, 1, 2, 3 };
+	static const guint reversed[] = { 3, 2, 1, 0 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_line_bus) bus = NULL;
+	guint64 word;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_inputs_or_fail(chip, offsets, 4,
+						    GPIOD_LINE_EDGE_NONE);
+
+	bus = gpiod_test_create_line_bus_or_fail();
+
+	ret = gpiod_line_bus_add_lines(bus, request, 4, reversed);
+	g_assert_cmpint(ret, ==, 0);
+
+	g_gpiosim_chip_set_pull(sim, 0, G_GPIOSIM_PULL_UP);
+	g_gpiosim_chip_set_pull(sim, 1, G_GPIOSIM_PULL_UP);
+	g_gpiosim_chip_set_pull(sim, 2, G_GPIOSIM_PULL_DOWN);
+	g_gpiosim_chip_set_pull(sim, 3, G_GPIOSIM_PULL_DOWN);
+
+	ret = gpiod_line_bus_read(bus, &word);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpuint(word, ==, 0xc);
+}
+
+GPIOD_TEST_CASE(bus_split_across_two_requests)
+{
+	static const guint low_offsets[] = { 4, 5, 6, 7 };
+	static const guint high_offsets[] = { 0, 1, 2, 3 };
+
+	g_autoptr(GPIOSimChip) sim_low = g_gpiosim_chip_new("num-lines", 8,
+							    NULL);
+	g_autoptr(GPIOSimChip) sim_high = g_gpiosim_chip_new("num-lines", 8,
+							     NULL);
+	g_autoptr(struct_gpiod_chip) chip_low = NULL;
+	g_autoptr(struct_gpiod_chip) chip_high = NULL;
+	g_autoptr(struct_gpiod_line_request) request_low = NULL;
+	g_autoptr(struct_gpiod_line_request) request_high = NULL;
+	g_autoptr(struct_gpiod_line_bus) bus = NULL;
+	guint64 word;
+	guint i;
+	gint ret;
+
+	chip_low = gpiod_test_open_chip_or_fail(
+			g_gpiosim_chip_get_dev_path(sim_low));
+	chip_high = gpiod_test_open_chip_or_fail(
+			g_gpiosim_chip_get_dev_path(sim_high));
+	request_low = gpiod_test_request_outputs_or_fail(
+				chip_low, low_offsets, 4, GPIOD_LINE_VALUE_INACTIVE);
+	request_high = gpiod_test_request_outputs_or_fail(
+				chip_high, high_offsets, 4, GPIOD_LINE_VALUE_INACTIVE);
+
+	bus = gpiod_test_create_line_bus_or_fail();
+
+	ret = gpiod_line_bus_add_lines(bus, request_low, 4, low_offsets);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_bus_add_lines(bus, request_high, 4, high_offsets);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpuint(gpiod_line_bus_get_width(bus), ==, 8);
+
+	ret = gpiod_line_bus_write(bus, 0x3c);
+	g_assert_cmpint(ret, ==, 0);
+	gpiod_test_return_if_failed();
+
+	for (i = 0; i < 4; i++) {
+		g_assert_cmpint(g_gpiosim_chip_get_value(sim_low, i + 4), ==,
+				(0xc >> i) & 1);
+		g_assert_cmpint(g_gpiosim_chip_get_value(sim_high, i), ==,
+				(0x3 >> i) & 1);
+	}
+
+	ret = gpiod_line_bus_read(bus, &word);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpuint(word, ==, 0x3c);
+}
+
+GPIOD_TEST_CASE(add_lines_invalid_arguments)
+{
+	static const guint offsets[] = { 0, 1, 2, 3 };
+	static const guint duplicate[] = { 2, 2 };
+	static const guint missing = 5;
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 8, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_line_bus) bus = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, offsets, 4,
+						     GPIOD_LINE_VALUE_INACTIVE);
+
+	bus = gpiod_test_create_line_bus_or_fail();
+
+	ret = gpiod_line_bus_add_lines(bus, request, 1, &missing);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_line_bus_add_lines(bus, request, 2, duplicate);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_line_bus_add_lines(bus, request, 0, offsets);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	g_assert_cmpuint(gpiod_line_bus_get_width(bus), ==, 0);
+
+	ret = gpiod_line_bus_add_lines(bus, request, 2, offsets);
+	g_assert_cmpint(ret, ==, 0);
+
+	/* Already on the bus. */
+	ret = gpiod_line_bus_add_lines(bus, request, 1, &offsets[1]);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	g_assert_cmpuint(gpiod_line_bus_get_width(bus), ==, 2);
+}
+
+GPIOD_TEST_CASE(empty_bus)
+{
+	g_autoptr(struct_gpiod_line_bus) bus = NULL;
+	guint64 word;
+	gint ret;
+
+	bus = gpiod_test_create_line_bus_or_fail();
+
+	ret = gpiod_line_bus_write(bus, 0);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_line_bus_read(bus, &word);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+}
@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <errno.h>
+#include <glib.h>
+#include <gpiod.h>
+
+#include "gpiod-test.h"
+#include "gpiod-test-helpers.h"
+#include "gpiod-test-sim.h"
+
+#define GPIOD_TEST_GROUP "line-config-table"
+
+static struct gpiod_line_config *
+make_line_config(const guint *offsets, gsize num_offsets,
+		 enum gpiod_line_direction direction,
+		 enum gpiod_line_value value)
+{
+	g_autoptr(struct_gpiod_line_settings) settings = NULL;
+	struct gpiod_line_config *line_cfg;
+	gint ret;
+
+	settings = gpiod_line_settings_new();
+	g_assert_nonnull(settings);
+	if (g_test_failed())
+		return NULL;
+
+	line_cfg = gpiod_line_config_new();
+	g_assert_nonnull(line_cfg);
+	if (g_test_failed())
+		return NULL;
+
+	gpiod_line_settings_set_direction(settings, direction);
+	gpiod_line_settings_set_output_value(settings, value);
+	ret = gpiod_line_config_add_line_settings(line_cfg, offsets,
+						  num_offsets, settings);
+	g_assert_cmpint(ret, ==, 0);
+	if (g_test_failed()) {
+		gpiod_line_config_free(line_cfg);
+		return NULL;
+	}
+
+	return line_cfg;
+}
+
+static void expect_direction(struct gpiod_chip *chip, guint offset,
+			     enum gpiod_line_direction direction)
+{
+	g_autoptr(struct_gpiod_line_info) info = NULL;
+
+	info = gpiod_chip_get_line_info(chip, offset);
+	g_assert_nonnull(info);
+	gpiod_test_return_if_failed();
+
+	g_assert_cmpint(gpiod_line_info_get_direction(info), ==, direction);
+}
+
+GPIOD_TEST_CASE(add_config_with_different_lines)
+{
+	static const guint offsets[] = { 0, 1 };
+	static const guint other_offsets[] = { 1, 0 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_config) line_cfg = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_line_config_table) table = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	line_cfg = make_line_config(offsets, 2, GPIOD_LINE_DIRECTION_INPUT,
+				    GPIOD_LINE_VALUE_INACTIVE);
+	gpiod_test_return_if_failed();
+	request = gpiod_test_chip_request_lines_or_fail(chip, NULL, line_cfg);
+	table = gpiod_test_create_line_config_table_or_fail(request);
+
+	gpiod_line_config_free(line_cfg);
+	line_cfg = make_line_config(other_offsets, 2,
+				    GPIOD_LINE_DIRECTION_OUTPUT,
+				    GPIOD_LINE_VALUE_INACTIVE);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_line_config_table_add_config(table, line_cfg);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	gpiod_line_config_free(line_cfg);
+	line_cfg = make_line_config(offsets, 1, GPIOD_LINE_DIRECTION_OUTPUT,
+				    GPIOD_LINE_VALUE_INACTIVE);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_line_config_table_add_config(table, line_cfg);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	g_assert_cmpuint(gpiod_line_config_table_get_num_configs(table), ==, 0);
+
+	ret = gpiod_line_config_table_apply(table, 0);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+}
+
+GPIOD_TEST_CASE(switch_direction)
+{
+	static const guint offsets[] = { 0, 1 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_config) input_cfg = NULL;
+	g_autoptr(struct_gpiod_line_config) output_cfg = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_line_config_table) table = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	input_cfg = make_line_config(offsets, 2, GPIOD_LINE_DIRECTION_INPUT,
+				     GPIOD_LINE_VALUE_INACTIVE);
+	output_cfg = make_line_config(offsets, 2, GPIOD_LINE_DIRECTION_OUTPUT,
+				      GPIOD_LINE_VALUE_ACTIVE);
+	gpiod_test_return_if_failed();
+	request = gpiod_test_chip_request_lines_or_fail(chip, NULL, input_cfg);
+	table = gpiod_test_create_line_config_table_or_fail(request);
+
+	ret = gpiod_line_config_table_add_config(table, input_cfg);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_config_table_add_config(table, output_cfg);
+	g_assert_cmpint(ret, ==, 1);
+	g_assert_cmpuint(gpiod_line_config_table_get_num_configs(table), ==, 2);
+
+	ret = gpiod_line_config_table_apply(table, 1);
+	g_assert_cmpint(ret, ==, 0);
+	expect_direction(chip, 0, GPIOD_LINE_DIRECTION_OUTPUT);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 0), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 1), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+
+	ret = gpiod_line_config_table_apply(table, 0);
+	g_assert_cmpint(ret, ==, 0);
+	expect_direction(chip, 0, GPIOD_LINE_DIRECTION_INPUT);
+	expect_direction(chip, 1, GPIOD_LINE_DIRECTION_INPUT);
+
+	ret = gpiod_line_config_table_apply(table, 2);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+}
+
+GPIOD_TEST_CASE(switch_with_values)
+{
+	static const guint offsets[] = { 0, 1 };
+	static const enum gpiod_line_value values[] = {
+		GPIOD_LINE_VALUE_INACTIVE,
+		GPIOD_LINE_VALUE_ACTIVE,
+	};
+	static const enum gpiod_line_value bad_values[] = {
+		GPIOD_LINE_VALUE_ERROR,
+		GPIOD_LINE_VALUE_ACTIVE,
+	};
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_config) output_cfg = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_line_config_table) table = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	output_cfg = make_line_config(offsets, 2, GPIOD_LINE_DIRECTION_OUTPUT,
+				      GPIOD_LINE_VALUE_ACTIVE);
+	gpiod_test_return_if_failed();
+	request = gpiod_test_chip_request_lines_or_fail(chip, NULL, output_cfg);
+	table = gpiod_test_create_line_config_table_or_fail(request);
+
+	ret = gpiod_line_config_table_add_config(table, output_cfg);
+	g_assert_cmpint(ret, ==, 0);
+
+	ret = gpiod_line_config_table_apply_with_values(table, 0, values);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 0), ==,
+			G_GPIOSIM_VALUE_INACTIVE);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 1), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+
+	ret = gpiod_line_config_table_apply_with_values(table, 0, bad_values);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	/* The stored values are still used by a plain switch. */
+	ret = gpiod_line_config_table_apply(table, 0);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 0), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+}
@@ -4,6 +4,7 @@
 #include <errno.h>
 #include <glib.h>
 #include <gpiod.h>
+#include <string.h>
 
 #include "gpiod-test.h"
 #include "gpiod-test-helpers.h"
@@ -96,6 +97,138 @@ GPIOD_TEST_CASE(line_info_basic_properties)
 	g_assert_cmpuint(gpiod_line_info_get_debounce_period_us(info4), ==, 0);
 }
 
+GPIOD_TEST_CASE(export_line_info)
+{
+	static const GPIOSimLineName names[] = {
+		{ .offset = 4, .name = "baz", },
+		{ }
+	};
+
+	static const GPIOSimHog hogs[] = {
+		{
+			.offset = 4,
+			.name = "hog4",
+			.direction = G_GPIOSIM_DIRECTION_OUTPUT_LOW,
+		},
+		{ }
+	};
+
+	g_autoptr(GPIOSimChip) sim = NULL;
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_info) info4 = NULL;
+	g_autoptr(struct_gpiod_line_info) info6 = NULL;
+	g_autoptr(GVariant) vnames = gpiod_test_package_line_names(names);
+	g_autoptr(GVariant) vhogs = gpiod_test_package_hogs(hogs);
+	struct {
+		struct gpiod_line_info_data data;
+		guint64 future_field;
+	} ext;
+	struct gpiod_line_info_data data;
+	gint ret;
+
+	sim = g_gpiosim_chip_new(
+			"num-lines", 8,
+			"line-names", vnames,
+			"hogs", vhogs,
+			NULL);
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	info4 = gpiod_test_chip_get_line_info_or_fail(chip, 4);
+	info6 = gpiod_test_chip_get_line_info_or_fail(chip, 6);
+
+	ret = gpiod_line_info_export(info4, &data, sizeof(data));
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpuint(data.offset, ==, 4);
+	g_assert_cmpstr(data.name, ==, "baz");
+	g_assert_cmpstr(data.consumer, ==, "hog4");
+	g_assert_true(data.used);
+	g_assert_false(data.active_low);
+	g_assert_false(data.debounced);
+	g_assert_cmpint(data.direction, ==, GPIOD_LINE_DIRECTION_OUTPUT);
+	g_assert_cmpint(data.bias, ==, GPIOD_LINE_BIAS_UNKNOWN);
+	g_assert_cmpint(data.drive, ==, GPIOD_LINE_DRIVE_PUSH_PULL);
+	g_assert_cmpint(data.edge_detection, ==, GPIOD_LINE_EDGE_NONE);
+	g_assert_cmpint(data.event_clock, ==, GPIOD_LINE_CLOCK_MONOTONIC);
+	g_assert_cmpuint(data.debounce_period_us, ==, 0);
+
+	/* Fields unknown to the library are zeroed. */
+	memset(&ext, 0xff, sizeof(ext));
+	ret = gpiod_line_info_export(info6, &ext.data, sizeof(ext));
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpuint(ext.data.offset, ==, 6);
+	g_assert_cmpstr(ext.data.name, ==, "");
+	g_assert_false(ext.data.used);
+	g_assert_cmpuint(ext.future_field, ==, 0);
+
+	ret = gpiod_line_info_export(info6, &data, sizeof(data.offset));
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+}
+
+GPIOD_TEST_CASE(read_line_info_data)
+{
+	static const GPIOSimLineName names[] = {
+		{ .offset = 2, .name = "foo", },
+		{ .offset = 3, .name = "bar", },
+		{ }
+	};
+
+	static const GPIOSimHog hogs[] = {
+		{
+			.offset = 3,
+			.name = "hog3",
+			.direction = G_GPIOSIM_DIRECTION_OUTPUT_HIGH,
+		},
+		{ }
+	};
+
+	g_autoptr(GPIOSimChip) sim = NULL;
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(GVariant) vnames = gpiod_test_package_line_names(names);
+	g_autoptr(GVariant) vhogs = gpiod_test_package_hogs(hogs);
+	struct gpiod_line_info_data data[3];
+	gint ret;
+
+	sim = g_gpiosim_chip_new(
+			"num-lines", 8,
+			"line-names", vnames,
+			"hogs", vhogs,
+			NULL);
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+
+	ret = gpiod_chip_read_line_info_data(chip, 1, 3, data, sizeof(*data));
+	g_assert_cmpint(ret, ==, 0);
+	gpiod_test_return_if_failed();
+
+	g_assert_cmpuint(data[0].offset, ==, 1);
+	g_assert_cmpstr(data[0].name, ==, "");
+	g_assert_false(data[0].used);
+	g_assert_cmpuint(data[1].offset, ==, 2);
+	g_assert_cmpstr(data[1].name, ==, "foo");
+	g_assert_cmpuint(data[2].offset, ==, 3);
+	g_assert_cmpstr(data[2].name, ==, "bar");
+	g_assert_cmpstr(data[2].consumer, ==, "hog3");
+	g_assert_true(data[2].used);
+	g_assert_cmpint(data[2].direction, ==, GPIOD_LINE_DIRECTION_OUTPUT);
+
+	/* The range is checked before any line is read. */
+	data[0].offset = 8;
+	ret = gpiod_chip_read_line_info_data(chip, 6, 3, data, sizeof(*data));
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+	g_assert_cmpuint(data[0].offset, ==, 8);
+
+	ret = gpiod_chip_read_line_info_data(chip, 8, 0, data, sizeof(*data));
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_chip_read_line_info_data(chip, 0, 1, data,
+					     sizeof(data->offset));
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+}
+
 GPIOD_TEST_CASE(copy_line_info)
 {
 	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 8, NULL);
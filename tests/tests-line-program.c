@@ -0,0 +1,298 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <errno.h>
+#include <glib.h>
+#include <gpiod.h>
+
+#include "gpiod-test.h"
+#include "gpiod-test-helpers.h"
+#include "gpiod-test-sim.h"
+
+#define GPIOD_TEST_GROUP "line-program"
+
+GPIOD_TEST_CASE(set_and_get_on_two_requests)
+{
+	static const guint out_offsets[] = { 0, 1 };
+	static const guint in_offsets[] = { 2, 3 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) outputs = NULL;
+	g_autoptr(struct_gpiod_line_request) inputs = NULL;
+	g_autoptr(struct_gpiod_line_program) program = NULL;
+	guint64 results[2];
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	outputs = gpiod_test_request_outputs_or_fail(chip, out_offsets, 2,
+						     GPIOD_LINE_VALUE_INACTIVE);
+	inputs = gpiod_test_request_inputs_or_fail(chip, in_offsets, 2,
+						   GPIOD_LINE_EDGE_NONE);
+
+	program = gpiod_test_create_line_program_or_fail();
+
+	g_gpiosim_chip_set_pull(sim, 3, G_GPIOSIM_PULL_UP);
+
+	ret = gpiod_line_program_add_set(program, outputs, 0x3, 0x2);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_program_add_get(program, inputs, 0x3);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_program_add_get(program, outputs, 0x3);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpuint(gpiod_line_program_get_num_results(program), ==, 2);
+
+	ret = gpiod_line_program_run(program, results, 2);
+	g_assert_cmpint(ret, ==, 2);
+	gpiod_test_return_if_failed();
+
+	g_assert_cmpuint(results[0], ==, 0x2);
+	g_assert_cmpuint(results[1], ==, 0x2);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 0), ==,
+			G_GPIOSIM_VALUE_INACTIVE);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 1), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+}
+
+GPIOD_TEST_CASE(nested_loops)
+{
+	static const guint offsets[] = { 0, 1 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_line_program) program = NULL;
+	guint64 results[7];
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, offsets, 2,
+						     GPIOD_LINE_VALUE_INACTIVE);
+
+	program = gpiod_test_create_line_program_or_fail();
+
+	/* for 3 { set 0; get; for 2 { set 1; get; } } -> 3 * (1 + 2) gets */
+	ret = gpiod_line_program_begin_loop(program, 3);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_program_add_set(program, request, 0x1, 0x0);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_program_add_get(program, request, 0x1);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_program_begin_loop(program, 2);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_program_add_set(program, request, 0x1, 0x1);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_program_add_get(program, request, 0x1);
+	g_assert_cmpint(ret, ==, 0);
+
+	/* Loop still open. */
+	ret = gpiod_line_program_run(program, results, 7);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_line_program_end_loop(program);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_program_end_loop(program);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_program_end_loop(program);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	g_assert_cmpuint(gpiod_line_program_get_num_results(program), ==, 9);
+
+	/* Results array too small. */
+	ret = gpiod_line_program_run(program, results, 7);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+}
+
+GPIOD_TEST_CASE(loop_results_in_order)
+{
+	static const guint offset = 2;
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_line_program) program = NULL;
+	guint64 results[8];
+	gint ret, i;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, &offset, 1,
+						     GPIOD_LINE_VALUE_INACTIVE);
+
+	program = gpiod_test_create_line_program_or_fail();
+
+	ret = gpiod_line_program_begin_loop(program, 4);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_program_add_set(program, request, 0x1, 0x1);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_program_add_get(program, request, 0x1);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_program_add_set(program, request, 0x1, 0x0);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_program_add_get(program, request, 0x1);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_program_end_loop(program);
+	g_assert_cmpint(ret, ==, 0);
+
+	ret = gpiod_line_program_run(program, results, 8);
+	g_assert_cmpint(ret, ==, 8);
+	gpiod_test_return_if_failed();
+
+	for (i = 0; i < 8; i++)
+		g_assert_cmpuint(results[i], ==, (i + 1) % 2);
+}
+
+GPIOD_TEST_CASE(periodic_loop_timing)
+{
+	static const guint offset = 0;
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_line_program) program = NULL;
+	gint64 start, elapsed;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, &offset, 1,
+						     GPIOD_LINE_VALUE_INACTIVE);
+
+	program = gpiod_test_create_line_program_or_fail();
+
+	ret = gpiod_line_program_begin_loop(program, 10);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_program_add_set(program, request, 0x1, 0x1);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_program_add_sleep_until(program, 1000000);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_program_add_set(program, request, 0x1, 0x0);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_program_add_sleep_until(program, 2000000);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_program_end_loop(program);
+	g_assert_cmpint(ret, ==, 0);
+
+	start = g_get_monotonic_time();
+	ret = gpiod_line_program_run(program, NULL, 0);
+	elapsed = g_get_monotonic_time() - start;
+	g_assert_cmpint(ret, ==, 0);
+
+	g_assert_cmpint(elapsed, >=, 20000);
+}
+
+GPIOD_TEST_CASE(wait_edge)
+{
+	static const guint offsets[] = { 1, 2 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_line_program) program = NULL;
+	guint64 results[2];
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_inputs_or_fail(chip, offsets, 2,
+						    GPIOD_LINE_EDGE_BOTH);
+
+	program = gpiod_test_create_line_program_or_fail();
+
+	ret = gpiod_line_program_add_wait_edge(program, request, 0x2,
+					       GPIOD_LINE_EDGE_RISING,
+					       100000000);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_program_add_get(program, request, 0x3);
+	g_assert_cmpint(ret, ==, 0);
+
+	/* The event on line 1 must be skipped. */
+	g_gpiosim_chip_set_pull(sim, 1, G_GPIOSIM_PULL_UP);
+	g_usleep(1000);
+	g_gpiosim_chip_set_pull(sim, 2, G_GPIOSIM_PULL_UP);
+	g_usleep(1000);
+
+	ret = gpiod_line_program_run(program, results, 2);
+	g_assert_cmpint(ret, ==, 2);
+	gpiod_test_return_if_failed();
+
+	g_assert_cmpuint(results[0], >, 0);
+	g_assert_cmpuint(results[1], ==, 0x3);
+
+	/* Nothing left to wait for. */
+	ret = gpiod_line_program_run(program, results, 2);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(ETIMEDOUT);
+}
+
+GPIOD_TEST_CASE(invalid_masks)
+{
+	static const guint offsets[] = { 0, 1 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_line_program) program = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, offsets, 2,
+						     GPIOD_LINE_VALUE_INACTIVE);
+
+	program = gpiod_test_create_line_program_or_fail();
+
+	ret = gpiod_line_program_add_set(program, request, 0x0, 0x0);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_line_program_add_get(program, request, 0x4);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_line_program_add_wait_edge(program, request, 0x1,
+					       GPIOD_LINE_EDGE_NONE, -1);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_line_program_begin_loop(program, 0);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+}
+
+GPIOD_TEST_CASE(result_count_overflow)
+{
+	static const guint offsets[] = { 0, 1 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_line_program) program = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, offsets, 2,
+						     GPIOD_LINE_VALUE_INACTIVE);
+
+	program = gpiod_test_create_line_program_or_fail();
+
+	ret = gpiod_line_program_begin_loop(program, 65536);
+	g_assert_cmpint(ret, ==, 0);
+
+	ret = gpiod_line_program_begin_loop(program, 65536);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EOVERFLOW);
+
+	ret = gpiod_line_program_begin_loop(program, 16384);
+	g_assert_cmpint(ret, ==, 0);
+
+	/* 65536 * 16384 == 2^30, two gets make it 2^31. */
+	ret = gpiod_line_program_add_get(program, request, 0x3);
+	g_assert_cmpint(ret, ==, 0);
+
+	ret = gpiod_line_program_add_get(program, request, 0x3);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EOVERFLOW);
+
+	g_assert_cmpuint(gpiod_line_program_get_num_results(program), ==,
+			 1 << 30);
+}
@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <glib.h>
+#include <gpiod.h>
+
+#include "gpiod-test.h"
+#include "gpiod-test-helpers.h"
+#include "gpiod-test-sim.h"
+
+#define GPIOD_TEST_GROUP "line-pulse"
+
+GPIOD_TEST_CASE(active_pulse_ends_inactive)
+{
+	static const guint offsets[] = { 1, 3 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	guint64 width = 0;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, offsets, 2,
+						     GPIOD_LINE_VALUE_ACTIVE);
+
+	ret = gpiod_line_request_pulse(request, 2, offsets,
+				       GPIOD_LINE_VALUE_ACTIVE, 50000, 10000,
+				       1, 0, &width);
+	g_assert_cmpint(ret, ==, 0);
+	gpiod_test_return_if_failed();
+
+	g_assert_cmpuint(width, >=, 40000);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 1), ==,
+			G_GPIOSIM_VALUE_INACTIVE);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 3), ==,
+			G_GPIOSIM_VALUE_INACTIVE);
+}
+
+GPIOD_TEST_CASE(inactive_pulse_ends_active)
+{
+	static const guint offset = 2;
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, &offset, 1,
+						     GPIOD_LINE_VALUE_INACTIVE);
+
+	ret = gpiod_line_request_pulse(request, 1, &offset,
+				       GPIOD_LINE_VALUE_INACTIVE, 10000, 0,
+				       1, 0, NULL);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 2), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+}
+
+GPIOD_TEST_CASE(pulse_train_reports_all_widths)
+{
+	static const guint offset = 0;
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	guint64 widths[4], start, elapsed;
+	guint i;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, &offset, 1,
+						     GPIOD_LINE_VALUE_INACTIVE);
+
+	memset(widths, 0, sizeof(widths));
+	start = g_get_monotonic_time();
+
+	ret = gpiod_line_request_pulse(request, 1, &offset,
+				       GPIOD_LINE_VALUE_ACTIVE, 100000, 20000,
+				       4, 1000000, widths);
+	g_assert_cmpint(ret, ==, 0);
+	gpiod_test_return_if_failed();
+
+	/* Three full periods plus the width of the last pulse. */
+	elapsed = g_get_monotonic_time() - start;
+	g_assert_cmpuint(elapsed, >=, 3100);
+
+	for (i = 0; i < 4; i++)
+		g_assert_cmpuint(widths[i], >=, 90000);
+}
+
+GPIOD_TEST_CASE(pulse_fails_with_invalid_arguments)
+{
+	static const guint offset = 0;
+	static const guint bad_offset = 3;
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, &offset, 1,
+						     GPIOD_LINE_VALUE_INACTIVE);
+
+	ret = gpiod_line_request_pulse(request, 1, &offset,
+				       GPIOD_LINE_VALUE_ACTIVE, 1000, 0,
+				       0, 0, NULL);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_line_request_pulse(request, 1, &offset,
+				       GPIOD_LINE_VALUE_ACTIVE, 1000, 0,
+				       2, 1000, NULL);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_line_request_pulse(request, 1, &bad_offset,
+				       GPIOD_LINE_VALUE_ACTIVE, 1000, 0,
+				       1, 0, NULL);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+}
@@ -0,0 +1,260 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <errno.h>
+#include <glib.h>
+#include <gpiod.h>
+
+#include "gpiod-test.h"
+#include "gpiod-test-helpers.h"
+#include "gpiod-test-sim.h"
+
+#define GPIOD_TEST_GROUP "line-pwm"
+
+GPIOD_TEST_CASE(add_channels)
+{
+	static const guint offsets[] = { 0, 2 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_pwm) pwm = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, offsets, 2,
+						     GPIOD_LINE_VALUE_INACTIVE);
+	pwm = gpiod_pwm_new();
+	g_assert_nonnull(pwm);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_pwm_add_channel(pwm, request, 0, 1000000, 500000);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_pwm_add_channel(pwm, request, 2, 1000000, 250000);
+	g_assert_cmpint(ret, ==, 1);
+	g_assert_cmpuint(gpiod_pwm_get_num_channels(pwm), ==, 2);
+}
+
+GPIOD_TEST_CASE(add_channel_invalid_arguments)
+{
+	static const guint offset = 1;
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_pwm) pwm = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, &offset, 1,
+						     GPIOD_LINE_VALUE_INACTIVE);
+	pwm = gpiod_pwm_new();
+	g_assert_nonnull(pwm);
+	gpiod_test_return_if_failed();
+
+	/* Line not in the request. */
+	ret = gpiod_pwm_add_channel(pwm, request, 3, 1000000, 500000);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	/* Duty cycle longer than the period. */
+	ret = gpiod_pwm_add_channel(pwm, request, 1, 1000000, 2000000);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	/* Period too long. */
+	ret = gpiod_pwm_add_channel(pwm, request, 1, 5000000000ULL, 0);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(ERANGE);
+
+	ret = gpiod_pwm_add_channel(pwm, request, 1, 1000000, 500000);
+	g_assert_cmpint(ret, ==, 0);
+
+	/* Line already driven by another channel. */
+	ret = gpiod_pwm_add_channel(pwm, request, 1, 1000000, 500000);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_pwm_set_channel(pwm, 1, 1000000, 500000);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+}
+
+GPIOD_TEST_CASE(start_without_channels)
+{
+	g_autoptr(struct_gpiod_pwm) pwm = NULL;
+	gint ret;
+
+	pwm = gpiod_pwm_new();
+	g_assert_nonnull(pwm);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_pwm_start(pwm);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_pwm_stop(pwm);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+}
+
+GPIOD_TEST_CASE(cannot_add_channels_while_running)
+{
+	static const guint offsets[] = { 0, 1 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_pwm) pwm = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, offsets, 2,
+						     GPIOD_LINE_VALUE_INACTIVE);
+	pwm = gpiod_pwm_new();
+	g_assert_nonnull(pwm);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_pwm_add_channel(pwm, request, 0, 1000000, 500000);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_pwm_start(pwm);
+	g_assert_cmpint(ret, ==, 0);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_pwm_add_channel(pwm, request, 1, 1000000, 500000);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EBUSY);
+
+	ret = gpiod_pwm_start(pwm);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EBUSY);
+
+	ret = gpiod_pwm_stop(pwm);
+	g_assert_cmpint(ret, ==, 0);
+}
+
+GPIOD_TEST_CASE(achieved_frequency)
+{
+	static const guint offsets[] = { 0, 1, 2, 3 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_pwm) pwm = NULL;
+	guint64 jitter, max_jitter;
+	gdouble frequency;
+	guint i;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, offsets, 4,
+						     GPIOD_LINE_VALUE_INACTIVE);
+	pwm = gpiod_pwm_new();
+	g_assert_nonnull(pwm);
+	gpiod_test_return_if_failed();
+
+	for (i = 0; i < 4; i++) {
+		ret = gpiod_pwm_add_channel(pwm, request, offsets[i],
+					    2000000, 500000 * i);
+		g_assert_cmpint(ret, ==, i);
+	}
+
+	ret = gpiod_pwm_start(pwm);
+	g_assert_cmpint(ret, ==, 0);
+	gpiod_test_return_if_failed();
+
+	g_usleep(200000);
+
+	ret = gpiod_pwm_stop(pwm);
+	g_assert_cmpint(ret, ==, 0);
+	gpiod_test_return_if_failed();
+
+	for (i = 0; i < 4; i++) {
+		ret = gpiod_pwm_get_stats(pwm, i, &frequency, &jitter,
+					  &max_jitter);
+		g_assert_cmpint(ret, ==, 0);
+		/* Generous bounds: the test may run on a loaded machine. */
+		g_assert_cmpfloat(frequency, >, 400.0);
+		g_assert_cmpfloat(frequency, <, 510.0);
+		g_assert_cmpuint(jitter, <=, max_jitter);
+	}
+
+	/* All lines are driven inactive when the engine stops. */
+	for (i = 0; i < 4; i++)
+		g_assert_cmpint(g_gpiosim_chip_get_value(sim, offsets[i]), ==,
+				G_GPIOSIM_VALUE_INACTIVE);
+}
+
+GPIOD_TEST_CASE(full_duty_cycle_keeps_line_active)
+{
+	static const guint offsets[] = { 1, 2 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_pwm) pwm = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, offsets, 2,
+						     GPIOD_LINE_VALUE_INACTIVE);
+	pwm = gpiod_pwm_new();
+	g_assert_nonnull(pwm);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_pwm_add_channel(pwm, request, 1, 1000000, 1000000);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_pwm_add_channel(pwm, request, 2, 1000000, 0);
+	g_assert_cmpint(ret, ==, 1);
+	ret = gpiod_pwm_start(pwm);
+	g_assert_cmpint(ret, ==, 0);
+	gpiod_test_return_if_failed();
+
+	g_usleep(20000);
+
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 1), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 2), ==,
+			G_GPIOSIM_VALUE_INACTIVE);
+
+	ret = gpiod_pwm_stop(pwm);
+	g_assert_cmpint(ret, ==, 0);
+}
+
+GPIOD_TEST_CASE(update_duty_cycle_while_running)
+{
+	static const guint offset = 3;
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_pwm) pwm = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, &offset, 1,
+						     GPIOD_LINE_VALUE_INACTIVE);
+	pwm = gpiod_pwm_new();
+	g_assert_nonnull(pwm);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_pwm_add_channel(pwm, request, 3, 1000000, 0);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_pwm_start(pwm);
+	g_assert_cmpint(ret, ==, 0);
+	gpiod_test_return_if_failed();
+
+	g_usleep(10000);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 3), ==,
+			G_GPIOSIM_VALUE_INACTIVE);
+
+	ret = gpiod_pwm_set_channel(pwm, 0, 500000, 500000);
+	g_assert_cmpint(ret, ==, 0);
+
+	g_usleep(10000);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 3), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+
+	ret = gpiod_pwm_stop(pwm);
+	g_assert_cmpint(ret, ==, 0);
+}
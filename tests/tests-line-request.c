@@ -699,3 +699,321 @@ GPIOD_TEST_CASE(get_chip_name)
 	g_assert_cmpstr(g_gpiosim_chip_get_name(sim), ==,
 			gpiod_line_request_get_chip_name(request));
 }
+
+static struct gpiod_line_request *
+request_output_and_input(struct gpiod_chip *chip, guint output, guint input)
+{
+	g_autoptr(struct_gpiod_line_settings) settings = NULL;
+	g_autoptr(struct_gpiod_line_config) line_cfg = NULL;
+	gint ret;
+
+	settings = gpiod_line_settings_new();
+	line_cfg = gpiod_line_config_new();
+	g_assert_nonnull(settings);
+	g_assert_nonnull(line_cfg);
+	if (g_test_failed())
+		return NULL;
+
+	gpiod_line_settings_set_direction(settings,
+					  GPIOD_LINE_DIRECTION_OUTPUT);
+	ret = gpiod_line_config_add_line_settings(line_cfg, &output, 1,
+						  settings);
+	g_assert_cmpint(ret, ==, 0);
+	if (g_test_failed())
+		return NULL;
+
+	gpiod_line_settings_reset(settings);
+	gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_INPUT);
+	gpiod_line_settings_set_edge_detection(settings, GPIOD_LINE_EDGE_BOTH);
+	ret = gpiod_line_config_add_line_settings(line_cfg, &input, 1,
+						  settings);
+	g_assert_cmpint(ret, ==, 0);
+	if (g_test_failed())
+		return NULL;
+
+	return gpiod_chip_request_lines(chip, NULL, line_cfg);
+}
+
+static gpointer acknowledge_request(gpointer data)
+{
+	GPIOSimChip *sim = data;
+	guint i;
+
+	/* Wait for the request line to go high and then acknowledge it. */
+	for (i = 0; i < 1000; i++) {
+		if (_g_gpiosim_chip_get_value(sim, 0, NULL) ==
+		    G_GPIOSIM_VALUE_ACTIVE) {
+			g_gpiosim_chip_set_pull(sim, 1, G_GPIOSIM_PULL_UP);
+			break;
+		}
+
+		g_usleep(1000);
+	}
+
+	return NULL;
+}
+
+GPIOD_TEST_CASE(handshake_waits_for_edge)
+{
+	static const guint req_offset = 0;
+	static const enum gpiod_line_value active = GPIOD_LINE_VALUE_ACTIVE;
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_edge_event_buffer) buffer = NULL;
+	g_autoptr(GThread) thread = NULL;
+	struct gpiod_edge_event *event;
+	guint64 turnaround = 0;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	buffer = gpiod_test_create_edge_event_buffer_or_fail(4);
+	request = request_output_and_input(chip, 0, 1);
+	g_assert_nonnull(request);
+	gpiod_test_return_if_failed();
+
+	thread = g_thread_new("acknowledge", acknowledge_request, sim);
+	g_thread_ref(thread);
+
+	ret = gpiod_line_request_handshake(request, 1, &req_offset, &active,
+					   request, 1,
+					   GPIOD_LINE_RESPONSE_RISING_EDGE,
+					   1000000000, buffer, &turnaround);
+	g_assert_cmpint(ret, ==, 1);
+	gpiod_test_join_thread_and_return_if_failed(thread);
+
+	g_assert_cmpuint(gpiod_edge_event_buffer_get_num_events(buffer), ==, 1);
+	event = gpiod_edge_event_buffer_get_event(buffer, 0);
+	g_assert_nonnull(event);
+	gpiod_test_join_thread_and_return_if_failed(thread);
+	g_assert_cmpuint(gpiod_edge_event_get_line_offset(event), ==, 1);
+	g_assert_cmpint(gpiod_edge_event_get_event_type(event), ==,
+			GPIOD_EDGE_EVENT_RISING_EDGE);
+	g_assert_cmpuint(turnaround, >, 0);
+
+	g_thread_join(thread);
+}
+
+GPIOD_TEST_CASE(handshake_level_already_reached)
+{
+	static const guint req_offset = 0;
+	static const enum gpiod_line_value active = GPIOD_LINE_VALUE_ACTIVE;
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_edge_event_buffer) buffer = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	buffer = gpiod_test_create_edge_event_buffer_or_fail(4);
+	request = request_output_and_input(chip, 0, 1);
+	g_assert_nonnull(request);
+	gpiod_test_return_if_failed();
+
+	g_gpiosim_chip_set_pull(sim, 1, G_GPIOSIM_PULL_UP);
+
+	ret = gpiod_line_request_handshake(request, 1, &req_offset, &active,
+					   request, 1,
+					   GPIOD_LINE_RESPONSE_ACTIVE,
+					   0, buffer, NULL);
+	g_assert_cmpint(ret, ==, 1);
+	g_assert_cmpuint(gpiod_edge_event_buffer_get_num_events(buffer), ==, 0);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 0), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+}
+
+GPIOD_TEST_CASE(handshake_timeout)
+{
+	static const guint req_offset = 0;
+	static const enum gpiod_line_value active = GPIOD_LINE_VALUE_ACTIVE;
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = request_output_and_input(chip, 0, 1);
+	g_assert_nonnull(request);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_line_request_handshake(request, 1, &req_offset, &active,
+					   request, 1,
+					   GPIOD_LINE_RESPONSE_FALLING_EDGE,
+					   10000000, NULL, NULL);
+	g_assert_cmpint(ret, ==, 0);
+}
+
+GPIOD_TEST_CASE(handshake_fails_with_response_line_not_requested)
+{
+	static const guint req_offset = 0;
+	static const enum gpiod_line_value active = GPIOD_LINE_VALUE_ACTIVE;
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = request_output_and_input(chip, 0, 1);
+	g_assert_nonnull(request);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_line_request_handshake(request, 1, &req_offset, &active,
+					   request, 3,
+					   GPIOD_LINE_RESPONSE_RISING_EDGE,
+					   0, NULL, NULL);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+}
+
+GPIOD_TEST_CASE(wait_value_already_matching)
+{
+	static const guint offsets[] = { 0, 1, 2, 3 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_edge_event_buffer) buffer = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	buffer = gpiod_test_create_edge_event_buffer_or_fail(4);
+
+	g_gpiosim_chip_set_pull(sim, 1, G_GPIOSIM_PULL_UP);
+
+	request = gpiod_test_request_inputs_or_fail(chip, offsets, 4,
+						    GPIOD_LINE_EDGE_BOTH);
+
+	ret = gpiod_line_request_wait_value(request, 0x3, 0x2,
+					    GPIOD_LINE_MATCH_ALL, 0, buffer);
+	g_assert_cmpint(ret, ==, 1);
+	g_assert_cmpuint(gpiod_edge_event_buffer_get_num_events(buffer), ==, 0);
+}
+
+static gpointer pull_up_lines_2_and_3(gpointer data)
+{
+	GPIOSimChip *sim = data;
+
+	g_usleep(1000);
+	g_gpiosim_chip_set_pull(sim, 2, G_GPIOSIM_PULL_UP);
+	g_usleep(1000);
+	g_gpiosim_chip_set_pull(sim, 3, G_GPIOSIM_PULL_UP);
+
+	return NULL;
+}
+
+GPIOD_TEST_CASE(wait_value_all_driven_by_edge_events)
+{
+	static const guint offsets[] = { 0, 1, 2, 3 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_edge_event_buffer) buffer = NULL;
+	g_autoptr(GThread) thread = NULL;
+	struct gpiod_edge_event *event;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	buffer = gpiod_test_create_edge_event_buffer_or_fail(4);
+	request = gpiod_test_request_inputs_or_fail(chip, offsets, 4,
+						    GPIOD_LINE_EDGE_BOTH);
+
+	thread = g_thread_new("pull-up", pull_up_lines_2_and_3, sim);
+	g_thread_ref(thread);
+
+	ret = gpiod_line_request_wait_value(request, 0xc, 0xc,
+					    GPIOD_LINE_MATCH_ALL, 1000000000,
+					    buffer);
+	g_assert_cmpint(ret, ==, 1);
+	gpiod_test_join_thread_and_return_if_failed(thread);
+
+	/* The event completing the pattern is the one on line 3. */
+	g_assert_cmpuint(gpiod_edge_event_buffer_get_num_events(buffer), ==, 1);
+	event = gpiod_edge_event_buffer_get_event(buffer, 0);
+	g_assert_nonnull(event);
+	gpiod_test_join_thread_and_return_if_failed(thread);
+	g_assert_cmpuint(gpiod_edge_event_get_line_offset(event), ==, 3);
+
+	g_thread_join(thread);
+}
+
+GPIOD_TEST_CASE(wait_value_any)
+{
+	static const guint offsets[] = { 0, 1, 2, 3 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_edge_event_buffer) buffer = NULL;
+	g_autoptr(GThread) thread = NULL;
+	struct gpiod_edge_event *event;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	buffer = gpiod_test_create_edge_event_buffer_or_fail(4);
+	request = gpiod_test_request_inputs_or_fail(chip, offsets, 4,
+						    GPIOD_LINE_EDGE_BOTH);
+
+	thread = g_thread_new("pull-up", pull_up_lines_2_and_3, sim);
+	g_thread_ref(thread);
+
+	ret = gpiod_line_request_wait_value(request, 0xc, 0xc,
+					    GPIOD_LINE_MATCH_ANY, 1000000000,
+					    buffer);
+	g_assert_cmpint(ret, ==, 1);
+	gpiod_test_join_thread_and_return_if_failed(thread);
+
+	event = gpiod_edge_event_buffer_get_event(buffer, 0);
+	g_assert_nonnull(event);
+	gpiod_test_join_thread_and_return_if_failed(thread);
+	g_assert_cmpuint(gpiod_edge_event_get_line_offset(event), ==, 2);
+
+	g_thread_join(thread);
+}
+
+GPIOD_TEST_CASE(wait_value_timeout)
+{
+	static const guint offsets[] = { 0, 1 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_inputs_or_fail(chip, offsets, 2,
+						    GPIOD_LINE_EDGE_BOTH);
+
+	ret = gpiod_line_request_wait_value(request, 0x1, 0x1,
+					    GPIOD_LINE_MATCH_ALL, 10000000,
+					    NULL);
+	g_assert_cmpint(ret, ==, 0);
+}
+
+GPIOD_TEST_CASE(wait_value_fails_with_invalid_mask)
+{
+	static const guint offsets[] = { 0, 1 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_inputs_or_fail(chip, offsets, 2,
+						    GPIOD_LINE_EDGE_BOTH);
+
+	ret = gpiod_line_request_wait_value(request, 0x4, 0x4,
+					    GPIOD_LINE_MATCH_ALL, 0, NULL);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_line_request_wait_value(request, 0, 0,
+					    GPIOD_LINE_MATCH_ALL, 0, NULL);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+}
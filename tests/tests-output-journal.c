@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <errno.h>
+#include <glib.h>
+#include <gpiod.h>
+#include <linux/gpio.h>
+#include <unistd.h>
+
+#include "gpiod-test.h"
+#include "gpiod-test-helpers.h"
+#include "gpiod-test-sim.h"
+
+#define GPIOD_TEST_GROUP "output-journal"
+
+GPIOD_TEST_CASE(capacity_is_rounded_up)
+{
+	g_autoptr(struct_gpiod_output_journal) journal = NULL;
+
+	journal = gpiod_output_journal_new(0);
+	g_assert_null(journal);
+	gpiod_test_expect_errno(EINVAL);
+
+	journal = gpiod_test_create_output_journal_or_fail(5);
+
+	g_assert_cmpuint(gpiod_output_journal_get_capacity(journal), ==, 8);
+	g_assert_cmpuint(gpiod_output_journal_get_num_entries(journal), ==, 0);
+}
+
+GPIOD_TEST_CASE(records_set_values)
+{
+	static const guint offsets[] = { 2, 3 };
+	static const enum gpiod_line_value values[] = {
+		GPIOD_LINE_VALUE_INACTIVE,
+		GPIOD_LINE_VALUE_ACTIVE,
+	};
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_output_journal) journal = NULL;
+	guint64 timestamp, mask, bits;
+	guint i, tag;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, offsets, 2,
+						     GPIOD_LINE_VALUE_INACTIVE);
+
+	journal = gpiod_test_create_output_journal_or_fail(4);
+
+	ret = gpiod_line_request_attach_journal(request, journal);
+	g_assert_cmpint(ret, ==, 0);
+
+	ret = gpiod_line_request_attach_journal(request, journal);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EBUSY);
+
+	for (i = 0; i < 5; i++) {
+		gpiod_output_journal_set_tag(journal, i);
+		ret = gpiod_line_request_set_value(request, 2, i % 2);
+		g_assert_cmpint(ret, ==, 0);
+	}
+
+	gpiod_output_journal_set_tag(journal, 42);
+	ret = gpiod_line_request_set_values(request, values);
+	g_assert_cmpint(ret, ==, 0);
+
+	g_assert_cmpuint(gpiod_output_journal_get_num_entries(journal), ==, 6);
+
+	/* The oldest entries were overwritten. */
+	ret = gpiod_output_journal_get_entry(journal, 1, NULL, NULL, NULL,
+					     NULL);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(ENOENT);
+
+	ret = gpiod_output_journal_get_entry(journal, 6, NULL, NULL, NULL,
+					     NULL);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(ENOENT);
+
+	ret = gpiod_output_journal_get_entry(journal, 3, &timestamp, &mask,
+					     &bits, &tag);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpuint(timestamp, >, 0);
+	g_assert_cmpuint(mask, ==, 0x1);
+	g_assert_cmpuint(bits, ==, 0x1);
+	g_assert_cmpuint(tag, ==, 3);
+
+	ret = gpiod_output_journal_get_entry(journal, 5, NULL, &mask,
+					     &bits, &tag);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpuint(mask, ==, 0x3);
+	g_assert_cmpuint(bits, ==, 0x2);
+	g_assert_cmpuint(tag, ==, 42);
+
+	ret = gpiod_line_request_attach_journal(request, NULL);
+	g_assert_cmpint(ret, ==, 0);
+
+	ret = gpiod_line_request_set_value(request, 3, 0);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpuint(gpiod_output_journal_get_num_entries(journal), ==, 6);
+}
+
+GPIOD_TEST_CASE(export_as_edge_events)
+{
+	static const guint offsets[] = { 2, 3 };
+	static const enum gpiod_line_value values[] = {
+		GPIOD_LINE_VALUE_ACTIVE,
+		GPIOD_LINE_VALUE_ACTIVE,
+	};
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_output_journal) journal = NULL;
+	struct gpio_v2_line_event events[8];
+	gint ret, fds[2];
+	ssize_t rd;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, offsets, 2,
+						     GPIOD_LINE_VALUE_INACTIVE);
+
+	journal = gpiod_test_create_output_journal_or_fail(16);
+
+	ret = gpiod_line_request_attach_journal(request, journal);
+	g_assert_cmpint(ret, ==, 0);
+
+	/* Both lines rise, then only line 3 falls: three edges. */
+	ret = gpiod_line_request_set_values(request, values);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_request_set_value(request, 2,
+					   GPIOD_LINE_VALUE_ACTIVE);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_line_request_set_value(request, 3,
+					   GPIOD_LINE_VALUE_INACTIVE);
+	g_assert_cmpint(ret, ==, 0);
+
+	ret = pipe(fds);
+	g_assert_cmpint(ret, ==, 0);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_output_journal_export(journal, fds[1]);
+	g_assert_cmpint(ret, ==, 3);
+	close(fds[1]);
+
+	rd = read(fds[0], events, sizeof(events));
+	close(fds[0]);
+	g_assert_cmpint(rd, ==, 3 * sizeof(*events));
+	gpiod_test_return_if_failed();
+
+	g_assert_cmpuint(events[0].offset, ==, 2);
+	g_assert_cmpuint(events[0].id, ==, GPIO_V2_LINE_EVENT_RISING_EDGE);
+	g_assert_cmpuint(events[1].offset, ==, 3);
+	g_assert_cmpuint(events[1].id, ==, GPIO_V2_LINE_EVENT_RISING_EDGE);
+	g_assert_cmpuint(events[2].offset, ==, 3);
+	g_assert_cmpuint(events[2].id, ==, GPIO_V2_LINE_EVENT_FALLING_EDGE);
+	g_assert_cmpuint(events[2].seqno, ==, 3);
+	g_assert_cmpuint(events[2].line_seqno, ==, 2);
+	g_assert_cmpuint(events[2].timestamp_ns, >=, events[0].timestamp_ns);
+}
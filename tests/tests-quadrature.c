@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <errno.h>
+#include <glib.h>
+#include <gpiod.h>
+
+#include "gpiod-test.h"
+#include "gpiod-test-helpers.h"
+#include "gpiod-test-sim.h"
+
+#define GPIOD_TEST_GROUP "quadrature"
+
+/* One full encoder cycle with the first line leading the second. */
+static void turn(GPIOSimChip *sim, guint first, guint second)
+{
+	g_gpiosim_chip_set_pull(sim, first, G_GPIOSIM_PULL_UP);
+	g_gpiosim_chip_set_pull(sim, second, G_GPIOSIM_PULL_UP);
+	g_gpiosim_chip_set_pull(sim, first, G_GPIOSIM_PULL_DOWN);
+	g_gpiosim_chip_set_pull(sim, second, G_GPIOSIM_PULL_DOWN);
+}
+
+static void read_and_process(struct gpiod_line_request *request,
+			     struct gpiod_edge_event_buffer *buffer,
+			     struct gpiod_quadrature *quad,
+			     gint expected_events, gsize expected_decoded)
+{
+	gint ret;
+
+	ret = gpiod_line_request_wait_edge_events(request, 1000000000);
+	g_assert_cmpint(ret, >, 0);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_line_request_read_edge_events(request, buffer, 64);
+	g_assert_cmpint(ret, ==, expected_events);
+	g_assert_cmpuint(gpiod_quadrature_process(quad, buffer), ==,
+			 expected_decoded);
+}
+
+GPIOD_TEST_CASE(count_both_directions)
+{
+	static const guint offsets[] = { 0, 1 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_edge_event_buffer) buffer = NULL;
+	g_autoptr(struct_gpiod_quadrature) quad = NULL;
+	guint64 num_errors;
+	gint64 position;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_inputs_or_fail(chip, offsets, 2,
+						    GPIOD_LINE_EDGE_BOTH);
+
+	buffer = gpiod_test_create_edge_event_buffer_or_fail(64);
+	quad = gpiod_test_create_quadrature_or_fail();
+
+	ret = gpiod_quadrature_add_encoder(quad, 0, 1);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpuint(gpiod_quadrature_get_num_encoders(quad), ==, 1);
+
+	ret = gpiod_quadrature_sync(quad, request);
+	g_assert_cmpint(ret, ==, 1);
+
+	turn(sim, 0, 1);
+	turn(sim, 0, 1);
+	read_and_process(request, buffer, quad, 8, 8);
+
+	ret = gpiod_quadrature_get_state(quad, 0, &position, NULL, &num_errors);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpint(position, ==, 8);
+	g_assert_cmpuint(num_errors, ==, 0);
+
+	turn(sim, 1, 0);
+	read_and_process(request, buffer, quad, 4, 4);
+
+	ret = gpiod_quadrature_get_state(quad, 0, &position, NULL, NULL);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpint(position, ==, 4);
+}
+
+GPIOD_TEST_CASE(levels_learned_without_sync)
+{
+	static const guint offsets[] = { 0, 1 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_edge_event_buffer) buffer = NULL;
+	g_autoptr(struct_gpiod_quadrature) quad = NULL;
+	gint64 position;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_inputs_or_fail(chip, offsets, 2,
+						    GPIOD_LINE_EDGE_BOTH);
+
+	buffer = gpiod_test_create_edge_event_buffer_or_fail(64);
+	quad = gpiod_test_create_quadrature_or_fail();
+
+	ret = gpiod_quadrature_add_encoder(quad, 0, 1);
+	g_assert_cmpint(ret, ==, 0);
+
+	/* The first edge of each channel only establishes its level. */
+	turn(sim, 0, 1);
+	read_and_process(request, buffer, quad, 4, 4);
+
+	ret = gpiod_quadrature_get_state(quad, 0, &position, NULL, NULL);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpint(position, ==, 2);
+}
+
+GPIOD_TEST_CASE(unrelated_lines_are_ignored)
+{
+	static const guint offsets[] = { 0, 1, 2 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_edge_event_buffer) buffer = NULL;
+	g_autoptr(struct_gpiod_quadrature) quad = NULL;
+	gint64 position;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_inputs_or_fail(chip, offsets, 3,
+						    GPIOD_LINE_EDGE_BOTH);
+
+	buffer = gpiod_test_create_edge_event_buffer_or_fail(64);
+	quad = gpiod_test_create_quadrature_or_fail();
+
+	gpiod_quadrature_add_encoder(quad, 0, 1);
+	gpiod_quadrature_sync(quad, request);
+
+	g_gpiosim_chip_set_pull(sim, 2, G_GPIOSIM_PULL_UP);
+	g_gpiosim_chip_set_pull(sim, 0, G_GPIOSIM_PULL_UP);
+	read_and_process(request, buffer, quad, 2, 1);
+
+	ret = gpiod_quadrature_get_state(quad, 0, &position, NULL, NULL);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpint(position, ==, 1);
+}
+
+GPIOD_TEST_CASE(reset)
+{
+	g_autoptr(struct_gpiod_quadrature) quad = NULL;
+	gint64 position;
+	gdouble velocity;
+	gint ret;
+
+	quad = gpiod_test_create_quadrature_or_fail();
+
+	gpiod_quadrature_add_encoder(quad, 0, 1);
+
+	ret = gpiod_quadrature_reset(quad, 0, -42);
+	g_assert_cmpint(ret, ==, 0);
+
+	ret = gpiod_quadrature_get_state(quad, 0, &position, &velocity, NULL);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpint(position, ==, -42);
+	g_assert_cmpfloat(velocity, ==, 0.0);
+}
+
+GPIOD_TEST_CASE(invalid_arguments)
+{
+	g_autoptr(struct_gpiod_quadrature) quad = NULL;
+	gint ret;
+
+	quad = gpiod_test_create_quadrature_or_fail();
+
+	ret = gpiod_quadrature_add_encoder(quad, 3, 3);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_quadrature_add_encoder(quad, 0, 1);
+	g_assert_cmpint(ret, ==, 0);
+
+	ret = gpiod_quadrature_add_encoder(quad, 1, 2);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_quadrature_get_state(quad, 1, NULL, NULL, NULL);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_quadrature_reset(quad, 1, 0);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+}
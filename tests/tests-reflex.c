@@ -0,0 +1,231 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <errno.h>
+#include <glib.h>
+#include <gpiod.h>
+
+#include "gpiod-test.h"
+#include "gpiod-test-helpers.h"
+#include "gpiod-test-sim.h"
+
+#define GPIOD_TEST_GROUP "reflex"
+
+GPIOD_TEST_CASE(add_rule_invalid_arguments)
+{
+	static const guint trig_offset = 0;
+	static const guint out_offsets[] = { 1, 2 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) trigger = NULL;
+	g_autoptr(struct_gpiod_line_request) outputs = NULL;
+	g_autoptr(struct_gpiod_reflex) reflex = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	trigger = gpiod_test_request_inputs_or_fail(chip, &trig_offset, 1,
+						    GPIOD_LINE_EDGE_BOTH);
+	outputs = gpiod_test_request_outputs_or_fail(chip, out_offsets, 2,
+						     GPIOD_LINE_VALUE_INACTIVE);
+
+	reflex = gpiod_test_create_reflex_or_fail();
+
+	/* Trigger line not in the request. */
+	ret = gpiod_reflex_add_rule(reflex, trigger, 3, GPIOD_LINE_EDGE_BOTH,
+				    outputs, 0x1, 0x1, 0);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_reflex_add_rule(reflex, trigger, 0, GPIOD_LINE_EDGE_NONE,
+				    outputs, 0x1, 0x1, 0);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	/* Mask out of range of the target request. */
+	ret = gpiod_reflex_add_rule(reflex, trigger, 0, GPIOD_LINE_EDGE_BOTH,
+				    outputs, 0x4, 0x4, 0);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_reflex_add_rule(reflex, trigger, 0, GPIOD_LINE_EDGE_BOTH,
+				    outputs, 0x3, 0x1, 0);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpuint(gpiod_reflex_get_num_rules(reflex), ==, 1);
+
+	ret = gpiod_reflex_set_priority(reflex, 1000);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+}
+
+GPIOD_TEST_CASE(start_without_rules)
+{
+	g_autoptr(struct_gpiod_reflex) reflex = NULL;
+	gint ret;
+
+	reflex = gpiod_test_create_reflex_or_fail();
+
+	ret = gpiod_reflex_start(reflex);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_reflex_stop(reflex);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+}
+
+GPIOD_TEST_CASE(falling_edge_drives_outputs_low)
+{
+	static const guint trig_offset = 0;
+	static const guint out_offsets[] = { 1, 2, 3 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) trigger = NULL;
+	g_autoptr(struct_gpiod_line_request) outputs = NULL;
+	g_autoptr(struct_gpiod_reflex) reflex = NULL;
+	guint64 num_triggers, last, avg, max;
+	gint ret;
+
+	g_gpiosim_chip_set_pull(sim, 0, G_GPIOSIM_PULL_UP);
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	trigger = gpiod_test_request_inputs_or_fail(chip, &trig_offset, 1,
+						    GPIOD_LINE_EDGE_FALLING);
+	outputs = gpiod_test_request_outputs_or_fail(chip, out_offsets, 3,
+						     GPIOD_LINE_VALUE_ACTIVE);
+
+	reflex = gpiod_test_create_reflex_or_fail();
+
+	/* Drive the first two outputs low, leave the third one alone. */
+	ret = gpiod_reflex_add_rule(reflex, trigger, 0, GPIOD_LINE_EDGE_FALLING,
+				    outputs, 0x3, 0x0, 0);
+	g_assert_cmpint(ret, ==, 0);
+
+	ret = gpiod_reflex_start(reflex);
+	g_assert_cmpint(ret, ==, 0);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_reflex_add_rule(reflex, trigger, 0, GPIOD_LINE_EDGE_RISING,
+				    outputs, 0x4, 0x0, 0);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EBUSY);
+
+	g_gpiosim_chip_set_pull(sim, 0, G_GPIOSIM_PULL_DOWN);
+	g_usleep(10000);
+
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 1), ==,
+			G_GPIOSIM_VALUE_INACTIVE);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 2), ==,
+			G_GPIOSIM_VALUE_INACTIVE);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 3), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+
+	ret = gpiod_reflex_stop(reflex);
+	g_assert_cmpint(ret, ==, 0);
+
+	ret = gpiod_reflex_get_stats(reflex, 0, &num_triggers, &last, &avg,
+				     &max);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpuint(num_triggers, ==, 1);
+	g_assert_cmpuint(last, >, 0);
+	g_assert_cmpuint(avg, ==, last);
+	g_assert_cmpuint(max, ==, last);
+
+	/* The outputs are left alone when the engine stops. */
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 1), ==,
+			G_GPIOSIM_VALUE_INACTIVE);
+}
+
+GPIOD_TEST_CASE(delayed_action)
+{
+	static const guint trig_offset = 0;
+	static const guint out_offset = 1;
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 2, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) trigger = NULL;
+	g_autoptr(struct_gpiod_line_request) output = NULL;
+	g_autoptr(struct_gpiod_reflex) reflex = NULL;
+	guint64 num_triggers;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	trigger = gpiod_test_request_inputs_or_fail(chip, &trig_offset, 1,
+						    GPIOD_LINE_EDGE_RISING);
+	output = gpiod_test_request_outputs_or_fail(chip, &out_offset, 1,
+						    GPIOD_LINE_VALUE_INACTIVE);
+
+	reflex = gpiod_test_create_reflex_or_fail();
+
+	ret = gpiod_reflex_add_rule(reflex, trigger, 0, GPIOD_LINE_EDGE_RISING,
+				    output, 0x1, 0x1, 50000000);
+	g_assert_cmpint(ret, ==, 0);
+
+	ret = gpiod_reflex_start(reflex);
+	g_assert_cmpint(ret, ==, 0);
+	gpiod_test_return_if_failed();
+
+	g_gpiosim_chip_set_pull(sim, 0, G_GPIOSIM_PULL_UP);
+	g_usleep(10000);
+
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 1), ==,
+			G_GPIOSIM_VALUE_INACTIVE);
+
+	g_usleep(100000);
+
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 1), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+
+	ret = gpiod_reflex_get_stats(reflex, 0, &num_triggers, NULL, NULL,
+				     NULL);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpuint(num_triggers, ==, 1);
+
+	ret = gpiod_reflex_stop(reflex);
+	g_assert_cmpint(ret, ==, 0);
+}
+
+GPIOD_TEST_CASE(rules_fired_together_are_merged)
+{
+	static const guint trig_offset = 0;
+	static const guint out_offsets[] = { 1, 2 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) trigger = NULL;
+	g_autoptr(struct_gpiod_line_request) outputs = NULL;
+	g_autoptr(struct_gpiod_reflex) reflex = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	trigger = gpiod_test_request_inputs_or_fail(chip, &trig_offset, 1,
+						    GPIOD_LINE_EDGE_BOTH);
+	outputs = gpiod_test_request_outputs_or_fail(chip, out_offsets, 2,
+						     GPIOD_LINE_VALUE_INACTIVE);
+
+	reflex = gpiod_test_create_reflex_or_fail();
+
+	ret = gpiod_reflex_add_rule(reflex, trigger, 0, GPIOD_LINE_EDGE_RISING,
+				    outputs, 0x3, 0x3, 0);
+	g_assert_cmpint(ret, ==, 0);
+	/* Added later so it wins on the line both rules drive. */
+	ret = gpiod_reflex_add_rule(reflex, trigger, 0, GPIOD_LINE_EDGE_BOTH,
+				    outputs, 0x2, 0x0, 0);
+	g_assert_cmpint(ret, ==, 1);
+
+	ret = gpiod_reflex_start(reflex);
+	g_assert_cmpint(ret, ==, 0);
+	gpiod_test_return_if_failed();
+
+	g_gpiosim_chip_set_pull(sim, 0, G_GPIOSIM_PULL_UP);
+	g_usleep(10000);
+
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 1), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 2), ==,
+			G_GPIOSIM_VALUE_INACTIVE);
+
+	ret = gpiod_reflex_stop(reflex);
+	g_assert_cmpint(ret, ==, 0);
+}
@@ -0,0 +1,210 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <errno.h>
+#include <glib.h>
+#include <gpiod.h>
+
+#include "gpiod-test.h"
+#include "gpiod-test-helpers.h"
+#include "gpiod-test-sim.h"
+
+#define GPIOD_TEST_GROUP "request-group"
+
+GPIOD_TEST_CASE(empty_group_and_duplicates)
+{
+	static const guint offset = 0;
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_request_group) group = NULL;
+	enum gpiod_line_value value;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_inputs_or_fail(chip, &offset, 1,
+						    GPIOD_LINE_EDGE_NONE);
+
+	group = gpiod_test_create_request_group_or_fail();
+
+	ret = gpiod_request_group_get_values(group, &value);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_request_group_add_request(group, request);
+	g_assert_cmpint(ret, ==, 0);
+
+	ret = gpiod_request_group_add_request(group, request);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EEXIST);
+
+	g_assert_cmpuint(gpiod_request_group_get_num_requests(group), ==, 1);
+
+	ret = gpiod_request_group_get_timestamps(group, 1, NULL, NULL);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+}
+
+GPIOD_TEST_CASE(set_values_on_multiple_chips)
+{
+	static const guint offsets0[] = { 1, 3 };
+	static const guint offsets1[] = { 2 };
+	static const guint offsets2[] = { 0, 1, 2 };
+	static const enum gpiod_line_value values[] = {
+		GPIOD_LINE_VALUE_ACTIVE,
+		GPIOD_LINE_VALUE_INACTIVE,
+		GPIOD_LINE_VALUE_ACTIVE,
+		GPIOD_LINE_VALUE_INACTIVE,
+		GPIOD_LINE_VALUE_ACTIVE,
+		GPIOD_LINE_VALUE_ACTIVE,
+	};
+
+	g_autoptr(GPIOSimChip) sim0 = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(GPIOSimChip) sim1 = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(GPIOSimChip) sim2 = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip0 = NULL;
+	g_autoptr(struct_gpiod_chip) chip1 = NULL;
+	g_autoptr(struct_gpiod_chip) chip2 = NULL;
+	g_autoptr(struct_gpiod_line_request) request0 = NULL;
+	g_autoptr(struct_gpiod_line_request) request1 = NULL;
+	g_autoptr(struct_gpiod_line_request) request2 = NULL;
+	g_autoptr(struct_gpiod_request_group) group = NULL;
+	guint64 start, end;
+	gint ret;
+	guint i;
+
+	chip0 = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim0));
+	chip1 = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim1));
+	chip2 = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim2));
+
+	request0 = gpiod_test_request_outputs_or_fail(chip0, offsets0, 2,
+						      GPIOD_LINE_VALUE_INACTIVE);
+	request1 = gpiod_test_request_outputs_or_fail(chip1, offsets1, 1,
+						      GPIOD_LINE_VALUE_INACTIVE);
+	request2 = gpiod_test_request_outputs_or_fail(chip2, offsets2, 3,
+						      GPIOD_LINE_VALUE_INACTIVE);
+
+	group = gpiod_test_create_request_group_or_fail();
+
+	g_assert_cmpint(gpiod_request_group_add_request(group, request0), ==, 0);
+	g_assert_cmpint(gpiod_request_group_add_request(group, request1), ==, 1);
+	g_assert_cmpint(gpiod_request_group_add_request(group, request2), ==, 2);
+
+	ret = gpiod_request_group_set_values(group, values);
+	g_assert_cmpint(ret, ==, 0);
+	gpiod_test_return_if_failed();
+
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim0, 1), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim0, 3), ==,
+			G_GPIOSIM_VALUE_INACTIVE);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim1, 2), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim2, 0), ==,
+			G_GPIOSIM_VALUE_INACTIVE);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim2, 1), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim2, 2), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+
+	for (i = 0; i < 3; i++) {
+		ret = gpiod_request_group_get_timestamps(group, i, &start,
+							 &end);
+		g_assert_cmpint(ret, ==, 0);
+		g_assert_cmpuint(start, >, 0);
+		g_assert_cmpuint(end, >=, start);
+		g_assert_cmpuint(gpiod_request_group_get_skew_ns(group), >=,
+				 end - start);
+	}
+}
+
+GPIOD_TEST_CASE(snapshot_multiple_chips)
+{
+	static const guint offsets0[] = { 0, 2 };
+	static const guint offsets1[] = { 3 };
+
+	g_autoptr(GPIOSimChip) sim0 = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(GPIOSimChip) sim1 = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip0 = NULL;
+	g_autoptr(struct_gpiod_chip) chip1 = NULL;
+	g_autoptr(struct_gpiod_line_request) request0 = NULL;
+	g_autoptr(struct_gpiod_line_request) request1 = NULL;
+	g_autoptr(struct_gpiod_request_group) group = NULL;
+	enum gpiod_line_value values[3];
+	gint ret;
+
+	chip0 = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim0));
+	chip1 = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim1));
+
+	request0 = gpiod_test_request_inputs_or_fail(chip0, offsets0, 2,
+						     GPIOD_LINE_EDGE_NONE);
+	request1 = gpiod_test_request_inputs_or_fail(chip1, offsets1, 1,
+						     GPIOD_LINE_EDGE_NONE);
+
+	group = gpiod_test_create_request_group_or_fail();
+
+	g_assert_cmpint(gpiod_request_group_add_request(group, request0), ==, 0);
+	g_assert_cmpint(gpiod_request_group_add_request(group, request1), ==, 1);
+
+	g_gpiosim_chip_set_pull(sim0, 2, G_GPIOSIM_PULL_UP);
+	g_gpiosim_chip_set_pull(sim1, 3, G_GPIOSIM_PULL_UP);
+
+	ret = gpiod_request_group_get_values(group, values);
+	g_assert_cmpint(ret, ==, 0);
+	gpiod_test_return_if_failed();
+
+	g_assert_cmpint(values[0], ==, GPIOD_LINE_VALUE_INACTIVE);
+	g_assert_cmpint(values[1], ==, GPIOD_LINE_VALUE_ACTIVE);
+	g_assert_cmpint(values[2], ==, GPIOD_LINE_VALUE_ACTIVE);
+
+	g_gpiosim_chip_set_pull(sim1, 3, G_GPIOSIM_PULL_DOWN);
+
+	ret = gpiod_request_group_get_values(group, values);
+	g_assert_cmpint(ret, ==, 0);
+	g_assert_cmpint(values[2], ==, GPIOD_LINE_VALUE_INACTIVE);
+}
+
+GPIOD_TEST_CASE(errors_per_request)
+{
+	static const enum gpiod_line_value values[] = {
+		GPIOD_LINE_VALUE_ACTIVE, GPIOD_LINE_VALUE_ACTIVE,
+	};
+	static const guint offset = 1;
+
+	g_autoptr(GPIOSimChip) sim0 = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(GPIOSimChip) sim1 = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip0 = NULL;
+	g_autoptr(struct_gpiod_chip) chip1 = NULL;
+	g_autoptr(struct_gpiod_line_request) request0 = NULL;
+	g_autoptr(struct_gpiod_line_request) request1 = NULL;
+	g_autoptr(struct_gpiod_request_group) group = NULL;
+	gint ret;
+
+	chip0 = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim0));
+	chip1 = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim1));
+
+	request0 = gpiod_test_request_outputs_or_fail(chip0, &offset, 1,
+						      GPIOD_LINE_VALUE_INACTIVE);
+	/* Setting the values of input lines fails. */
+	request1 = gpiod_test_request_inputs_or_fail(chip1, &offset, 1,
+						     GPIOD_LINE_EDGE_NONE);
+
+	group = gpiod_test_create_request_group_or_fail();
+
+	g_assert_cmpint(gpiod_request_group_add_request(group, request0), ==, 0);
+	g_assert_cmpint(gpiod_request_group_add_request(group, request1), ==, 1);
+
+	ret = gpiod_request_group_set_values(group, values);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EPERM);
+
+	g_assert_cmpint(gpiod_request_group_get_error(group, 0), ==, 0);
+	g_assert_cmpint(gpiod_request_group_get_error(group, 1), ==, EPERM);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim0, 1), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+
+	ret = gpiod_request_group_get_error(group, 2);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+}
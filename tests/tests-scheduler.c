@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// SPDX-FileCopyrightText: 2026 The libgpiod authors
+
+#include <errno.h>
+#include <glib.h>
+#include <gpiod.h>
+
+#include "gpiod-test.h"
+#include "gpiod-test-helpers.h"
+#include "gpiod-test-sim.h"
+
+#define GPIOD_TEST_GROUP "scheduler"
+
+static guint64 monotonic_ns(void)
+{
+	return g_get_monotonic_time() * 1000;
+}
+
+GPIOD_TEST_CASE(invalid_arguments)
+{
+	static const guint offsets[] = { 0, 1 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_scheduler) sched = NULL;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, offsets, 2,
+						     GPIOD_LINE_VALUE_INACTIVE);
+
+	sched = gpiod_test_create_scheduler_or_fail();
+
+	ret = gpiod_scheduler_add(sched, 0, request, 0, 0);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	/* Mask out of range of the request. */
+	ret = gpiod_scheduler_add(sched, 0, request, 0x4, 0x4);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	g_assert_cmpuint(gpiod_scheduler_get_num_pending(sched), ==, 0);
+
+	ret = gpiod_scheduler_set_priority(sched, 1000);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+
+	ret = gpiod_scheduler_stop(sched);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EINVAL);
+}
+
+GPIOD_TEST_CASE(values_are_set_at_deadlines)
+{
+	static const guint offsets[] = { 0, 1 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_scheduler) sched = NULL;
+	guint64 now, num_executed, max_lateness;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, offsets, 2,
+						     GPIOD_LINE_VALUE_INACTIVE);
+
+	sched = gpiod_test_create_scheduler_or_fail();
+	gpiod_scheduler_set_spin(sched, 50000);
+
+	now = monotonic_ns();
+
+	/* Added before starting and out of order. */
+	ret = gpiod_scheduler_add(sched, now + 300000000, request, 0x1, 0x0);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_scheduler_add(sched, now + 100000000, request, 0x3, 0x3);
+	g_assert_cmpint(ret, ==, 0);
+
+	ret = gpiod_scheduler_start(sched);
+	g_assert_cmpint(ret, ==, 0);
+	gpiod_test_return_if_failed();
+
+	ret = gpiod_scheduler_start(sched);
+	g_assert_cmpint(ret, ==, -1);
+	gpiod_test_expect_errno(EBUSY);
+
+	g_usleep(200000);
+
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 0), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 1), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+	g_assert_cmpuint(gpiod_scheduler_get_num_pending(sched), ==, 1);
+
+	g_usleep(200000);
+
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 0), ==,
+			G_GPIOSIM_VALUE_INACTIVE);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 1), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+	g_assert_cmpuint(gpiod_scheduler_get_num_pending(sched), ==, 0);
+
+	gpiod_scheduler_get_stats(sched, &num_executed, NULL, NULL, NULL,
+				  &max_lateness);
+	g_assert_cmpuint(num_executed, ==, 2);
+	/* Generous bound, we only want to know it wasn't set at once. */
+	g_assert_cmpuint(max_lateness, <, 100000000);
+
+	ret = gpiod_scheduler_stop(sched);
+	g_assert_cmpint(ret, ==, 0);
+}
+
+GPIOD_TEST_CASE(entries_due_together_are_batched)
+{
+	static const guint offsets[] = { 0, 1, 2 };
+
+	g_autoptr(GPIOSimChip) sim = g_gpiosim_chip_new("num-lines", 4, NULL);
+	g_autoptr(struct_gpiod_chip) chip = NULL;
+	g_autoptr(struct_gpiod_line_request) request = NULL;
+	g_autoptr(struct_gpiod_scheduler) sched = NULL;
+	guint64 deadline, num_executed, num_batches;
+	gint ret;
+
+	chip = gpiod_test_open_chip_or_fail(g_gpiosim_chip_get_dev_path(sim));
+	request = gpiod_test_request_outputs_or_fail(chip, offsets, 3,
+						     GPIOD_LINE_VALUE_INACTIVE);
+
+	sched = gpiod_test_create_scheduler_or_fail();
+
+	ret = gpiod_scheduler_start(sched);
+	g_assert_cmpint(ret, ==, 0);
+	gpiod_test_return_if_failed();
+
+	deadline = monotonic_ns() + 50000000;
+
+	/* The later entry wins on the line they share. */
+	ret = gpiod_scheduler_add(sched, deadline, request, 0x3, 0x3);
+	g_assert_cmpint(ret, ==, 0);
+	ret = gpiod_scheduler_add(sched, deadline, request, 0x6, 0x4);
+	g_assert_cmpint(ret, ==, 0);
+
+	g_usleep(150000);
+
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 0), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 1), ==,
+			G_GPIOSIM_VALUE_INACTIVE);
+	g_assert_cmpint(g_gpiosim_chip_get_value(sim, 2), ==,
+			G_GPIOSIM_VALUE_ACTIVE);
+
+	gpiod_scheduler_get_stats(sched, &num_executed, &num_batches, NULL,
+				  NULL, NULL);
+	g_assert_cmpuint(num_executed, ==, 2);
+	g_assert_cmpuint(num_batches, ==, 1);
+}
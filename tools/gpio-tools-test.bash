@@ -153,6 +153,12 @@ gpiosim_wait_value() {
 	return 1
 }
 
+gpiosim_set_live() {
+	local NAME=${GPIOSIM_APP_NAME}-$$-$1
+
+	echo "$2" > "$GPIOSIM_CONFIGFS/$NAME/live"
+}
+
 gpiosim_cleanup() {
 	for CHIP in "${!GPIOSIM_CHIP_NAME[@]}"
 	do
@@ -755,6 +761,48 @@ test_gpioinfo_with_offset_out_of_range() {
 	status_is 1
 }
 
+test_gpioinfo_json() {
+	gpiosim_chip sim0 num_lines=2 line_name=1:foo
+	gpiosim_chip sim1 num_lines=1
+
+	local sim0=${GPIOSIM_CHIP_NAME[sim0]}
+	local sim1=${GPIOSIM_CHIP_NAME[sim1]}
+
+	dut_run gpioset --banner --consumer "test\"er" foo=1
+
+	run_tool gpioinfo --json
+
+	output_regex_match "^\\[.*\\{\"name\":\"$sim0\",\"label\":\"[^\"]+\",\"num_lines\":2,\"lines\":\\["
+	output_regex_match ".*\\{\"offset\":0,\"name\":null,\"used\":false,\"consumer\":null,\"direction\":\"input\",.*\\},"
+	output_regex_match ".*\\{\"offset\":1,\"name\":\"foo\",\"used\":true,\"consumer\":\"test\\\\\"er\",\"direction\":\"output\",.*\\}\\]\\}"
+	output_regex_match ".*\\{\"name\":\"$sim1\",.*\"num_lines\":1,"
+	output_regex_match ".*\\]$"
+	num_lines_is 1
+	status_is 0
+}
+
+test_gpioinfo_ndjson_with_lines() {
+	gpiosim_chip sim0 num_lines=4 line_name=1:foo line_name=3:bar
+
+	local sim0=${GPIOSIM_CHIP_NAME[sim0]}
+
+	run_tool gpioinfo --ndjson --chip "$sim0" 0 bar
+
+	output_regex_match "^\\{\"chip\":\"$sim0\",\"offset\":0,\"name\":null,.*\\}
+\\{\"chip\":\"$sim0\",\"offset\":3,\"name\":\"bar\",.*\\}$"
+	num_lines_is 2
+	status_is 0
+}
+
+test_gpioinfo_with_json_and_ndjson() {
+	gpiosim_chip sim0 num_lines=4
+
+	run_tool gpioinfo --json --ndjson --chip "${GPIOSIM_CHIP_NAME[sim0]}"
+
+	output_regex_match ".*can't combine json with ndjson"
+	status_is 1
+}
+
 #
 # gpioget test cases
 #
@@ -1141,6 +1189,49 @@ test_gpioget_with_invalid_hold_period() {
 	status_is 1
 }
 
+test_gpioget_samples() {
+	gpiosim_chip sim0 num_lines=8
+
+	local sim0=${GPIOSIM_CHIP_NAME[sim0]}
+
+	gpiosim_set_pull sim0 2 pull-up
+
+	run_tool gpioget --numeric --samples=3 --interval=10ms --chip "$sim0" 1 2
+
+	status_is 0
+	num_lines_is 3
+	output_regex_match "^[0-9]+\.[0-9]{9} 0 1
+[0-9]+\.[0-9]{9} 0 1
+[0-9]+\.[0-9]{9} 0 1$"
+}
+
+test_gpioget_binary_samples() {
+	gpiosim_chip sim0 num_lines=8
+
+	local sim0=${GPIOSIM_CHIP_NAME[sim0]}
+
+	gpiosim_set_pull sim0 2 pull-up
+
+	timeout 10s "$SOURCE_DIR/gpioget" --binary --samples=4 \
+		--chip "$sim0" 1 2 > "$SHUNIT_TMPDIR/$DUT_OUTPUT"
+	status=$?
+
+	status_is 0
+
+	# a 64-bit timestamp and a byte of values for each row
+	output=$(wc -c < "$SHUNIT_TMPDIR/$DUT_OUTPUT")
+	output_is 36
+}
+
+test_gpioget_with_invalid_number_of_samples() {
+	gpiosim_chip sim0 num_lines=8
+
+	run_tool gpioget --samples=0 --chip "${GPIOSIM_CHIP_NAME[sim0]}" 0
+
+	output_regex_match ".*invalid number of samples.*"
+	status_is 1
+}
+
 #
 # gpioset test cases
 #
@@ -1560,6 +1651,128 @@ test_gpioset_interactive_sleep() {
 	dut_readable
 }
 
+test_gpioset_stdin_text_frames() {
+	gpiosim_chip sim0 num_lines=8 line_name=1:foo line_name=4:bar
+	gpiosim_chip sim1 num_lines=8 line_name=3:baz
+
+	dut_run gpioset --banner --stdin=text foo=0 baz=0 bar=0
+
+	gpiosim_check_value sim0 1 0
+	gpiosim_check_value sim0 4 0
+	gpiosim_check_value sim1 3 0
+
+	dut_write "110"
+
+	gpiosim_wait_value sim0 1 1
+	gpiosim_wait_value sim1 3 1
+	gpiosim_check_value sim0 4 0
+
+	dut_write "001"
+
+	gpiosim_wait_value sim0 4 1
+	gpiosim_check_value sim0 1 0
+	gpiosim_check_value sim1 3 0
+
+	dut_write "01x"
+	dut_wait
+
+	status_is 1
+}
+
+test_gpioset_stdin_binary_frames() {
+	gpiosim_chip sim0 num_lines=8
+
+	local sim0=${GPIOSIM_CHIP_NAME[sim0]}
+
+	dut_run gpioset --banner --stdin=binary --chip "$sim0" 0=0 2=0 7=0
+
+	printf '\x05' >&"${COPROC[1]}"
+
+	gpiosim_wait_value sim0 0 1
+	gpiosim_wait_value sim0 7 1
+	gpiosim_check_value sim0 2 0
+
+	printf '\x02' >&"${COPROC[1]}"
+
+	gpiosim_wait_value sim0 2 1
+	gpiosim_check_value sim0 0 0
+	gpiosim_check_value sim0 7 0
+}
+
+test_gpioset_stdin_with_toggle() {
+	gpiosim_chip sim0 num_lines=8 line_name=1:foo
+
+	run_tool gpioset --stdin=text --toggle 1s foo=1
+
+	output_regex_match ".*can't combine stdin with toggle"
+	status_is 1
+}
+
+test_gpioset_pwm() {
+	gpiosim_chip sim0 num_lines=8
+
+	local sim0=${GPIOSIM_CHIP_NAME[sim0]}
+
+	dut_run_redirect gpioset --pwm 20ms --chip "$sim0" 1=50% 3=0% 5=100%
+
+	gpiosim_wait_value sim0 1 1
+	gpiosim_wait_value sim0 1 0
+	gpiosim_wait_value sim0 5 1
+	gpiosim_check_value sim0 3 0
+
+	dut_kill -SIGINT
+	dut_wait
+
+	status_is 0
+
+	dut_read_redirect
+
+	regex_matches "'1': [0-9.]+ Hz, jitter: avg [0-9]+ ns, max [0-9]+ ns" \
+		      "${lines[0]}"
+	regex_matches "'3': [0-9.]+ Hz" "${lines[1]}"
+	regex_matches "'5': [0-9.]+ Hz" "${lines[2]}"
+	num_lines_is 3
+}
+
+test_gpioset_pwm_exits_on_error() {
+	gpiosim_chip sim0 num_lines=8
+
+	local sim0=${GPIOSIM_CHIP_NAME[sim0]}
+
+	dut_run_redirect gpioset --pwm 20ms --chip "$sim0" 0=50%
+
+	gpiosim_wait_value sim0 0 1
+
+	# Removing the chip makes setting the values fail.
+	gpiosim_set_live sim0 0
+	dut_wait
+	gpiosim_set_live sim0 1
+
+	status_is 1
+
+	dut_read_redirect
+
+	output_regex_match ".*error generating PWM signals"
+}
+
+test_gpioset_pwm_with_invalid_duty_cycle() {
+	gpiosim_chip sim0 num_lines=8 line_name=1:foo
+
+	run_tool gpioset --pwm 20ms foo=150%
+
+	output_regex_match ".*invalid duty cycle: '150%'"
+	status_is 1
+}
+
+test_gpioset_pwm_with_toggle() {
+	gpiosim_chip sim0 num_lines=8 line_name=1:foo
+
+	run_tool gpioset --pwm 20ms --toggle 1s foo=50%
+
+	output_regex_match ".*can't combine toggle with PWM"
+	status_is 1
+}
+
 test_gpioset_toggle_continuous() {
 	gpiosim_chip sim0 num_lines=8 line_name=1:foo line_name=4:bar \
 				      line_name=7:baz
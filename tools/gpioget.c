@@ -11,15 +11,20 @@
 
 #include "tools-common.h"
 
+#define SAMPLE_BUF_SIZE	65536
+
 struct config {
 	bool active_low;
+	bool binary;
 	bool by_name;
 	bool numeric;
 	bool strict;
 	bool unquoted;
 	enum gpiod_line_bias bias;
 	enum gpiod_line_direction direction;
+	int num_samples;
 	unsigned long long hold_period_us;
+	unsigned long long interval_us;
 	const char *chip_id;
 	const char *consumer;
 };
@@ -36,11 +41,16 @@ static void print_help(void)
 	printf("Options:\n");
 	printf("  -a, --as-is\t\tleave the line direction unchanged, not forced to input\n");
 	print_bias_help();
+	printf("      --binary\t\toutput samples as binary rows\n");
 	printf("      --by-name\t\ttreat lines as names even if they would parse as an offset\n");
 	printf("  -c, --chip <chip>\trestrict scope to a particular chip\n");
 	printf("  -C, --consumer <name>\tconsumer name applied to requested lines (default is 'gpioget')\n");
 	printf("  -h, --help\t\tdisplay this help and exit\n");
+	printf("  -i, --interval <period>\n");
+	printf("\t\t\tthe period between samples (default is 0)\n");
 	printf("  -l, --active-low\ttreat the line as active low\n");
+	printf("  -n, --samples <num>\tread the values <num> times and output a timestamped\n");
+	printf("\t\t\trow for each sample\n");
 	printf("  -p, --hold-period <period>\n");
 	printf("\t\t\twait between requesting the lines and reading the values\n");
 	printf("      --numeric\t\tdisplay line values as '0' (inactive) or '1' (active)\n");
@@ -49,6 +59,16 @@ static void print_help(void)
 	printf("  -v, --version\t\toutput version information and exit\n");
 	print_chip_help();
 	print_period_help();
+	printf("\n");
+	printf("Samples:\n");
+	printf("    Samples are taken on a fixed schedule starting from the first one.\n");
+	printf("    If reading the values takes longer than the interval then the missed\n");
+	printf("    samples are skipped and the number of overruns is reported on exit.\n");
+	printf("    Text rows start with the CLOCK_MONOTONIC timestamp of the sample in\n");
+	printf("    seconds, followed by the values.\n");
+	printf("    Binary rows start with the timestamp in nanoseconds as a 64-bit integer in\n");
+	printf("    native byte order, followed by one bit per line, the first line being the\n");
+	printf("    least significant bit of the first byte.\n");
 }
 
 static int parse_config(int argc, char **argv, struct config *cfg)
@@ -57,19 +77,22 @@ static int parse_config(int argc, char **argv, struct config *cfg)
 		{ "active-low",	no_argument,		NULL,	'l' },
 		{ "as-is",	no_argument,		NULL,	'a' },
 		{ "bias",	required_argument,	NULL,	'b' },
+		{ "binary",	no_argument,		NULL,	'X' },
 		{ "by-name",	no_argument,		NULL,	'B' },
 		{ "chip",	required_argument,	NULL,	'c' },
 		{ "consumer",	required_argument,	NULL,	'C' },
 		{ "help",	no_argument,		NULL,	'h' },
 		{ "hold-period", required_argument,	NULL,	'p' },
+		{ "interval",	required_argument,	NULL,	'i' },
 		{ "numeric",	no_argument,		NULL,	'N' },
+		{ "samples",	required_argument,	NULL,	'n' },
 		{ "strict",	no_argument,		NULL,	's' },
 		{ "unquoted",	no_argument,		NULL,	'Q' },
 		{ "version",	no_argument,		NULL,	'v' },
 		{ GETOPT_NULL_LONGOPT },
 	};
 
-	static const char *const shortopts = "+ab:c:C:hlp:sv";
+	static const char *const shortopts = "+ab:c:C:hi:ln:p:sv";
 
 	int opti, optc;
 
@@ -98,9 +121,17 @@ static int parse_config(int argc, char **argv, struct config *cfg)
 		case 'C':
 			cfg->consumer = optarg;
 			break;
+		case 'i':
+			cfg->interval_us = parse_period_or_die(optarg);
+			break;
 		case 'l':
 			cfg->active_low = true;
 			break;
+		case 'n':
+			cfg->num_samples = parse_uint(optarg);
+			if (cfg->num_samples <= 0)
+				die("invalid number of samples: %s", optarg);
+			break;
 		case 'N':
 			cfg->numeric = true;
 			break;
@@ -113,6 +144,9 @@ static int parse_config(int argc, char **argv, struct config *cfg)
 		case 's':
 			cfg->strict = true;
 			break;
+		case 'X':
+			cfg->binary = true;
+			break;
 		case 'h':
 			print_help();
 			exit(EXIT_SUCCESS);
@@ -128,23 +162,145 @@ static int parse_config(int argc, char **argv, struct config *cfg)
 		}
 	}
 
+	if (cfg->interval_us && !cfg->num_samples)
+		die("can't use an interval without samples");
+	if (cfg->binary && !cfg->num_samples)
+		die("can't use binary output without samples");
+
 	return optind;
 }
 
+/*
+ * Read the values of the lines on all chips at once into the resolver.
+ * offsets and values are scratch pads for working.
+ */
+static void read_values(struct gpiod_request_group *group,
+			struct line_resolver *resolver, unsigned int *offsets,
+			enum gpiod_line_value *values)
+{
+	int i, num_values = 0;
+
+	if (gpiod_request_group_get_values(group, values))
+		die_perror("unable to read GPIO line values");
+
+	for (i = 0; i < resolver->num_chips; i++) {
+		set_line_values(resolver, i, values + num_values);
+		num_values += get_line_offsets_and_values(resolver, i, offsets,
+							  NULL);
+	}
+}
+
+static void print_values(struct line_resolver *resolver, struct config *cfg)
+{
+	const char *fmt = cfg->unquoted ? "%s=%s" : "\"%s\"=%s";
+	struct resolved_line *line;
+	int i;
+
+	for (i = 0; i < resolver->num_lines; i++) {
+		line = &resolver->lines[i];
+		if (cfg->numeric)
+			printf("%d", line->value);
+		else
+			printf(fmt, line->id,
+			       line->value ? "active" : "inactive");
+
+		if (i != resolver->num_lines - 1)
+			printf(" ");
+	}
+	printf("\n");
+}
+
+static void write_binary_row(struct line_resolver *resolver, uint64_t ts,
+			     unsigned char *row, size_t row_size)
+{
+	int i;
+
+	memset(row, 0, row_size);
+	memcpy(row, &ts, sizeof(ts));
+
+	for (i = 0; i < resolver->num_lines; i++)
+		if (resolver->lines[i].value)
+			row[sizeof(ts) + i / 8] |= 1 << (i % 8);
+
+	fwrite(row, row_size, 1, stdout);
+}
+
+/*
+ * Take the samples on a fixed schedule, skipping the slots that were
+ * missed because a sample took longer than the interval.
+ * offsets and values are scratch pads for working.
+ */
+static void sample_values(struct gpiod_request_group *group,
+			  struct line_resolver *resolver, unsigned int *offsets,
+			  enum gpiod_line_value *values, struct config *cfg)
+{
+	uint64_t interval_ns = cfg->interval_us * 1000, deadline, now;
+	unsigned long long num_overruns = 0, missed;
+	unsigned char *row = NULL;
+	size_t row_size = 0;
+	int i;
+
+	if (cfg->binary) {
+		row_size = sizeof(uint64_t) + (resolver->num_lines + 7) / 8;
+		row = malloc(row_size);
+		if (!row)
+			die("out of memory");
+	}
+
+	/* Let stdio batch the rows instead of writing them one by one. */
+	setvbuf(stdout, NULL, _IOFBF, SAMPLE_BUF_SIZE);
+
+	deadline = monotonic_ns();
+
+	for (i = 0; i < cfg->num_samples; i++) {
+		if (i && interval_ns) {
+			deadline += interval_ns;
+			now = monotonic_ns();
+
+			if (now >= deadline + interval_ns) {
+				missed = (now - deadline) / interval_ns;
+				num_overruns += missed;
+				deadline += missed * interval_ns;
+			}
+
+			sleep_until_ns(deadline);
+		}
+
+		now = monotonic_ns();
+		read_values(group, resolver, offsets, values);
+
+		if (cfg->binary) {
+			write_binary_row(resolver, now, row, row_size);
+		} else {
+			print_event_time(now, 0);
+			printf(" ");
+			print_values(resolver, cfg);
+		}
+	}
+
+	if (fflush(stdout))
+		die_perror("error writing samples");
+
+	if (num_overruns)
+		print_error("%llu sample(s) skipped due to overruns",
+			    num_overruns);
+
+	free(row);
+}
+
 int main(int argc, char **argv)
 {
 	struct gpiod_line_settings *settings;
 	struct gpiod_request_config *req_cfg;
-	struct gpiod_line_request *request;
+	struct gpiod_line_request **requests;
+	struct gpiod_request_group *group;
 	struct gpiod_line_config *line_cfg;
 	struct line_resolver *resolver;
 	enum gpiod_line_value *values;
-	struct resolved_line *line;
 	struct gpiod_chip *chip;
 	unsigned int *offsets;
 	int i, num_lines, ret;
 	struct config cfg;
-	const char *fmt;
 
 	set_prog_name(argv[0]);
 	i = parse_config(argc, argv, &cfg);
@@ -158,9 +314,10 @@ int main(int argc, char **argv)
 				 cfg.by_name);
 	validate_resolution(resolver, cfg.chip_id);
 
+	requests = calloc(resolver->num_chips, sizeof(*requests));
 	offsets = calloc(resolver->num_lines, sizeof(*offsets));
 	values = calloc(resolver->num_lines, sizeof(*values));
-	if (!offsets || !values)
+	if (!requests || !offsets || !values)
 		die("out of memory");
 
 	settings = gpiod_line_settings_new();
@@ -185,6 +342,10 @@ int main(int argc, char **argv)
 
 	gpiod_request_config_set_consumer(req_cfg, cfg.consumer);
 
+	group = gpiod_request_group_new();
+	if (!group)
+		die_perror("unable to allocate the request group");
+
 	for (i = 0; i < resolver->num_chips; i++) {
 		chip = gpiod_chip_open(resolver->chips[i].path);
 		if (!chip)
@@ -200,42 +361,38 @@ int main(int argc, char **argv)
 		if (ret)
 			die_perror("unable to add line settings");
 
-		request = gpiod_chip_request_lines(chip, req_cfg, line_cfg);
-		if (!request)
+		requests[i] = gpiod_chip_request_lines(chip, req_cfg, line_cfg);
+		if (!requests[i])
 			die_perror("unable to request lines");
 
-		if (cfg.hold_period_us)
-			sleep_us(cfg.hold_period_us);
-
-		ret = gpiod_line_request_get_values(request, values);
-		if (ret)
-			die_perror("unable to read GPIO line values");
-
-		set_line_values(resolver, i, values);
+		if (gpiod_request_group_add_request(group, requests[i]) < 0)
+			die_perror("unable to add the request to the group");
 
-		gpiod_line_request_release(request);
 		gpiod_chip_close(chip);
 	}
 
-	fmt = cfg.unquoted ? "%s=%s" : "\"%s\"=%s";
+	if (cfg.hold_period_us)
+		sleep_us(cfg.hold_period_us);
 
-	for (i = 0; i < resolver->num_lines; i++) {
-		line = &resolver->lines[i];
-		if (cfg.numeric)
-			printf("%d", line->value);
-		else
-			printf(fmt, line->id,
-			       line->value ? "active" : "inactive");
+	/* Every sample is a snapshot of the lines on all chips at once. */
+	if (cfg.num_samples)
+		sample_values(group, resolver, offsets, values, &cfg);
+	else
+		read_values(group, resolver, offsets, values);
 
-		if (i != resolver->num_lines - 1)
-			printf(" ");
-	}
-	printf("\n");
+	gpiod_request_group_free(group);
+
+	for (i = 0; i < resolver->num_chips; i++)
+		gpiod_line_request_release(requests[i]);
+
+	if (!cfg.num_samples)
+		print_values(resolver, &cfg);
 
 	free_line_resolver(resolver);
 	gpiod_request_config_free(req_cfg);
 	gpiod_line_config_free(line_cfg);
 	gpiod_line_settings_free(settings);
+	free(requests);
 	free(offsets);
 	free(values);
 
@@ -2,8 +2,10 @@
 // SPDX-FileCopyrightText: 2017-2021 Bartosz Golaszewski <bartekgola@gmail.com>
 // SPDX-FileCopyrightText: 2022 Kent Gibson <warthog618@gmail.com>
 
+#include <errno.h>
 #include <getopt.h>
 #include <gpiod.h>
+#include <pthread.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -11,13 +13,38 @@
 
 #include "tools-common.h"
 
+#define SCAN_MAX_THREADS	8
+#define OUTPUT_BUF_SIZE		65536
+
+enum {
+	FORMAT_JSON = 1,
+	FORMAT_NDJSON,
+};
+
 struct config {
 	bool by_name;
 	bool strict;
 	bool unquoted_strings;
+	int format;
 	const char *chip_id;
 };
 
+/* Everything read from a single chip by the parallel scan. */
+struct chip_scan {
+	const char *path;
+	struct gpiod_chip_info_data info;
+	struct gpiod_line_info_data *lines;
+	/* errno of the failed step, 0 if the chip was read successfully. */
+	int error;
+	bool opened;
+};
+
+struct scan_queue {
+	struct chip_scan *chips;
+	int num_chips;
+	int next;
+};
+
 static void print_help(void)
 {
 	printf("Usage: %s [OPTIONS] [line]...\n", get_prog_name());
@@ -33,6 +60,8 @@ static void print_help(void)
 	printf("      --by-name\t\ttreat lines as names even if they would parse as an offset\n");
 	printf("  -c, --chip <chip>\trestrict scope to a particular chip\n");
 	printf("  -h, --help\t\tdisplay this help and exit\n");
+	printf("      --json\t\toutput a JSON array with an object for each chip\n");
+	printf("      --ndjson\t\toutput a JSON object for each line, one per output line\n");
 	printf("  -s, --strict\t\tcheck all lines - don't assume line names are unique\n");
 	printf("      --unquoted\tdon't quote line or consumer names\n");
 	printf("  -v, --version\t\toutput version information and exit\n");
@@ -45,6 +74,8 @@ static int parse_config(int argc, char **argv, struct config *cfg)
 		{ "by-name",	no_argument,	NULL,		'B' },
 		{ "chip",	required_argument, NULL,	'c' },
 		{ "help",	no_argument,	NULL,		'h' },
+		{ "json",	no_argument,	NULL,		'J' },
+		{ "ndjson",	no_argument,	NULL,		'L' },
 		{ "strict",	no_argument,	NULL,		's' },
 		{ "unquoted",	no_argument,	NULL,		'Q' },
 		{ "version",	no_argument,	NULL,		'v' },
@@ -70,6 +101,16 @@ static int parse_config(int argc, char **argv, struct config *cfg)
 		case 'c':
 			cfg->chip_id = optarg;
 			break;
+		case 'J':
+			if (cfg->format == FORMAT_NDJSON)
+				die("can't combine json with ndjson");
+			cfg->format = FORMAT_JSON;
+			break;
+		case 'L':
+			if (cfg->format == FORMAT_JSON)
+				die("can't combine json with ndjson");
+			cfg->format = FORMAT_NDJSON;
+			break;
 		case 's':
 			cfg->strict = true;
 			break;
@@ -99,17 +140,13 @@ static int parse_config(int argc, char **argv, struct config *cfg)
  * printed rather than storing details into the resolver.
  * Does not die on non-unique lines.
  */
-static bool resolve_line(struct line_resolver *resolver,
-			 struct gpiod_line_info *info, int chip_num)
+static bool resolve_line(struct line_resolver *resolver, unsigned int offset,
+			 const char *name, int chip_num)
 {
 	struct resolved_line *line;
 	bool resolved = false;
-	unsigned int offset;
-	const char *name;
 	int i;
 
-	offset = gpiod_line_info_get_offset(info);
-
 	for (i = 0; i < resolver->num_lines; i++) {
 		line = &resolver->lines[i];
 
@@ -123,7 +160,6 @@ static bool resolve_line(struct line_resolver *resolver,
 			continue;
 
 		/* else resolve by name */
-		name = gpiod_line_info_get_name(info);
 		if (name && (strcmp(line->id, name) == 0)) {
 			line->resolved = true;
 			line->offset = offset;
@@ -195,7 +231,8 @@ static void list_lines(struct line_resolver *resolver, struct gpiod_chip *chip,
 				   offset, gpiod_chip_info_get_name(chip_info));
 
 		if (resolver->num_lines &&
-		    !resolve_line(resolver, info, chip_num))
+		    !resolve_line(resolver, offset,
+				  gpiod_line_info_get_name(info), chip_num))
 			continue;
 
 		if (resolver->num_lines) {
@@ -220,6 +257,336 @@ static void list_lines(struct line_resolver *resolver, struct gpiod_chip *chip,
 	gpiod_chip_info_free(chip_info);
 }
 
+static void scan_chip(struct chip_scan *scan)
+{
+	struct gpiod_chip_info *info;
+	struct gpiod_chip *chip;
+	int ret;
+
+	chip = gpiod_chip_open(scan->path);
+	if (!chip) {
+		scan->error = errno;
+		return;
+	}
+
+	scan->opened = true;
+
+	info = gpiod_chip_get_info(chip);
+	if (!info) {
+		scan->error = errno;
+		goto out_close;
+	}
+
+	ret = gpiod_chip_info_export(info, &scan->info, sizeof(scan->info));
+	gpiod_chip_info_free(info);
+	if (ret) {
+		scan->error = errno;
+		goto out_close;
+	}
+
+	scan->lines = calloc(scan->info.num_lines, sizeof(*scan->lines));
+	if (!scan->lines && scan->info.num_lines) {
+		scan->error = ENOMEM;
+		goto out_close;
+	}
+
+	ret = gpiod_chip_read_line_info_data(chip, 0, scan->info.num_lines,
+					     scan->lines,
+					     sizeof(*scan->lines));
+	if (ret)
+		scan->error = errno;
+
+out_close:
+	gpiod_chip_close(chip);
+}
+
+static void *scan_worker(void *data)
+{
+	struct scan_queue *queue = data;
+	int i;
+
+	for (;;) {
+		i = __atomic_fetch_add(&queue->next, 1, __ATOMIC_RELAXED);
+		if (i >= queue->num_chips)
+			return NULL;
+
+		scan_chip(&queue->chips[i]);
+	}
+}
+
+/*
+ * Read the info of all chips and their lines, with the chips spread over
+ * several threads. Reading the direction of a line on an expander behind a
+ * slow bus may sleep, so the number of threads isn't limited to the number
+ * of CPUs.
+ */
+static struct chip_scan *scan_chips(char **paths, int num_chips)
+{
+	pthread_t threads[SCAN_MAX_THREADS - 1];
+	int i, num_threads = 0, max_threads;
+	struct scan_queue queue;
+
+	memset(&queue, 0, sizeof(queue));
+	queue.num_chips = num_chips;
+	queue.chips = calloc(num_chips, sizeof(*queue.chips));
+	if (!queue.chips && num_chips)
+		die("out of memory");
+
+	for (i = 0; i < num_chips; i++)
+		queue.chips[i].path = paths[i];
+
+	max_threads = num_chips < SCAN_MAX_THREADS ? num_chips :
+						     SCAN_MAX_THREADS;
+
+	/* The calling thread scans too. */
+	for (i = 0; i < max_threads - 1; i++) {
+		if (pthread_create(&threads[num_threads], NULL,
+				   scan_worker, &queue))
+			break;
+
+		num_threads++;
+	}
+
+	scan_worker(&queue);
+
+	for (i = 0; i < num_threads; i++)
+		pthread_join(threads[i], NULL);
+
+	return queue.chips;
+}
+
+static void print_json_string(const char *str)
+{
+	const unsigned char *pos;
+
+	putchar('"');
+
+	for (pos = (const unsigned char *)str; *pos; pos++) {
+		if (*pos == '"' || *pos == '\\')
+			printf("\\%c", *pos);
+		else if (*pos < 0x20)
+			printf("\\u%04x", *pos);
+		else
+			putchar(*pos);
+	}
+
+	putchar('"');
+}
+
+static void print_json_optional_string(const char *str)
+{
+	if (str[0] == '\0')
+		printf("null");
+	else
+		print_json_string(str);
+}
+
+static const char *direction_str(enum gpiod_line_direction direction)
+{
+	return direction == GPIOD_LINE_DIRECTION_INPUT ? "input" : "output";
+}
+
+static const char *bias_str(enum gpiod_line_bias bias)
+{
+	switch (bias) {
+	case GPIOD_LINE_BIAS_PULL_UP:
+		return "pull-up";
+	case GPIOD_LINE_BIAS_PULL_DOWN:
+		return "pull-down";
+	case GPIOD_LINE_BIAS_DISABLED:
+		return "disabled";
+	default:
+		return "unknown";
+	}
+}
+
+static const char *drive_str(enum gpiod_line_drive drive)
+{
+	switch (drive) {
+	case GPIOD_LINE_DRIVE_OPEN_DRAIN:
+		return "open-drain";
+	case GPIOD_LINE_DRIVE_OPEN_SOURCE:
+		return "open-source";
+	default:
+		return "push-pull";
+	}
+}
+
+static const char *edge_str(enum gpiod_line_edge edge)
+{
+	switch (edge) {
+	case GPIOD_LINE_EDGE_BOTH:
+		return "both";
+	case GPIOD_LINE_EDGE_RISING:
+		return "rising";
+	case GPIOD_LINE_EDGE_FALLING:
+		return "falling";
+	default:
+		return "none";
+	}
+}
+
+static const char *event_clock_str(enum gpiod_line_clock event_clock)
+{
+	switch (event_clock) {
+	case GPIOD_LINE_CLOCK_REALTIME:
+		return "realtime";
+	case GPIOD_LINE_CLOCK_HTE:
+		return "hte";
+	default:
+		return "monotonic";
+	}
+}
+
+/* Print the members of the JSON object describing a line. */
+static void print_json_line(struct gpiod_line_info_data *line)
+{
+	printf("\"offset\":%u,\"name\":", line->offset);
+	print_json_optional_string(line->name);
+	printf(",\"used\":%s,\"consumer\":", line->used ? "true" : "false");
+	if (!line->used)
+		printf("null");
+	else if (line->consumer[0] == '\0')
+		print_json_string("kernel");
+	else
+		print_json_string(line->consumer);
+
+	printf(",\"direction\":\"%s\",\"active_low\":%s",
+	       direction_str(line->direction),
+	       line->active_low ? "true" : "false");
+	printf(",\"drive\":\"%s\",\"bias\":\"%s\",\"edges\":\"%s\"",
+	       drive_str(line->drive), bias_str(line->bias),
+	       edge_str(line->edge_detection));
+	printf(",\"event_clock\":\"%s\",\"debounce_period_us\":%lu",
+	       event_clock_str(line->event_clock), line->debounce_period_us);
+}
+
+static void print_json_chip_start(struct chip_scan *scan, bool first)
+{
+	printf("%s{\"name\":", first ? "" : ",");
+	print_json_string(scan->info.name);
+	printf(",\"label\":");
+	print_json_optional_string(scan->info.label);
+	printf(",\"num_lines\":%zu,\"lines\":[", scan->info.num_lines);
+}
+
+/*
+ * Same as list_lines, but for a chip that has already been scanned and with
+ * the lines output as JSON. Returns true if the chip has been output.
+ */
+static bool list_lines_json(struct line_resolver *resolver,
+			    struct chip_scan *scan, int chip_num,
+			    struct config *cfg, bool first_chip)
+{
+	struct gpiod_line_info_data *line;
+	bool started = false;
+	unsigned int offset;
+
+	if ((chip_num == 0) && (cfg->chip_id && !cfg->by_name))
+		resolve_lines_by_offset(resolver, scan->info.num_lines);
+
+	for (offset = 0; ((offset < scan->info.num_lines) &&
+			  !(resolver->num_lines && resolve_done(resolver)));
+	     offset++) {
+		line = &scan->lines[offset];
+
+		if (resolver->num_lines &&
+		    !resolve_line(resolver, offset,
+				  line->name[0] ? line->name : NULL, chip_num))
+			continue;
+
+		if (cfg->format == FORMAT_NDJSON) {
+			printf("{\"chip\":");
+			print_json_string(scan->info.name);
+			putchar(',');
+			print_json_line(line);
+			printf("}\n");
+		} else {
+			if (!started)
+				print_json_chip_start(scan, first_chip);
+			else
+				putchar(',');
+
+			putchar('{');
+			print_json_line(line);
+			putchar('}');
+		}
+
+		started = true;
+		resolver->num_found++;
+	}
+
+	if (cfg->format == FORMAT_NDJSON)
+		return started;
+
+	/* Without a list of lines every chip is output, even if empty. */
+	if (!started && !resolver->num_lines) {
+		print_json_chip_start(scan, first_chip);
+		started = true;
+	}
+
+	if (started)
+		printf("]}");
+
+	return started;
+}
+
+/*
+ * Scan all chips in parallel, then output them in order through a single
+ * fully buffered stdout.
+ */
+static int list_chips_json(struct line_resolver *resolver, char **paths,
+			   int num_chips, struct config *cfg)
+{
+	int i, ret = EXIT_SUCCESS;
+	struct chip_scan *chips;
+	bool first = true;
+
+	chips = scan_chips(paths, num_chips);
+
+	for (i = 0; i < num_chips; i++) {
+		if (!chips[i].error)
+			continue;
+
+		errno = chips[i].error;
+
+		if (chips[i].opened)
+			die_perror("unable to read info from chip %s",
+				   paths[i]);
+
+		print_perror("unable to open chip '%s'", paths[i]);
+
+		if (cfg->chip_id)
+			exit(EXIT_FAILURE);
+
+		ret = EXIT_FAILURE;
+	}
+
+	setvbuf(stdout, NULL, _IOFBF, OUTPUT_BUF_SIZE);
+
+	if (cfg->format == FORMAT_JSON)
+		putchar('[');
+
+	for (i = 0; i < num_chips; i++) {
+		if (chips[i].error)
+			continue;
+
+		if (list_lines_json(resolver, &chips[i], i, cfg, first))
+			first = false;
+	}
+
+	if (cfg->format == FORMAT_JSON)
+		printf("]\n");
+
+	fflush(stdout);
+
+	for (i = 0; i < num_chips; i++)
+		free(chips[i].lines);
+	free(chips);
+
+	return ret;
+}
+
 int main(int argc, char **argv)
 {
 	struct line_resolver *resolver = NULL;
@@ -243,21 +610,28 @@ int main(int argc, char **argv)
 	resolver = resolver_init(argc, argv, num_chips, cfg.strict,
 				 cfg.by_name);
 
-	for (i = 0; i < num_chips; i++) {
-		chip = gpiod_chip_open(paths[i]);
-		if (chip) {
-			list_lines(resolver, chip, i, &cfg);
-			gpiod_chip_close(chip);
-		} else {
-			print_perror("unable to open chip '%s'", paths[i]);
-
-			if (cfg.chip_id)
-				return EXIT_FAILURE;
-
-			ret = EXIT_FAILURE;
+	if (cfg.format) {
+		ret = list_chips_json(resolver, paths, num_chips, &cfg);
+	} else {
+		for (i = 0; i < num_chips; i++) {
+			chip = gpiod_chip_open(paths[i]);
+			if (chip) {
+				list_lines(resolver, chip, i, &cfg);
+				gpiod_chip_close(chip);
+			} else {
+				print_perror("unable to open chip '%s'",
+					     paths[i]);
+
+				if (cfg.chip_id)
+					return EXIT_FAILURE;
+
+				ret = EXIT_FAILURE;
+			}
 		}
-		free(paths[i]);
 	}
+
+	for (i = 0; i < num_chips; i++)
+		free(paths[i]);
 	free(paths);
 
 	validate_resolution(resolver, cfg.chip_id);
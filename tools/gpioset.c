@@ -3,13 +3,16 @@
 // SPDX-FileCopyrightText: 2022 Kent Gibson <warthog618@gmail.com>
 
 #include <ctype.h>
+#include <errno.h>
 #include <gpiod.h>
 #include <getopt.h>
 #include <limits.h>
 #include <poll.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 #ifdef GPIOSET_INTERACTIVE
 #include <editline/readline.h>
@@ -17,6 +20,13 @@
 
 #include "tools-common.h"
 
+#define STDIN_BUF_SIZE	65536
+
+enum {
+	STDIN_FORMAT_TEXT = 1,
+	STDIN_FORMAT_BINARY,
+};
+
 struct config {
 	bool active_low;
 	bool banner;
@@ -27,9 +37,11 @@ struct config {
 	bool unquoted;
 	enum gpiod_line_bias bias;
 	enum gpiod_line_drive drive;
+	int stdin_format;
 	int toggles;
 	unsigned long long *toggle_periods;
 	unsigned long long hold_period_us;
+	unsigned long long pwm_period_us;
 	const char *chip_id;
 	const char *consumer;
 };
@@ -65,7 +77,13 @@ static void print_help(void)
 	printf("  -l, --active-low\ttreat the line as active low\n");
 	printf("  -p, --hold-period <period>\n");
 	printf("\t\t\tthe minimum time period to hold lines at the requested values\n");
+	printf("      --pwm <period>\tgenerate PWM signals with the specified period\n");
+	printf("\t\t\tValues are duty cycles in percent, e.g. 'line=25%%'.\n");
+	printf("\t\t\tThe achieved frequency and jitter are printed on exit.\n");
 	printf("  -s, --strict\t\tabort if requested line names are not unique\n");
+	printf("      --stdin <format>\tset the lines then apply frames of values read from\n");
+	printf("\t\t\tstandard input until end of file\n");
+	printf("\t\t\tPossible values: 'text', 'binary'.\n");
 	printf("  -t, --toggle <period>[,period]...\n");
 	printf("\t\t\ttoggle the line(s) after the specified period(s)\n");
 	printf("\t\t\tIf the last period is 0 then gpioset exits else the sequence repeats.\n");
@@ -80,6 +98,14 @@ static void print_help(void)
 	printf("    When a process exits, any GPIO lines it has requested are automatically released.\n");
 	printf("    Once released, the state of a line may be modified by the kernel or another process.\n");
 	printf("    To guarantee the requested value, by default gpioset does not exit.\n");
+	printf("\n");
+	printf("Frames:\n");
+	printf("    Frames hold the values of all requested lines in the order they were\n");
+	printf("    specified on the command line.\n");
+	printf("    A text frame is a line of '0' and '1' characters, one per requested line,\n");
+	printf("    e.g. '0110'.\n");
+	printf("    A binary frame is a fixed number of bytes with one bit per requested line,\n");
+	printf("    the first line being the least significant bit of the first byte.\n");
 }
 
 static int parse_drive_or_die(const char *option)
@@ -94,6 +120,16 @@ static int parse_drive_or_die(const char *option)
 	return 0;
 }
 
+static int parse_stdin_format_or_die(const char *option)
+{
+	if (strcmp(option, "text") == 0)
+		return STDIN_FORMAT_TEXT;
+	if (strcmp(option, "binary") != 0)
+		die("invalid frame format: %s", option);
+
+	return STDIN_FORMAT_BINARY;
+}
+
 static int parse_periods_or_die(char *option, unsigned long long **periods)
 {
 	int i, num_periods = 1;
@@ -135,9 +171,11 @@ static int parse_config(int argc, char **argv, struct config *cfg)
 		{ "drive",	required_argument,	NULL,	'd' },
 		{ "help",	no_argument,		NULL,	'h' },
 		{ "hold-period", required_argument,	NULL,	'p' },
+		{ "pwm",	required_argument,	NULL,	'P' },
 #ifdef GPIOSET_INTERACTIVE
 		{ "interactive", no_argument,		NULL,	'i' },
 #endif
+		{ "stdin",	required_argument,	NULL,	'S' },
 		{ "strict",	no_argument,		NULL,	's' },
 		{ "toggle",	required_argument,	NULL,	't' },
 		{ "unquoted",	no_argument,		NULL,	'Q' },
@@ -191,12 +229,21 @@ static int parse_config(int argc, char **argv, struct config *cfg)
 		case 'p':
 			cfg->hold_period_us = parse_period_or_die(optarg);
 			break;
+		case 'P':
+			cfg->pwm_period_us = parse_period_or_die(optarg);
+			if (!cfg->pwm_period_us ||
+			    cfg->pwm_period_us > UINT32_MAX / 1000)
+				die("invalid PWM period: %s", optarg);
+			break;
 		case 'Q':
 			cfg->unquoted = true;
 			break;
 		case 's':
 			cfg->strict = true;
 			break;
+		case 'S':
+			cfg->stdin_format = parse_stdin_format_or_die(optarg);
+			break;
 		case 't':
 			cfg->toggles = parse_periods_or_die(optarg,
 						 &cfg->toggle_periods);
@@ -222,7 +269,17 @@ static int parse_config(int argc, char **argv, struct config *cfg)
 #ifdef GPIOSET_INTERACTIVE
 	if (cfg->toggles && cfg->interactive)
 		die("can't combine interactive with toggle");
+	if (cfg->pwm_period_us && cfg->interactive)
+		die("can't combine interactive with PWM");
+	if (cfg->stdin_format && cfg->interactive)
+		die("can't combine interactive with stdin");
 #endif
+	if (cfg->pwm_period_us && cfg->toggles)
+		die("can't combine toggle with PWM");
+	if (cfg->stdin_format && cfg->toggles)
+		die("can't combine stdin with toggle");
+	if (cfg->stdin_format && cfg->pwm_period_us)
+		die("can't combine stdin with PWM");
 
 	return optind;
 }
@@ -249,6 +306,25 @@ static enum gpiod_line_value parse_value(const char *option)
 	return GPIOD_LINE_VALUE_ERROR;
 }
 
+/* Parse a duty cycle in percent, with an optional '%' suffix. */
+static int parse_duty(const char *option)
+{
+	unsigned long duty;
+	char *end;
+
+	if (!isdigit(*option))
+		return -1;
+
+	duty = strtoul(option, &end, 10);
+	if (*end == '%')
+		end++;
+
+	if (*end != '\0' || duty > 100)
+		return -1;
+
+	return duty;
+}
+
 /*
  * Parse line id and values from lvs into lines and values.
  *
@@ -259,7 +335,8 @@ static enum gpiod_line_value parse_value(const char *option)
  * If line id is quoted then it is returned unquoted.
  */
 static bool parse_line_values(int num_lines, char **lvs, char **lines,
-			      enum gpiod_line_value *values, bool interactive)
+			      enum gpiod_line_value *values, int *duties,
+			      bool interactive)
 {
 	char *value, *line;
 	int i;
@@ -289,7 +366,18 @@ static bool parse_line_values(int num_lines, char **lvs, char **lines,
 
 		*value = '\0';
 		value++;
-		values[i] = parse_value(value);
+
+		if (duties) {
+			/* PWM lines start inactive. */
+			values[i] = GPIOD_LINE_VALUE_INACTIVE;
+			duties[i] = parse_duty(value);
+			if (duties[i] < 0) {
+				print_error("invalid duty cycle: '%s'", value);
+				return false;
+			}
+		} else {
+			values[i] = parse_value(value);
+		}
 
 		if (values[i] == GPIOD_LINE_VALUE_ERROR) {
 			if (interactive)
@@ -308,11 +396,13 @@ static bool parse_line_values(int num_lines, char **lvs, char **lines,
 
 /*
  * Parse line id and values from lvs into lines and values, or die trying.
+ * If duties is not NULL then the values are parsed as PWM duty cycles.
  */
 static void parse_line_values_or_die(int num_lines, char **lvs, char **lines,
-				     enum gpiod_line_value *values)
+				     enum gpiod_line_value *values,
+				     int *duties)
 {
-	if (!parse_line_values(num_lines, lvs, lines, values, false))
+	if (!parse_line_values(num_lines, lvs, lines, values, duties, false))
 		exit(EXIT_FAILURE);
 }
 
@@ -344,24 +434,39 @@ static void wait_fd(int fd)
 		die_perror("error waiting on request");
 }
 
-/*
- * Apply values from the resolver to the requests.
- * offset and values are scratch pads for working.
- */
-static void apply_values(struct gpiod_line_request **requests,
-			 struct line_resolver *resolver, unsigned int *offsets,
-			 enum gpiod_line_value *values)
+/* Report the chips on which setting the values of the group failed. */
+static void print_group_errors(struct gpiod_request_group *group,
+			       struct line_resolver *resolver)
 {
 	int i;
 
+	/* The requests were added to the group in the order of the chips. */
 	for (i = 0; i < resolver->num_chips; i++) {
-		get_line_offsets_and_values(resolver, i, offsets, values);
-		if (gpiod_line_request_set_values(requests[i], values))
+		errno = gpiod_request_group_get_error(group, i);
+		if (errno)
 			print_perror("unable to set values on '%s'",
 				     get_chip_name(resolver, i));
 	}
 }
 
+/*
+ * Apply values from the resolver to the requests of all chips at once.
+ * offset and values are scratch pads for working.
+ */
+static void apply_values(struct gpiod_request_group *group,
+			 struct line_resolver *resolver, unsigned int *offsets,
+			 enum gpiod_line_value *values)
+{
+	int i, num_values = 0;
+
+	for (i = 0; i < resolver->num_chips; i++)
+		num_values += get_line_offsets_and_values(resolver, i, offsets,
+							  values + num_values);
+
+	if (gpiod_request_group_set_values(group, values))
+		print_group_errors(group, resolver);
+}
+
 /* Toggle the values of all lines in the resolver */
 static void toggle_all_lines(struct line_resolver *resolver)
 {
@@ -377,7 +482,7 @@ static void toggle_all_lines(struct line_resolver *resolver)
  * offset and values are scratch pads for working.
  */
 static void toggle_sequence(int toggles, unsigned long long *toggle_periods,
-			    struct gpiod_line_request **requests,
+			    struct gpiod_request_group *group,
 			    struct line_resolver *resolver,
 			    unsigned int *offsets,
 			    enum gpiod_line_value *values)
@@ -390,7 +495,7 @@ static void toggle_sequence(int toggles, unsigned long long *toggle_periods,
 	for (;;) {
 		sleep_us(toggle_periods[i]);
 		toggle_all_lines(resolver);
-		apply_values(requests, resolver, offsets, values);
+		apply_values(group, resolver, offsets, values);
 
 		i++;
 		if ((i == toggles - 1) && (toggle_periods[i] == 0))
@@ -401,6 +506,200 @@ static void toggle_sequence(int toggles, unsigned long long *toggle_periods,
 	}
 }
 
+/*
+ * Map each line, in the order given on the command line, to its index in
+ * the values of the request group, which are grouped by chip.
+ */
+static void map_group_slots(struct line_resolver *resolver, int *slots)
+{
+	int i, j, slot = 0;
+
+	for (i = 0; i < resolver->num_chips; i++)
+		for (j = 0; j < resolver->num_lines; j++)
+			if (resolver->lines[j].chip_num == i)
+				slots[j] = slot++;
+}
+
+static bool decode_text_frame(const char *frame, size_t len, int num_lines,
+			      const int *slots, enum gpiod_line_value *values)
+{
+	int i;
+
+	if (len && frame[len - 1] == '\r')
+		len--;
+
+	if (len != (size_t)num_lines)
+		return false;
+
+	for (i = 0; i < num_lines; i++) {
+		if (frame[i] != '0' && frame[i] != '1')
+			return false;
+
+		values[slots[i]] = frame[i] == '1' ? GPIOD_LINE_VALUE_ACTIVE :
+						     GPIOD_LINE_VALUE_INACTIVE;
+	}
+
+	return true;
+}
+
+static void decode_binary_frame(const unsigned char *frame, int num_lines,
+				const int *slots, enum gpiod_line_value *values)
+{
+	int i;
+
+	for (i = 0; i < num_lines; i++)
+		values[slots[i]] = (frame[i / 8] >> (i % 8)) & 1 ?
+					GPIOD_LINE_VALUE_ACTIVE :
+					GPIOD_LINE_VALUE_INACTIVE;
+}
+
+/*
+ * Apply frames of values read from stdin until end of file.
+ *
+ * The frames are decoded straight into the values of the request group,
+ * so every frame costs a single set per chip and no line ids are looked
+ * up after startup.
+ */
+static void stream_values(struct gpiod_request_group *group,
+			  struct line_resolver *resolver,
+			  enum gpiod_line_value *values, int format)
+{
+	int num_lines = resolver->num_lines, *slots;
+	size_t frame_size, len = 0, pos;
+	unsigned long frame_num = 0;
+	char *buf, *end;
+	ssize_t rd;
+
+	slots = calloc(num_lines, sizeof(*slots));
+	/* Room for the newline appended to the last text frame. */
+	buf = malloc(STDIN_BUF_SIZE + 1);
+	if (!slots || !buf)
+		die("out of memory");
+
+	map_group_slots(resolver, slots);
+	frame_size = (num_lines + 7) / 8;
+
+	for (;;) {
+		rd = read(STDIN_FILENO, buf + len, STDIN_BUF_SIZE - len);
+		if (rd < 0) {
+			if (errno == EINTR)
+				continue;
+
+			die_perror("error reading frames");
+		}
+
+		if (rd == 0) {
+			/* Allow the last text frame to lack the newline. */
+			if (len && format == STDIN_FORMAT_TEXT) {
+				buf[len++] = '\n';
+			} else if (len) {
+				die("incomplete frame %lu", frame_num + 1);
+			} else {
+				break;
+			}
+		} else {
+			len += rd;
+		}
+
+		for (pos = 0;;) {
+			if (format == STDIN_FORMAT_BINARY) {
+				if (len - pos < frame_size)
+					break;
+
+				decode_binary_frame((unsigned char *)buf + pos,
+						    num_lines, slots, values);
+				pos += frame_size;
+			} else {
+				end = memchr(buf + pos, '\n', len - pos);
+				if (!end)
+					break;
+
+				if (!decode_text_frame(buf + pos,
+						       end - (buf + pos),
+						       num_lines, slots,
+						       values))
+					die("invalid frame %lu", frame_num + 1);
+
+				pos = end - buf + 1;
+			}
+
+			frame_num++;
+
+			if (gpiod_request_group_set_values(group, values)) {
+				print_group_errors(group, resolver);
+				die("unable to set values of frame %lu",
+				    frame_num);
+			}
+		}
+
+		if (pos == 0 && len == STDIN_BUF_SIZE)
+			die("frame %lu is too long", frame_num + 1);
+
+		memmove(buf, buf + pos, len - pos);
+		len -= pos;
+	}
+
+	free(buf);
+	free(slots);
+}
+
+/*
+ * Drive the resolved lines with PWM signals of the given period and duty
+ * cycles until interrupted, then report the achieved signal parameters.
+ */
+static void run_pwm(struct gpiod_line_request **requests,
+		    struct line_resolver *resolver, char **lines, int *duties,
+		    unsigned long long period_us)
+{
+	uint64_t period_ns = period_us * 1000, jitter, max_jitter;
+	struct timespec poll_interval = { 0, 100000000 };
+	struct resolved_line *line;
+	struct gpiod_pwm *pwm;
+	double frequency;
+	sigset_t sigmask;
+	int i, ret, sig;
+
+	pwm = gpiod_pwm_new();
+	if (!pwm)
+		die_perror("unable to allocate the PWM engine");
+
+	for (i = 0; i < resolver->num_lines; i++) {
+		line = &resolver->lines[i];
+		ret = gpiod_pwm_add_channel(pwm, requests[line->chip_num],
+					    line->offset, period_ns,
+					    period_ns * duties[i] / 100);
+		if (ret < 0)
+			die_perror("unable to add PWM channel for '%s'",
+				   lines[i]);
+	}
+
+	/* Block the signals before spawning the timer thread. */
+	sigemptyset(&sigmask);
+	sigaddset(&sigmask, SIGINT);
+	sigaddset(&sigmask, SIGTERM);
+	sigprocmask(SIG_BLOCK, &sigmask, NULL);
+
+	if (gpiod_pwm_start(pwm))
+		die_perror("unable to start the PWM engine");
+
+	/* Wake up periodically to bail out if the timer thread failed. */
+	do {
+		sig = sigtimedwait(&sigmask, NULL, &poll_interval);
+	} while (sig < 0 && !gpiod_pwm_get_error(pwm));
+
+	if (gpiod_pwm_stop(pwm))
+		die_perror("error generating PWM signals");
+
+	for (i = 0; i < resolver->num_lines; i++) {
+		gpiod_pwm_get_stats(pwm, i, &frequency, &jitter, &max_jitter);
+		printf("'%s': %.3f Hz, jitter: avg %llu ns, max %llu ns\n",
+		       lines[i], frequency, (unsigned long long)jitter,
+		       (unsigned long long)max_jitter);
+	}
+
+	gpiod_pwm_free(pwm);
+}
+
 #ifdef GPIOSET_INTERACTIVE
 
 /*
@@ -734,7 +1033,7 @@ static char **tab_completion(const char *text, int start, int end)
 
 #define PROMPT "gpioset> "
 
-static void interact(struct gpiod_line_request **requests,
+static void interact(struct gpiod_request_group *group,
 		     struct line_resolver *resolver, char **lines,
 		     unsigned int *offsets, enum gpiod_line_value *values,
 		     bool unquoted)
@@ -793,12 +1092,11 @@ static void interact(struct gpiod_line_request **requests,
 			if (num_lines == 0)
 				printf("at least one GPIO line value must be specified\n");
 			else if (parse_line_values(num_lines, &words[1], lines,
-						   values, true) &&
+						   values, NULL, true) &&
 				 valid_lines(resolver, num_lines, lines)) {
 				set_line_values_subset(resolver, num_lines,
 						       lines, values);
-				apply_values(requests, resolver, offsets,
-					     values);
+				apply_values(group, resolver, offsets, values);
 			}
 			goto cmd_ok;
 		}
@@ -809,7 +1107,7 @@ static void interact(struct gpiod_line_request **requests,
 				 valid_lines(resolver, num_lines, lines))
 				toggle_lines(resolver, num_lines, lines);
 
-			apply_values(requests, resolver, offsets, values);
+			apply_values(group, resolver, offsets, values);
 			goto cmd_ok;
 		}
 		if (strcmp(words[0], "sleep") == 0) {
@@ -866,6 +1164,7 @@ int main(int argc, char **argv)
 	struct gpiod_line_settings *settings;
 	struct gpiod_request_config *req_cfg;
 	struct gpiod_line_request **requests;
+	struct gpiod_request_group *group;
 	struct gpiod_line_config *line_cfg;
 	struct line_resolver *resolver;
 	enum gpiod_line_value *values;
@@ -873,6 +1172,7 @@ int main(int argc, char **argv)
 	unsigned int *offsets;
 	int i, num_lines, ret;
 	struct config cfg;
+	int *duties = NULL;
 	char **lines;
 
 	set_prog_name(argv[0]);
@@ -890,7 +1190,13 @@ int main(int argc, char **argv)
 	if (!lines || !values)
 		die("out of memory");
 
-	parse_line_values_or_die(argc, argv, lines, values);
+	if (cfg.pwm_period_us) {
+		duties = calloc(num_lines, sizeof(*duties));
+		if (!duties)
+			die("out of memory");
+	}
+
+	parse_line_values_or_die(argc, argv, lines, values, duties);
 
 	settings = gpiod_line_settings_new();
 	if (!settings)
@@ -965,9 +1271,19 @@ int main(int argc, char **argv)
 		print_banner(argc, lines);
 
 	if (cfg.daemonize)
-		if (daemon(0, cfg.interactive) < 0)
+		if (daemon(0, cfg.interactive || cfg.stdin_format) < 0)
 			die_perror("unable to daemonize");
 
+	/* The worker threads of the group wouldn't survive daemonizing. */
+	group = gpiod_request_group_new();
+	if (!group)
+		die_perror("unable to allocate the request group");
+
+	for (i = 0; i < resolver->num_chips; i++) {
+		if (gpiod_request_group_add_request(group, requests[i]) < 0)
+			die_perror("unable to add the request to the group");
+	}
+
 	if (cfg.toggles) {
 		for (i = 0; i < cfg.toggles; i++)
 			if ((cfg.hold_period_us > cfg.toggle_periods[i]) &&
@@ -975,7 +1291,7 @@ int main(int argc, char **argv)
 			     cfg.toggle_periods[i] != 0))
 				cfg.toggle_periods[i] = cfg.hold_period_us;
 
-		toggle_sequence(cfg.toggles, cfg.toggle_periods, requests,
+		toggle_sequence(cfg.toggles, cfg.toggle_periods, group,
 				resolver, offsets, values);
 		free(cfg.toggle_periods);
 	}
@@ -983,17 +1299,23 @@ int main(int argc, char **argv)
 	if (cfg.hold_period_us)
 		sleep_us(cfg.hold_period_us);
 
+	if (cfg.pwm_period_us)
+		run_pwm(requests, resolver, lines, duties, cfg.pwm_period_us);
+	else if (cfg.stdin_format)
+		stream_values(group, resolver, values, cfg.stdin_format);
 #ifdef GPIOSET_INTERACTIVE
-	if (cfg.interactive)
-		interact(requests, resolver, lines, offsets, values,
+	else if (cfg.interactive)
+		interact(group, resolver, lines, offsets, values,
 			 cfg.unquoted);
 	else if (!cfg.toggles)
 		wait_fd(gpiod_line_request_get_fd(requests[0]));
 #else
-	if (!cfg.toggles)
+	else if (!cfg.toggles)
 		wait_fd(gpiod_line_request_get_fd(requests[0]));
 #endif
 
+	gpiod_request_group_free(group);
+
 	for (i = 0; i < resolver->num_chips; i++)
 		gpiod_line_request_release(requests[i]);
 
@@ -1001,6 +1323,7 @@ int main(int argc, char **argv)
 	free_line_resolver(resolver);
 	free(lines);
 	free(values);
+	free(duties);
 	free(offsets);
 
 	return EXIT_SUCCESS;
@@ -90,6 +90,8 @@ int parse_bias_or_die(const char *option);
 long long parse_period(const char *option);
 unsigned long long parse_period_or_die(const char *option);
 void sleep_us(unsigned long long period);
+uint64_t monotonic_ns(void);
+void sleep_until_ns(uint64_t deadline);
 int parse_uint(const char *option);
 unsigned int parse_uint_or_die(const char *option);
 void print_bias_help(void);